@@ -0,0 +1,280 @@
+#pragma once
+#include "Prerequisites.h"
+#include <algorithm>
+
+/**
+ * @brief Caja alineada a los ejes.
+ */
+struct
+AABB {
+    XMFLOAT3 lower = XMFLOAT3(0.0f, 0.0f, 0.0f);   ///< Esquina mínima.
+    XMFLOAT3 upper = XMFLOAT3(0.0f, 0.0f, 0.0f);   ///< Esquina máxima.
+
+    /**
+     * @brief Caja mínima que contiene a las dos cajas.
+     */
+    static AABB
+    merge(const AABB& a, const AABB& b) {
+        AABB result;
+        result.lower = XMFLOAT3(std::min(a.lower.x, b.lower.x),
+                                std::min(a.lower.y, b.lower.y),
+                                std::min(a.lower.z, b.lower.z));
+        result.upper = XMFLOAT3(std::max(a.upper.x, b.upper.x),
+                                std::max(a.upper.y, b.upper.y),
+                                std::max(a.upper.z, b.upper.z));
+        return result;
+    }
+
+    /**
+     * @brief Mitad del área de superficie (suficiente para comparar costos SAH).
+     */
+    float
+    surfaceArea() const {
+        float dx = upper.x - lower.x;
+        float dy = upper.y - lower.y;
+        float dz = upper.z - lower.z;
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+    bool
+    contains(const AABB& other) const {
+        return lower.x <= other.lower.x && lower.y <= other.lower.y && lower.z <= other.lower.z &&
+               upper.x >= other.upper.x && upper.y >= other.upper.y && upper.z >= other.upper.z;
+    }
+
+    bool
+    overlaps(const AABB& other) const {
+        return lower.x <= other.upper.x && lower.y <= other.upper.y && lower.z <= other.upper.z &&
+               upper.x >= other.lower.x && upper.y >= other.lower.y && upper.z >= other.lower.z;
+    }
+};
+
+/**
+ * @brief Resultado de un rayo contra el árbol.
+ */
+struct
+RayHit {
+    void* userData = nullptr;   ///< Datos del objeto golpeado.
+    int proxy = -1;             ///< Proxy del objeto golpeado.
+    float distance = 0.0f;      ///< Distancia desde el origen, en unidades de la dirección.
+};
+
+/**
+ * @brief Árbol dinámico de cajas (BVH) para consultas espaciales sobre objetos de la escena.
+ *
+ * Cada objeto es una hoja identificada por un proxy estable (el índice de su nodo). Las hojas
+ * guardan la caja exacta del objeto y una caja ampliada por un margen; mover un objeto dentro
+ * de su caja ampliada no modifica el árbol. Al insertar se busca el hermano de menor costo SAH
+ * con ramificación y poda, y al reajustar los ancestros se aplican rotaciones de subárboles que
+ * reducen el área total. build() construye el árbol completo de una vez con SAH por bins.
+ */
+class
+AABBTree {
+public:
+    static constexpr int kNullNode = -1;    ///< Índice de nodo inválido.
+
+    AABBTree() = default;
+    ~AABBTree() = default;
+
+    /**
+     * @brief Margen con el que se amplían las cajas de las hojas.
+     */
+    void
+    setMargin(float margin) { m_margin = margin; }
+
+    /**
+     * @brief Inserta un objeto.
+     * @param box Caja del objeto en mundo.
+     * @param userData Dato asociado que devuelven las consultas.
+     * @return Proxy del objeto.
+     */
+    int
+    insert(const AABB& box, void* userData);
+
+    /**
+     * @brief Elimina un objeto.
+     * @param proxy Proxy devuelto por insert() o build().
+     */
+    void
+    remove(int proxy);
+
+    /**
+     * @brief Actualiza la caja de un objeto tras cambiar su transformación.
+     * @param proxy Proxy del objeto.
+     * @param box Nueva caja en mundo.
+     * @return true si la hoja se reinsertó (la caja salió de su caja ampliada).
+     */
+    bool
+    move(int proxy, const AABB& box);
+
+    /**
+     * @brief Reemplaza el árbol con uno construido de arriba hacia abajo con SAH por bins.
+     * @param boxes Cajas de los objetos.
+     * @param userData Dato de cada objeto (mismo tamaño que boxes).
+     * @param proxies Salida: proxy de cada objeto, en el mismo orden.
+     */
+    void
+    build(const std::vector<AABB>& boxes,
+          const std::vector<void*>& userData,
+          std::vector<int>& proxies);
+
+    /**
+     * @brief Elimina todos los objetos.
+     */
+    void
+    clear();
+
+    /**
+     * @brief Obtiene los objetos cuya caja intersecta el frustum.
+     * @param viewProjection Producto vista * proyección.
+     * @param results Salida: datos de los objetos visibles (se agregan al final).
+     */
+    void
+    queryFrustum(const XMMATRIX& viewProjection, std::vector<void*>& results) const;
+
+    /**
+     * @brief Obtiene los objetos cuya caja se superpone con otra caja.
+     * @param box Caja de consulta.
+     * @param results Salida: datos de los objetos (se agregan al final).
+     */
+    void
+    queryOverlap(const AABB& box, std::vector<void*>& results) const;
+
+    /**
+     * @brief Busca la caja más cercana que golpea un rayo.
+     * @param origin Origen del rayo.
+     * @param direction Dirección del rayo (no necesita estar normalizada).
+     * @param maxDistance Distancia máxima en unidades de la dirección.
+     * @param hit Salida: objeto golpeado más cercano.
+     * @return true si el rayo golpeó algún objeto.
+     */
+    bool
+    raycast(const XMFLOAT3& origin,
+            const XMFLOAT3& direction,
+            float maxDistance,
+            RayHit& hit) const;
+
+    void*
+    getUserData(int proxy) const { return m_nodes[proxy].userData; }
+
+    const AABB&
+    getFatBox(int proxy) const { return m_nodes[proxy].box; }
+
+    /**
+     * @brief Altura del árbol (0 si está vacío o tiene una sola hoja).
+     */
+    int
+    getHeight() const { return m_root == kNullNode ? 0 : m_nodes[m_root].height; }
+
+    unsigned int
+    getLeafCount() const { return m_leafCount; }
+
+    /**
+     * @brief Rotaciones aplicadas desde la creación del árbol.
+     */
+    unsigned int
+    getRotationCount() const { return m_rotations; }
+
+    /**
+     * @brief Costo SAH del árbol: suma de las áreas de los nodos internos.
+     */
+    float
+    computeCost() const;
+
+private:
+    struct Node {
+        AABB box;                   ///< Caja ampliada (hojas) o caja de los hijos (internos).
+        AABB tight;                 ///< Caja exacta del objeto (solo hojas).
+        void* userData = nullptr;   ///< Dato del objeto (solo hojas).
+        int parent = kNullNode;     ///< Padre, o siguiente nodo libre si el nodo no está en uso.
+        int child1 = kNullNode;     ///< Primer hijo (kNullNode en hojas).
+        int child2 = kNullNode;     ///< Segundo hijo.
+        int height = 0;             ///< 0 en hojas, -1 en nodos libres.
+
+        bool
+        isLeaf() const { return child1 == kNullNode; }
+    };
+
+    int
+    allocateNode();
+
+    void
+    freeNode(int node);
+
+    void
+    insertLeaf(int leaf);
+
+    void
+    removeLeaf(int leaf);
+
+    /**
+     * @brief Busca el nodo hermano que minimiza el costo SAH de insertar una caja.
+     */
+    int
+    findBestSibling(const AABB& box);
+
+    /**
+     * @brief Recalcula cajas y alturas desde un nodo hasta la raíz, rotando en el camino.
+     */
+    void
+    refitAncestors(int node);
+
+    /**
+     * @brief Intercambia un hijo con un nieto si eso reduce el área del nodo intermedio.
+     */
+    void
+    rotate(int node);
+
+    /**
+     * @brief Hoja pendiente de ubicar durante build(); contigua para recorrerla sin saltos.
+     */
+    struct BuildEntry {
+        AABB box;                   ///< Caja ampliada de la hoja.
+        XMFLOAT3 center;            ///< Centroide de la caja.
+        int leaf;                   ///< Nodo hoja.
+    };
+
+    /**
+     * @brief Construye un subárbol a partir de un rango de hojas.
+     * @return Índice del nodo raíz del subárbol.
+     */
+    int
+    buildRange(BuildEntry* entries, unsigned int count);
+
+    AABB
+    inflate(const AABB& box) const;
+
+private:
+    std::vector<Node> m_nodes;                  ///< Nodos (los índices de hojas son los proxies).
+    int m_root = kNullNode;                     ///< Raíz del árbol.
+    int m_freeList = kNullNode;                 ///< Primer nodo libre.
+    unsigned int m_leafCount = 0;               ///< Objetos en el árbol.
+    unsigned int m_rotations = 0;               ///< Rotaciones aplicadas.
+    float m_margin = 0.1f;                      ///< Margen de las cajas ampliadas.
+    std::vector<std::pair<float, int>> m_heap;  ///< Candidatos de la búsqueda de hermano.
+};
+
+/**
+ * @brief Resultado de runAABBTreeBenchmark().
+ */
+struct
+AABBTreeBenchmarkResult {
+    unsigned int objects = 0;           ///< Objetos en el árbol.
+    int height = 0;                     ///< Altura del árbol construido.
+    double buildMs = 0.0;               ///< Tiempo de build().
+    double frustumQueryMs = 0.0;        ///< Tiempo medio de una queryFrustum().
+    double frustumResults = 0.0;        ///< Objetos visibles promedio por queryFrustum().
+    double raycastsPerMs = 0.0;         ///< Rayos por milisegundo con raycast().
+    double raycastHitRate = 0.0;        ///< Fracción de rayos que golpearon algún objeto.
+    double overlapQueriesPerMs = 0.0;   ///< Consultas por milisegundo con queryOverlap().
+    double overlapResults = 0.0;        ///< Objetos promedio por queryOverlap().
+};
+
+/**
+ * @brief Mide build() y las consultas del árbol sobre cajas aleatorias (semilla fija) de 1 a 4
+ *        unidades repartidas en un cubo de 2000 unidades.
+ * @param objects Objetos del árbol.
+ * @param queries Consultas de rayo y de superposición (las de frustum son queries / 1000, mínimo 8).
+ */
+AABBTreeBenchmarkResult
+runAABBTreeBenchmark(unsigned int objects, unsigned int queries);
@@ -0,0 +1,223 @@
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @brief Influencias de huesos de un vértice: los 4 huesos de mayor peso con pesos
+ *        normalizados y cuantizados a 8 bits (suman exactamente 255).
+ *
+ * Los índices de 8 bits limitan el esqueleto a kMaxSkinBones huesos.
+ */
+struct
+VertexSkin {
+    unsigned char bones[4] = { 0, 0, 0, 0 };    ///< Índices en Skeleton::bones.
+    unsigned char weights[4] = { 0, 0, 0, 0 };  ///< Pesos en 1/255 (0 = influencia sin usar).
+};
+
+/**
+ * @brief Transformación local de un hueso separada en traslación, rotación y escala.
+ */
+struct
+BoneTransform {
+    XMFLOAT3 translation = XMFLOAT3(0.0f, 0.0f, 0.0f);      ///< Traslación.
+    XMFLOAT4 rotation = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);   ///< Rotación (cuaternión x, y, z, w).
+    XMFLOAT3 scale = XMFLOAT3(1.0f, 1.0f, 1.0f);            ///< Escala.
+};
+
+/**
+ * @brief Hueso del esqueleto.
+ */
+struct
+Bone {
+    std::string name;           ///< Nombre del nodo en el archivo.
+    int parent = -1;            ///< Índice del padre (siempre menor que el propio) o -1.
+    BoneTransform bindPose;     ///< Transformación local en la pose de enlace.
+    XMFLOAT4X4 inverseBindPose; ///< Espacio de la malla a espacio del hueso en la pose de enlace.
+};
+
+/**
+ * @brief Jerarquía de huesos ordenada de padres a hijos.
+ *
+ * Las matrices siguen la convención del motor (vector fila): un vértice se transforma con
+ * v * inverseBindPose * model, y el espacio del modelo de un hueso es local * model(padre).
+ */
+class
+Skeleton {
+public:
+    static constexpr unsigned int kMaxSkinBones = 256;  ///< Huesos direccionables por VertexSkin.
+
+    /**
+     * @brief Índice del hueso con ese nombre o -1.
+     */
+    int
+    findBone(const std::string& name) const;
+
+    /**
+     * @brief Pose de enlace de todos los huesos (para modelos sin animación).
+     * @param pose Salida: una transformación local por hueso.
+     */
+    void
+    getBindPose(std::vector<BoneTransform>& pose) const;
+
+    /**
+     * @brief Calcula las matrices de skinning (inverseBindPose * espacio del modelo) de una pose.
+     * @param pose Transformación local de cada hueso.
+     * @param skinMatrices Salida: una matriz por hueso.
+     */
+    void
+    computeSkinMatrices(const std::vector<BoneTransform>& pose,
+                        std::vector<XMFLOAT4X4>& skinMatrices) const;
+
+    unsigned int
+    getBoneCount() const { return static_cast<unsigned int>(bones.size()); }
+
+public:
+    std::vector<Bone> bones;    ///< Huesos, padres antes que hijos.
+};
+
+/**
+ * @brief Canales de una transformación local en las estructuras SoA.
+ */
+enum
+PoseChannel {
+    POSE_TRANSLATION_X = 0,
+    POSE_TRANSLATION_Y,
+    POSE_TRANSLATION_Z,
+    POSE_ROTATION_X,
+    POSE_ROTATION_Y,
+    POSE_ROTATION_Z,
+    POSE_ROTATION_W,
+    POSE_SCALE_X,
+    POSE_SCALE_Y,
+    POSE_SCALE_Z,
+    POSE_CHANNEL_COUNT
+};
+
+/**
+ * @brief Pose local de un esqueleto en formato SoA: un arreglo por canal, con los huesos
+ *        rellenados hasta múltiplo de kLanes para procesar 8 huesos por instrucción AVX.
+ *
+ * Los huesos de relleno guardan la identidad (cuaternión unitario y escala 1).
+ */
+class
+PoseSoA {
+public:
+    static constexpr unsigned int kLanes = 8;   ///< Huesos por registro AVX.
+
+    /**
+     * @brief Redimensiona la pose; los huesos nuevos quedan en la identidad.
+     */
+    void
+    resize(unsigned int boneCount);
+
+    unsigned int
+    getBoneCount() const { return m_boneCount; }
+
+    unsigned int
+    getPaddedBoneCount() const { return m_paddedBones; }
+
+    float*
+    channel(PoseChannel c) { return m_channels.data() + static_cast<size_t>(c) * m_paddedBones; }
+
+    const float*
+    channel(PoseChannel c) const { return m_channels.data() + static_cast<size_t>(c) * m_paddedBones; }
+
+    BoneTransform
+    get(unsigned int bone) const;
+
+    void
+    set(unsigned int bone, const BoneTransform& transform);
+
+private:
+    unsigned int m_boneCount = 0;                                   ///< Huesos reales.
+    unsigned int m_paddedBones = 0;                                 ///< Huesos con relleno.
+    TrackedVector<float, MEMORY_TAG_ANIMATION> m_channels;          ///< POSE_CHANNEL_COUNT * m_paddedBones.
+};
+
+/**
+ * @brief Clip de animación muestreado a frecuencia fija.
+ *
+ * Cada muestra es una pose completa en SoA (samples[(muestra * POSE_CHANNEL_COUNT + canal) *
+ * paddedBones + hueso]): evaluar un instante es calcular dos índices e interpolar canal por
+ * canal de 8 en 8 huesos, sin buscar llaves y recorriendo la memoria en orden. Los
+ * cuaterniones de muestras consecutivas están en el mismo hemisferio, así que basta con nlerp.
+ */
+class
+AnimationClip {
+public:
+    /**
+     * @brief Reserva las muestras con todos los huesos en la identidad.
+     */
+    void
+    init(const std::string& clipName, float clipDuration, float rate, unsigned int samples, unsigned int bones);
+
+    /**
+     * @brief Transformación local de un hueso en una muestra.
+     */
+    BoneTransform
+    getTransform(unsigned int sample, unsigned int bone) const;
+
+    void
+    setTransform(unsigned int sample, unsigned int bone, const BoneTransform& transform);
+
+    /**
+     * @brief Evalúa la pose del clip en un instante (AVX2 si el procesador lo soporta).
+     * @param time Segundos desde el inicio del clip.
+     * @param loop Si es verdadero el tiempo se envuelve; si no, se limita a la duración.
+     * @param pose Salida: pose local del esqueleto.
+     */
+    void
+    sample(float time, bool loop, PoseSoA& pose) const;
+
+    /**
+     * @brief Igual que sample(), con una transformación por hueso.
+     */
+    void
+    sample(float time, bool loop, std::vector<BoneTransform>& pose) const;
+
+    /**
+     * @brief Memoria de las muestras en bytes.
+     */
+    size_t
+    getMemoryBytes() const { return m_samples.size() * sizeof(float); }
+
+    unsigned int
+    getSampleCount() const { return m_sampleCount; }
+
+    unsigned int
+    getBoneCount() const { return m_boneCount; }
+
+public:
+    std::string name;                   ///< Nombre de la pila de animación.
+    float duration = 0.0f;              ///< Duración en segundos.
+    float sampleRate = 30.0f;           ///< Muestras por segundo.
+
+private:
+    const float*
+    samplePointer(unsigned int sample) const {
+        return m_samples.data() + static_cast<size_t>(sample) * POSE_CHANNEL_COUNT * m_paddedBones;
+    }
+
+    float*
+    samplePointer(unsigned int sample) {
+        return m_samples.data() + static_cast<size_t>(sample) * POSE_CHANNEL_COUNT * m_paddedBones;
+    }
+
+private:
+    unsigned int m_sampleCount = 0;                                 ///< Muestras (incluye ambos extremos).
+    unsigned int m_boneCount = 0;                                   ///< Huesos por muestra.
+    unsigned int m_paddedBones = 0;                                 ///< Huesos con relleno a PoseSoA::kLanes.
+    TrackedVector<float, MEMORY_TAG_ANIMATION> m_samples;           ///< Poses SoA consecutivas.
+};
+
+/**
+ * @brief Cuantiza influencias arbitrarias de un vértice a VertexSkin.
+ *
+ * Conserva las 4 de mayor peso, las normaliza y reparte el error de redondeo para que los
+ * pesos de 8 bits sumen exactamente 255.
+ * @param bones Índice de hueso de cada influencia.
+ * @param weights Peso de cada influencia.
+ * @param count Número de influencias.
+ * @return Influencias cuantizadas (todas en cero si ningún peso es positivo).
+ */
+VertexSkin
+quantizeSkinWeights(const unsigned int* bones, const float* weights, unsigned int count);
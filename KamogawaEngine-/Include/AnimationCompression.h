@@ -0,0 +1,184 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Animation.h"
+
+/**
+ * @brief Parámetros de compresión de un clip.
+ *
+ * El error se mide en espacio del modelo sobre puntos virtuales a virtualVertexDistance de cada
+ * hueso (el desplazamiento que vería un vértice con skin), no sobre los valores locales.
+ */
+struct
+AnimationCompressionSettings {
+    float maxError = 0.01f;             ///< Error máximo en espacio del modelo (unidades de la escena).
+    float virtualVertexDistance = 3.0f; ///< Distancia de los puntos virtuales a su hueso.
+    unsigned int maxIterations = 4;     ///< Pasadas para endurecer huesos que superan el error.
+};
+
+/**
+ * @brief Resultado de CompressedAnimationClip::compress().
+ */
+struct
+AnimationCompressionReport {
+    size_t rawBytes = 0;                ///< Memoria del clip sin compactar (floats sin relleno).
+    size_t compressedBytes = 0;         ///< Memoria del clip comprimido.
+    double ratio = 0.0;                 ///< rawBytes / compressedBytes.
+    float maxError = 0.0f;              ///< Peor error medido en espacio del modelo.
+    float averageError = 0.0f;          ///< Error medio por hueso y muestra.
+    int worstBone = -1;                 ///< Hueso con el peor error.
+    unsigned int constantTracks = 0;    ///< Pistas reducidas a un valor.
+    unsigned int animatedTracks = 0;    ///< Pistas con llaves.
+    unsigned int rawKeys = 0;           ///< Muestras de las pistas animadas antes de reducir.
+    unsigned int keptKeys = 0;          ///< Llaves conservadas.
+    unsigned int iterations = 0;        ///< Pasadas de compresión realizadas.
+};
+
+/**
+ * @brief Componente de la transformación que guarda una pista.
+ */
+enum
+CompressedTrackType {
+    TRACK_TRANSLATION = 0,
+    TRACK_ROTATION = 1,
+    TRACK_SCALE = 2
+};
+
+/**
+ * @brief Pista de un hueso: un valor constante o un rango de cuantización para sus llaves.
+ */
+struct
+CompressedTrack {
+    unsigned short bone = 0;            ///< Hueso de la pista.
+    unsigned char type = TRACK_TRANSLATION; ///< CompressedTrackType.
+    unsigned char constant = 0;         ///< 1 si la pista no tiene llaves.
+    float origin[4] = {};               ///< Valor constante, o mínimo del rango (traslación y escala).
+    float extent[3] = {};               ///< Tamaño del rango de cuantización (traslación y escala).
+};
+
+/**
+ * @brief Llave de 48 bits: cuaternión "smallest three" (2 + 3 x 15 bits) o tres valores de
+ *        16 bits normalizados al rango de la pista.
+ */
+struct
+CompressedKey {
+    unsigned short sample = 0;          ///< Muestra del clip original.
+    unsigned short track = 0;           ///< Índice de la pista.
+    unsigned short value[3] = {};       ///< Valor cuantizado.
+};
+
+class CompressedAnimationClip;
+
+/**
+ * @brief Estado de reproducción de un clip comprimido para una instancia.
+ *
+ * Guarda las dos llaves decodificadas que rodean el tiempo actual de cada pista y la posición en
+ * el flujo de llaves; avanzar en el tiempo solo lee las llaves siguientes del flujo.
+ */
+class
+CompressedClipCursor {
+public:
+    /**
+     * @brief Obliga a reiniciar el flujo en el siguiente muestreo.
+     */
+    void
+    reset() { m_clip = nullptr; }
+
+private:
+    friend class CompressedAnimationClip;
+
+    /**
+     * @brief Llaves vecinas de una pista, ya decodificadas.
+     */
+    struct TrackState {
+        unsigned short left = 0;        ///< Muestra de la llave anterior.
+        unsigned short right = 0;       ///< Muestra de la llave siguiente.
+        float from[4] = {};             ///< Valor de la llave anterior.
+        float to[4] = {};               ///< Valor de la llave siguiente.
+    };
+
+    const CompressedAnimationClip* m_clip = nullptr;    ///< Clip del estado actual.
+    size_t m_position = 0;                              ///< Siguiente llave del flujo.
+    float m_samplePosition = 0.0f;                      ///< Último instante muestreado (en muestras).
+    std::vector<TrackState> m_tracks;                   ///< Estado por pista.
+};
+
+/**
+ * @brief Clip de animación comprimido para reproducción en streaming.
+ *
+ * Las pistas constantes se guardan como un valor. De las animadas se conservan solo las llaves
+ * necesarias para que la interpolación lineal quede bajo el error, cuantizadas a 48 bits. Las
+ * llaves se guardan en un único flujo ordenado por el instante en que se necesitan (cuando la
+ * reproducción pasa la llave anterior de su pista), así que reproducir hacia adelante recorre la
+ * memoria en orden y decodifica cada llave una sola vez. Retroceder reinicia el flujo.
+ */
+class
+CompressedAnimationClip {
+public:
+    /**
+     * @brief Comprime un clip.
+     * @param clip Clip muestreado.
+     * @param skeleton Esqueleto del clip (jerarquía para medir el error).
+     * @param settings Parámetros de compresión.
+     * @param report Salida opcional con la relación de compresión y el error.
+     * @return Falso si el clip no se puede representar (más de 65535 muestras o pistas).
+     */
+    bool
+    compress(const AnimationClip& clip,
+             const Skeleton& skeleton,
+             const AnimationCompressionSettings& settings,
+             AnimationCompressionReport* report = nullptr);
+
+    /**
+     * @brief Evalúa la pose en un instante avanzando el cursor de la instancia.
+     */
+    void
+    sample(float time, bool loop, CompressedClipCursor& cursor, PoseSoA& pose) const;
+
+    /**
+     * @brief Memoria de pistas y llaves en bytes.
+     */
+    size_t
+    getMemoryBytes() const {
+        return m_tracks.size() * sizeof(CompressedTrack) + m_keys.size() * sizeof(CompressedKey);
+    }
+
+    unsigned int
+    getBoneCount() const { return m_boneCount; }
+
+    unsigned int
+    getKeyCount() const { return static_cast<unsigned int>(m_keys.size()); }
+
+public:
+    std::string name;                   ///< Nombre de la pila de animación.
+    float duration = 0.0f;              ///< Duración en segundos.
+    float sampleRate = 30.0f;           ///< Muestras por segundo del clip original.
+
+private:
+    /**
+     * @brief Evalúa la pose en una posición medida en muestras del clip original.
+     */
+    void
+    evaluate(float position, CompressedClipCursor& cursor, PoseSoA& pose) const;
+
+    /**
+     * @brief Decodifica las dos primeras llaves de cada pista animada.
+     */
+    void
+    rewind(CompressedClipCursor& cursor) const;
+
+    /**
+     * @brief Lee del flujo las llaves necesarias hasta la muestra frame.
+     */
+    void
+    advance(CompressedClipCursor& cursor, unsigned int frame) const;
+
+    void
+    decodeKey(const CompressedKey& key, float* value) const;
+
+private:
+    unsigned int m_sampleCount = 0;                             ///< Muestras del clip original.
+    unsigned int m_boneCount = 0;                               ///< Huesos.
+    unsigned int m_animatedTracks = 0;                          ///< Pistas con llaves.
+    TrackedVector<CompressedTrack, MEMORY_TAG_ANIMATION> m_tracks;  ///< Pistas de todos los huesos.
+    TrackedVector<CompressedKey, MEMORY_TAG_ANIMATION> m_keys;      ///< Flujo de llaves.
+};
@@ -5,6 +5,7 @@
 #include "DeviceContext.h"
 #include "Swapchain.h"
 #include "Texture.h"
+#include "TextureAtlas.h"
 #include "RenderTargetView.h"
 #include "DepthStencilView.h"
 #include "Viewport.h"
@@ -15,10 +16,28 @@
 #include "UserInterface.h"
 #include "ModelLoader.h"
 #include "ECS/Actor.h"
+#include "RenderQueue.h"
+#include "ConstantBufferRing.h"
+#include "AABBTree.h"
+#include "OcclusionCuller.h"
+#include "CommandRecorder.h"
+#include "CommandListPool.h"
+#include "FrameStats.h"
+#include "FrameArena.h"
+#include "FrameClock.h"
+#include "FramePacket.h"
+#include "Skinning.h"
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
 
 /**
- * @brief Clase principal base para una aplicacin grfica.
- * Encapsula la lgica de inicializacin, actualizacin, renderizado y destruccin.
+ * @brief Clase principal base para una aplicación gráfica.
+ * Encapsula la lógica de inicialización, actualización, renderizado y destrucción.
+ *
+ * La simulación corre en su propio hilo y publica cada frame como un FramePacket inmutable;
+ * el hilo principal atiende los mensajes de la ventana y dibuja el último paquete publicado.
+ * El estado del mundo (actores, cámara, árbol de la escena) solo se toca bajo m_worldMutex.
  */
 class 
 BaseApp {
@@ -27,33 +46,71 @@ public:
     ~BaseApp() = default;
 
     /**
-     * @brief Inicializa los componentes necesarios para la aplicacin.
-     * @return HRESULT Indica si la inicializacin fue exitosa.
+     * @brief Inicializa los componentes necesarios para la aplicación.
+     * @return HRESULT Indica si la inicialización fue exitosa.
      */
     HRESULT
     init();
 
     /**
-     * @brief Actualiza el estado de la aplicacin en cada ciclo.
+     * @brief Actualiza el estado de la aplicación en cada ciclo: ejecuta los pasos de
+     *        simulación pendientes e interpola cámara y actores para el render.
      */
     void 
     update();
 
     /**
-     * @brief Lgica de renderizado de cada frame.
+     * @brief Congela en el paquete el estado que dibuja el render: cámara, matrices de los
+     *        actores y actores dentro del frustum.
+     * @param packet Paquete a escribir (propiedad del hilo de simulación hasta publicarlo).
+     */
+    void
+    buildFramePacket(FramePacket& packet);
+
+    /**
+     * @brief Bucle del hilo de simulación: update() y publicación de un paquete por frame.
+     * @param packetCount Paquetes a publicar (0 = hasta stopSimulation()).
+     */
+    void
+    simulationLoop(unsigned int packetCount);
+
+    /**
+     * @brief Arranca el hilo de simulación.
+     * @param packetCount Paquetes a publicar (0 = hasta stopSimulation()).
+     * @param lockstep Si es verdadero cada paquete se dibuja (corridas reproducibles).
+     */
+    void
+    startSimulation(unsigned int packetCount, bool lockstep);
+
+    /**
+     * @brief Detiene y espera al hilo de simulación.
+     */
+    void
+    stopSimulation();
+
+    /**
+     * @brief Avanza la simulación un paso fijo (entrada, cámara y actores).
+     * @param deltaTime Duración del paso en segundos.
+     */
+    void
+    simulate(float deltaTime);
+
+    /**
+     * @brief Lógica de renderizado de cada frame.
+     * @param packet Estado del frame publicado por la simulación.
      */
     void 
-    render();
+    render(const FramePacket& packet);
 
     /**
-     * @brief Libera recursos y finaliza la aplicacin.
+     * @brief Libera recursos y finaliza la aplicación.
      */
     void 
     destroy();
 
     /**
-     * @brief Mapea las entradas del usuario y aplica acciones segn el deltaTime.
-     * @param deltaTime Tiempo transcurrido desde el ltimo frame.
+     * @brief Mapea las entradas del usuario y aplica acciones según el deltaTime.
+     * @param deltaTime Duración del paso de simulación.
      */
     void 
     InputActionMap(float deltaTime);
@@ -61,34 +118,56 @@ public:
     /**
      * @brief Maneja el evento de redimensionamiento de la ventana.
      * @param hWnd Manejador de la ventana.
-     * @param lParam Parmetros del evento de redimensionamiento.
+     * @param lParam Parámetros del evento de redimensionamiento.
      * @return HRESULT Resultado del manejo.
      */
     HRESULT 
     resizeWindow(HWND hWnd, LPARAM lParam);
 
     /**
-     * @brief Actualiza la cmara con base en las entradas o cambios del entorno.
+     * @brief Actualiza la cámara con base en las entradas o cambios del entorno.
      */
     void 
     updateCamera();
 
     /**
-     * @brief Rota la cmara en funcin del movimiento del mouse.
-     * @param mouseX Posicin X del mouse.
-     * @param mouseY Posicin Y del mouse.
+     * @brief Rota la cámara en función del movimiento del mouse.
+     * @param mouseX Posición X del mouse.
+     * @param mouseY Posición Y del mouse.
      */
     void 
     rotateCamera(int mouseX, int mouseY);
 
     /**
-     * @brief Inicia la ejecucin principal de la aplicacin.
-     * @param hInstance Instancia actual de la aplicacin.
+     * @brief Selecciona el actor más cercano bajo el cursor lanzando un rayo contra el árbol de la escena.
+     * @param mouseX Posición X del mouse en la ventana.
+     * @param mouseY Posición Y del mouse en la ventana.
+     */
+    void
+    pickActor(int mouseX, int mouseY);
+
+    /**
+     * @brief Inicia o termina la captura del profiler (F9); al terminar escribe "ProfileTrace.json".
+     */
+    void
+    toggleProfilerCapture();
+
+    /**
+     * @brief Junta los contadores del frame (registro, cola, oclusión, anillo) en el historial
+     *        del panel de estadísticas.
+     * @param packet Paquete dibujado (pasos de simulación, jitter y latencia).
+     */
+    void
+    updateFrameStats(const FramePacket& packet);
+
+    /**
+     * @brief Inicia la ejecución principal de la aplicación.
+     * @param hInstance Instancia actual de la aplicación.
      * @param hPrevInstance Instancia anterior (usualmente nula).
-     * @param lpCmdLine Lnea de comandos.
-     * @param nCmdShow Modo de visualizacin de la ventana.
+     * @param lpCmdLine Línea de comandos.
+     * @param nCmdShow Modo de visualización de la ventana.
      * @param wndproc Procedimiento de ventana.
-     * @return int Cdigo de retorno de la aplicacin.
+     * @return int Código de retorno de la aplicación.
      */
     int run(HINSTANCE hInstance,
             HINSTANCE hPrevInstance,
@@ -96,6 +175,28 @@ public:
             int nCmdShow,
             WNDPROC wndproc);
 
+    /**
+     * @brief Corre un número fijo de frames sin ventana visible y escribe el reporte del registro.
+     *
+     * Se usa con el backend nulo (argumento "-headless [frames] [reporte]") para medir tiempo
+     * de CPU por frame, dibujos, cambios de estado y memoria de recursos sin GPU. Simulación y
+     * render corren en lockstep y al final se registra el hash de todos los paquetes: dos
+     * corridas con los mismos argumentos deben dar el mismo hash.
+     *
+     * @param frameCount Frames a ejecutar.
+     * @param reportPath Ruta del reporte JSON.
+     * @return 0 si el reporte se escribió.
+     */
+    int
+    runHeadless(unsigned int frameCount, const std::string& reportPath);
+
+    static constexpr double kTargetFps = 144.0;                               ///< Límite de FPS en modo interactivo.
+    static constexpr unsigned int kPacketWaitMs = 5;                          ///< Espera máxima del render por un paquete.
+    static constexpr unsigned long long kMeshMemoryBudget = 256ull << 20;     ///< Vértices e índices en CPU.
+    static constexpr unsigned long long kTextureMemoryBudget = 256ull << 20;  ///< Píxeles decodificados y atlas.
+    static constexpr unsigned long long kEcsMemoryBudget = 16ull << 20;       ///< Actores y componentes.
+    static constexpr unsigned long long kUiMemoryBudget = 16ull << 20;        ///< Memoria de ImGui.
+
 public:
     Window                                          m_window;               ///< Objeto de la ventana principal.
     Device                                          m_device;               ///< Dispositivo de renderizado.
@@ -107,13 +208,16 @@ public:
     DepthStencilView                                m_depthStencilView;     ///< Vista del depth stencil.
     Viewport                                        m_viewport;             ///< Viewport de renderizado.
     ShaderProgram                                   m_shaderProgram;        ///< Programa de shaders activo.
+    ShaderProgram                                   m_instancedShader;      ///< Shaders del dibujo instanciado.
    
     Buffer                                          m_neverChanges;         ///< Buffer de constantes que no cambian.
     Buffer                                          m_changeOnResize;       ///< Buffer que cambia al redimensionar.
     Buffer                                          m_changeEveryFrame;     ///< Buffer que cambia cada frame.
  
-    Camera                                          m_camera;               ///< Cmara principal.
+    Camera                                          m_camera;               ///< Cámara principal.
     UserInterface                                   m_UI;                   ///< Interfaz de usuario.
+    RenderQueue                                     m_renderQueue;          ///< Cola de render ordenada por llaves.
+    ConstantBufferRing                              m_constantRing;         ///< Anillo de constantes por objeto del frame.
    
 	ModelLoader                                     m_model;                ///< Cargador de modelos fbx.
     EngineUtilities::TSharedPointer<Actor>          AModel;                       
@@ -126,20 +230,44 @@ public:
     ModelLoader                                     m_modelOBJ;             ///< Cargador de modelos obj.
     EngineUtilities::TSharedPointer<Actor>          AModelOBJ;
     std::vector<Texture>                            m_modelTexturesOBJ;
+    bool                                            m_mergeMeshBuffers = true; ///< Un vertex e index buffer por modelo ("-separatebuffers" lo desactiva).
+    unsigned int                                    m_actorCopies = 0;      ///< Copias de Mordecai que comparten su malla ("-copies" las agrega).
+
+    std::vector<EngineUtilities::TSharedPointer<Actor>> m_actors;           ///< Actores de la escena.
+    AABBTree                                        m_sceneTree;            ///< Árbol de cajas de los actores.
+    std::vector<int>                                m_actorProxies;         ///< Proxy en el árbol de cada actor.
+    std::vector<void*>                              m_visibleActors;        ///< Actores dentro del frustum en el frame.
+    OcclusionCuller                                 m_occlusionCuller;      ///< Rasterizador de oclusión por software.
+    CommandRecorder                                 m_recorder;             ///< Registro de comandos, recursos y tiempos por frame.
+    CommandListPool                                 m_commandLists;         ///< Hilos que graban los dibujos en listas de comandos.
+    SkinningSystem                                  m_skinning;             ///< Evaluación de poses y skinning en paralelo.
+    FrameStats                                      m_frameStats;           ///< Historial del panel de estadísticas.
+    FrameClock                                      m_clock;                ///< Reloj de alta resolución del bucle.
+    FixedTimestep                                   m_timestep;             ///< Acumulador de pasos fijos de simulación.
+    FramePacer                                      m_framePacer;           ///< Limitador de FPS y telemetría de jitter.
+    double                                          m_simulationTime = 0.0; ///< Segundos simulados.
+    unsigned int                                    m_simulationSteps = 0;  ///< Pasos simulados en el último frame.
+    float                                           m_interpolationAlpha = 1.0f; ///< Peso del último paso en el render.
+    XMFLOAT3                                        m_previousCameraPosition; ///< Cámara al final del paso anterior.
+    FramePacketBuffer                               m_packets;              ///< Paquetes entre simulación y render.
+    std::thread                                     m_simulationThread;     ///< Hilo de simulación.
+    std::mutex                                      m_worldMutex;           ///< Protege el estado del mundo entre hilos.
+    std::unordered_map<const void*, unsigned int>   m_actorIndex;           ///< Índice en m_actors de cada actor.
+    unsigned long long                              m_packetCount = 0;      ///< Paquetes construidos.
 
 	Texture                                         m_default;  	        ///< Textura por defecto.
  
     XMMATRIX                                        m_View;                 ///< Matriz de vista.
-    XMMATRIX                                        m_Projection;           ///< Matriz de proyeccin.
+    XMMATRIX                                        m_Projection;           ///< Matriz de proyección.
     XMFLOAT4                                        m_vMeshColor;           ///< Color del mesh.
    
     CBNeverChanges                                  cbNeverChanges;         ///< Constantes que nunca cambian.
     CBChangeOnResize                                cbChangesOnResize;      ///< Constantes que cambian al redimensionar.
 
-    bool keys[256] = { false };                     ///< Estado de las teclas del teclado.
-    float sensitivity = 0.01f;                      ///< Sensibilidad para rotacin de cmara.
-    bool mouseLeftDown = false;                     ///< Estado del botn izquierdo del mouse.
-    bool mouseRightDown = false;                    ///< Estado del botn derecho del mouse.
-    int lastX;                                      ///< ltima posicin X del mouse.
-    int lastY;                                      ///< ltima posicin Y del mouse.
+    std::atomic<bool> keys[256] = {};               ///< Estado de las teclas (escrito por la ventana, leído por la simulación).
+    float sensitivity = 0.01f;                      ///< Sensibilidad para rotación de cámara.
+    bool mouseLeftDown = false;                     ///< Estado del botón izquierdo del mouse.
+    bool mouseRightDown = false;                    ///< Estado del botón derecho del mouse.
+    int lastX;                                      ///< Última posición X del mouse.
+    int lastY;                                      ///< Última posición Y del mouse.
 };
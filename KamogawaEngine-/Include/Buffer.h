@@ -20,7 +20,7 @@ public:
      * @param device Referencia al dispositivo de render.
      * @param mesh Componente de malla con los datos necesarios.
      * @param bindFlag Tipo de uso del buffer (D3D11_BIND_VERTEX_BUFFER, etc.).
-     * @return HRESULT Resultado de la operacin.
+     * @return HRESULT Resultado de la operación.
      */
     HRESULT
     init(Device& device,
@@ -28,23 +28,65 @@ public:
          unsigned int bindFlag);
 
     /**
-     * @brief Inicializa un buffer vaco con el tamao especificado.
+     * @brief Inicializa un vertex o index buffer con varias mallas, una detrás de otra.
+     *
+     * Las mallas de un vertex buffer deben compartir formato de vértice, y las de un index buffer
+     * formato de índice. En el index buffer los índices de cada malla quedan relativos a su primer
+     * vértice, así que cada malla se dibuja con su baseVertex y su startIndex.
      * @param device Referencia al dispositivo de render.
-     * @param ByteWidth Tamao en bytes del buffer.
-     * @return HRESULT Resultado de la operacin.
+     * @param meshes Mallas en el orden en que se guardan.
+     * @param bindFlag D3D11_BIND_VERTEX_BUFFER o D3D11_BIND_INDEX_BUFFER.
+     * @return HRESULT Resultado de la operación.
+     */
+    HRESULT
+    init(Device& device,
+         const std::vector<const MeshComponent*>& meshes,
+         unsigned int bindFlag);
+
+    /**
+     * @brief Inicializa un buffer vacío con el tamaño especificado.
+     * @param device Referencia al dispositivo de render.
+     * @param ByteWidth Tamaño en bytes del buffer.
+     * @return HRESULT Resultado de la operación.
      */
     HRESULT
    init(Device& device,
         unsigned int ByteWidth);
 
+    /**
+     * @brief Inicializa un buffer dinámico que la CPU reescribe cada frame.
+     * @param device Referencia al dispositivo de render.
+     * @param stride Tamaño de cada elemento en bytes.
+     * @param count Número de elementos que caben en el buffer.
+     * @param bindFlag Tipo de uso del buffer (D3D11_BIND_VERTEX_BUFFER, etc.).
+     * @return HRESULT Resultado de la operación.
+     */
+    HRESULT
+    init(Device& device,
+         unsigned int stride,
+         unsigned int count,
+         unsigned int bindFlag);
+
+    /**
+     * @brief Reescribe un buffer dinámico completo (Map con WRITE_DISCARD).
+     * @param deviceContext Contexto del dispositivo.
+     * @param pSrcData Datos a copiar.
+     * @param byteSize Tamaño de los datos; no puede exceder el tamaño del buffer.
+     * @return HRESULT Resultado de la operación.
+     */
+    HRESULT
+    write(DeviceContext& deviceContext,
+          const void* pSrcData,
+          unsigned int byteSize);
+
     /**
      * @brief Actualiza el contenido del buffer con nuevos datos.
-     * @param deviceContext Contexto del dispositivo para aplicar la actualizacin.
+     * @param deviceContext Contexto del dispositivo para aplicar la actualización.
      * @param DstSubresource Subrecurso destino.
-     * @param pDstBox Caja de destino para la regin a actualizar.
+     * @param pDstBox Caja de destino para la región a actualizar.
      * @param pSrcData Puntero a los nuevos datos.
-     * @param SrcRowPitch Tamao de cada fila en los datos fuente.
-     * @param SrcDepthPitch Tamao del volumen en los datos fuente.
+     * @param SrcRowPitch Tamaño de cada fila en los datos fuente.
+     * @param SrcDepthPitch Tamaño del volumen en los datos fuente.
      */
     void
     update(DeviceContext& deviceContext,
@@ -55,12 +97,12 @@ public:
            unsigned int SrcDepthPitch);
 
     /**
-     * @brief Enva el buffer al pipeline para su uso en renderizado.
+     * @brief Envía el buffer al pipeline para su uso en renderizado.
      * @param deviceContext Contexto del dispositivo.
      * @param StartSlot Slot inicial donde enlazar el buffer.
-     * @param NumBuffers Nmero de buffers a enlazar.
-     * @param setPixelShader Si es verdadero, tambin se enlaza al pixel shader.
-     * @param format Formato del ndice si se usa como index buffer.
+     * @param NumBuffers Número de buffers a enlazar.
+     * @param setPixelShader Si es verdadero, también se enlaza al pixel shader.
+     * @param format Formato del índice si se usa como index buffer.
      */
     void
     render(DeviceContext& deviceContext,
@@ -75,13 +117,31 @@ public:
     void
     destroy();
 
+    /**
+     * @brief Obtiene el buffer de Direct3D (útil para comparar enlaces).
+     */
+    ID3D11Buffer*
+    getBuffer() const { return m_buffer; }
+
+    /**
+     * @brief Obtiene el tamaño de cada elemento (vértice o índice) en bytes.
+     */
+    unsigned int
+    getStride() const { return m_stride; }
+
+    /**
+     * @brief Formato de los índices de un index buffer creado desde mallas.
+     */
+    DXGI_FORMAT
+    getIndexFormat() const { return m_indexFormat; }
+
 private:
     /**
-     * @brief Crea un buffer de Direct3D con la descripcin y datos proporcionados.
+     * @brief Crea un buffer de Direct3D con la descripción y datos proporcionados.
      * @param device Referencia al dispositivo de render.
-     * @param desc Descripcin del buffer.
+     * @param desc Descripción del buffer.
      * @param initData Datos iniciales del buffer (puede ser nullptr).
-     * @return HRESULT Resultado de la creacin.
+     * @return HRESULT Resultado de la creación.
      */
     HRESULT
     createBuffer(Device& device,
@@ -90,7 +150,9 @@ private:
 
 private:
     ID3D11Buffer* m_buffer = nullptr;   ///< Puntero al buffer de Direct3D.
-    unsigned int m_stride = 0;          ///< Tamao de cada elemento del buffer.
+    unsigned int m_stride = 0;          ///< Tamaño de cada elemento del buffer.
     unsigned int m_offset = 0;          ///< Offset utilizado al enviar el buffer al pipeline.
     unsigned int m_bindFlag = 0;        ///< Tipo de enlace del buffer (vertex, index, constant, etc.).
+    unsigned int m_byteWidth = 0;       ///< Tamaño total del buffer en bytes.
+    DXGI_FORMAT m_indexFormat = DXGI_FORMAT_R32_UINT; ///< Ancho de los índices (index buffers).
 };
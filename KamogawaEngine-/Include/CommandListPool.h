@@ -0,0 +1,157 @@
+#pragma once
+#include "Prerequisites.h"
+#include "DeviceContext.h"
+#include "CommandRecorder.h"
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+
+class Device;
+
+/**
+ * @brief Contadores del último reparto de grabación.
+ */
+struct
+CommandListStats {
+    unsigned int ranges = 0;        ///< Rangos grabados (incluido el del hilo que llama).
+    unsigned int lists = 0;         ///< Listas de comandos reproducidas.
+    double recordTimeMs = 0.0;      ///< Tiempo hasta que todos los rangos quedaron grabados.
+    double executeTimeMs = 0.0;     ///< Tiempo de reproducción de las listas en el contexto inmediato.
+};
+
+/**
+ * @brief Hilos de trabajo con un contexto diferido cada uno para grabar comandos en paralelo.
+ *
+ * dispatch() reparte rangos de trabajo: el rango 0 se graba directo en el contexto inmediato
+ * en el hilo que llama y los demás en los contextos diferidos de los hilos de trabajo. Al
+ * terminar, las listas se reproducen en el contexto inmediato en orden de rango, así que el
+ * resultado es el mismo que grabar todo en un solo hilo.
+ *
+ * Los contextos diferidos empiezan cada lista con el estado por defecto; el estado común del
+ * frame (render targets, viewport, constantes globales) se vuelve a enlazar con la función de
+ * setStateSetup() al inicio de cada lista y en el contexto inmediato después de reproducirlas.
+ *
+ * Con un CommandRecorder asignado, cada hilo graba sus comandos en un registro propio que se
+ * agrega al registro principal en orden de reproducción.
+ */
+class
+CommandListPool {
+public:
+    /**
+     * @brief Trabajo de un rango: graba los comandos del rango en el contexto recibido.
+     */
+    typedef std::function<void(DeviceContext& deviceContext, unsigned int range)> RecordTask;
+
+    CommandListPool() = default;
+    ~CommandListPool() { destroy(); }
+
+    /**
+     * @brief Crea los contextos diferidos y arranca los hilos de trabajo.
+     * @param device Dispositivo que crea los contextos.
+     * @param workerCount Hilos de trabajo (0 = todo se graba en el hilo que llama).
+     * @return HRESULT Resultado de la operación.
+     */
+    HRESULT
+    init(Device& device, unsigned int workerCount);
+
+    /**
+     * @brief Detiene los hilos y libera los contextos diferidos.
+     */
+    void
+    destroy();
+
+    /**
+     * @brief Función que enlaza el estado común del frame en un contexto.
+     */
+    void
+    setStateSetup(const std::function<void(DeviceContext&)>& setup) { m_stateSetup = setup; }
+
+    /**
+     * @brief Registro principal donde se agregan los comandos de los hilos.
+     */
+    void
+    setRecorder(CommandRecorder* recorder);
+
+    /**
+     * @brief Rangos que se pueden grabar a la vez (hilos de trabajo + 1).
+     */
+    unsigned int
+    getMaxRanges() const { return static_cast<unsigned int>(m_contexts.size()) + 1; }
+
+    /**
+     * @brief Graba rangeCount rangos en paralelo y los reproduce en orden.
+     * @param immediate Contexto inmediato.
+     * @param rangeCount Rangos a grabar (se limita a getMaxRanges()).
+     * @param task Trabajo de cada rango; debe poder correr en varios hilos a la vez.
+     */
+    void
+    dispatch(DeviceContext& immediate, unsigned int rangeCount, const RecordTask& task);
+
+    const CommandListStats&
+    getStats() const { return m_stats; }
+
+private:
+    /**
+     * @brief Bucle de los hilos de trabajo.
+     */
+    void
+    workerLoop(unsigned int worker);
+
+    /**
+     * @brief Graba el rango de un hilo de trabajo en su contexto diferido.
+     */
+    void
+    recordWorker(unsigned int worker);
+
+private:
+    std::vector<DeviceContext> m_contexts;              ///< Contexto diferido de cada hilo.
+    std::vector<ID3D11CommandList*> m_commandLists;     ///< Lista grabada por cada hilo en el reparto actual.
+    std::vector<CommandRecorder> m_recorders;           ///< Registro propio de cada hilo.
+    CommandRecorder* m_recorder = nullptr;              ///< Registro principal (opcional).
+    std::function<void(DeviceContext&)> m_stateSetup;   ///< Estado común del frame.
+    CommandListStats m_stats;                           ///< Contadores.
+
+    const RecordTask* m_task = nullptr;                 ///< Trabajo del reparto actual.
+    unsigned int m_rangeCount = 0;                      ///< Rangos del reparto actual.
+
+    std::vector<std::thread> m_workers;                 ///< Hilos de trabajo.
+    std::mutex m_mutex;                                 ///< Protege el estado compartido con los hilos.
+    std::condition_variable m_startSignal;              ///< Despierta a los hilos al iniciar un reparto.
+    std::condition_variable m_doneSignal;               ///< Avisa que todos los hilos terminaron.
+    unsigned int m_generation = 0;                      ///< Reparto actual.
+    unsigned int m_pendingWorkers = 0;                  ///< Hilos aún grabando.
+    bool m_quit = false;                                ///< Pide a los hilos terminar.
+};
+
+/**
+ * @brief Resultado de una cantidad de hilos en runCommandListBenchmark().
+ */
+struct
+CommandListBenchmarkEntry {
+    unsigned int workers = 0;           ///< Hilos de trabajo (0 = todo en el hilo que llama).
+    double recordTimeMs = 0.0;          ///< Promedio de CommandListStats::recordTimeMs por frame.
+    double executeTimeMs = 0.0;         ///< Promedio de CommandListStats::executeTimeMs por frame.
+    double drawsPerMs = 0.0;            ///< Dibujos por milisegundo de grabación + reproducción.
+};
+
+/**
+ * @brief Mide la grabación de dibujos para cada cantidad de hilos de trabajo de 0 a maxWorkers.
+ *
+ * Cada dibujo enlaza uno de 16 constant buffers, fija la topología y llama a DrawIndexed(), como
+ * un paquete de la cola de render sin estado redundante. Con el driver nulo ("-headless") solo
+ * se mide el costo de CPU.
+ * @param device Dispositivo que crea los contextos diferidos y los buffers.
+ * @param immediate Contexto inmediato donde se reproducen las listas.
+ * @param draws Dibujos por frame, repartidos en partes iguales entre los rangos.
+ * @param maxWorkers Mayor cantidad de hilos de trabajo medida.
+ * @param frames Frames medidos por cantidad de hilos.
+ * @param entries Salida: un resultado por cantidad de hilos.
+ * @return HRESULT Resultado de la operación.
+ */
+HRESULT
+runCommandListBenchmark(Device& device,
+                        DeviceContext& immediate,
+                        unsigned int draws,
+                        unsigned int maxWorkers,
+                        unsigned int frames,
+                        std::vector<CommandListBenchmarkEntry>& entries);
@@ -0,0 +1,185 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Tipos de comando que se registran en el flujo de un frame.
+ */
+enum
+RecordedCommandType {
+    CMD_SET_INPUT_LAYOUT = 0,
+    CMD_SET_VERTEX_SHADER,
+    CMD_SET_PIXEL_SHADER,
+    CMD_SET_VERTEX_BUFFERS,
+    CMD_SET_INDEX_BUFFER,
+    CMD_SET_TOPOLOGY,
+    CMD_SET_SHADER_RESOURCES,
+    CMD_SET_SAMPLERS,
+    CMD_SET_VS_CONSTANT_BUFFERS,
+    CMD_SET_PS_CONSTANT_BUFFERS,
+    CMD_SET_RASTERIZER_STATE,
+    CMD_SET_BLEND_STATE,
+    CMD_SET_RENDER_TARGETS,
+    CMD_SET_VIEWPORTS,
+    CMD_CLEAR_RENDER_TARGET,
+    CMD_CLEAR_DEPTH_STENCIL,
+    CMD_UPDATE_SUBRESOURCE,
+    CMD_MAP,
+    CMD_DRAW_INDEXED,
+    CMD_DRAW_INDEXED_INSTANCED,
+    CMD_PRESENT,
+    CMD_TYPE_COUNT
+};
+
+/**
+ * @brief Tipos de recurso cuya memoria se contabiliza al crearlos.
+ */
+enum
+RecordedResourceType {
+    RESOURCE_BUFFER = 0,
+    RESOURCE_TEXTURE = 1,
+    RESOURCE_TYPE_COUNT
+};
+
+/**
+ * @brief Comando registrado.
+ */
+struct
+RecordedCommand {
+    RecordedCommandType type = CMD_DRAW_INDEXED;
+    unsigned int slot = 0;              ///< Primer slot enlazado (instancias en los dibujos).
+    unsigned int count = 0;             ///< Elementos enlazados (índices por instancia en los dibujos).
+    const void* resource = nullptr;     ///< Primer recurso del comando (identificador opaco).
+    unsigned int bytes = 0;             ///< Bytes subidos con UpdateSubresource.
+};
+
+/**
+ * @brief Resumen de un frame registrado.
+ */
+struct
+RecordedFrame {
+    double cpuTimeMs = 0.0;             ///< Tiempo de CPU entre beginFrame() y endFrame().
+    unsigned int commands = 0;          ///< Comandos registrados.
+    unsigned int draws = 0;             ///< Llamadas de dibujo.
+    unsigned int instances = 0;         ///< Instancias dibujadas (1 por dibujo no instanciado).
+    unsigned long long indices = 0;     ///< Índices dibujados en total.
+    unsigned int stateChanges = 0;      ///< Enlaces de estado que llegaron a la API.
+    unsigned int uploads = 0;           ///< Actualizaciones y mapeos de recursos.
+    unsigned long long uploadBytes = 0; ///< Bytes de UpdateSubresource (lo escrito en mapeos no se conoce).
+    unsigned int resourcesCreated = 0;  ///< Buffers y texturas creados durante el frame.
+};
+
+/**
+ * @brief Registro de los comandos que el motor envía a la API de render.
+ *
+ * Device, DeviceContext y SwapChain reportan aquí cada llamada que realmente llega a la API
+ * (después del filtrado de la caché de estado), junto con los bytes de cada recurso creado.
+ * No depende de tipos de Direct3D: los recursos se guardan como punteros opacos.
+ *
+ * Con el backend nulo (ver RenderBackend) el motor corre sin ventana visible y sin dibujar,
+ * de modo que el flujo registrado y los tiempos por frame sirven para medir el costo de CPU
+ * de BaseApp::update/render, el número de dibujos y la memoria de recursos.
+ */
+class
+CommandRecorder {
+public:
+    CommandRecorder() = default;
+    ~CommandRecorder() = default;
+
+    /**
+     * @brief Inicia un frame: vacía el flujo de comandos y arranca el cronómetro.
+     */
+    void
+    beginFrame();
+
+    /**
+     * @brief Termina el frame y guarda su resumen.
+     */
+    void
+    endFrame();
+
+    /**
+     * @brief Registra un comando del frame actual.
+     */
+    void
+    record(RecordedCommandType type,
+           unsigned int slot,
+           unsigned int count,
+           const void* resource,
+           unsigned int bytes = 0);
+
+    /**
+     * @brief Agrega al frame actual los comandos grabados en otro registro (p. ej. de un hilo
+     *        que grabó una lista de comandos), en el orden en que se reproducen.
+     */
+    void
+    append(const std::vector<RecordedCommand>& commands);
+
+    /**
+     * @brief Contabiliza la memoria de un recurso creado.
+     * @param type Tipo de recurso.
+     * @param bytes Tamaño aproximado en bytes.
+     */
+    void
+    recordResource(RecordedResourceType type, unsigned long long bytes);
+
+    /**
+     * @brief Borra los frames y los contadores de recursos.
+     */
+    void
+    reset();
+
+    /**
+     * @brief Flujo de comandos del frame actual (o del último terminado).
+     */
+    const std::vector<RecordedCommand>&
+    getCommands() const { return m_commands; }
+
+    const std::vector<RecordedFrame>&
+    getFrames() const { return m_frames; }
+
+    /**
+     * @brief Resumen del último frame terminado.
+     */
+    const RecordedFrame&
+    getLastFrame() const { return m_lastFrame; }
+
+    /**
+     * @brief Guarda o no el resumen de cada frame en getFrames() (con la aplicación interactiva
+     *        solo interesa el último, y la lista crecería sin límite).
+     */
+    void
+    setKeepFrames(bool keepFrames) { m_keepFrames = keepFrames; }
+
+    unsigned long long
+    getResourceBytes(RecordedResourceType type) const { return m_resourceBytes[type]; }
+
+    unsigned int
+    getResourceCount(RecordedResourceType type) const { return m_resourceCount[type]; }
+
+    /**
+     * @brief Nombre legible de un tipo de comando.
+     */
+    static const char*
+    getCommandName(RecordedCommandType type);
+
+    /**
+     * @brief Escribe un reporte JSON con estadísticas de tiempo, dibujos, memoria y el
+     *        flujo de comandos del último frame.
+     * @param path Ruta del archivo.
+     * @return true si el archivo se escribió.
+     */
+    bool
+    writeReport(const std::string& path) const;
+
+private:
+    std::vector<RecordedCommand> m_commands;                    ///< Comandos del frame.
+    std::vector<RecordedFrame> m_frames;                        ///< Resumen de cada frame terminado.
+    RecordedFrame m_current;                                    ///< Contadores del frame en curso.
+    RecordedFrame m_lastFrame;                                  ///< Contadores del último frame terminado.
+    bool m_keepFrames = true;                                   ///< Guardar cada frame en m_frames.
+    std::chrono::steady_clock::time_point m_frameStart;         ///< Inicio del frame en curso.
+    unsigned long long m_resourceBytes[RESOURCE_TYPE_COUNT] = { 0, 0 };  ///< Memoria por tipo.
+    unsigned int m_resourceCount[RESOURCE_TYPE_COUNT] = { 0, 0 };        ///< Recursos por tipo.
+};
@@ -0,0 +1,151 @@
+#pragma once
+#include "Prerequisites.h"
+
+class Device;
+class DeviceContext;
+
+/**
+ * @brief Sub-asignación de constantes dentro del anillo.
+ */
+struct
+ConstantAllocation {
+    unsigned char* data = nullptr;     ///< Puntero de CPU para escribir (válido hasta unmap()).
+    unsigned int offset = 0;           ///< Desplazamiento en bytes dentro del buffer.
+    unsigned int firstConstant = 0;    ///< Desplazamiento en constantes de 16 bytes.
+    unsigned int numConstants = 0;     ///< Tamaño en constantes de 16 bytes (múltiplo de 16).
+};
+
+/**
+ * @brief Estadísticas del anillo de constantes.
+ */
+struct
+ConstantRingStats {
+    unsigned int capacity = 0;         ///< Tamaño del buffer en bytes.
+    unsigned int allocations = 0;      ///< Sub-asignaciones del frame actual.
+    unsigned int bytesAllocated = 0;   ///< Bytes asignados en el frame (con alineación).
+    unsigned int bytesWasted = 0;      ///< Bytes perdidos al dar la vuelta al final del buffer.
+    unsigned int framesInFlight = 0;   ///< Frames que la GPU aún no termina de leer.
+    unsigned int wraps = 0;            ///< Veces que el anillo volvió al inicio (acumulado).
+    unsigned int stalls = 0;           ///< Esperas a un fence por falta de espacio (acumulado).
+    unsigned int peakBytes = 0;        ///< Mayor ocupación observada del anillo.
+};
+
+/**
+ * @brief Asignador lineal en anillo sobre un constant buffer dinámico grande.
+ *
+ * Todas las constantes por dibujo de un frame se escriben de forma contigua con Map
+ * (WRITE_NO_OVERWRITE, y WRITE_DISCARD solo cuando el anillo está vacío) en bloques
+ * alineados a 256 bytes, y se enlazan con VSSetConstantBuffers1 usando el desplazamiento
+ * de cada bloque. Al terminar el frame se inserta un evento de GPU como fence; la memoria
+ * de un frame se recicla cuando su fence se completa.
+ *
+ * Requiere Direct3D 11.1 con soporte de desplazamientos en constant buffers; si no está
+ * disponible isSupported() devuelve false y los llamadores deben usar sus propios buffers.
+ */
+class
+ConstantBufferRing {
+public:
+    static const unsigned int kAlignment = 256;  ///< Alineación exigida por Direct3D 11.1.
+    static const unsigned int kMaxFrames = 4;    ///< Frames en vuelo como máximo.
+
+    ConstantBufferRing() = default;
+    ~ConstantBufferRing() = default;
+
+    /**
+     * @brief Crea el buffer dinámico y los fences.
+     * @param device Referencia al dispositivo de render.
+     * @param deviceContext Contexto inicializado (necesita la interfaz 11.1).
+     * @param byteWidth Tamaño del anillo en bytes (se redondea a 256).
+     * @return HRESULT Resultado; S_FALSE si el hardware no soporta el anillo.
+     */
+    HRESULT
+    init(Device& device, DeviceContext& deviceContext, unsigned int byteWidth);
+
+    /**
+     * @brief Recicla los frames cuya lectura ya terminó en la GPU y reinicia las estadísticas del frame.
+     */
+    void
+    update(DeviceContext& deviceContext);
+
+    /**
+     * @brief Mapea el buffer para empezar a escribir constantes.
+     * @return HRESULT Resultado del Map.
+     */
+    HRESULT
+    map(DeviceContext& deviceContext);
+
+    /**
+     * @brief Reserva un bloque contiguo; debe llamarse entre map() y unmap().
+     * @param deviceContext Contexto del dispositivo (para esperar fences si no hay espacio).
+     * @param size Tamaño de los datos en bytes.
+     * @param allocation Salida: bloque reservado.
+     * @return true si se pudo reservar.
+     */
+    bool
+    allocate(DeviceContext& deviceContext, unsigned int size, ConstantAllocation& allocation);
+
+    /**
+     * @brief Termina la escritura de constantes del lote actual.
+     */
+    void
+    unmap(DeviceContext& deviceContext);
+
+    /**
+     * @brief Enlaza un bloque en un slot de constantes del vertex (y opcionalmente pixel) shader.
+     */
+    void
+    render(DeviceContext& deviceContext,
+           const ConstantAllocation& allocation,
+           unsigned int StartSlot,
+           bool setPixelShader = false);
+
+    /**
+     * @brief Inserta el fence del frame; lo asignado desde el último endFrame queda en vuelo.
+     */
+    void
+    endFrame(DeviceContext& deviceContext);
+
+    /**
+     * @brief Libera el buffer y los fences.
+     */
+    void
+    destroy();
+
+    /**
+     * @brief Indica si el anillo está disponible en este dispositivo.
+     */
+    bool
+    isSupported() const { return m_buffer != nullptr; }
+
+    const ConstantRingStats&
+    getStats() const { return m_stats; }
+
+private:
+    /**
+     * @brief Libera el frame más antiguo en vuelo.
+     * @param wait Si es true espera a que la GPU complete su fence.
+     * @return true si se liberó un frame.
+     */
+    bool
+    retireOldest(DeviceContext& deviceContext, bool wait);
+
+private:
+    struct FrameFence {
+        ID3D11Query* query = nullptr;  ///< Evento insertado al terminar el frame.
+        unsigned int bytes = 0;        ///< Bytes del anillo usados por el frame.
+    };
+
+    ID3D11Buffer* m_buffer = nullptr;      ///< Constant buffer dinámico.
+    unsigned char* m_mapped = nullptr;     ///< Memoria mapeada entre map() y unmap().
+    unsigned int m_size = 0;               ///< Tamaño del anillo.
+    unsigned int m_head = 0;               ///< Siguiente byte libre.
+    unsigned int m_tail = 0;               ///< Inicio de los datos más antiguos en vuelo.
+    unsigned int m_used = 0;               ///< Bytes ocupados (en vuelo + frame actual).
+    unsigned int m_frameBytes = 0;         ///< Bytes ocupados por el frame actual.
+
+    FrameFence m_frames[kMaxFrames];       ///< Frames en vuelo (cola circular).
+    unsigned int m_firstFrame = 0;         ///< Frame más antiguo en vuelo.
+    unsigned int m_frameCount = 0;         ///< Número de frames en vuelo.
+
+    ConstantRingStats m_stats;             ///< Estadísticas.
+};
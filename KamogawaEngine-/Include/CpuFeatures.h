@@ -0,0 +1,19 @@
+#pragma once
+
+/**
+ * @brief Extensiones SIMD del procesador que usan los núcleos vectorizados del motor.
+ *
+ * Se detectan una sola vez con CPUID; AVX y AVX2 además exigen que el sistema operativo guarde
+ * los registros YMM (OSXSAVE y XGETBV).
+ */
+struct
+CpuFeatures {
+    bool avx = false;   ///< AVX (culling de frustum de 8 en 8).
+    bool avx2 = false;  ///< AVX2 (rasterizador de oclusión, animación y skinning).
+};
+
+/**
+ * @brief Extensiones del procesador actual (se detectan en la primera llamada).
+ */
+const CpuFeatures&
+getCpuFeatures();
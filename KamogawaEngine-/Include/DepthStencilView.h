@@ -13,7 +13,7 @@ Texture;
  * @brief Clase que representa una vista de profundidad y stencil en DirectX 11.
  *
  * Esta clase encapsula un ID3D11DepthStencilView, que se usa para gestionar
- * los buffers de profundidad y stencil en una aplicacin de grficos.
+ * los buffers de profundidad y stencil en una aplicación de gráficos.
  */
     class 
     DepthStencilView {
@@ -31,10 +31,10 @@ Texture;
     /**
      * @brief Inicializa la vista de profundidad y stencil.
      *
-     * @param device Referencia al dispositivo Direct3D que crear la vista.
-     * @param depthStencil Referencia a la textura que actuar como buffer de profundidad y stencil.
+     * @param device Referencia al dispositivo Direct3D que creará la vista.
+     * @param depthStencil Referencia a la textura que actuará como buffer de profundidad y stencil.
      * @param format Formato del buffer de profundidad y stencil (DXGI_FORMAT).
-     * @return HRESULT Cdigo de resultado que indica el xito o error de la operacin.
+     * @return HRESULT Código de resultado que indica el éxito o error de la operación.
      */
     HRESULT 
     init(Device& device, 
@@ -44,8 +44,8 @@ Texture;
     /**
      * @brief Actualiza la vista de profundidad y stencil si es necesario.
      *
-     * Esta funcin se puede utilizar para realizar cambios dinmicos en la vista si el
-     * contexto de la aplicacin lo requiere.
+     * Esta función se puede utilizar para realizar cambios dinámicos en la vista si el
+     * contexto de la aplicación lo requiere.
      */
     void 
     update();
@@ -53,7 +53,7 @@ Texture;
     /**
      * @brief Vincula la vista de profundidad y stencil al contexto del dispositivo.
      *
-     * @param deviceContext Referencia al contexto del dispositivo en el que se aplicar la vista.
+     * @param deviceContext Referencia al contexto del dispositivo en el que se aplicará la vista.
      */
     void 
     render(DeviceContext& deviceContext);
@@ -61,7 +61,7 @@ Texture;
     /**
      * @brief Libera los recursos asociados con la vista de profundidad y stencil.
      *
-     * Esta funcin debe llamarse antes de la destruccin de la clase para evitar prdidas de memoria.
+     * Esta función debe llamarse antes de la destrucción de la clase para evitar pérdidas de memoria.
      */
     void 
     destroy();
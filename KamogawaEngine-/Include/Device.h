@@ -1,13 +1,14 @@
 #pragma once
 #include "Prerequisites.h"
+#include "CommandRecorder.h"
 
 /**
  * @class Device
- * @brief Clase encargada de la gestin del dispositivo Direct3D 11.
+ * @brief Clase encargada de la gestión del dispositivo Direct3D 11.
  *
- * Esta clase proporciona funciones para la creacin de recursos grficos,
- * como shaders, buffers y texturas, adems de gestionar la inicializacin,
- * actualizacin y renderizado del dispositivo.
+ * Esta clase proporciona funciones para la creación de recursos gráficos,
+ * como shaders, buffers y texturas, además de gestionar la inicialización,
+ * actualización y renderizado del dispositivo.
  */
 class 
 Device
@@ -42,7 +43,7 @@ public:
     render();
 
     /**
-     * @brief Libera los recursos del dispositivo antes de su destruccin.
+     * @brief Libera los recursos del dispositivo antes de su destrucción.
      */
     void 
     destroy();
@@ -51,9 +52,9 @@ public:
      * @brief Crea una vista de renderizado para un recurso.
      *
      * @param pResource Puntero al recurso de Direct3D.
-     * @param pDesc Descripcin de la vista de renderizado.
+     * @param pDesc Descripción de la vista de renderizado.
      * @param ppRTView Puntero de salida para la vista de renderizado creada.
-     * @return HRESULT Cdigo de estado indicando xito o fallo.
+     * @return HRESULT Código de estado indicando éxito o fallo.
      */
     HRESULT 
     CreateRenderTargetView(ID3D11Resource* pResource,
@@ -63,10 +64,10 @@ public:
     /**
      * @brief Crea una textura 2D en el dispositivo.
      *
-     * @param pDesc Descripcin de la textura.
+     * @param pDesc Descripción de la textura.
      * @param pInitialData Datos iniciales para la textura (opcional).
      * @param ppTexture2D Puntero de salida para la textura creada.
-     * @return HRESULT Cdigo de estado indicando xito o fallo.
+     * @return HRESULT Código de estado indicando éxito o fallo.
      */
     HRESULT 
     CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc,
@@ -77,9 +78,9 @@ public:
      * @brief Crea una vista de profundidad y stencil para un recurso.
      *
      * @param pResource Puntero al recurso de Direct3D.
-     * @param pDesc Descripcin de la vista de profundidad y stencil.
+     * @param pDesc Descripción de la vista de profundidad y stencil.
      * @param ppDepthStencilView Puntero de salida para la vista creada.
-     * @return HRESULT Cdigo de estado indicando xito o fallo.
+     * @return HRESULT Código de estado indicando éxito o fallo.
      */
     HRESULT 
     CreateDepthStencilView(ID3D11Resource* pResource,
@@ -87,13 +88,13 @@ public:
                                    ID3D11DepthStencilView** ppDepthStencilView);
 
     /**
-     * @brief Crea un shader de vrtices.
+     * @brief Crea un shader de vértices.
      *
-     * @param pShaderBytecode Cdigo de bytes del shader.
-     * @param BytecodeLength Longitud del cdigo de bytes.
+     * @param pShaderBytecode Código de bytes del shader.
+     * @param BytecodeLength Longitud del código de bytes.
      * @param pClassLinkage Puntero opcional a una interfaz de enlace de clases.
-     * @param ppVertexShader Puntero de salida para el shader de vrtices creado.
-     * @return HRESULT Cdigo de estado indicando xito o fallo.
+     * @param ppVertexShader Puntero de salida para el shader de vértices creado.
+     * @return HRESULT Código de estado indicando éxito o fallo.
      */
     HRESULT 
     CreateVertexShader(const void* pShaderBytecode,
@@ -102,14 +103,14 @@ public:
                                ID3D11VertexShader** ppVertexShader);
 
     /**
-     * @brief Crea un diseo de entrada para el pipeline grfico.
+     * @brief Crea un diseño de entrada para el pipeline gráfico.
      *
-     * @param pInputElementDescs Descripcin de los elementos de entrada.
-     * @param NumElements Nmero de elementos en la descripcin.
-     * @param pShaderBytecodeWithInputSignature Cdigo de bytes del shader con la firma de entrada.
-     * @param BytecodeLength Longitud del cdigo de bytes.
-     * @param ppInputLayout Puntero de salida para el diseo de entrada creado.
-     * @return HRESULT Cdigo de estado indicando xito o fallo.
+     * @param pInputElementDescs Descripción de los elementos de entrada.
+     * @param NumElements Número de elementos en la descripción.
+     * @param pShaderBytecodeWithInputSignature Código de bytes del shader con la firma de entrada.
+     * @param BytecodeLength Longitud del código de bytes.
+     * @param ppInputLayout Puntero de salida para el diseño de entrada creado.
+     * @return HRESULT Código de estado indicando éxito o fallo.
      */
     HRESULT 
     CreateInputLayout(D3D11_INPUT_ELEMENT_DESC* pInputElementDescs,
@@ -119,13 +120,13 @@ public:
                               ID3D11InputLayout** ppInputLayout);
 
     /**
-     * @brief Crea un shader de pxeles.
+     * @brief Crea un shader de píxeles.
      *
-     * @param pShaderBytecode Cdigo de bytes del shader.
-     * @param BytecodeLength Longitud del cdigo de bytes.
+     * @param pShaderBytecode Código de bytes del shader.
+     * @param BytecodeLength Longitud del código de bytes.
      * @param pClassLinkage Puntero opcional a una interfaz de enlace de clases.
-     * @param ppPixelShader Puntero de salida para el shader de pxeles creado.
-     * @return HRESULT Cdigo de estado indicando xito o fallo.
+     * @param ppPixelShader Puntero de salida para el shader de píxeles creado.
+     * @return HRESULT Código de estado indicando éxito o fallo.
      */
     HRESULT 
     CreatePixelShader(const void* pShaderBytecode,
@@ -136,10 +137,10 @@ public:
     /**
      * @brief Crea un buffer de datos en la GPU.
      *
-     * @param pDesc Descripcin del buffer.
+     * @param pDesc Descripción del buffer.
      * @param pInitialData Datos iniciales del buffer (opcional).
      * @param ppBuffer Puntero de salida para el buffer creado.
-     * @return HRESULT Cdigo de estado indicando xito o fallo.
+     * @return HRESULT Código de estado indicando éxito o fallo.
      */
     HRESULT 
     CreateBuffer(const D3D11_BUFFER_DESC* pDesc,
@@ -147,22 +148,22 @@ public:
                          ID3D11Buffer** ppBuffer);
 
     /**
-     * @brief Crea un estado de muestreo para la configuracin de texturas.
+     * @brief Crea un estado de muestreo para la configuración de texturas.
      *
-     * @param pSamplerDesc Descripcin del estado de muestreo.
+     * @param pSamplerDesc Descripción del estado de muestreo.
      * @param ppSamplerState Puntero de salida para el estado de muestreo creado.
-     * @return HRESULT Cdigo de estado indicando xito o fallo.
+     * @return HRESULT Código de estado indicando éxito o fallo.
      */
     HRESULT 
     CreateSamplerState(const D3D11_SAMPLER_DESC* pSamplerDesc,
                                ID3D11SamplerState** ppSamplerState);
 
     /**
-     * @brief Crea un estado de rasterizacin para configurar la forma en que se dibujan los tringulos.
+     * @brief Crea un estado de rasterización para configurar la forma en que se dibujan los triángulos.
      *
-     * @param pRasterizerDesc Descripcin del estado de rasterizacin.
-     * @param ppRasterizerState Puntero de salida para el estado de rasterizacin creado.
-     * @return HRESULT Cdigo de estado indicando xito o fallo.
+     * @param pRasterizerDesc Descripción del estado de rasterización.
+     * @param ppRasterizerState Puntero de salida para el estado de rasterización creado.
+     * @return HRESULT Código de estado indicando éxito o fallo.
      */
     HRESULT 
     CreateRasterizerState(const D3D11_RASTERIZER_DESC* pRasterizerDesc,
@@ -171,15 +172,61 @@ public:
     /**
      * @brief Crea un estado de mezcla para configurar la mezcla de colores en el renderizado.
      *
-     * @param pBlendStateDesc Descripcin del estado de mezcla.
+     * @param pBlendStateDesc Descripción del estado de mezcla.
      * @param ppBlendState Puntero de salida para el estado de mezcla creado.
-     * @return HRESULT Cdigo de estado indicando xito o fallo.
+     * @return HRESULT Código de estado indicando éxito o fallo.
      */
     HRESULT 
     CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc,
                              ID3D11BlendState** ppBlendState);
 
+    /**
+     * @brief Crea una consulta de GPU (p. ej. un evento usado como fence).
+     *
+     * @param pQueryDesc Descripción de la consulta.
+     * @param ppQuery Puntero de salida para la consulta creada.
+     * @return HRESULT Código de estado indicando éxito o fallo.
+     */
+    HRESULT 
+    CreateQuery(const D3D11_QUERY_DESC* pQueryDesc,
+                ID3D11Query** ppQuery);
+
+    /**
+     * @brief Crea un contexto diferido para grabar listas de comandos en otro hilo.
+     *
+     * @param ContextFlags Reservado; debe ser 0.
+     * @param ppDeferredContext Puntero de salida para el contexto creado.
+     * @return HRESULT Código de estado indicando éxito o fallo.
+     */
+    HRESULT 
+    CreateDeferredContext(unsigned int ContextFlags,
+                          ID3D11DeviceContext** ppDeferredContext);
+
+    /**
+     * @brief Consulta el soporte de una característica opcional del dispositivo.
+     *
+     * @param Feature Característica a consultar.
+     * @param pFeatureSupportData Estructura de salida con el resultado.
+     * @param FeatureSupportDataSize Tamaño de la estructura de salida.
+     * @return HRESULT Código de estado indicando éxito o fallo.
+     */
+    HRESULT 
+    CheckFeatureSupport(D3D11_FEATURE Feature,
+                        void* pFeatureSupportData,
+                        unsigned int FeatureSupportDataSize);
+
+    /**
+     * @brief Asigna el registro donde se contabiliza la memoria de los recursos creados.
+     * @param recorder Registro de comandos (nullptr para no registrar).
+     */
+    void
+    setRecorder(CommandRecorder* recorder) { m_recorder = recorder; }
+
 public:
     /// Puntero a la interfaz ID3D11Device que representa el dispositivo Direct3D.
     ID3D11Device* m_device = nullptr;
+
+private:
+    /// Registro de comandos (opcional).
+    CommandRecorder* m_recorder = nullptr;
 };
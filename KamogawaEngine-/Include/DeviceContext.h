@@ -1,12 +1,17 @@
 #pragma once
 #include "PreRequisites.h"
+#include "StateCache.h"
+#include "CommandRecorder.h"
+
+class Device;
 
 /**
  * @class DeviceContext
  * @brief Clase que gestiona el contexto del dispositivo Direct3D 11.
  *
- * Proporciona mtodos para configurar y ejecutar operaciones de renderizado
- * en el pipeline grfico de Direct3D.
+ * Proporciona métodos para configurar y ejecutar operaciones de renderizado
+ * en el pipeline gráfico de Direct3D. Los enlaces de estado pasan por una caché
+ * sombra que descarta las llamadas que repiten el estado ya enlazado.
  */
     class 
     DeviceContext {
@@ -23,10 +28,26 @@
 
     /**
      * @brief Inicializa el contexto del dispositivo.
+     *
+     * Obtiene la interfaz de Direct3D 11.1 si el sistema la ofrece; sin ella no se pueden
+     * enlazar constant buffers con desplazamiento.
      */
     void 
     init();
 
+    /**
+     * @brief Crea este contexto como contexto diferido del dispositivo.
+     *
+     * Un contexto diferido graba comandos en otro hilo; FinishCommandList los cierra en una
+     * lista que el contexto inmediato reproduce con ExecuteCommandList. Empieza cada lista
+     * con el estado por defecto del pipeline.
+     *
+     * @param device Dispositivo que crea el contexto.
+     * @return HRESULT Resultado de la operación.
+     */
+    HRESULT
+    initDeferred(Device& device);
+
     /**
      * @brief Actualiza los estados del contexto del dispositivo.
      */
@@ -45,10 +66,37 @@
     void 
     destroy();
 
+    /**
+     * @brief Inicia un frame: invalida la caché de estado y reinicia sus contadores.
+     *
+     * El estado se invalida porque otros módulos (p. ej. ImGui) usan el contexto directamente.
+     */
+    void
+    beginFrame();
+
+    /**
+     * @brief Olvida el estado guardado; usar tras modificar el contexto sin esta clase.
+     */
+    void
+    invalidateState() { m_stateCache.invalidate(); }
+
+    /**
+     * @brief Obtiene las llamadas de estado enviadas y filtradas en el frame actual.
+     */
+    const StateCacheStats&
+    getStateStats() const { return m_stateCache.getStats(); }
+
+    /**
+     * @brief Asigna el registro donde se anotan las llamadas que llegan a la API.
+     * @param recorder Registro de comandos (nullptr para no registrar).
+     */
+    void
+    setRecorder(CommandRecorder* recorder) { m_recorder = recorder; }
+
     /**
      * @brief Establece las vistas de la pantalla.
      *
-     * @param NumViewports Nmero de viewports a establecer.
+     * @param NumViewports Número de viewports a establecer.
      * @param pViewports Puntero a los viewports.
      */
     void 
@@ -56,10 +104,10 @@
                    const D3D11_VIEWPORT* pViewports);
 
     /**
-     * @brief Asigna recursos de textura a la etapa de pxeles del pipeline.
+     * @brief Asigna recursos de textura a la etapa de píxeles del pipeline.
      *
-     * @param StartSlot Primer slot en el que se asignar el recurso.
-     * @param NumViews Nmero de vistas a asignar.
+     * @param StartSlot Primer slot en el que se asignará el recurso.
+     * @param NumViews Número de vistas a asignar.
      * @param ppShaderResourceViews Puntero a la lista de vistas de recursos de shader.
      */
     void 
@@ -68,19 +116,19 @@
                               ID3D11ShaderResourceView* const* ppShaderResourceViews);
 
     /**
-     * @brief Establece el diseo de entrada para la etapa de entrada del ensamblador.
+     * @brief Establece el diseño de entrada para la etapa de entrada del ensamblador.
      *
-     * @param pInputLayout Puntero al diseo de entrada.
+     * @param pInputLayout Puntero al diseño de entrada.
      */
     void 
     IASetInputLayout(ID3D11InputLayout* pInputLayout);
 
     /**
-     * @brief Establece el shader de vrtices en el pipeline.
+     * @brief Establece el shader de vértices en el pipeline.
      *
-     * @param pVertexShader Puntero al shader de vrtices.
+     * @param pVertexShader Puntero al shader de vértices.
      * @param ppClassInstances Lista de instancias de clase.
-     * @param NumClassInstances Nmero de instancias de clase.
+     * @param NumClassInstances Número de instancias de clase.
      */
     void 
     VSSetShader(ID3D11VertexShader* pVertexShader,
@@ -88,11 +136,11 @@
                 unsigned int NumClassInstances);
 
     /**
-     * @brief Establece el shader de pxeles en el pipeline.
+     * @brief Establece el shader de píxeles en el pipeline.
      *
-     * @param pPixelShader Puntero al shader de pxeles.
+     * @param pPixelShader Puntero al shader de píxeles.
      * @param ppClassInstances Lista de instancias de clase.
-     * @param NumClassInstances Nmero de instancias de clase.
+     * @param NumClassInstances Número de instancias de clase.
      */
     void 
     PSSetShader(ID3D11PixelShader* pPixelShader,
@@ -104,7 +152,7 @@
      *
      * @param pDstResource Recurso de destino.
      * @param DstSubresource Subrecurso de destino.
-     * @param pDstBox Regin de destino a actualizar (opcional).
+     * @param pDstBox Región de destino a actualizar (opcional).
      * @param pSrcData Datos de origen.
      * @param SrcRowPitch Desplazamiento por fila.
      * @param SrcDepthPitch Desplazamiento por profundidad.
@@ -118,12 +166,12 @@
                       unsigned int SrcDepthPitch);
 
     /**
-     * @brief Asigna buffers de vrtices al pipeline grfico.
+     * @brief Asigna buffers de vértices al pipeline gráfico.
      *
      * @param StartSlot Primer slot del buffer.
-     * @param NumBuffers Nmero de buffers.
-     * @param ppVertexBuffers Puntero a los buffers de vrtices.
-     * @param pStrides Tamao de cada vrtice en los buffers.
+     * @param NumBuffers Número de buffers.
+     * @param ppVertexBuffers Puntero a los buffers de vértices.
+     * @param pStrides Tamaño de cada vértice en los buffers.
      * @param pOffsets Desplazamiento inicial en los buffers.
      */
     void 
@@ -134,10 +182,10 @@
                        const unsigned int* pOffsets);
 
     /**
-     * @brief Asigna un buffer de ndices al pipeline grfico.
+     * @brief Asigna un buffer de índices al pipeline gráfico.
      *
-     * @param pIndexBuffer Puntero al buffer de ndices.
-     * @param Format Formato de los ndices.
+     * @param pIndexBuffer Puntero al buffer de índices.
+     * @param Format Formato de los índices.
      * @param Offset Desplazamiento dentro del buffer.
      */
     void 
@@ -146,10 +194,10 @@
                      unsigned int Offset);
 
     /**
-     * @brief Establece los estados de muestreo en la etapa de pxeles.
+     * @brief Establece los estados de muestreo en la etapa de píxeles.
      *
      * @param StartSlot Primer slot del sampler.
-     * @param NumSamplers Nmero de estados de muestreo.
+     * @param NumSamplers Número de estados de muestreo.
      * @param ppSamplers Puntero a los estados de muestreo.
      */
     void 
@@ -158,9 +206,9 @@
                   ID3D11SamplerState* const* ppSamplers);
 
     /**
-     * @brief Configura el estado de rasterizacin.
+     * @brief Configura el estado de rasterización.
      *
-     * @param pRasterizerState Puntero al estado de rasterizacin.
+     * @param pRasterizerState Puntero al estado de rasterización.
      */
     void 
     RSSetState(ID3D11RasterizerState* pRasterizerState);
@@ -170,7 +218,7 @@
      *
      * @param pBlendState Puntero al estado de mezcla.
      * @param BlendFactor Factores de mezcla de color.
-     * @param SampleMask Mscara de muestreo.
+     * @param SampleMask Máscara de muestreo.
      */
     void 
     OMSetBlendState(ID3D11BlendState* pBlendState,
@@ -180,7 +228,7 @@
     /**
      * @brief Establece los objetivos de renderizado y el buffer de profundidad.
      *
-     * @param NumViews Nmero de vistas de renderizado.
+     * @param NumViews Número de vistas de renderizado.
      * @param ppRenderTargetViews Puntero a la lista de vistas de renderizado.
      * @param pDepthStencilView Puntero a la vista de profundidad y stencil.
      */
@@ -190,15 +238,15 @@
                        ID3D11DepthStencilView* pDepthStencilView);
 
     /**
-     * @brief Establece la topologa primitiva utilizada en el pipeline.
+     * @brief Establece la topología primitiva utilizada en el pipeline.
      *
-     * @param Topology Tipo de topologa de primitivas.
+     * @param Topology Tipo de topología de primitivas.
      */
     void 
     IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology);
 
     /**
-     * @brief Limpia una vista de renderizado con un color especfico.
+     * @brief Limpia una vista de renderizado con un color específico.
      *
      * @param pRenderTargetView Puntero a la vista de renderizado.
      * @param ColorRGBA Color en formato RGBA.
@@ -211,7 +259,7 @@
      * @brief Limpia el buffer de profundidad y stencil.
      *
      * @param pDepthStencilView Puntero a la vista de profundidad y stencil.
-     * @param ClearFlags Flags que indican qu limpiar (profundidad/stencil).
+     * @param ClearFlags Flags que indican qué limpiar (profundidad/stencil).
      * @param Depth Valor de profundidad a establecer.
      * @param Stencil Valor de stencil a establecer.
      */
@@ -222,10 +270,10 @@
                           UINT8 Stencil);
 
     /**
-     * @brief Asigna buffers constantes a la etapa de vrtices.
+     * @brief Asigna buffers constantes a la etapa de vértices.
      *
      * @param StartSlot Primer slot del buffer.
-     * @param NumBuffers Nmero de buffers.
+     * @param NumBuffers Número de buffers.
      * @param ppConstantBuffers Puntero a los buffers constantes.
      */
     void 
@@ -234,10 +282,10 @@
                          ID3D11Buffer* const* ppConstantBuffers);
 
     /**
-     * @brief Asigna buffers constantes a la etapa de pxeles.
+     * @brief Asigna buffers constantes a la etapa de píxeles.
      *
      * @param StartSlot Primer slot del buffer.
-     * @param NumBuffers Nmero de buffers.
+     * @param NumBuffers Número de buffers.
      * @param ppConstantBuffers Puntero a los buffers constantes.
      */
     void 
@@ -248,16 +296,142 @@
     /**
      * @brief Dibuja los elementos indexados.
      *
-     * @param IndexCount Nmero de ndices.
-     * @param StartIndexLocation Ubicacin inicial del ndice.
-     * @param BaseVertexLocation Ubicacin base del vrtice.
+     * @param IndexCount Número de índices.
+     * @param StartIndexLocation Ubicación inicial del índice.
+     * @param BaseVertexLocation Ubicación base del vértice.
      */
     void 
     DrawIndexed(unsigned int IndexCount,
                 unsigned int StartIndexLocation,
                 int BaseVertexLocation);
 
+    /**
+     * @brief Asigna rangos de buffers constantes a la etapa de vértices (Direct3D 11.1).
+     *
+     * @param StartSlot Primer slot del buffer.
+     * @param NumBuffers Número de buffers.
+     * @param ppConstantBuffers Puntero a los buffers constantes.
+     * @param pFirstConstant Primera constante (16 bytes) de cada rango; múltiplo de 16.
+     * @param pNumConstants Número de constantes de cada rango; múltiplo de 16.
+     */
+    void 
+    VSSetConstantBuffers1(unsigned int StartSlot,
+                          unsigned int NumBuffers,
+                          ID3D11Buffer* const* ppConstantBuffers,
+                          const unsigned int* pFirstConstant,
+                          const unsigned int* pNumConstants);
+
+    /**
+     * @brief Asigna rangos de buffers constantes a la etapa de píxeles (Direct3D 11.1).
+     *
+     * @param StartSlot Primer slot del buffer.
+     * @param NumBuffers Número de buffers.
+     * @param ppConstantBuffers Puntero a los buffers constantes.
+     * @param pFirstConstant Primera constante (16 bytes) de cada rango; múltiplo de 16.
+     * @param pNumConstants Número de constantes de cada rango; múltiplo de 16.
+     */
+    void 
+    PSSetConstantBuffers1(unsigned int StartSlot,
+                          unsigned int NumBuffers,
+                          ID3D11Buffer* const* ppConstantBuffers,
+                          const unsigned int* pFirstConstant,
+                          const unsigned int* pNumConstants);
+
+    /**
+     * @brief Marca el final de una consulta (para eventos, inserta el fence en la cola).
+     *
+     * @param pAsync Consulta a finalizar.
+     */
+    void 
+    End(ID3D11Asynchronous* pAsync);
+
+    /**
+     * @brief Obtiene el resultado de una consulta sin bloquear.
+     *
+     * @param pAsync Consulta a revisar.
+     * @param pData Datos de salida (opcional).
+     * @param DataSize Tamaño de los datos de salida.
+     * @param GetDataFlags Flags de la consulta.
+     * @return S_OK si la GPU ya la completó, S_FALSE si sigue pendiente.
+     */
+    HRESULT 
+    GetData(ID3D11Asynchronous* pAsync,
+            void* pData,
+            unsigned int DataSize,
+            unsigned int GetDataFlags);
+
+    /**
+     * @brief Dibuja varias instancias de los elementos indexados.
+     *
+     * @param IndexCountPerInstance Número de índices por instancia.
+     * @param InstanceCount Número de instancias.
+     * @param StartIndexLocation Ubicación inicial del índice.
+     * @param BaseVertexLocation Ubicación base del vértice.
+     * @param StartInstanceLocation Primera instancia leída de los buffers por instancia.
+     */
+    void 
+    DrawIndexedInstanced(unsigned int IndexCountPerInstance,
+                         unsigned int InstanceCount,
+                         unsigned int StartIndexLocation,
+                         int BaseVertexLocation,
+                         unsigned int StartInstanceLocation);
+
+    /**
+     * @brief Obtiene acceso de CPU a un recurso dinámico.
+     *
+     * @param pResource Recurso a mapear.
+     * @param Subresource Subrecurso a mapear.
+     * @param MapType Tipo de acceso (p. ej. D3D11_MAP_WRITE_DISCARD).
+     * @param MapFlags Flags adicionales.
+     * @param pMappedResource Salida: puntero y pitch de los datos mapeados.
+     * @return HRESULT Resultado de la operación.
+     */
+    HRESULT 
+    Map(ID3D11Resource* pResource,
+        unsigned int Subresource,
+        D3D11_MAP MapType,
+        unsigned int MapFlags,
+        D3D11_MAPPED_SUBRESOURCE* pMappedResource);
+
+    /**
+     * @brief Libera el acceso de CPU obtenido con Map.
+     *
+     * @param pResource Recurso mapeado.
+     * @param Subresource Subrecurso mapeado.
+     */
+    void 
+    Unmap(ID3D11Resource* pResource,
+          unsigned int Subresource);
+
+    /**
+     * @brief Cierra los comandos grabados en un contexto diferido.
+     *
+     * @param RestoreDeferredContextState Conservar el estado del contexto para la siguiente lista.
+     * @param ppCommandList Puntero de salida para la lista de comandos.
+     * @return HRESULT Resultado de la operación.
+     */
+    HRESULT 
+    FinishCommandList(bool RestoreDeferredContextState,
+                      ID3D11CommandList** ppCommandList);
+
+    /**
+     * @brief Reproduce en el contexto inmediato una lista grabada en un contexto diferido.
+     *
+     * @param pCommandList Lista de comandos.
+     * @param RestoreContextState Restaurar el estado previo del contexto tras la ejecución;
+     *        con false el contexto queda en el estado por defecto.
+     */
+    void 
+    ExecuteCommandList(ID3D11CommandList* pCommandList,
+                       bool RestoreContextState);
+
 public:
     /// Puntero al contexto del dispositivo Direct3D.
     ID3D11DeviceContext* m_deviceContext = nullptr;
+    /// Interfaz de Direct3D 11.1 del mismo contexto (nullptr si no está disponible).
+    ID3D11DeviceContext1* m_deviceContext1 = nullptr;
+
+private:
+    StateCache m_stateCache;                ///< Copia sombra del estado enlazado.
+    CommandRecorder* m_recorder = nullptr;  ///< Registro de comandos (opcional).
 };
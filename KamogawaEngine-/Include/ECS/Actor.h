@@ -8,6 +8,11 @@
 
 class Device;
 class Component;
+class RenderQueue;
+class ShaderProgram;
+struct AABB;
+struct ActorSnapshot;
+class OcclusionCuller;
 
 /**
  * @brief Clase que representa un Actor en el motor de juego.
@@ -17,6 +22,8 @@ class Component;
  */
 class
 Actor : Entity {
+    DECLARE_POOL_ALLOCATION(Actor, MEMORY_TAG_ECS)
+
 public:
     /**
      * @brief Constructor por defecto.
@@ -35,13 +42,26 @@ public:
     virtual ~Actor() = default;
 
     /**
-     * @brief Actualiza la lgica del actor.
-     * @param deltaTime Tiempo transcurrido desde el ltimo frame.
+     * @brief Actualiza la lógica del actor.
+     * @param deltaTime Duración del paso de simulación.
      * @param deviceContext Contexto del dispositivo para operaciones de renderizado.
      */
     void
     update(float deltaTime, DeviceContext& deviceContext) override;
 
+    /**
+     * @brief Guarda el estado del transform como el del paso anterior (inicio de un paso fijo).
+     */
+    void
+    savePreviousState();
+
+    /**
+     * @brief Prepara la matriz de mundo del frame interpolando entre los dos últimos pasos.
+     * @param alpha Peso del estado del último paso (ver FixedTimestep::getAlpha()).
+     */
+    void
+    interpolate(float alpha);
+
     /**
      * @brief Renderiza el actor utilizando el dispositivo de renderizado.
      * @param deviceContext Contexto del dispositivo para operaciones de renderizado.
@@ -49,6 +69,50 @@ public:
     void
     render(DeviceContext& deviceContext) override;
 
+    /**
+     * @brief Copia el estado del actor que necesita el render (matriz de mundo, constantes y caja).
+     *
+     * Las mallas con posición cuantizada reciben sus propias constantes, con la decodificación
+     * de la posición (VertexFormat::getPositionDecode()) antepuesta a la matriz de mundo.
+     * @param snapshot Salida: estado congelado del actor.
+     */
+    void
+    writeSnapshot(ActorSnapshot& snapshot);
+
+    /**
+     * @brief Envía un paquete de dibujo por cada malla del actor a la cola de render.
+     *
+     * Las matrices y constantes salen de la instantánea (no del actor), así que el actor
+     * puede seguir simulándose mientras se dibuja; la instantánea debe vivir hasta el flush.
+     * @param queue Cola de render del frame.
+     * @param shader Programa de shaders con el que se dibuja el actor.
+     * @param snapshot Estado del actor en el frame que se dibuja.
+     */
+    void
+    submit(RenderQueue& queue, ShaderProgram& shader, const ActorSnapshot& snapshot);
+
+    /**
+     * @brief Agrega las mallas del actor al rasterizador de oclusión si el actor es oclusor.
+     * @param culler Rasterizador de oclusión del frame.
+     * @param snapshot Estado del actor en el frame que se dibuja.
+     */
+    void
+    submitOccluder(OcclusionCuller& culler, const ActorSnapshot& snapshot);
+
+    /**
+     * @brief Marca al actor como oclusor (sus mallas ocultan a otros actores).
+     */
+    void
+    setOccluder(bool occluder) { m_occluder = occluder; }
+
+    /**
+     * @brief Calcula la caja en mundo que contiene todas las mallas del actor.
+     * @param bounds Salida: caja en mundo.
+     * @return false si el actor no tiene mallas con vértices.
+     */
+    bool
+    getWorldBounds(AABB& bounds);
+
     /**
      * @brief Libera los recursos utilizados por el actor.
      */
@@ -57,11 +121,28 @@ public:
 
     /**
      * @brief Establece las mallas del actor.
+     *
+     * Con mergeBuffers las mallas que comparten formato de vértice y de índice se guardan en un solo vertex
+     * buffer y un solo index buffer, y cada una se dibuja con su startIndex y su baseVertex; así
+     * el modelo completo se dibuja sin volver a enlazar buffers entre mallas.
      * @param device Referencia al dispositivo de renderizado.
      * @param meshes Vector de componentes de malla a asignar.
+     * @param mergeBuffers Falso = un vertex y un index buffer por malla.
      */
     void
-    setMesh(Device& device, std::vector<MeshComponent> meshes);
+    setMesh(Device& device, std::vector<MeshComponent> meshes, bool mergeBuffers = true);
+
+    /**
+     * @brief Reutiliza las mallas, buffers y texturas de otro actor sin duplicarlos en la GPU.
+     *
+     * Los actores que comparten geometría se agrupan en lotes instanciados en la cola de render.
+     * El actor de origen conserva la propiedad de los recursos y debe destruirse al final.
+     * Los constant buffers de las mallas con posición cuantizada son propios de cada actor.
+     * @param device Dispositivo con el que se crean los constant buffers por malla.
+     * @param source Actor del que se comparten los recursos.
+     */
+    void
+    shareMesh(Device& device, const Actor& source);
 
     /**
      * @brief Establece las texturas del actor.
@@ -82,7 +163,7 @@ public:
     }
 
     /**
-     * @brief Obtiene un componente especfico del actor.
+     * @brief Obtiene un componente específico del actor.
      * @tparam T Tipo de componente a obtener.
      * @return Puntero compartido al componente solicitado o nulo si no existe.
      */
@@ -90,16 +171,42 @@ public:
     EngineUtilities::TSharedPointer<T>
         getComponent();
 
+private:
+    /**
+     * @brief Ubicación de una malla dentro de los buffers del actor.
+     */
+    struct MeshRange {
+        unsigned int buffer = 0;        ///< Índice en m_vertexBuffers y m_indexBuffers.
+        unsigned int startIndex = 0;    ///< Primer índice de la malla en el index buffer.
+        int baseVertex = 0;             ///< Primer vértice de la malla en el vertex buffer.
+    };
+
+    /**
+     * @brief Verdadero si la malla guarda la posición relativa a su caja (UNORM16).
+     */
+    bool
+    hasPositionDecode(unsigned int mesh) const;
+
+    /**
+     * @brief Crea un constant buffer por cada malla con posición cuantizada (vacío en las demás).
+     */
+    void
+    createMeshConstantBuffers(Device& device);
+
 private:
     std::vector<MeshComponent> m_meshes; ///< Mallas asociadas al actor.
     std::vector<Texture> m_textures; ///< Texturas asociadas al actor.
-    std::vector<Buffer> m_vertexBuffers; ///< Buffers de vrtices para cada malla.
-    std::vector<Buffer> m_indexBuffers; ///< Buffers de ndices para cada malla.
+    std::vector<Buffer> m_vertexBuffers; ///< Buffers de vértices (uno por malla o por formato de vértice e índice).
+    std::vector<Buffer> m_indexBuffers; ///< Buffers de índices, paralelos a m_vertexBuffers.
+    std::vector<MeshRange> m_meshRanges; ///< Buffers y desplazamientos de cada malla.
+    std::vector<Buffer> m_meshConstantBuffers; ///< Constant buffer propio de las mallas con posición cuantizada.
 
     CBChangesEveryFrame m_model; ///< Estructura de constantes que cambia cada frame.
     Buffer m_modelBuffer; ///< Buffer de constantes para el modelo.
     SamplerState m_sampler; ///< Estado del muestreador de texturas.
     std::string m_name = "Actor"; ///< Nombre del actor.
+    bool m_ownsGeometry = true; ///< Falso si las mallas y texturas se comparten con otro actor.
+    bool m_occluder = false; ///< Sus mallas se rasterizan en el buffer de oclusión.
 };
 
 template<typename T>
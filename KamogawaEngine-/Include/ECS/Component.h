@@ -7,8 +7,8 @@ class DeviceContext;
  * @class Component
  * @brief Clase base abstracta para todos los componentes del juego.
  *
- * La clase Component define la interfaz bsica que todos los componentes deben implementar,
- * permitiendo actualizar y renderizar el componente, as como obtener su tipo.
+ * La clase Component define la interfaz básica que todos los componentes deben implementar,
+ * permitiendo actualizar y renderizar el componente, así como obtener su tipo.
  */
 class
 Component {
@@ -31,16 +31,16 @@ public:
     ~Component() = default;
 
     /**
-     * @brief Mtodo virtual puro para actualizar el componente.
-     * @param deltaTime El tiempo transcurrido desde la ltima actualizacin.
+     * @brief Método virtual puro para actualizar el componente.
+     * @param deltaTime El tiempo transcurrido desde la última actualización.
      */
     virtual 
     void
     update(float deltaTime) = 0;
 
     /**
-     * @brief Mtodo virtual puro para renderizar el componente.
-     * @param deviceContext Contexto del dispositivo para operaciones grficas.
+     * @brief Método virtual puro para renderizar el componente.
+     * @param deviceContext Contexto del dispositivo para operaciones gráficas.
      */
     virtual 
     void
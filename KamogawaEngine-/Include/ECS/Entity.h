@@ -14,17 +14,17 @@ public:
     ~Entity() = default;
 
     /**
-     * @brief Mtodo virtual puro para actualizar la entidad.
-     * @param deltaTime El tiempo transcurrido desde la ltima actualizacin.
-     * @param deviceContext Contexto del dispositivo para operaciones grficas.
+     * @brief Método virtual puro para actualizar la entidad.
+     * @param deltaTime El tiempo transcurrido desde la última actualización.
+     * @param deviceContext Contexto del dispositivo para operaciones gráficas.
      */
     virtual 
     void
     update(float deltaTime, DeviceContext& deviceContext) = 0;
 
     /**
-     * @brief Mtodo virtual puro para renderizar la entidad.
-     * @param deviceContext Contexto del dispositivo para operaciones grficas.
+     * @brief Método virtual puro para renderizar la entidad.
+     * @param deviceContext Contexto del dispositivo para operaciones gráficas.
      */
     virtual 
     void
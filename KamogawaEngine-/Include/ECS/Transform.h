@@ -4,72 +4,93 @@
 #include "Component.h"
 
 /**
- * @brief Componente de transformacin que gestiona posicin, rotacin y escala de un objeto.
+ * @brief Componente de transformación que gestiona posición, rotación y escala de un objeto.
  *
- * Representa la transformacin espacial de una entidad en el mundo 3D.
+ * Representa la transformación espacial de una entidad en el mundo 3D.
  */
 class
 Transform : public Component {
+    DECLARE_POOL_ALLOCATION(Transform, MEMORY_TAG_ECS)
+
 public:
     /**
-     * @brief Constructor que inicializa posicin, rotacin y escala por defecto.
+     * @brief Constructor que inicializa posición, rotación y escala por defecto.
      */
     Transform() : position(),
         rotation(),
         scale(),
+        previousPosition(),
+        previousRotation(),
+        previousScale(),
         matrix(),
         Component(ComponentType::TRANSFORM) {}
 
     /**
-     * @brief Inicializa el componente de transformacin.
+     * @brief Inicializa el componente de transformación.
      */
     void
     init();
 
     /**
-     * @brief Actualiza la transformacin en cada frame.
-     * @param deltaTime Tiempo transcurrido desde el ltimo frame.
+     * @brief Avanza un paso de simulación. No construye la matriz: eso lo hace interpolate().
+     * @param deltaTime Duración del paso.
      */
     void
     update(float deltaTime) override;
 
     /**
-     * @brief Renderiza el componente. (Vaco ya que Transform no tiene renderizado propio).
+     * @brief Guarda el estado actual como el del paso anterior.
+     *
+     * Se llama una vez al inicio de cada paso fijo, antes de cualquier lógica que mueva el
+     * objeto, para que interpolate() mezcle entre el paso anterior y el actual.
+     */
+    void
+    savePreviousState();
+
+    /**
+     * @brief Calcula la matriz de render entre el estado del paso anterior y el actual.
+     * @param alpha Peso del estado actual (0 = anterior, 1 = actual).
+     */
+    void
+    interpolate(float alpha);
+
+    /**
+     * @brief Renderiza el componente. (Vacío ya que Transform no tiene renderizado propio).
      * @param deviceContext Contexto del dispositivo de renderizado.
      */
     void
     render(DeviceContext& deviceContext) override {}
 
     /**
-     * @brief Destruye el componente. (Vaco en este caso).
+     * @brief Destruye el componente. (Vacío en este caso).
      */
     void
     destroy() {}
 
     /**
-     * @brief Obtiene la posicin actual del objeto.
-     * @return Referencia constante al vector de posicin.
+     * @brief Obtiene la posición actual del objeto.
+     * @return Referencia constante al vector de posición.
      */
     const EngineUtilities::Vector3&
     getPosition() const { return position; }
 
     /**
-     * @brief Establece una nueva posicin.
-     * @param newPos Vector que representa la nueva posicin.
+     * @brief Establece una nueva posición.
+     * @param newPos Vector que representa la nueva posición.
      */
     void
     setPosition(const EngineUtilities::Vector3& newPos) { position = newPos; }
 
     /**
-     * @brief Obtiene la rotacin actual del objeto.
-     * @return Referencia constante al vector de rotacin.
+     * @brief Obtiene la rotación actual del objeto.
+     * @return Referencia constante al vector de rotación.
      */
     const EngineUtilities::Vector3&
     getRotation() const { return rotation; }
 
     /**
-     * @brief Establece una nueva rotacin.
-     * @param newRot Vector que representa la nueva rotacin.
+     * @brief Establece una nueva rotación.
+     * @param newRot Vector que representa la nueva rotación.
      */
     void
     setRotation(const EngineUtilities::Vector3& newRot) { rotation = newRot; }
@@ -89,9 +110,10 @@ public:
     setScale(const EngineUtilities::Vector3& newScale) { scale = newScale; }
 
     /**
-     * @brief Establece posicin, rotacin y escala en una sola operacin.
-     * @param newPos Nueva posicin.
-     * @param newRot Nueva rotacin.
+     * @brief Establece posición, rotación y escala en una sola operación, sin interpolar
+     *        desde el estado previo (el objeto se coloca de golpe).
+     * @param newPos Nueva posición.
+     * @param newRot Nueva rotación.
      * @param newSca Nueva escala.
      */
     void
@@ -100,17 +122,20 @@ public:
                  const EngineUtilities::Vector3& newSca);
 
     /**
-     * @brief Traslada (mueve) la posicin actual por un vector de traslacin.
-     * @param translation Vector de traslacin a aplicar.
+     * @brief Traslada (mueve) la posición actual por un vector de traslación.
+     * @param translation Vector de traslación a aplicar.
      */
     void
     translate(const EngineUtilities::Vector3& translation);
 
 private:
-    EngineUtilities::Vector3 position; ///< Posicin del objeto.
-    EngineUtilities::Vector3 rotation; ///< Rotacin del objeto.
+    EngineUtilities::Vector3 position; ///< Posición del objeto.
+    EngineUtilities::Vector3 rotation; ///< Rotación del objeto.
     EngineUtilities::Vector3 scale;    ///< Escala del objeto.
+    EngineUtilities::Vector3 previousPosition; ///< Posición al final del paso anterior.
+    EngineUtilities::Vector3 previousRotation; ///< Rotación al final del paso anterior.
+    EngineUtilities::Vector3 previousScale;    ///< Escala al final del paso anterior.
 
 public:
-    XMMATRIX matrix; ///< Matriz de transformacin resultante (posicin, rotacin y escala combinadas).
+    XMMATRIX matrix; ///< Matriz de transformación resultante (posición, rotación y escala combinadas).
 };
@@ -0,0 +1,231 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Utilities\Structures\TArray.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief Asignador lineal por bloques: reservar es mover un desplazamiento, liberar es reset().
+ *
+ * Si un frame no cabe en el bloque actual se agrega otro; en reset() los bloques se fusionan en
+ * uno del tamaño total para que los frames siguientes no vuelvan a pedir memoria al sistema.
+ */
+class
+LinearAllocator {
+public:
+    explicit LinearAllocator(size_t blockSize = 64 * 1024) : m_blockSize(blockSize) {}
+    ~LinearAllocator() { release(); }
+
+    LinearAllocator(const LinearAllocator&) = delete;
+    LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+    /**
+     * @brief Reserva memoria sin inicializar.
+     * @param size Bytes.
+     * @param alignment Alineación (potencia de 2, hasta kBlockAlignment).
+     */
+    void*
+    allocate(size_t size, size_t alignment);
+
+    /**
+     * @brief Libera todo lo reservado desde el último reset().
+     */
+    void
+    reset();
+
+    /**
+     * @brief Devuelve los bloques al sistema.
+     */
+    void
+    release();
+
+    size_t
+    getUsed() const { return m_used; }
+
+    size_t
+    getCapacity() const { return m_capacity; }
+
+    unsigned int
+    getAllocations() const { return m_allocations; }
+
+    /**
+     * @brief Bloques pedidos al sistema desde el último reset().
+     */
+    unsigned int
+    getHeapBlocks() const { return m_heapBlocks; }
+
+    static constexpr size_t kBlockAlignment = 64;  ///< Alineación de cada bloque (línea de caché).
+
+private:
+    struct Block {
+        unsigned char* data;
+        size_t size;
+    };
+
+    std::vector<Block> m_blocks;        ///< Bloques reservados.
+    size_t m_blockSize;                 ///< Tamaño mínimo de un bloque nuevo.
+    size_t m_current = 0;               ///< Bloque en uso.
+    size_t m_offset = 0;                ///< Desplazamiento dentro del bloque en uso.
+    size_t m_used = 0;                  ///< Bytes entregados desde el último reset() (con relleno).
+    size_t m_capacity = 0;              ///< Bytes de todos los bloques.
+    unsigned int m_allocations = 0;     ///< Reservas desde el último reset().
+    unsigned int m_heapBlocks = 0;      ///< Bloques pedidos al sistema desde el último reset().
+};
+
+/**
+ * @brief Estadísticas del último frame de la arena.
+ */
+struct
+FrameArenaStats {
+    unsigned int allocations = 0;       ///< Reservas en el frame (todos los hilos).
+    unsigned long long bytes = 0;       ///< Bytes reservados en el frame.
+    unsigned long long peakBytes = 0;   ///< Mayor uso de un frame desde el inicio.
+    unsigned long long capacity = 0;    ///< Memoria total de los bloques.
+    unsigned int heapBlocks = 0;        ///< Bloques pedidos al sistema en el frame (0 al estabilizarse).
+    unsigned int threads = 0;           ///< Hilos con arena propia.
+};
+
+/**
+ * @brief Memoria temporal por frame.
+ *
+ * Cada hilo tiene sus propios asignadores lineales, así que reservar no toma bloqueos.
+ * allocate() entrega memoria válida hasta el final del frame; allocateTwoFrames() la entrega
+ * de un par de asignadores que se alternan por frame, válida también durante el siguiente
+ * (datos que el frame N produce y el N+1 consume).
+ *
+ * endFrame() se llama desde el hilo principal cuando ningún otro hilo está reservando (los
+ * hilos de trabajo del motor terminan su parte dentro del frame). Un hilo con su propio ciclo
+ * de frames (la simulación) llama a endThreadFrame() y endFrame() deja de tocar su arena.
+ */
+class
+FrameArena {
+public:
+    static FrameArena&
+    getInstance();
+
+    /**
+     * @brief Reserva memoria sin inicializar válida hasta el final del frame.
+     */
+    void*
+    allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Reserva memoria sin inicializar válida hasta el final del frame siguiente.
+     */
+    void*
+    allocateTwoFrames(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * @brief Libera la memoria del frame y la del frame anterior de doble buffer.
+     */
+    void
+    endFrame();
+
+    /**
+     * @brief Libera la arena del hilo actual al terminar su propio frame; desde la primera
+     *        llamada endFrame() ya no la libera.
+     */
+    void
+    endThreadFrame();
+
+    /**
+     * @brief Estadísticas del último frame terminado.
+     */
+    const FrameArenaStats&
+    getStats() const { return m_stats; }
+
+private:
+    FrameArena() = default;
+
+    struct ThreadArena {
+        LinearAllocator frame;          ///< Memoria de un frame.
+        LinearAllocator twoFrames[2];   ///< Memoria de dos frames (se alterna cada frame).
+        bool ownFrame = false;          ///< El hilo libera su arena con endThreadFrame().
+        unsigned int parity = 0;        ///< Asignador de dos frames activo si ownFrame.
+    };
+
+    /**
+     * @brief Arena del hilo actual (se registra la primera vez).
+     */
+    ThreadArena&
+    getThreadArena();
+
+private:
+    std::mutex m_registryMutex;                             ///< Protege el registro de hilos.
+    std::vector<std::unique_ptr<ThreadArena>> m_arenas;     ///< Arena de cada hilo.
+    std::atomic<unsigned int> m_parity{ 0 };                ///< Asignador de dos frames activo.
+    FrameArenaStats m_stats;                                ///< Estadísticas del último frame.
+};
+
+/**
+ * @brief Adaptador de FrameArena para contenedores de la STL y TArray.
+ *
+ * deallocate() no hace nada: la memoria vuelve a la arena al final del frame, así que el
+ * contenedor no debe vivir más que el frame (usar reserve() evita desperdiciar lo que deja
+ * cada crecimiento).
+ */
+template<typename T>
+class
+FrameAllocator {
+public:
+    typedef T value_type;
+
+    FrameAllocator() = default;
+
+    template<typename U>
+    FrameAllocator(const FrameAllocator<U>&) {}
+
+    T*
+    allocate(size_t count) {
+        return static_cast<T*>(FrameArena::getInstance().allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void
+    deallocate(T*, size_t) {}
+
+    template<typename U>
+    bool
+    operator==(const FrameAllocator<U>&) const { return true; }
+
+    template<typename U>
+    bool
+    operator!=(const FrameAllocator<U>&) const { return false; }
+};
+
+/** Vector temporal en la arena del frame. */
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+/** TArray temporal en la arena del frame. */
+template<typename T>
+using FrameArray = EngineUtilities::TArray<T, FrameAllocator<T>>;
+
+/**
+ * @brief Resultado de runFrameArenaBenchmark().
+ */
+struct
+FrameArenaBenchmarkResult {
+    unsigned int frames = 0;                        ///< Frames medidos después del calentamiento.
+    unsigned int warmupFrames = 0;                  ///< Frames de calentamiento.
+    unsigned long long firstFrameHeapCalls = 0;     ///< Llamadas a operator new en el primer frame.
+    unsigned int firstFrameArenaBlocks = 0;         ///< Bloques que la arena pidió al sistema en el primer frame.
+    double heapCallsPerFrame = 0.0;                 ///< Llamadas a operator new por frame después del calentamiento.
+    unsigned int arenaBlocks = 0;                   ///< Bloques pedidos por la arena después del calentamiento.
+    unsigned int arenaAllocationsPerFrame = 0;      ///< Reservas servidas por la arena en el último frame.
+};
+
+/**
+ * @brief Cuenta las reservas del heap por frame de un trabajo que usa memoria temporal.
+ *
+ * Corre frame() en el hilo actual y termina cada frame con FrameArena::endFrame(). Las llamadas
+ * a operator new se cuentan con MemoryTracker::getThreadHeapAllocations(), así que otros hilos
+ * no se mezclan en el resultado; los bloques de la arena se toman de sus estadísticas.
+ * @param frame Trabajo de un frame.
+ * @param frames Frames medidos.
+ * @param warmupFrames Frames previos en los que los contenedores y la arena alcanzan su tamaño.
+ */
+FrameArenaBenchmarkResult
+runFrameArenaBenchmark(const std::function<void()>& frame, unsigned int frames, unsigned int warmupFrames);
@@ -0,0 +1,162 @@
+#pragma once
+#include <cstddef>
+
+/**
+ * @brief Reloj monotónico de alta resolución (QueryPerformanceCounter en Windows).
+ *
+ * tick() se llama una vez por frame y mide el intervalo desde el tick anterior; el tiempo
+ * no retrocede aunque cambie la hora del sistema.
+ */
+class
+FrameClock {
+public:
+    FrameClock();
+
+    /**
+     * @brief Instante actual en nanosegundos (origen arbitrario).
+     */
+    static long long
+    now();
+
+    /**
+     * @brief Marca un frame nuevo y mide el intervalo desde el anterior.
+     */
+    void
+    tick();
+
+    /**
+     * @brief Segundos entre los dos últimos tick() (0 en el primero).
+     */
+    double
+    getDeltaSeconds() const { return m_deltaSeconds; }
+
+    /**
+     * @brief Segundos desde la creación del reloj.
+     */
+    double
+    getTotalSeconds() const;
+
+private:
+    long long m_start;              ///< Creación del reloj.
+    long long m_last;               ///< Último tick().
+    double m_deltaSeconds = 0.0;    ///< Intervalo entre los dos últimos tick().
+};
+
+/**
+ * @brief Acumulador de paso fijo: la simulación avanza en pasos de duración constante sin
+ *        depender de los FPS, y el render interpola entre los dos últimos estados con getAlpha().
+ */
+class
+FixedTimestep {
+public:
+    /**
+     * @param step Duración de un paso en segundos.
+     * @param maxSteps Pasos máximos por frame; el tiempo que exceda se descarta para que un
+     *                 frame lento no dispare una cadena de frames cada vez más lentos.
+     */
+    explicit FixedTimestep(double step = 1.0 / 60.0, unsigned int maxSteps = 5)
+        : m_step(step), m_maxSteps(maxSteps) {}
+
+    /**
+     * @brief Acumula el tiempo del frame.
+     * @return Pasos de simulación a ejecutar en este frame.
+     */
+    unsigned int
+    advance(double frameSeconds);
+
+    double
+    getStep() const { return m_step; }
+
+    /**
+     * @brief Fracción del paso siguiente ya transcurrida (0..1): peso del estado actual al
+     *        interpolar con el anterior.
+     */
+    float
+    getAlpha() const { return static_cast<float>(m_accumulator / m_step); }
+
+    /**
+     * @brief Pasos ejecutados desde el inicio.
+     */
+    unsigned long long
+    getStepCount() const { return m_stepCount; }
+
+    /**
+     * @brief Segundos descartados por superar maxSteps.
+     */
+    double
+    getDroppedSeconds() const { return m_droppedSeconds; }
+
+private:
+    double m_step;                          ///< Duración de un paso.
+    unsigned int m_maxSteps;                ///< Pasos máximos por frame.
+    double m_accumulator = 0.0;             ///< Tiempo pendiente de simular.
+    unsigned long long m_stepCount = 0;     ///< Pasos ejecutados.
+    double m_droppedSeconds = 0.0;          ///< Tiempo descartado.
+};
+
+/**
+ * @brief Telemetría del ritmo de frames sobre el historial del FramePacer.
+ */
+struct
+FramePacingStats {
+    float targetMs = 0.0f;          ///< Intervalo objetivo (0 = sin límite).
+    float averageMs = 0.0f;         ///< Intervalo promedio entre frames.
+    float jitterMs = 0.0f;          ///< Desviación absoluta media respecto del objetivo (o del promedio).
+    float stdDevMs = 0.0f;          ///< Desviación estándar del intervalo.
+    float maxDeviationMs = 0.0f;    ///< Mayor desviación de un frame.
+    unsigned int missedFrames = 0;  ///< Frames del historial que llegaron tarde más de medio intervalo.
+    float sleepMs = 0.0f;           ///< Tiempo dormido en la última espera.
+    float spinMs = 0.0f;            ///< Tiempo de espera activa en la última espera.
+};
+
+/**
+ * @brief Limita los FPS a un objetivo con espera híbrida: duerme con un temporizador de alta
+ *        resolución hasta poco antes del instante objetivo y termina con espera activa.
+ *
+ * Si un frame llega tarde el objetivo se reprograma desde ese instante en vez de intentar
+ * recuperar el tiempo perdido con frames más cortos.
+ */
+class
+FramePacer {
+public:
+    static constexpr unsigned int kHistory = 120;   ///< Intervalos usados en la telemetría.
+    static constexpr double kSpinSeconds = 0.002;   ///< Margen final que se espera activamente.
+
+    FramePacer();
+    ~FramePacer();
+
+    FramePacer(const FramePacer&) = delete;
+    FramePacer& operator=(const FramePacer&) = delete;
+
+    /**
+     * @brief FPS objetivo (0 = sin límite; solo se mide el ritmo).
+     */
+    void
+    setTargetFps(double fps);
+
+    /**
+     * @brief Espera al inicio del frame siguiente y registra el intervalo.
+     */
+    void
+    wait();
+
+    /**
+     * @brief Telemetría actualizada en cada wait().
+     */
+    const FramePacingStats&
+    getStats() const { return m_stats; }
+
+private:
+    void
+    updateStats(double periodSeconds);
+
+private:
+    void* m_timer = nullptr;                ///< Temporizador de espera (HANDLE en Windows).
+    double m_targetSeconds = 0.0;           ///< Intervalo objetivo.
+    long long m_nextFrame = 0;              ///< Instante objetivo del próximo frame.
+    long long m_lastFrame = 0;              ///< Inicio del frame anterior.
+    float m_periods[kHistory] = {};         ///< Intervalos recientes en milisegundos.
+    unsigned int m_next = 0;                ///< Siguiente posición del anillo.
+    unsigned int m_count = 0;               ///< Intervalos válidos.
+    FramePacingStats m_stats;               ///< Telemetría.
+};
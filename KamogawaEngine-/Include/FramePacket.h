@@ -0,0 +1,122 @@
+#pragma once
+#include "Prerequisites.h"
+#include "AABBTree.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+class Actor;
+
+/**
+ * @brief Estado de un actor congelado para el render.
+ */
+struct
+ActorSnapshot {
+    Actor* actor = nullptr;             ///< Actor (mallas y recursos de GPU, que no cambian tras init).
+    XMFLOAT4X4 world;                   ///< Matriz de mundo interpolada.
+    CBChangesEveryFrame constants;      ///< Constantes del objeto para el shader.
+    std::vector<CBChangesEveryFrame> meshConstants; ///< Constantes por malla con la posición cuantizada (vacío si no hay).
+    AABB bounds;                        ///< Caja en mundo.
+    bool hasBounds = false;             ///< El actor tiene mallas con vértices.
+};
+
+/**
+ * @brief Todo lo que el hilo de render necesita de un frame de simulación.
+ *
+ * La simulación lo escribe completo antes de publicarlo y el render solo lo lee: no hay
+ * estado compartido mutable entre ambos hilos durante el dibujo.
+ */
+struct
+FramePacket {
+    unsigned long long frame = 0;               ///< Número de paquete (1, 2, ...).
+    long long inputTime = 0;                    ///< FrameClock::now() al leer la entrada (inicio del frame).
+    unsigned int simulationSteps = 0;           ///< Pasos simulados para producirlo.
+    float interpolationAlpha = 1.0f;            ///< Peso del último paso en la interpolación.
+    float jitterMs = 0.0f;                      ///< Jitter del ritmo de la simulación.
+    XMFLOAT4X4 view;                            ///< Matriz de vista de la cámara.
+    XMFLOAT4X4 projection;                      ///< Matriz de proyección.
+    XMFLOAT3 cameraPosition;                    ///< Posición interpolada de la cámara.
+    std::vector<ActorSnapshot> actors;          ///< Estado de cada actor de la escena.
+    std::vector<unsigned int> visible;          ///< Índices en actors dentro del frustum.
+
+    /**
+     * @brief Hash (FNV-1a) del contenido que determina la imagen; dos corridas deterministas
+     *        producen la misma secuencia de hashes.
+     */
+    unsigned long long
+    hash() const;
+};
+
+/**
+ * @brief Contadores del intercambio de paquetes.
+ */
+struct
+FramePacketStats {
+    unsigned long long published = 0;   ///< Paquetes publicados por la simulación.
+    unsigned long long consumed = 0;    ///< Paquetes tomados por el render.
+    unsigned long long dropped = 0;     ///< Paquetes reemplazados antes de que el render los tomara.
+};
+
+/**
+ * @brief Triple buffer de FramePacket entre el hilo de simulación y el de render.
+ *
+ * Cada hilo trabaja sobre su propio paquete; solo el intercambio de índices toma el mutex.
+ * La simulación escribe en m_write y lo publica como m_ready; el render toma m_ready como
+ * m_read. En modo normal la simulación nunca espera (un render lento hace que se descarten
+ * paquetes sin frenar la simulación); en lockstep espera a que el render tome cada paquete
+ * para que todos se dibujen (corridas headless reproducibles).
+ */
+class
+FramePacketBuffer {
+public:
+    FramePacketBuffer() = default;
+    ~FramePacketBuffer() = default;
+
+    /**
+     * @brief En lockstep la simulación espera a que el render tome cada paquete.
+     */
+    void
+    setLockstep(bool lockstep);
+
+    /**
+     * @brief Paquete a escribir por la simulación (en lockstep espera a que haya lugar).
+     * @return nullptr si el intercambio se cerró con shutdown().
+     */
+    FramePacket*
+    beginWrite();
+
+    /**
+     * @brief Publica el paquete escrito; reemplaza al publicado que el render no tomó.
+     */
+    void
+    publish();
+
+    /**
+     * @brief Toma el paquete publicado más reciente.
+     * @param timeout Espera máxima si no hay uno nuevo.
+     * @return nullptr si no llegó un paquete nuevo a tiempo.
+     */
+    const FramePacket*
+    acquire(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Despierta a los hilos en espera y hace que beginWrite() devuelva nullptr.
+     */
+    void
+    shutdown();
+
+    FramePacketStats
+    getStats();
+
+private:
+    std::mutex m_mutex;                         ///< Protege los índices y contadores.
+    std::condition_variable m_signal;           ///< Avisa publicaciones, tomas y cierre.
+    FramePacket m_packets[3];                   ///< Paquetes de escritura, publicado y lectura.
+    unsigned int m_write = 0;                   ///< Paquete de la simulación.
+    unsigned int m_ready = 1;                   ///< Último publicado.
+    unsigned int m_read = 2;                    ///< Paquete del render.
+    bool m_hasReady = false;                    ///< m_ready tiene un paquete sin tomar.
+    bool m_lockstep = false;                    ///< La simulación espera a cada toma.
+    bool m_closed = false;                      ///< shutdown() llamado.
+    FramePacketStats m_stats;                   ///< Contadores.
+};
@@ -0,0 +1,130 @@
+#pragma once
+#include "Prerequisites.h"
+#include <chrono>
+
+/**
+ * @brief Contadores de un frame para el panel de estadísticas.
+ */
+struct
+FrameSample {
+    float frameMs = 0.0f;                   ///< Tiempo desde el inicio del frame anterior.
+    float cpuMs = 0.0f;                     ///< Tiempo de CPU entre beginFrame() y endFrame().
+    unsigned int draws = 0;                 ///< Llamadas de dibujo que llegaron a la API.
+    unsigned int stateChanges = 0;          ///< Enlaces de estado que llegaron a la API.
+    unsigned int bindsSkipped = 0;          ///< Enlaces omitidos por redundantes en la cola.
+    unsigned int vertexBufferBinds = 0;     ///< Vertex buffers enlazados por la cola.
+    unsigned int indexBufferBinds = 0;      ///< Index buffers enlazados por la cola.
+    unsigned int trianglesSubmitted = 0;    ///< Triángulos enviados a la cola de render.
+    unsigned int trianglesCulled = 0;       ///< Triángulos descartados por el frustum en la cola.
+    unsigned long long trianglesDrawn = 0;  ///< Triángulos dibujados (incluye instancias).
+    unsigned long long vertexBytes = 0;     ///< Bytes de vértices leídos por los dibujos (ver RenderQueueStats).
+    unsigned int actorsOccluded = 0;        ///< Actores descartados por el occlusion culling.
+    unsigned int uploads = 0;               ///< Actualizaciones y mapeos de recursos.
+    unsigned long long uploadBytes = 0;     ///< Bytes subidos con UpdateSubresource.
+    unsigned int allocations = 0;           ///< Recursos creados en el frame.
+    unsigned int ringAllocations = 0;       ///< Sub-asignaciones del anillo de constantes.
+    unsigned int arenaAllocations = 0;      ///< Reservas en la arena del frame.
+    unsigned long long arenaBytes = 0;      ///< Bytes reservados en la arena del frame.
+    unsigned int arenaHeapBlocks = 0;       ///< Bloques que la arena pidió al sistema en el frame.
+    unsigned int simulationSteps = 0;       ///< Pasos fijos de simulación ejecutados en el frame.
+    float interpolationAlpha = 0.0f;        ///< Peso del último paso al interpolar el render.
+    float jitterMs = 0.0f;                  ///< Jitter del ritmo de frames (ver FramePacingStats).
+    float latencyMs = 0.0f;                 ///< Desde la lectura de la entrada hasta el Present del paquete.
+    unsigned long long packetsDropped = 0;  ///< Paquetes de simulación que el render no llegó a dibujar.
+    unsigned long long bufferBytes = 0;     ///< Memoria total de buffers creados.
+    unsigned long long textureBytes = 0;    ///< Memoria total de texturas creadas.
+};
+
+/**
+ * @brief Percentiles del tiempo de frame sobre el historial.
+ */
+struct
+FrameTimePercentiles {
+    float average = 0.0f;
+    float p50 = 0.0f;
+    float p95 = 0.0f;
+    float p99 = 0.0f;
+    float max = 0.0f;
+};
+
+/**
+ * @brief Historial en anillo de las estadísticas por frame.
+ *
+ * Guarda los últimos kHistory frames sin asignar memoria durante la ejecución: endFrame() solo
+ * copia la muestra en su posición del anillo. Los percentiles se calculan bajo demanda (cuando
+ * el panel se dibuja) con nth_element sobre una copia de los tiempos.
+ */
+class
+FrameStats {
+public:
+    static constexpr unsigned int kHistory = 256;  ///< Frames guardados.
+
+    FrameStats() = default;
+    ~FrameStats() = default;
+
+    /**
+     * @brief Marca el inicio de un frame; el tiempo de frame se mide entre inicios consecutivos.
+     */
+    void
+    beginFrame();
+
+    /**
+     * @brief Guarda los contadores del frame en el historial.
+     * @param sample Contadores del frame; frameMs y cpuMs se calculan aquí.
+     */
+    void
+    endFrame(const FrameSample& sample);
+
+    /**
+     * @brief Muestra del último frame terminado.
+     */
+    const FrameSample&
+    getLatest() const { return m_samples[(m_next + kHistory - 1) % kHistory]; }
+
+    /**
+     * @brief Tiempos de frame en orden de anillo (para ImGui::PlotLines con getOffset()).
+     */
+    const float*
+    getFrameTimes() const { return m_frameTimes; }
+
+    /**
+     * @brief Tiempos de CPU en orden de anillo.
+     */
+    const float*
+    getCpuTimes() const { return m_cpuTimes; }
+
+    /**
+     * @brief Frames válidos en el historial.
+     */
+    unsigned int
+    getCount() const { return m_count; }
+
+    /**
+     * @brief Posición del frame más antiguo en el anillo.
+     */
+    unsigned int
+    getOffset() const { return m_count < kHistory ? 0 : m_next; }
+
+    /**
+     * @brief Calcula promedio y percentiles del tiempo de frame del historial.
+     */
+    FrameTimePercentiles
+    computePercentiles() const;
+
+    /**
+     * @brief Costo del último endFrame() en milisegundos.
+     */
+    double
+    getUpdateTimeMs() const { return m_updateTimeMs; }
+
+private:
+    FrameSample m_samples[kHistory];                        ///< Contadores de cada frame.
+    float m_frameTimes[kHistory] = {};                      ///< Tiempo de frame (continuo para graficar).
+    float m_cpuTimes[kHistory] = {};                        ///< Tiempo de CPU (continuo para graficar).
+    unsigned int m_next = 0;                                ///< Siguiente posición a escribir.
+    unsigned int m_count = 0;                               ///< Frames válidos.
+    std::chrono::steady_clock::time_point m_frameStart;     ///< Inicio del frame en curso.
+    float m_frameMs = 0.0f;                                 ///< Intervalo entre los dos últimos inicios.
+    bool m_started = false;                                 ///< Ya hubo un beginFrame().
+    double m_updateTimeMs = 0.0;                            ///< Costo del último endFrame().
+};
@@ -0,0 +1,126 @@
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @brief Contadores de la última pasada de culling.
+ */
+struct
+CullingStats {
+    unsigned int tested = 0;    ///< Cajas probadas contra el frustum.
+    unsigned int visible = 0;   ///< Cajas que intersectan el frustum.
+    unsigned int culled = 0;    ///< Cajas descartadas.
+    double cullTimeMs = 0.0;    ///< Tiempo de la prueba en milisegundos.
+};
+
+/**
+ * @brief Culling de cajas alineadas a los ejes contra el frustum de la cámara.
+ *
+ * Las cajas se guardan en estructura de arreglos (centro y extensión por eje) y se prueban
+ * de 8 en 8 con AVX, o de 4 en 4 con SSE2 si el procesador no tiene AVX. Una caja se descarta
+ * si queda completamente detrás de alguno de los 6 planos.
+ */
+class
+FrustumCuller {
+public:
+    FrustumCuller() = default;
+    ~FrustumCuller() = default;
+
+    /**
+     * @brief Extrae los 6 planos del frustum de una matriz vista * proyección.
+     * @param viewProjection Producto m_View * m_Projection (convención fila-vector).
+     */
+    void
+    setFrustum(const XMMATRIX& viewProjection);
+
+    /**
+     * @brief Elimina las cajas del frame anterior (conserva la memoria reservada).
+     */
+    void
+    clear();
+
+    /**
+     * @brief Agrega una caja en espacio de mundo.
+     * @param center Centro de la caja.
+     * @param extents Mitad del tamaño de la caja por eje.
+     * @return Índice de la caja.
+     */
+    unsigned int
+    add(const XMFLOAT3& center, const XMFLOAT3& extents);
+
+    /**
+     * @brief Prueba todas las cajas agregadas contra el frustum.
+     */
+    void
+    cull();
+
+    /**
+     * @brief Indica si una caja sobrevivió la última llamada a cull().
+     */
+    bool
+    isVisible(unsigned int index) const {
+        return (m_visibleMask[index >> 3] >> (index & 7)) & 1;
+    }
+
+    const CullingStats&
+    getStats() const { return m_stats; }
+
+    /**
+     * @brief Extrae los 6 planos normalizados de una matriz vista * proyección.
+     * @param viewProjection Producto m_View * m_Projection (convención fila-vector).
+     * @param planes Salida: planos (nx, ny, nz, d); un punto está dentro si n·p + d >= 0.
+     */
+    static void
+    extractPlanes(const XMMATRIX& viewProjection, XMFLOAT4 planes[6]);
+
+    /**
+     * @brief Transforma un AABB local al AABB de mundo que lo contiene (método de Arvo).
+     * @param localMin Esquina mínima local.
+     * @param localMax Esquina máxima local.
+     * @param world Matriz de mundo.
+     * @param center Salida: centro en mundo.
+     * @param extents Salida: extensión en mundo.
+     */
+    static void
+    transformBox(const XMFLOAT3& localMin,
+                 const XMFLOAT3& localMax,
+                 const XMMATRIX& world,
+                 XMFLOAT3& center,
+                 XMFLOAT3& extents);
+
+private:
+    void
+    cullAVX(unsigned int groups);
+
+    void
+    cullSSE(unsigned int groups);
+
+private:
+    XMFLOAT4 m_planes[6];                       ///< Planos (nx, ny, nz, d); dentro si n·p + d >= 0.
+
+    std::vector<float> m_centerX, m_centerY, m_centerZ;    ///< Centros (rellenados a múltiplo de 8).
+    std::vector<float> m_extentX, m_extentY, m_extentZ;    ///< Extensiones (rellenadas a múltiplo de 8).
+    std::vector<unsigned char> m_visibleMask;   ///< Un bit por caja, 8 cajas por byte.
+    unsigned int m_count = 0;                   ///< Cajas agregadas.
+
+    CullingStats m_stats;                       ///< Contadores de la última pasada.
+};
+
+/**
+ * @brief Resultado de runCullingBenchmark().
+ */
+struct
+CullingBenchmarkResult {
+    unsigned int objects = 0;           ///< Cajas probadas por frame.
+    unsigned int visible = 0;           ///< Cajas visibles en el último frame.
+    double cullTimeMs = 0.0;            ///< Promedio de CullingStats::cullTimeMs por frame.
+    double nsPerObject = 0.0;           ///< cullTimeMs por caja, en nanosegundos.
+};
+
+/**
+ * @brief Mide FrustumCuller::cull() sobre cajas aleatorias (semilla fija) repartidas en un cubo
+ *        de 1000 unidades alrededor de una cámara de 45 grados que gira un poco cada frame.
+ * @param objects Cajas por frame.
+ * @param frames Frames medidos.
+ */
+CullingBenchmarkResult
+runCullingBenchmark(unsigned int objects, unsigned int frames);
@@ -0,0 +1,42 @@
+#pragma once
+#include "Prerequisites.h"
+
+class MeshComponent;
+
+/**
+ * @brief Contadores de la elección del ancho de índices.
+ */
+struct
+IndexFormatStats {
+    unsigned int shortMeshes = 0;           ///< Mallas con índices de 16 bits.
+    unsigned int longMeshes = 0;            ///< Mallas que se quedan con índices de 32 bits.
+    unsigned int splitMeshes = 0;           ///< Mallas partidas en trozos para usar 16 bits.
+    unsigned int chunks = 0;                ///< Trozos creados al partir.
+    unsigned int duplicatedVertices = 0;    ///< Vértices repetidos en más de un trozo.
+    unsigned long long bytes = 0;           ///< Memoria de los index buffers resultantes.
+    unsigned long long longBytes = 0;       ///< Memoria que ocuparían con índices de 32 bits.
+};
+
+/**
+ * @brief Vértices máximos que direcciona un índice de 16 bits.
+ */
+constexpr unsigned int kMaxShortIndexVertices = 65536;
+
+/**
+ * @brief Elige el ancho de índices de una malla (MeshComponent::m_indexFormat).
+ *
+ * Con kMaxShortIndexVertices vértices o menos la malla usa DXGI_FORMAT_R16_UINT. Si tiene más y
+ * se permite partirla, los triángulos se agrupan en orden en trozos de hasta maxVertices
+ * vértices contiguos (repitiendo los vértices que comparten trozos, con su skin); cada trozo se
+ * dibuja con su baseVertex y sus índices de 16 bits son relativos a él. Los índices de
+ * MeshComponent::m_index siguen siendo absolutos para los usos en CPU.
+ * @param mesh Malla triangulada.
+ * @param allowSplit Permite partir las mallas grandes en vez de dejarlas en 32 bits.
+ * @param stats Contadores a los que se suma el resultado.
+ * @param maxVertices Vértices por trozo (como máximo kMaxShortIndexVertices).
+ */
+void
+selectIndexFormat(MeshComponent& mesh,
+                  bool allowSplit,
+                  IndexFormatStats& stats,
+                  unsigned int maxVertices = kMaxShortIndexVertices);
@@ -8,7 +8,7 @@ DeviceContext;
 
 /**
  * @brief Clase que encapsula un Input Layout de Direct3D 11.
- * Define cmo se interpretan los datos del vertex buffer al pasar al pipeline.
+ * Define cómo se interpretan los datos del vertex buffer al pasar al pipeline.
  */
 class 
 InputLayout
@@ -18,11 +18,11 @@ public:
 	~InputLayout() = default;
 
 	/**
-	 * @brief Inicializa el input layout con una descripcin y los datos del shader.
+	 * @brief Inicializa el input layout con una descripción y los datos del shader.
 	 * @param device Referencia al dispositivo de render.
-	 * @param Layout Vector con la descripcin de los elementos de entrada.
+	 * @param Layout Vector con la descripción de los elementos de entrada.
 	 * @param VertexShaderData Blob con los datos compilados del vertex shader.
-	 * @return HRESULT Resultado de la operacin.
+	 * @return HRESULT Resultado de la operación.
 	 */
 	HRESULT
 	init(Device& device,
@@ -30,7 +30,7 @@ public:
 		 ID3DBlob* VertexShaderData);
 
 	/**
-	 * @brief Actualiza el estado del input layout. (Vaco por diseo, puede ser extendido).
+	 * @brief Actualiza el estado del input layout. (Vacío por diseño, puede ser extendido).
 	 */
 	void
 	update();
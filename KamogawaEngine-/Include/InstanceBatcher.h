@@ -0,0 +1,160 @@
+#pragma once
+#include <vector>
+#include <functional>
+#include <cstddef>
+
+/**
+ * @brief Identifica la geometría y el material que comparten las instancias de un lote.
+ *
+ * Los recursos se guardan como punteros opacos para que la agrupación no dependa de Direct3D.
+ */
+struct
+InstanceKey {
+    const void* shader = nullptr;        ///< Programa de shaders.
+    const void* material = nullptr;      ///< Textura difusa (shader resource view).
+    const void* sampler = nullptr;       ///< Sampler de la etapa de píxeles.
+    const void* vertexBuffer = nullptr;  ///< Vertex buffer de la malla.
+    const void* indexBuffer = nullptr;   ///< Index buffer de la malla.
+    unsigned int indexCount = 0;         ///< Número de índices por instancia.
+    unsigned int startIndex = 0;         ///< Primer índice.
+    int baseVertex = 0;                  ///< Desplazamiento de vértices.
+
+    bool
+    operator==(const InstanceKey& other) const {
+        return shader == other.shader && material == other.material && sampler == other.sampler &&
+               vertexBuffer == other.vertexBuffer && indexBuffer == other.indexBuffer &&
+               indexCount == other.indexCount && startIndex == other.startIndex &&
+               baseVertex == other.baseVertex;
+    }
+};
+
+/**
+ * @brief Transformación afín 3x4 de una instancia, tal como la lee el shader.
+ *
+ * Cada fila es una columna de la matriz de mundo (convención fila-vector de XNA Math),
+ * por lo que el shader obtiene la posición en mundo con tres productos punto.
+ */
+struct
+InstanceTransform {
+    float rows[3][4];
+};
+
+/**
+ * @brief Lote de instancias que se dibuja con una sola llamada instanciada.
+ */
+struct
+InstanceBatch {
+    InstanceKey key;                 ///< Geometría y material compartidos.
+    unsigned int firstItem = 0;      ///< Primer elemento (en orden de llegada) del lote.
+    unsigned int firstInstance = 0;  ///< Primera transformación del lote en el instance buffer.
+    unsigned int instanceCount = 0;  ///< Número de instancias del lote.
+};
+
+/**
+ * @brief Agrupa elementos de dibujo que comparten malla y material en lotes instanciados.
+ *
+ * No usa ningún tipo de Direct3D: recibe llaves opacas y matrices de 16 floats y produce
+ * los lotes y el arreglo contiguo de transformaciones a subir al instance buffer.
+ */
+class
+InstanceBatcher {
+public:
+    static constexpr unsigned int kNoBatch = ~0u; ///< El elemento se dibuja sin instanciar.
+
+    InstanceBatcher() = default;
+    ~InstanceBatcher() = default;
+
+    /**
+     * @brief Vacía los elementos y lotes del frame anterior (conserva la memoria reservada).
+     */
+    void
+    clear();
+
+    /**
+     * @brief Agrega un elemento candidato a instanciarse.
+     * @param key Geometría y material del elemento.
+     * @param world Matriz de mundo de 4x4 en orden de filas (XMFLOAT4X4).
+     * @param item Identificador del elemento para el llamador (p. ej. índice del paquete).
+     */
+    void
+    add(const InstanceKey& key, const float* world, unsigned int item);
+
+    /**
+     * @brief Forma los lotes y empaqueta sus transformaciones de forma contigua.
+     * @param minInstances Mínimo de elementos con la misma llave para formar un lote.
+     * @param maxInstances Capacidad del instance buffer; los lotes que no caben no se instancian.
+     */
+    void
+    build(unsigned int minInstances, unsigned int maxInstances);
+
+    /**
+     * @brief Obtiene el lote al que pertenece un elemento.
+     * @param item Identificador usado en add().
+     * @return Índice del lote o kNoBatch.
+     */
+    unsigned int
+    batchOf(unsigned int item) const {
+        return item < m_itemBatch.size() ? m_itemBatch[item] : kNoBatch;
+    }
+
+    const std::vector<InstanceBatch>&
+    getBatches() const { return m_batches; }
+
+    const std::vector<InstanceTransform>&
+    getTransforms() const { return m_transforms; }
+
+private:
+    struct KeyHash {
+        size_t
+        operator()(const InstanceKey& key) const {
+            size_t hash = std::hash<const void*>()(key.vertexBuffer);
+            hash = hash * 31 + std::hash<const void*>()(key.indexBuffer);
+            hash = hash * 31 + std::hash<const void*>()(key.material);
+            hash = hash * 31 + std::hash<const void*>()(key.shader);
+            return hash * 31 + key.startIndex;
+        }
+    };
+
+    /**
+     * @brief Agranda la tabla de grupos al doble y vuelve a insertar las llaves.
+     */
+    void
+    growGroupTable();
+
+    struct Item {
+        unsigned int item;             ///< Identificador del llamador.
+        unsigned int group;            ///< Grupo de llave al que pertenece.
+        InstanceTransform transform;   ///< Transformación ya empaquetada.
+    };
+
+    std::vector<Item> m_items;                                       ///< Elementos del frame.
+    std::vector<InstanceKey> m_groupKeys;                            ///< Llave de cada grupo.
+    std::vector<unsigned int> m_groupTable;                          ///< Llave -> grupo (direccionamiento abierto; conserva su memoria entre frames).
+    std::vector<InstanceBatch> m_batches;                            ///< Lotes formados.
+    std::vector<InstanceTransform> m_transforms;                     ///< Transformaciones por lote.
+    std::vector<unsigned int> m_itemBatch;                           ///< Lote de cada elemento.
+};
+
+/**
+ * @brief Resultado de runInstancingBenchmark().
+ */
+struct
+InstancingBenchmarkResult {
+    unsigned int instances = 0;         ///< Instancias enviadas por frame.
+    unsigned int keys = 0;              ///< Mallas distintas entre las que se reparten.
+    unsigned int batches = 0;           ///< Lotes formados.
+    double submitMs = 0.0;              ///< Tiempo medio por frame de clear() + add() + build().
+    double nsPerInstance = 0.0;         ///< submitMs por instancia, en nanosegundos.
+};
+
+/**
+ * @brief Mide el costo en CPU de agrupar un frame de instancias (sin Direct3D).
+ *
+ * Las instancias se reparten en orden intercalado entre varias llaves sintéticas, con matrices
+ * de mundo fijas, y cada frame se vacía, se llena y se construye el batcher como en RenderQueue.
+ * @param instances Instancias por frame.
+ * @param keys Mallas distintas.
+ * @param frames Frames medidos (después de uno de calentamiento).
+ */
+InstancingBenchmarkResult
+runInstancingBenchmark(unsigned int instances, unsigned int keys, unsigned int frames);
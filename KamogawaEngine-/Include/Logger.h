@@ -0,0 +1,364 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Severidad de un mensaje del log.
+ */
+enum LogSeverity {
+    LOG_SEVERITY_TRACE = 0,
+    LOG_SEVERITY_INFO = 1,
+    LOG_SEVERITY_WARNING = 2,
+    LOG_SEVERITY_ERROR = 3,
+    LOG_SEVERITY_COUNT = 4
+};
+
+/**
+ * @brief Categorías del log (bits combinables en la máscara de filtrado).
+ */
+enum LogCategory {
+    LOG_CATEGORY_CORE = 1 << 0,
+    LOG_CATEGORY_RENDER = 1 << 1,
+    LOG_CATEGORY_RESOURCE = 1 << 2,
+    LOG_CATEGORY_ASSET = 1 << 3,
+    LOG_CATEGORY_UI = 1 << 4,
+    LOG_CATEGORY_ALL = 0xFF
+};
+
+/**
+ * @brief Destinos de escritura del log (bits combinables).
+ */
+enum LogSink {
+    LOG_SINK_DEBUGGER = 1 << 0,     ///< OutputDebugString en Windows, stderr en otras plataformas.
+    LOG_SINK_STDOUT = 1 << 1,
+    LOG_SINK_FILE = 1 << 2
+};
+
+/**
+ * @brief Argumento de un mensaje guardado en binario hasta que el hilo del log lo formatea.
+ */
+struct
+LogArg {
+    enum Type : unsigned char { INT, UINT, DOUBLE, TEXT, POINTER };
+
+    Type type = INT;
+    union {
+        long long i;
+        unsigned long long u;
+        double d;
+        const void* p;
+        unsigned int text;          ///< Desplazamiento del texto dentro de LogRecord::text.
+    };
+};
+
+/**
+ * @brief Mensaje sin formatear: cadena de formato estilo printf más sus argumentos.
+ *
+ * Tamaño fijo para vivir en el buffer circular sin asignar memoria. Los argumentos de texto
+ * se copian a text (se recortan si no caben); la cadena de formato debe ser un literal.
+ */
+struct
+LogRecord {
+    static constexpr unsigned int kMaxArgs = 8;     ///< Argumentos por mensaje.
+    static constexpr unsigned int kTextSize = 352;  ///< Espacio para copiar argumentos de texto.
+
+    long long time = 0;                 ///< Nanosegundos de steady_clock.
+    const char* format = nullptr;       ///< Cadena de formato (literal).
+    unsigned int thread = 0;            ///< Índice del hilo que lo escribió.
+    unsigned char severity = 0;         ///< LogSeverity.
+    unsigned char category = 0;         ///< LogCategory.
+    unsigned char argCount = 0;         ///< Argumentos usados.
+    unsigned char truncated = 0;        ///< Algún argumento de texto no cupo completo.
+    unsigned int textUsed = 0;          ///< Bytes usados en text.
+    LogArg args[kMaxArgs];              ///< Argumentos.
+    char text[kTextSize];               ///< Copia de los argumentos de texto.
+};
+
+/**
+ * @brief Buffer circular de mensajes de un hilo.
+ *
+ * Un productor (el hilo dueño) y un consumidor (el hilo del log) sincronizados solo con los
+ * índices atómicos. Si se llena, los mensajes nuevos se descartan y se cuentan: escribir en
+ * el log nunca bloquea.
+ */
+class
+LogThreadBuffer {
+public:
+    static constexpr unsigned int kCapacity = 1024; ///< Mensajes por hilo (potencia de 2).
+
+public:
+    unsigned int m_thread = 0;                      ///< Índice del hilo.
+    LogRecord m_records[kCapacity];                 ///< Mensajes pendientes.
+    std::atomic<unsigned int> m_write{ 0 };         ///< Siguiente posición a escribir.
+    std::atomic<unsigned int> m_read{ 0 };          ///< Siguiente posición a leer.
+    std::atomic<unsigned int> m_dropped{ 0 };       ///< Mensajes descartados por buffer lleno.
+};
+
+/**
+ * @brief Log asíncrono del motor.
+ *
+ * log() solo copia la cadena de formato y los argumentos en binario al buffer del hilo que
+ * llama; un hilo en segundo plano junta los buffers, ordena los mensajes por tiempo, los
+ * formatea y los escribe en los destinos activos (depurador, salida estándar, archivo).
+ *
+ * El filtrado es en dos niveles: LOG_MIN_SEVERITY elimina en compilación las llamadas de menor
+ * severidad, y setMinSeverity()/setCategories() filtran en ejecución antes de copiar nada.
+ *
+ * Los errores no terminan el programa: se cuentan (getErrorCount()) y despiertan al hilo del
+ * log para que se escriban de inmediato.
+ */
+class
+Logger {
+public:
+    /**
+     * @brief Instancia única del log (el hilo de escritura arranca con la primera llamada).
+     */
+    static Logger&
+    getInstance();
+
+    ~Logger();
+
+    /**
+     * @brief Indica si un mensaje pasaría el filtro de ejecución.
+     */
+    bool
+    isEnabled(LogSeverity severity, unsigned int category) const {
+        return severity >= m_minSeverity.load(std::memory_order_relaxed) &&
+               (category & m_categories.load(std::memory_order_relaxed)) != 0;
+    }
+
+    /**
+     * @brief Escribe un mensaje con formato estilo printf (%d, %u, %x, %f, %s, %p...).
+     * @param severity Severidad.
+     * @param category Categoría.
+     * @param format Cadena de formato; debe ser un literal (se guarda solo el puntero).
+     * @param args Enteros, flotantes, punteros, cadenas C o std::string (hasta kMaxArgs).
+     */
+    template<typename... Args>
+    void
+    log(LogSeverity severity, LogCategory category, const char* format, const Args&... args) {
+        static_assert(sizeof...(Args) <= LogRecord::kMaxArgs, "Too many log arguments");
+        LogThreadBuffer& buffer = getThreadBuffer();
+        const unsigned int write = buffer.m_write.load(std::memory_order_relaxed);
+        if (write - buffer.m_read.load(std::memory_order_acquire) >= LogThreadBuffer::kCapacity) {
+            buffer.m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        LogRecord& record = buffer.m_records[write & (LogThreadBuffer::kCapacity - 1)];
+        record.time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        record.format = format;
+        record.thread = buffer.m_thread;
+        record.severity = static_cast<unsigned char>(severity);
+        record.category = static_cast<unsigned char>(category);
+        record.argCount = 0;
+        record.truncated = 0;
+        record.textUsed = 0;
+        int expand[] = { 0, (encodeArg(record, args), 0)... };
+        (void)expand;
+        buffer.m_write.store(write + 1, std::memory_order_release);
+
+        if (severity >= LOG_SEVERITY_ERROR) {
+            m_errorCount.fetch_add(1, std::memory_order_relaxed);
+            m_wakeSignal.notify_one();
+        }
+    }
+
+    /**
+     * @brief Severidad mínima que se escribe.
+     */
+    void
+    setMinSeverity(LogSeverity severity) { m_minSeverity.store(severity, std::memory_order_relaxed); }
+
+    /**
+     * @brief Máscara de categorías que se escriben (combinación de LogCategory).
+     */
+    void
+    setCategories(unsigned int categories) { m_categories.store(categories, std::memory_order_relaxed); }
+
+    /**
+     * @brief Destinos activos (combinación de LogSink).
+     */
+    void
+    setSinks(unsigned int sinks) { m_sinks.store(sinks, std::memory_order_relaxed); }
+
+    unsigned int
+    getSinks() const { return m_sinks.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Abre el archivo del log y activa LOG_SINK_FILE.
+     * @param path Ruta del archivo (se sobrescribe).
+     * @return true si se pudo abrir.
+     */
+    bool
+    openFile(const std::string& path);
+
+    /**
+     * @brief Espera a que todos los mensajes escritos hasta ahora estén en los destinos.
+     */
+    void
+    flush();
+
+    /**
+     * @brief Escribe lo pendiente, detiene el hilo del log y cierra el archivo.
+     *        Los mensajes posteriores vuelven a arrancar el hilo.
+     */
+    void
+    shutdown();
+
+    /**
+     * @brief Errores registrados desde el inicio.
+     */
+    unsigned int
+    getErrorCount() const { return m_errorCount.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Mensajes descartados por buffers llenos.
+     */
+    unsigned int
+    getDroppedRecords() const;
+
+private:
+    Logger();
+
+    /**
+     * @brief Buffer del hilo actual; lo registra y arranca el hilo del log la primera vez.
+     */
+    LogThreadBuffer&
+    getThreadBuffer();
+
+    /**
+     * @brief Copia un argumento al mensaje según su tipo.
+     */
+    template<typename T>
+    static void
+    encodeArg(LogRecord& record, const T& value) {
+        LogArg& arg = record.args[record.argCount++];
+        if constexpr (std::is_same<T, std::string>::value) {
+            encodeText(record, arg, value.c_str(), value.size());
+        }
+        else if constexpr (std::is_convertible<const T&, const char*>::value) {
+            const char* text = value;
+            encodeText(record, arg, text, text ? strlen(text) : 0);
+        }
+        else if constexpr (std::is_floating_point<T>::value) {
+            arg.type = LogArg::DOUBLE;
+            arg.d = static_cast<double>(value);
+        }
+        else if constexpr (std::is_enum<T>::value || std::is_signed<T>::value) {
+            arg.type = LogArg::INT;
+            arg.i = static_cast<long long>(value);
+        }
+        else if constexpr (std::is_integral<T>::value) {
+            arg.type = LogArg::UINT;
+            arg.u = static_cast<unsigned long long>(value);
+        }
+        else {
+            static_assert(std::is_pointer<T>::value, "Unsupported log argument type");
+            arg.type = LogArg::POINTER;
+            arg.p = value;
+        }
+    }
+
+    /**
+     * @brief Copia un texto al espacio del mensaje (recortado si no cabe).
+     */
+    static void
+    encodeText(LogRecord& record, LogArg& arg, const char* text, size_t length);
+
+    /**
+     * @brief Bucle del hilo del log.
+     */
+    void
+    sinkLoop();
+
+    /**
+     * @brief Formatea y escribe los mensajes pendientes de todos los hilos.
+     */
+    void
+    drain();
+
+    /**
+     * @brief Escribe una línea formateada en los destinos activos.
+     */
+    void
+    writeLine(const std::string& line);
+
+private:
+    mutable std::mutex m_registryMutex;                         ///< Protege el registro de hilos y el arranque.
+    std::vector<std::unique_ptr<LogThreadBuffer>> m_buffers;    ///< Buffer de cada hilo registrado.
+
+    std::atomic<int> m_minSeverity{ LOG_SEVERITY_TRACE };       ///< Filtro de severidad.
+    std::atomic<unsigned int> m_categories{ LOG_CATEGORY_ALL }; ///< Filtro de categorías.
+    std::atomic<unsigned int> m_sinks{ LOG_SINK_DEBUGGER };     ///< Destinos activos.
+    std::atomic<unsigned int> m_errorCount{ 0 };                ///< Errores registrados.
+
+    std::thread m_sinkThread;                                   ///< Hilo que formatea y escribe.
+    std::mutex m_sinkMutex;                                     ///< Protege el archivo y las esperas.
+    std::condition_variable m_wakeSignal;                       ///< Despierta al hilo del log.
+    std::condition_variable m_flushedSignal;                    ///< Avisa que terminó una pasada.
+    unsigned long long m_flushRequest = 0;                      ///< Pasadas pedidas por flush().
+    unsigned long long m_flushDone = 0;                         ///< Pasadas completadas.
+    std::atomic<bool> m_running{ false };                       ///< El hilo del log está activo.
+    bool m_quit = false;                                        ///< Pide al hilo terminar.
+    FILE* m_file = nullptr;                                     ///< Archivo del log.
+    std::string m_line;                                         ///< Línea en formateo (solo el hilo del log).
+    long long m_startTime = 0;                                  ///< Tiempo de creación del log (ns).
+};
+
+/**
+ * @brief Resultado de runLoggerBenchmark().
+ */
+struct
+LoggerBenchmarkResult {
+    unsigned int threads = 0;           ///< Hilos escribiendo a la vez.
+    unsigned long long calls = 0;       ///< Llamadas medidas en total.
+    double nsPerCall = 0.0;             ///< Tiempo medio de log() por llamada en cada hilo.
+    unsigned int dropped = 0;           ///< Mensajes descartados durante la medición.
+};
+
+/**
+ * @brief Mide log() con varios hilos escribiendo a la vez.
+ *
+ * Cada hilo escribe ráfagas de la mitad de su buffer (un entero, un flotante y una cadena) y
+ * espera con flush() fuera de la medición, así se mide el camino que copia el mensaje y no el
+ * que lo descarta. Los destinos se apagan durante la medición (el hilo del log sigue
+ * formateando) y se restauran al terminar.
+ * @param threads Hilos escribiendo.
+ * @param callsPerThread Llamadas de cada hilo.
+ */
+LoggerBenchmarkResult
+runLoggerBenchmark(unsigned int threads, unsigned int callsPerThread);
+
+// Severidad mínima compilada: las llamadas por debajo desaparecen del binario
+#ifndef LOG_MIN_SEVERITY
+#ifdef _DEBUG
+#define LOG_MIN_SEVERITY 0
+#else
+#define LOG_MIN_SEVERITY 1
+#endif
+#endif
+
+/** Escribe un mensaje en el log si pasa el filtro de compilación y de ejecución. */
+#define LOG(severity, category, ...)                                                    \
+do {                                                                                    \
+    if ((severity) >= LOG_MIN_SEVERITY &&                                               \
+        Logger::getInstance().isEnabled(severity, category)) {                          \
+        Logger::getInstance().log(severity, category, __VA_ARGS__);                     \
+    }                                                                                   \
+} while (0)
+
+#define LOG_TRACE(category, ...)   LOG(LOG_SEVERITY_TRACE, category, __VA_ARGS__)
+#define LOG_INFO(category, ...)    LOG(LOG_SEVERITY_INFO, category, __VA_ARGS__)
+#define LOG_WARNING(category, ...) LOG(LOG_SEVERITY_WARNING, category, __VA_ARGS__)
+#define LOG_ERROR(category, ...)   LOG(LOG_SEVERITY_ERROR, category, __VA_ARGS__)
@@ -0,0 +1,245 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+// En Debug se guardan estadísticas por punto de llamada; en el resto solo contadores por etiqueta
+#if defined(_DEBUG) && !defined(MEMORY_TRACK_CALLSITES)
+#define MEMORY_TRACK_CALLSITES
+#endif
+
+/**
+ * @brief Etiqueta de memoria: agrupa las reservas por sistema.
+ */
+enum MemoryTag {
+    MEMORY_TAG_GENERAL = 0,
+    MEMORY_TAG_MESH = 1,
+    MEMORY_TAG_TEXTURE = 2,
+    MEMORY_TAG_ECS = 3,
+    MEMORY_TAG_UI = 4,
+    MEMORY_TAG_ANIMATION = 5,
+    MEMORY_TAG_COUNT = 6
+};
+
+/**
+ * @brief Uso de memoria de una etiqueta.
+ */
+struct
+MemoryTagStats {
+    long long bytes = 0;                        ///< Bytes vivos.
+    long long peakBytes = 0;                    ///< Mayor número de bytes vivos.
+    long long allocations = 0;                  ///< Reservas vivas.
+    unsigned long long totalAllocations = 0;    ///< Reservas desde el inicio.
+    unsigned long long budget = 0;              ///< Presupuesto en bytes (0 = sin límite).
+};
+
+/**
+ * @brief Uso de memoria de un punto de llamada (solo con MEMORY_TRACK_CALLSITES).
+ *
+ * Las reservas explícitas se identifican por archivo y línea; las de contenedores con
+ * TrackedAllocator, por el tipo de elemento (line = 0).
+ */
+struct
+MemoryCallSite {
+    const char* file = "";
+    unsigned int line = 0;
+    MemoryTag tag = MEMORY_TAG_GENERAL;
+    long long bytes = 0;
+    long long peakBytes = 0;
+    long long allocations = 0;
+    unsigned long long totalAllocations = 0;
+};
+
+/**
+ * @brief Contabilidad de memoria por etiqueta, con presupuestos y reporte en JSON.
+ *
+ * Registrar una reserva en Release son tres operaciones atómicas sobre la línea de caché de
+ * su etiqueta. Con MEMORY_TRACK_CALLSITES además se guarda el punto de llamada de cada
+ * dirección viva (bajo un mutex) para atribuir la liberación a quien reservó.
+ */
+class
+MemoryTracker {
+public:
+    /**
+     * @brief Instancia única. No se destruye: hay memoria que se libera en la destrucción
+     *        estática (actores de la aplicación global).
+     */
+    static MemoryTracker&
+    getInstance();
+
+    static const char*
+    getTagName(MemoryTag tag);
+
+    void
+    recordAllocation(MemoryTag tag, const void* memory, size_t bytes, const char* file, unsigned int line) {
+        TagCounters& counters = m_tags[tag];
+        const long long now = counters.bytes.fetch_add(static_cast<long long>(bytes), std::memory_order_relaxed) +
+                              static_cast<long long>(bytes);
+        counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+        long long peak = counters.peakBytes.load(std::memory_order_relaxed);
+        while (now > peak && !counters.peakBytes.compare_exchange_weak(peak, now, std::memory_order_relaxed)) {
+        }
+#ifdef MEMORY_TRACK_CALLSITES
+        recordSite(tag, memory, bytes, file, line);
+#else
+        (void)memory; (void)file; (void)line;
+#endif
+    }
+
+    void
+    recordFree(MemoryTag tag, const void* memory, size_t bytes) {
+        TagCounters& counters = m_tags[tag];
+        counters.bytes.fetch_sub(static_cast<long long>(bytes), std::memory_order_relaxed);
+        counters.allocations.fetch_sub(1, std::memory_order_relaxed);
+#ifdef MEMORY_TRACK_CALLSITES
+        releaseSite(memory, bytes);
+#else
+        (void)memory;
+#endif
+    }
+
+    /**
+     * @brief Fija el presupuesto de una etiqueta (0 = sin límite).
+     */
+    void
+    setBudget(MemoryTag tag, unsigned long long bytes) {
+        m_tags[tag].budget.store(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Avisa en el log de las etiquetas que acaban de superar su presupuesto (una vez
+     *        por exceso; el aviso se rearma al volver por debajo).
+     * @return Etiquetas por encima de su presupuesto.
+     */
+    unsigned int
+    checkBudgets();
+
+    MemoryTagStats
+    getTagStats(MemoryTag tag) const;
+
+    /**
+     * @brief Llamadas al operator new global hechas por el hilo actual desde que empezó.
+     *
+     * MemoryTracker.cpp reemplaza el operator new del programa solo para contarlas (la memoria
+     * sigue saliendo de malloc). Las variantes con alineación explícita no se cuentan.
+     */
+    static unsigned long long
+    getThreadHeapAllocations();
+
+    /**
+     * @brief Puntos de llamada ordenados por bytes vivos (vacío sin MEMORY_TRACK_CALLSITES).
+     */
+    std::vector<MemoryCallSite>
+    getCallSites() const;
+
+    /**
+     * @brief Escribe etiquetas, presupuestos y puntos de llamada en un archivo JSON.
+     */
+    bool
+    writeReport(const std::string& path) const;
+
+private:
+    MemoryTracker() = default;
+
+    struct alignas(64) TagCounters {
+        std::atomic<long long> bytes{ 0 };
+        std::atomic<long long> peakBytes{ 0 };
+        std::atomic<long long> allocations{ 0 };
+        std::atomic<unsigned long long> totalAllocations{ 0 };
+        std::atomic<unsigned long long> budget{ 0 };
+        bool overBudget = false;    ///< Ya se avisó del exceso actual (solo checkBudgets()).
+    };
+
+#ifdef MEMORY_TRACK_CALLSITES
+    void
+    recordSite(MemoryTag tag, const void* memory, size_t bytes, const char* file, unsigned int line);
+
+    void
+    releaseSite(const void* memory, size_t bytes);
+
+    mutable std::mutex m_siteMutex;                             ///< Protege los puntos de llamada.
+    std::vector<MemoryCallSite> m_sites;                        ///< Puntos de llamada conocidos.
+    std::map<std::tuple<const char*, unsigned int, int>, size_t> m_siteIndex;  ///< (archivo, línea, etiqueta) -> índice.
+    std::unordered_map<const void*, size_t> m_liveSites;        ///< Dirección viva -> índice en m_sites.
+#endif
+
+    TagCounters m_tags[MEMORY_TAG_COUNT];                       ///< Contadores por etiqueta.
+};
+
+/**
+ * @brief malloc/free/realloc contabilizados en una etiqueta, para bibliotecas que solo dan el
+ *        puntero al liberar (stb_image, ImGui). Guardan el tamaño en un encabezado de 16 bytes.
+ */
+void*
+trackedMalloc(MemoryTag tag, size_t bytes, const char* file, unsigned int line);
+
+void
+trackedFree(MemoryTag tag, void* memory);
+
+void*
+trackedRealloc(MemoryTag tag, void* memory, size_t bytes, const char* file, unsigned int line);
+
+/**
+ * @brief Asignador para contenedores que contabiliza su memoria en la etiqueta Tag.
+ */
+template<typename T, MemoryTag Tag>
+class
+TrackedAllocator {
+public:
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind {
+        typedef TrackedAllocator<U, Tag> other;
+    };
+
+    TrackedAllocator() = default;
+
+    template<typename U>
+    TrackedAllocator(const TrackedAllocator<U, Tag>&) {}
+
+    T*
+    allocate(size_t count) {
+        T* memory = std::allocator<T>().allocate(count);
+#ifdef MEMORY_TRACK_CALLSITES
+        MemoryTracker::getInstance().recordAllocation(Tag, memory, count * sizeof(T), typeid(T).name(), 0);
+#else
+        MemoryTracker::getInstance().recordAllocation(Tag, memory, count * sizeof(T), nullptr, 0);
+#endif
+        return memory;
+    }
+
+    void
+    deallocate(T* memory, size_t count) {
+        MemoryTracker::getInstance().recordFree(Tag, memory, count * sizeof(T));
+        std::allocator<T>().deallocate(memory, count);
+    }
+
+    template<typename U>
+    bool
+    operator==(const TrackedAllocator<U, Tag>&) const { return true; }
+
+    template<typename U>
+    bool
+    operator!=(const TrackedAllocator<U, Tag>&) const { return false; }
+};
+
+/** Vector contabilizado en una etiqueta de memoria. */
+template<typename T, MemoryTag Tag>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+
+/**
+ * Registra reservas y liberaciones hechas fuera de un asignador contabilizado.
+ */
+#define MEMORY_TRACK_ALLOC(tag, memory, bytes) \
+    MemoryTracker::getInstance().recordAllocation((tag), (memory), (bytes), __FILE__, __LINE__)
+#define MEMORY_TRACK_FREE(tag, memory, bytes) \
+    MemoryTracker::getInstance().recordFree((tag), (memory), (bytes))
@@ -2,14 +2,28 @@
 #include "Prerequisites.h"
 #include "DeviceContext.h"
 #include "ECS/Component.h"
+#include "Animation.h"
+#include "VertexFormat.h"
 
 /**
- * @brief Representa una malla bsica que contiene vrtices e ndices.
+ * @brief Rango de una malla que se dibuja con su propio vértice base (índices de 16 bits).
+ */
+struct
+MeshChunk {
+	unsigned int startIndex = 0;  ///< Primer índice del trozo en el index buffer.
+	unsigned int indexCount = 0;  ///< Índices del trozo.
+	int baseVertex = 0;           ///< Primer vértice del trozo; sus índices en GPU son relativos a él.
+};
+
+/**
+ * @brief Representa una malla básica que contiene vértices e índices.
  *
- * Esta clase almacena la geometra necesaria para representar un modelo 3D simple.
+ * Esta clase almacena la geometría necesaria para representar un modelo 3D simple.
  */
 class 
 MeshComponent : public Component {
+	DECLARE_POOL_ALLOCATION(MeshComponent, MEMORY_TAG_ECS)
+
 public:
 	MeshComponent() : m_numVertex(0), m_numIndex(0), Component(ComponentType::MESH) {}
 	
@@ -24,8 +38,17 @@ public:
 
 public:
 	std::string m_name;                       ///< Nombre identificador de la malla.
-	std::vector<SimpleVertex> m_vertex;       ///< Lista de vrtices que componen la malla.
-	std::vector<unsigned int> m_index;        ///< Lista de ndices para definir la topologa.
-	int m_numVertex;                          ///< Nmero total de vrtices.
-	int m_numIndex;                           ///< Nmero total de ndices.
+	TrackedVector<SimpleVertex, MEMORY_TAG_MESH> m_vertex;   ///< Lista de vértices que componen la malla.
+	TrackedVector<unsigned int, MEMORY_TAG_MESH> m_index;    ///< Lista de índices para definir la topología.
+	TrackedVector<VertexSkin, MEMORY_TAG_MESH> m_skin;       ///< Influencias de huesos por vértice (vacío sin skin).
+	VertexFormat m_format = VertexFormat::standard();        ///< Disposición en el vertex buffer; debe coincidir con el input layout del shader.
+	DXGI_FORMAT m_indexFormat = DXGI_FORMAT_R32_UINT;        ///< Ancho de los índices en el index buffer (ver selectIndexFormat()).
+	std::vector<MeshChunk> m_chunks;                         ///< Trozos de una malla partida para índices de 16 bits (vacío = un solo dibujo).
+	int m_numVertex;                          ///< Número total de vértices.
+	int m_numIndex;                           ///< Número total de índices.
+
+	XMFLOAT3 m_boundsMin = XMFLOAT3(0.0f, 0.0f, 0.0f);     ///< Esquina mínima del AABB en espacio local.
+	XMFLOAT3 m_boundsMax = XMFLOAT3(0.0f, 0.0f, 0.0f);     ///< Esquina máxima del AABB en espacio local.
+	XMFLOAT3 m_sphereCenter = XMFLOAT3(0.0f, 0.0f, 0.0f);  ///< Centro de la esfera envolvente local.
+	float m_sphereRadius = 0.0f;                           ///< Radio de la esfera envolvente local.
 };
@@ -1,16 +1,25 @@
 #pragma once
 #include "Prerequisites.h"
 #include "MeshComponent.h"
+#include "AnimationCompression.h"
 #include "fbxsdk.h"
 
+class TextureAtlas;
+
 /**
  * @brief Clase encargada de cargar modelos 3D en formato FBX y OBJ.
  *
  * Procesa nodos, mallas, y materiales para convertirlos en MeshComponents utilizables por el motor.
+ * De los FBX con skin importa además el esqueleto, las influencias por vértice y las pilas de
+ * animación (muestreadas a kAnimationSampleRate y comprimidas con animationCompression).
+ * Cada malla se empaqueta en el formato de vertexQuantization salvo los atributos que superan
+ * su error admitido, que quedan en floats.
  */
 class
 ModelLoader {
 public:
+    static constexpr float kAnimationSampleRate = 30.0f;   ///< Muestras por segundo de los clips importados.
+
     /**
      * @brief Constructor por defecto.
      */
@@ -23,7 +32,7 @@ public:
 
     /**
      * @brief Inicializa el gestor de FBX (FbxManager).
-     * @return true si la inicializacin fue exitosa, false en caso contrario.
+     * @return true si la inicialización fue exitosa, false en caso contrario.
      */
     bool
     InitializeFBXManager();
@@ -72,11 +81,92 @@ public:
     std::vector<std::string>
         GetTextureFileNames() const { return textureFileNames; }
 
+    /**
+     * @brief Vuelve a elegir el formato de vértice después de que un atlas reescribió las UVs.
+     *
+     * Las UVs empaquetadas quedan en espacio de la página, así que el error de UV de esas mallas
+     * se limita a un cuarto de texel de su página. Registra en el log el error de los datos que
+     * se suben.
+     * @param filePath Archivo del modelo (para el log).
+     * @param atlas Atlas construido sobre meshes.
+     */
+    void
+    RefitVertexFormats(const std::string& filePath, const TextureAtlas& atlas);
+
+private:
+    /**
+     * @brief Agrega a skeleton los nodos de tipo esqueleto del subárbol (padres antes que hijos).
+     * @param node Raíz del subárbol.
+     */
+    void
+    ProcessFBXSkeleton(FbxNode* node);
+
+    /**
+     * @brief Índice del hueso de un nodo; lo agrega al esqueleto si todavía no está.
+     * @param node Nodo del hueso.
+     * @return Índice en skeleton.bones.
+     */
+    int
+    AddFBXBone(FbxNode* node);
+
+    /**
+     * @brief Lee los clusters de los deformadores FbxSkin de la malla: matrices de enlace de
+     *        los huesos e influencias por punto de control (cuantizadas en mesh.m_skin).
+     * @param fbxMesh Malla FBX.
+     * @param mesh Malla del motor con un vértice por punto de control.
+     */
+    void
+    ProcessFBXSkin(FbxMesh* fbxMesh, MeshComponent& mesh);
+
+    /**
+     * @brief Muestrea cada pila de animación de la escena sobre los huesos del esqueleto y la comprime.
+     */
+    void
+    ProcessFBXAnimations();
+
+    /**
+     * @brief Completa normales y genera las tangentes de todas las mallas cargadas, en paralelo.
+     * @param filePath Archivo del modelo (para el log).
+     */
+    void
+    ProcessTangentSpaces(const std::string& filePath);
+
+    /**
+     * @brief Elige el formato de vértice de cada malla según vertexQuantization y registra en el
+     *        log el error y la memoria de los vertex buffers resultantes.
+     * @param filePath Archivo del modelo (para el log).
+     * @param maxTexcoordErrors Error de UV admitido por malla; vacío = el de vertexQuantization.
+     */
+    void
+    ProcessVertexFormats(const std::string& filePath,
+                         const std::vector<float>& maxTexcoordErrors = std::vector<float>());
+
+    /**
+     * @brief Elige el ancho de índices de cada malla (16 bits si sus vértices caben; las más
+     *        grandes se parten en trozos si splitForShortIndices) y registra la memoria en el log.
+     * @param filePath Archivo del modelo (para el log).
+     */
+    void
+    ProcessIndexFormats(const std::string& filePath);
+
+    /**
+     * @brief Calcula el AABB y la esfera envolvente de una malla en espacio local.
+     * @param mesh Malla con sus vértices ya cargados.
+     */
+    void
+    ComputeMeshBounds(MeshComponent& mesh);
+
 private:
     FbxManager* lSdkManager;               ///< Gestor de FBX utilizado para cargar y administrar escenas.
     FbxScene* lScene;                      ///< Escena cargada en memoria del archivo FBX.
     std::vector<std::string> textureFileNames; ///< Lista de nombres de texturas encontradas en el modelo.
+    std::vector<FbxNode*> boneNodes;       ///< Nodo FBX de cada hueso de skeleton.
 
 public:
     std::vector<MeshComponent> meshes;     ///< Lista de componentes de malla generados a partir del modelo cargado.
+    Skeleton skeleton;                     ///< Huesos del modelo (vacío si no tiene skin).
+    std::vector<CompressedAnimationClip> animations; ///< Clips de animación comprimidos del modelo.
+    AnimationCompressionSettings animationCompression; ///< Parámetros de compresión de los clips.
+    VertexQuantizationSettings vertexQuantization;     ///< Formato buscado y errores admitidos de los vértices.
+    bool splitForShortIndices = false;                 ///< Parte las mallas de más de 65536 vértices para usar índices de 16 bits.
 };
@@ -0,0 +1,196 @@
+#pragma once
+#include "Prerequisites.h"
+#include <mutex>
+#include <condition_variable>
+
+struct AABB;
+
+/**
+ * @brief Contadores del último frame de occlusion culling.
+ */
+struct
+OcclusionStats {
+    unsigned int occluderTriangles = 0;    ///< Triángulos de oclusores recibidos.
+    unsigned int rasterizedTriangles = 0;  ///< Triángulos que llegaron al rasterizador (tras recorte y caras traseras).
+    unsigned int tested = 0;               ///< Cajas probadas.
+    unsigned int occluded = 0;             ///< Cajas completamente ocultas.
+    double rasterTimeMs = 0.0;             ///< Tiempo de rasterización en milisegundos.
+};
+
+/**
+ * @brief Rasterizador de profundidad por software para descartar objetos ocultos antes de dibujarlos.
+ *
+ * Las mallas oclusoras se transforman y rasterizan en un buffer de profundidad de baja resolución
+ * (profundidad z/w de Direct3D, 0 = cerca). El buffer se divide en franjas horizontales que se
+ * rasterizan en paralelo en hilos de trabajo; cada fila se recorre de 8 en 8 píxeles con AVX2
+ * (o con código escalar si el procesador no lo soporta). Después se construye una Z jerárquica
+ * con la profundidad más lejana de cada bloque de 8x8 píxeles.
+ *
+ * Una caja está oculta si en todo el rectángulo que cubre en pantalla la profundidad rasterizada
+ * es menor que la profundidad más cercana de la caja. Las cajas que cruzan el plano cercano se
+ * consideran visibles.
+ */
+class
+OcclusionCuller {
+public:
+    static constexpr unsigned int kTileSize = 8;   ///< Lado de los bloques de la Z jerárquica.
+
+    OcclusionCuller() = default;
+    ~OcclusionCuller() { destroy(); }
+
+    /**
+     * @brief Reserva el buffer de profundidad y arranca los hilos de trabajo.
+     * @param width Ancho en píxeles (se redondea a múltiplo de 8).
+     * @param height Alto en píxeles (se redondea a múltiplo de 8).
+     * @param workerCount Hilos adicionales al que llama a rasterize() (0 = solo el hilo actual).
+     * @return HRESULT Resultado de la operación.
+     */
+    HRESULT
+    init(unsigned int width, unsigned int height, unsigned int workerCount);
+
+    /**
+     * @brief Detiene los hilos de trabajo y libera la memoria.
+     */
+    void
+    destroy();
+
+    /**
+     * @brief Inicia un frame: guarda la cámara y vacía la lista de triángulos.
+     * @param viewProjection Producto vista * proyección del frame.
+     */
+    void
+    begin(const XMMATRIX& viewProjection);
+
+    /**
+     * @brief Agrega una malla oclusora.
+     * @param positions Primera posición (XMFLOAT3) de los vértices.
+     * @param stride Distancia en bytes entre posiciones consecutivas.
+     * @param vertexCount Número de vértices.
+     * @param indices Índices de la lista de triángulos.
+     * @param indexCount Número de índices.
+     * @param world Matriz de mundo de la malla.
+     */
+    void
+    addOccluder(const void* positions,
+                unsigned int stride,
+                unsigned int vertexCount,
+                const unsigned int* indices,
+                unsigned int indexCount,
+                const XMMATRIX& world);
+
+    /**
+     * @brief Rasteriza los oclusores agregados y construye la Z jerárquica.
+     */
+    void
+    rasterize();
+
+    /**
+     * @brief Prueba una caja en mundo contra el buffer rasterizado.
+     * @param box Caja a probar.
+     * @return true si la caja puede ser visible.
+     */
+    bool
+    isVisible(const AABB& box);
+
+    /**
+     * @brief Profundidad rasterizada de un píxel (para depuración).
+     */
+    float
+    getDepth(unsigned int x, unsigned int y) const { return m_depth[y * m_width + x]; }
+
+    unsigned int
+    getWidth() const { return m_width; }
+
+    unsigned int
+    getHeight() const { return m_height; }
+
+    const OcclusionStats&
+    getStats() const { return m_stats; }
+
+private:
+    /**
+     * @brief Triángulo en espacio de pantalla listo para rasterizar.
+     */
+    struct ScreenTriangle {
+        float edgeA[3], edgeB[3], edgeC[3];   ///< Funciones de borde A*x + B*y + C (>= 0 dentro).
+        float depthA, depthB, depthC;         ///< Plano de profundidad z = A*x + B*y + C.
+        int minX, minY, maxX, maxY;           ///< Rectángulo de píxeles que cubre (inclusivo).
+    };
+
+    /**
+     * @brief Recorta un triángulo en espacio de clip contra el plano cercano y lo configura.
+     */
+    void
+    setupTriangle(const XMFLOAT4& v0, const XMFLOAT4& v1, const XMFLOAT4& v2);
+
+    /**
+     * @brief Agrega un triángulo ya proyectado (x, y en píxeles, z en [0, 1]).
+     */
+    void
+    addScreenTriangle(const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2);
+
+    /**
+     * @brief Rasteriza todos los triángulos dentro de una franja de filas y actualiza su Z jerárquica.
+     */
+    void
+    rasterizeBand(unsigned int band);
+
+    void
+    rasterizeRowsAVX2(const ScreenTriangle& triangle, int firstRow, int lastRow);
+
+    void
+    rasterizeRowsScalar(const ScreenTriangle& triangle, int firstRow, int lastRow);
+
+    /**
+     * @brief Bucle de los hilos de trabajo.
+     */
+    void
+    workerLoop(unsigned int band);
+
+private:
+    unsigned int m_width = 0;                   ///< Ancho del buffer.
+    unsigned int m_height = 0;                  ///< Alto del buffer.
+    unsigned int m_tilesX = 0;                  ///< Bloques de la Z jerárquica por fila.
+    unsigned int m_tilesY = 0;                  ///< Filas de bloques.
+    std::vector<float> m_depth;                 ///< Profundidad por píxel.
+    std::vector<float> m_hiZ;                   ///< Profundidad más lejana de cada bloque.
+    std::vector<ScreenTriangle> m_triangles;    ///< Triángulos del frame.
+    std::vector<XMFLOAT4> m_clipVertices;       ///< Vértices transformados de la malla actual.
+    XMMATRIX m_viewProjection;                  ///< Cámara del frame.
+    unsigned int m_bandCount = 1;               ///< Franjas (hilos de trabajo + 1).
+    OcclusionStats m_stats;                     ///< Contadores.
+
+    std::vector<std::thread> m_workers;         ///< Hilos de trabajo (uno por franja extra).
+    std::mutex m_mutex;                         ///< Protege el estado compartido con los hilos.
+    std::condition_variable m_startSignal;      ///< Despierta a los hilos al iniciar un frame.
+    std::condition_variable m_doneSignal;       ///< Avisa que todas las franjas terminaron.
+    unsigned int m_generation = 0;              ///< Frame de rasterización actual.
+    unsigned int m_pendingBands = 0;            ///< Franjas de hilos aún en proceso.
+    bool m_quit = false;                        ///< Pide a los hilos terminar.
+};
+
+/**
+ * @brief Resultado de runOcclusionBenchmark().
+ */
+struct
+OcclusionBenchmarkResult {
+    unsigned int width = 0;                ///< Ancho del buffer de profundidad.
+    unsigned int height = 0;               ///< Alto del buffer de profundidad.
+    unsigned int occluderTriangles = 0;    ///< Triángulos de oclusores por frame.
+    unsigned int rasterizedTriangles = 0;  ///< Triángulos que llegaron al rasterizador.
+    unsigned int tested = 0;               ///< Cajas probadas por frame.
+    unsigned int occluded = 0;             ///< Cajas ocultas en el último frame.
+    double rasterTimeMs = 0.0;             ///< Promedio de OcclusionStats::rasterTimeMs por frame.
+    double testNsPerBox = 0.0;             ///< Tiempo medio de isVisible() por caja.
+};
+
+/**
+ * @brief Mide el rasterizador con una escena sintética (semilla fija): cubos oclusores entre 10
+ *        y 30 unidades delante de la cámara y cajas de prueba entre 5 y 100 unidades.
+ * @param culler Culler a medir (ya inicializado, con sus hilos de trabajo).
+ * @param occluders Cubos oclusores (12 triángulos cada uno).
+ * @param boxes Cajas probadas por frame.
+ * @param frames Frames medidos.
+ */
+OcclusionBenchmarkResult
+runOcclusionBenchmark(OcclusionCuller& culler, unsigned int occluders, unsigned int boxes, unsigned int frames);
@@ -1,26 +1,34 @@
 #pragma once
 
-// Libreras estndar
+// Librerías estándar
 #include <string>
 #include <sstream>
 #include <vector>
+#ifndef NOMINMAX
+#define NOMINMAX // std::min / std::max en lugar de las macros de windows.h
+#endif
 #include <windows.h>
 #include <xnamath.h>
 //#include <memory>
 #include <thread>
 
-// Libreras DirectX
+// Librerías DirectX
 #include <d3d11.h>
+#include <d3d11_1.h>
 #include <d3dx11.h>
 #include <d3dcompiler.h>
 #include "Resource.h"
 #include "resource.h"
 
 // Third Parties
+#include "MemoryTracker.h"
 #include "Utilities\Memory\TSharedPointer.h"
 #include "Utilities\Memory\TWeakPointer.h"
 #include "Utilities\Memory\TStaticPtr.h"
 #include "Utilities\Memory\TUniquePtr.h"
+#include "Utilities\Memory\TObjectPool.h"
+#include "Profiler.h"
+#include "Logger.h"
 
 /**
  * Macro para liberar recursos de DirectX de forma segura.
@@ -29,45 +37,58 @@
 #define SAFE_RELEASE(x) if(x != nullptr) x->Release(); x = nullptr;
 
  /**
-  * Macro para imprimir mensajes de depuracin sobre la creacin de recursos.
+  * Macro para imprimir mensajes de depuración sobre la creación de recursos.
+  * Se escribe en el log asíncrono (categoría Resource); state admite encadenar con <<.
   *
   * @param classObj Nombre de la clase que llama.
-  * @param method Nombre del mtodo donde se ejecuta.
-  * @param state Estado de la creacin del recurso.
+  * @param method Nombre del método donde se ejecuta.
+  * @param state Estado de la creación del recurso.
   */
 #define MESSAGE( classObj, method, state )   \
 {                                            \
-   std::wostringstream os_;                  \
-   os_ << classObj << "::" << method << " : " << "[CREACIN DE RECURSO " << ": " << state << "] \n"; \
-   OutputDebugStringW( os_.str().c_str() );  \
+   if (LOG_SEVERITY_INFO >= LOG_MIN_SEVERITY && \
+       Logger::getInstance().isEnabled(LOG_SEVERITY_INFO, LOG_CATEGORY_RESOURCE)) { \
+      std::ostringstream os_;                \
+      os_ << state;                          \
+      Logger::getInstance().log(LOG_SEVERITY_INFO, LOG_CATEGORY_RESOURCE, \
+         "%s::%s : [CREACIÓN DE RECURSO : %s]", classObj, method, os_.str()); \
+   }                                         \
 }
 
   /**
-   * Macro para registrar errores en la depuracin y terminar la ejecucin.
+   * Macro para registrar errores en el log asíncrono.
    *
-   * @param classObj Nombre de la clase donde ocurri el error.
-   * @param method Mtodo en el que ocurri el error.
+   * No termina la ejecución: quien la llama debe devolver el error y el log cuenta los errores
+   * (Logger::getErrorCount()).
+   *
+   * @param classObj Nombre de la clase donde ocurrió el error.
+   * @param method Método en el que ocurrió el error.
    * @param errorMSG Mensaje descriptivo del error.
    */
 #define ERROR( classObj, method, errorMSG )  \
 {                                            \
-   std::wostringstream os_;                  \
-   os_ << "ERROR : " << classObj << "::" << method << " : " << "  Error en los datos de los parmetros [" << errorMSG << "] \n"; \
-   OutputDebugStringW( os_.str().c_str() );  \
-   exit(1);                                  \
+   std::ostringstream os_;                   \
+   os_ << errorMSG;                          \
+   Logger::getInstance().log(LOG_SEVERITY_ERROR, LOG_CATEGORY_CORE, \
+      "%s::%s : Error en los datos de los parámetros [%s]", classObj, method, os_.str()); \
 }
 
    /**
-    * Estructura que define un vrtice simple con posicin y coordenadas de textura.
+    * Estructura que define un vértice con todos los atributos que puede importar el motor.
+    * Lo que llega a la GPU y en qué codificación lo decide el VertexFormat de la malla.
     */
     struct 
     SimpleVertex {
-    XMFLOAT3 Pos;  ///< Posicin del vrtice en el espacio 3D.
-    XMFLOAT2 Tex;  ///< Coordenadas de textura del vrtice.
+    XMFLOAT3 Pos;  ///< Posición del vértice en el espacio 3D.
+    XMFLOAT2 Tex;  ///< Coordenadas de textura del vértice.
+    XMFLOAT3 Normal = XMFLOAT3(0.0f, 0.0f, 0.0f);           ///< Normal unitaria (cero si no se importó).
+    XMFLOAT4 Tangent = XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f);    ///< Tangente unitaria; w = signo de la bitangente.
+    XMFLOAT2 Tex1 = XMFLOAT2(0.0f, 0.0f);                   ///< Segundo juego de coordenadas de textura.
+    unsigned int Color = 0xFFFFFFFF;                        ///< Color RGBA8 (R en el byte bajo).
 };
 
 /**
- * Estructura para almacenar la matriz de vista utilizada en la renderizacin.
+ * Estructura para almacenar la matriz de vista utilizada en la renderización.
  */
     struct 
     CBNeverChanges {
@@ -75,11 +96,11 @@
 };
 
 /**
- * Estructura para almacenar la matriz de proyeccin que cambia al redimensionar la ventana.
+ * Estructura para almacenar la matriz de proyección que cambia al redimensionar la ventana.
  */
     struct
     CBChangeOnResize {
-    XMMATRIX mProjection;  ///< Matriz de proyeccin para gestionar la perspectiva de la escena.
+    XMMATRIX mProjection;  ///< Matriz de proyección para gestionar la perspectiva de la escena.
 };
 
 /**
@@ -87,12 +108,12 @@
  */
     struct 
     CBChangesEveryFrame {
-    XMMATRIX mWorld;      ///< Matriz de transformacin del mundo para cada frame.
+    XMMATRIX mWorld;      ///< Matriz de transformación del mundo para cada frame.
     XMFLOAT4 vMeshColor;  ///< Color del objeto en RGBA.
 };
 
 /**
- * Enumeracin para definir los tipos de extensiones de imagen soportadas.
+ * Enumeración para definir los tipos de extensiones de imagen soportadas.
  */
     enum 
     ExtensionType {
@@ -114,11 +135,31 @@
     enum
         ComponentType {
         NONE = 0,     ///< Tipo de componente no especificado.
-        TRANSFORM = 1,///< Componente de transformacin.
+        TRANSFORM = 1,///< Componente de transformación.
         MESH = 2,     ///< Componente de malla.
         MATERIAL = 3  ///< Componente de material.
     };
 
+    /**
+ * @enum RenderPass
+ * @brief Pasadas de render usadas para ordenar la cola de dibujo.
+ */
+    enum
+        RenderPass {
+        OPAQUE_PASS = 0,      ///< Geometría opaca, ordenada por estado y de adelante hacia atrás.
+        TRANSPARENT_PASS = 1  ///< Geometría transparente, ordenada de atrás hacia adelante.
+    };
+
+    /**
+ * @enum RenderBackend
+ * @brief Implementación de render sobre la que corre el motor.
+ */
+    enum
+        RenderBackend {
+        D3D11_BACKEND = 0,  ///< Dispositivo de hardware (o WARP/referencia si no lo hay) con cadena de intercambio.
+        NULL_BACKEND = 1    ///< Driver nulo de Direct3D sin ventana visible: acepta las llamadas sin dibujar.
+    };
+
 
     struct Camera {
         XMFLOAT3 position; //Posicion de la camara
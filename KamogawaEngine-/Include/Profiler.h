@@ -0,0 +1,255 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <intrin.h>
+
+/**
+ * @brief Intervalo medido por un PROFILE_SCOPE.
+ */
+struct
+ProfileEvent {
+    const char* name = nullptr;         ///< Nombre del bloque (literal de cadena).
+    unsigned long long start = 0;       ///< Marca de tiempo inicial (ciclos del TSC).
+    unsigned long long end = 0;         ///< Marca de tiempo final.
+    unsigned int depth = 0;             ///< Anidamiento dentro del hilo (0 = raíz).
+    unsigned int thread = 0;            ///< Índice del hilo que lo midió.
+};
+
+/**
+ * @brief Tiempo acumulado de un bloque en el último frame.
+ */
+struct
+ProfileSummaryEntry {
+    const char* name = nullptr;         ///< Nombre del bloque.
+    unsigned int depth = 0;             ///< Anidamiento.
+    unsigned int thread = 0;            ///< Hilo que lo midió.
+    unsigned int calls = 0;             ///< Veces que se ejecutó en el frame.
+    double totalMs = 0.0;               ///< Tiempo total incluyendo bloques anidados.
+    double selfMs = 0.0;                ///< Tiempo sin contar bloques anidados.
+    double maxMs = 0.0;                 ///< Ejecución más larga.
+    unsigned long long firstStart = 0;  ///< Primera ejecución (para ordenar la jerarquía).
+};
+
+/**
+ * @brief Buffer circular de eventos de un hilo.
+ *
+ * Un solo productor (el hilo dueño) y un solo consumidor (el hilo que llama a
+ * Profiler::endFrame), sincronizados solo con los índices atómicos de escritura y lectura.
+ * Si el buffer se llena los eventos nuevos se descartan y se cuentan.
+ */
+class
+ProfileThreadBuffer {
+public:
+    static constexpr unsigned int kCapacity = 1 << 14;  ///< Eventos por hilo (potencia de 2).
+    static constexpr unsigned int kMaxDepth = 64;       ///< Anidamiento máximo con tiempo propio.
+
+    /**
+     * @brief Agrega un evento; solo lo llama el hilo dueño.
+     */
+    void
+    push(const ProfileEvent& event) {
+        const unsigned int write = m_write.load(std::memory_order_relaxed);
+        if (write - m_read.load(std::memory_order_acquire) >= kCapacity) {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_events[write & (kCapacity - 1)] = event;
+        m_write.store(write + 1, std::memory_order_release);
+    }
+
+public:
+    unsigned int m_thread = 0;                          ///< Índice del hilo.
+    std::string m_name;                                 ///< Nombre del hilo para la traza.
+    unsigned int m_depth = 0;                           ///< Bloques abiertos (solo el hilo dueño).
+    ProfileEvent m_events[kCapacity];                   ///< Eventos pendientes de leer.
+    std::atomic<unsigned int> m_write{ 0 };             ///< Siguiente posición a escribir.
+    std::atomic<unsigned int> m_read{ 0 };              ///< Siguiente posición a leer.
+    std::atomic<unsigned int> m_dropped{ 0 };           ///< Eventos descartados por buffer lleno.
+    unsigned long long m_childTicks[kMaxDepth + 1] = {}; ///< Tiempo de hijos por nivel (solo el consumidor).
+};
+
+/**
+ * @brief Profiler jerárquico de CPU.
+ *
+ * Cada hilo escribe los bloques medidos con PROFILE_SCOPE en su propio buffer sin bloqueos;
+ * endFrame() los recoge, calcula el resumen del frame (llamadas, tiempo total, propio y máximo
+ * por bloque) y, durante una captura, los guarda para exportarlos en formato de traza de
+ * Chrome (chrome://tracing o Perfetto).
+ *
+ * Las marcas de tiempo son ciclos del TSC (__rdtsc); la conversión a milisegundos se calibra
+ * contra steady_clock durante la ejecución.
+ *
+ * Las macros solo generan código si PROFILE está definido (configuraciones Debug y Profile).
+ */
+class
+Profiler {
+public:
+    /**
+     * @brief Instancia única del profiler.
+     */
+    static Profiler&
+    getInstance();
+
+    /**
+     * @brief Marca de tiempo actual en ciclos.
+     */
+    static unsigned long long
+    now() { return __rdtsc(); }
+
+    /**
+     * @brief Buffer del hilo actual (se registra la primera vez que el hilo mide algo).
+     */
+    ProfileThreadBuffer&
+    getThreadBuffer();
+
+    /**
+     * @brief Nombre del hilo actual en la traza exportada.
+     */
+    void
+    setThreadName(const char* name);
+
+    /**
+     * @brief Marca el inicio de un frame.
+     */
+    void
+    beginFrame();
+
+    /**
+     * @brief Recoge los eventos de todos los hilos y calcula el resumen del frame.
+     */
+    void
+    endFrame();
+
+    /**
+     * @brief Resumen del último frame, ordenado por la primera ejecución de cada bloque.
+     */
+    const std::vector<ProfileSummaryEntry>&
+    getSummary() const { return m_summary; }
+
+    /**
+     * @brief Duración del último frame entre beginFrame() y endFrame().
+     */
+    double
+    getFrameTimeMs() const { return m_frameTimeMs; }
+
+    /**
+     * @brief Eventos descartados desde el inicio por buffers llenos.
+     */
+    unsigned int
+    getDroppedEvents() const;
+
+    /**
+     * @brief Empieza a guardar los eventos de cada frame para exportarlos.
+     * @param maxEvents Límite de eventos guardados.
+     */
+    void
+    beginCapture(size_t maxEvents = 1 << 20);
+
+    /**
+     * @brief Termina la captura y la escribe en formato JSON de traza de Chrome.
+     * @param path Ruta del archivo.
+     * @return true si el archivo se escribió.
+     */
+    bool
+    endCapture(const std::string& path);
+
+    bool
+    isCapturing() const { return m_capturing; }
+
+    /**
+     * @brief Convierte ciclos a milisegundos con la calibración actual.
+     */
+    double
+    ticksToMs(unsigned long long ticks) const { return ticks / m_ticksPerMs; }
+
+private:
+    Profiler();
+
+    /**
+     * @brief Recalibra los ciclos por milisegundo con el tiempo transcurrido desde el inicio.
+     */
+    void
+    calibrate();
+
+    /**
+     * @brief Acumula un evento en el resumen del frame.
+     */
+    void
+    addToSummary(const ProfileEvent& event, unsigned long long selfTicks);
+
+private:
+    std::mutex m_registryMutex;                                 ///< Protege el registro de hilos.
+    std::vector<std::unique_ptr<ProfileThreadBuffer>> m_buffers; ///< Buffer de cada hilo registrado.
+
+    unsigned long long m_startTicks = 0;                        ///< TSC al crear el profiler.
+    std::chrono::steady_clock::time_point m_startTime;          ///< Reloj al crear el profiler.
+    double m_ticksPerMs = 1.0e6;                                ///< Calibración actual.
+
+    unsigned long long m_frameStart = 0;                        ///< Inicio del frame en curso.
+    double m_frameTimeMs = 0.0;                                 ///< Duración del último frame.
+    std::vector<ProfileEvent> m_frameEvents;                    ///< Eventos recogidos en endFrame().
+    std::vector<ProfileSummaryEntry> m_summary;                 ///< Resumen del último frame.
+
+    bool m_capturing = false;                                   ///< Guardando eventos para exportar.
+    size_t m_maxCaptureEvents = 0;                              ///< Límite de la captura.
+    std::vector<ProfileEvent> m_captureEvents;                  ///< Eventos de la captura.
+};
+
+/**
+ * @brief Mide el tiempo entre su construcción y su destrucción.
+ */
+class
+ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : m_buffer(&Profiler::getInstance().getThreadBuffer()),
+          m_name(name) {
+        m_depth = m_buffer->m_depth++;
+        m_start = Profiler::now();
+    }
+
+    ~ProfileScope() {
+        ProfileEvent event;
+        event.end = Profiler::now();
+        event.start = m_start;
+        event.name = m_name;
+        event.depth = m_depth;
+        event.thread = m_buffer->m_thread;
+        m_buffer->m_depth--;
+        m_buffer->push(event);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileThreadBuffer* m_buffer;      ///< Buffer del hilo.
+    const char* m_name;                 ///< Nombre del bloque.
+    unsigned long long m_start = 0;     ///< Inicio del bloque.
+    unsigned int m_depth = 0;           ///< Anidamiento.
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef PROFILE
+/** Mide el bloque actual con el nombre indicado (debe ser un literal de cadena). */
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+/** Mide la función actual. */
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+/** Nombra el hilo actual en la traza. */
+#define PROFILE_THREAD(name) Profiler::getInstance().setThreadName(name)
+/** Delimita un frame. */
+#define PROFILE_BEGIN_FRAME() Profiler::getInstance().beginFrame()
+#define PROFILE_END_FRAME() Profiler::getInstance().endFrame()
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_FUNCTION() ((void)0)
+#define PROFILE_THREAD(name) ((void)0)
+#define PROFILE_BEGIN_FRAME() ((void)0)
+#define PROFILE_END_FRAME() ((void)0)
+#endif
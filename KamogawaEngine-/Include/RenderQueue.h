@@ -0,0 +1,298 @@
+#pragma once
+#include "Prerequisites.h"
+#include "InstanceBatcher.h"
+#include "Buffer.h"
+#include "ConstantBufferRing.h"
+#include "FrustumCuller.h"
+#include <unordered_map>
+
+class Device;
+class DeviceContext;
+class ShaderProgram;
+class SamplerState;
+class Texture;
+class CommandListPool;
+class VertexFormat;
+
+/**
+ * @brief Paquete de dibujo que un actor envía a la cola de render.
+ *
+ * Contiene todo el estado necesario para emitir un DrawIndexed sin volver a consultar al actor.
+ */
+struct
+DrawPacket {
+    unsigned long long sortKey = 0;         ///< Llave de ordenamiento de 64 bits.
+    ShaderProgram* shader = nullptr;        ///< Programa de shaders (nullptr = el que ya está enlazado).
+    SamplerState* sampler = nullptr;        ///< Sampler de la etapa de píxeles (slot 0).
+    Texture* texture = nullptr;             ///< Textura difusa (slot 0), opcional.
+    Buffer* vertexBuffer = nullptr;         ///< Vertex buffer (slot 0).
+    const VertexFormat* vertexFormat = nullptr; ///< Formato del vertex buffer (nullptr = layout por defecto del shader).
+    Buffer* indexBuffer = nullptr;          ///< Index buffer.
+    Buffer* constantBuffer = nullptr;       ///< Constant buffer por objeto (slot 2, VS y PS).
+    const void* constants = nullptr;        ///< Datos del constant buffer por objeto (deben vivir hasta flush).
+    unsigned int constantSize = 0;          ///< Tamaño de los datos por objeto en bytes.
+    DXGI_FORMAT indexFormat = DXGI_FORMAT_R32_UINT; ///< Formato de los índices.
+    unsigned int indexCount = 0;            ///< Número de índices a dibujar.
+    unsigned int startIndex = 0;            ///< Primer índice dentro del index buffer.
+    int baseVertex = 0;                     ///< Desplazamiento sumado a cada índice.
+    bool instanceable = false;              ///< Puede agruparse con paquetes de la misma malla y material.
+    XMFLOAT4X4 world;                       ///< Matriz de mundo (sin transponer) si es instanciable.
+    bool hasBounds = false;                 ///< Tiene caja en mundo; sin caja nunca se descarta.
+    XMFLOAT3 boundsCenter;                  ///< Centro de la caja en mundo.
+    XMFLOAT3 boundsExtents;                 ///< Mitad del tamaño de la caja en mundo.
+};
+
+/**
+ * @brief Contadores de la cola de render del último frame.
+ */
+struct
+RenderQueueStats {
+    unsigned int packets = 0;               ///< Paquetes recibidos.
+    unsigned int culled = 0;                ///< Paquetes descartados por el frustum.
+    unsigned int trianglesSubmitted = 0;    ///< Triángulos de los paquetes recibidos.
+    unsigned int trianglesCulled = 0;       ///< Triángulos de los paquetes descartados.
+    unsigned int draws = 0;                 ///< Llamadas de dibujo emitidas.
+    unsigned int bindsIssued = 0;           ///< Cambios de estado enviados al contexto.
+    unsigned int bindsSkipped = 0;          ///< Cambios de estado omitidos por ser redundantes.
+    unsigned int vertexBufferBinds = 0;     ///< Vertex buffers enlazados (incluidos en bindsIssued).
+    unsigned int indexBufferBinds = 0;      ///< Index buffers enlazados (incluidos en bindsIssued).
+    unsigned int instancedDraws = 0;        ///< Llamadas de dibujo instanciadas (incluidas en draws).
+    unsigned int instances = 0;             ///< Paquetes dibujados a través de lotes instanciados.
+    unsigned long long vertexBytes = 0;     ///< Bytes de vértices leídos: índices * stride (cota sin caché post-transform).
+    double sortTimeMs = 0.0;                ///< Tiempo del ordenamiento radix en milisegundos.
+    double cullTimeMs = 0.0;                ///< Tiempo del culling contra el frustum en milisegundos.
+};
+
+/**
+ * @brief Cola de render con llaves de ordenamiento y filtrado de cambios de estado.
+ *
+ * Los actores envían DrawPackets durante el frame; la cola los ordena con un radix sort
+ * sobre la llave de 64 bits y los envía al contexto omitiendo los enlaces que ya están activos.
+ *
+ * Distribución de la llave para la pasada opaca (del bit más alto al más bajo):
+ * pasada (4) | shader (8) | textura (16) | buffer (16) | profundidad (20).
+ * En la pasada transparente la profundidad invertida sube justo debajo de la pasada
+ * para dibujar de atrás hacia adelante.
+ *
+ * Si se configura el instanciado, los paquetes instanciables que comparten malla y material
+ * se agrupan en lotes y se dibujan con una sola llamada DrawIndexedInstanced; sus matrices de
+ * mundo se suben en un instance buffer por frame (slot 1). El resto del estado por objeto
+ * (constant buffer del slot 2) se toma del primer paquete del lote.
+ *
+ * Las constantes por objeto se suben en flush(): con un ConstantBufferRing se escriben en un
+ * solo stream contiguo por frame y se enlazan por desplazamiento; sin él se copian al
+ * constant buffer propio de cada paquete con UpdateSubresource.
+ */
+class
+RenderQueue {
+public:
+    RenderQueue() = default;
+    ~RenderQueue() = default;
+
+    /**
+     * @brief Habilita el dibujo instanciado.
+     * @param device Referencia al dispositivo de render.
+     * @param instancedShader Programa de shaders que lee la matriz de mundo por instancia.
+     * @param maxInstances Capacidad del instance buffer por frame.
+     * @return HRESULT Resultado de la operación.
+     */
+    HRESULT
+    initInstancing(Device& device, ShaderProgram& instancedShader, unsigned int maxInstances);
+
+    /**
+     * @brief Usa un anillo de constantes para subir las constantes por objeto.
+     * @param ring Anillo inicializado (nullptr o sin soporte = constant buffer por objeto).
+     */
+    void
+    setConstantRing(ConstantBufferRing* ring) { m_constantRing = ring; }
+
+    /**
+     * @brief Graba los dibujos en varios hilos con listas de comandos.
+     *
+     * La lista ordenada de dibujos se parte en rangos contiguos de al menos kMinDrawsPerRange
+     * dibujos; cada rango enlaza su propio estado y se reproduce en orden, así que el resultado
+     * es el mismo que con un solo hilo.
+     *
+     * @param commandLists Hilos de grabación (nullptr = todo en el contexto inmediato).
+     */
+    void
+    setCommandLists(CommandListPool* commandLists) { m_commandLists = commandLists; }
+
+    /**
+     * @brief Libera los recursos del instanciado.
+     */
+    void
+    destroy();
+
+    /**
+     * @brief Inicia un frame: vacía la cola y guarda la cámara para calcular profundidades.
+     * @param view Matriz de vista del frame.
+     * @param farPlane Distancia del plano lejano usada para cuantizar la profundidad.
+     */
+    void
+    begin(const XMMATRIX& view, float farPlane);
+
+    /**
+     * @brief Construye la llave de ordenamiento de un paquete.
+     * @param pass Pasada de render a la que pertenece el paquete.
+     * @param packet Paquete con el estado a codificar.
+     * @param worldPosition Posición en el mundo usada para la profundidad.
+     * @return Llave de 64 bits.
+     */
+    unsigned long long
+    makeSortKey(RenderPass pass, const DrawPacket& packet, const XMFLOAT3& worldPosition);
+
+    /**
+     * @brief Agrega un paquete a la cola.
+     * @param packet Paquete con su llave ya calculada.
+     */
+    void
+    submit(const DrawPacket& packet);
+
+    /**
+     * @brief Descarta los paquetes cuya caja queda fuera del frustum; se llama antes de sort().
+     * @param viewProjection Producto vista * proyección del frame.
+     */
+    void
+    cull(const XMMATRIX& viewProjection);
+
+    /**
+     * @brief Ordena los paquetes por llave con un radix sort LSD de 8 bits.
+     */
+    void
+    sort();
+
+    /**
+     * @brief Envía los paquetes ordenados al contexto, omitiendo enlaces redundantes.
+     * @param deviceContext Contexto del dispositivo.
+     */
+    void
+    flush(DeviceContext& deviceContext);
+
+    /**
+     * @brief Obtiene los contadores del último frame.
+     */
+    const RenderQueueStats&
+    getStats() const { return m_stats; }
+
+    /**
+     * @brief Obtiene los contadores de la última pasada de culling.
+     */
+    const CullingStats&
+    getCullingStats() const { return m_culler.getStats(); }
+
+    static constexpr unsigned int kMinDrawsPerRange = 64;  ///< Dibujos mínimos por rango de grabación.
+
+private:
+    /**
+     * @brief Estado enlazado y contadores de un rango de grabación.
+     */
+    struct BindState {
+        ShaderProgram* boundShader = nullptr;
+        ID3D11InputLayout* boundInputLayout = nullptr;
+        ID3D11SamplerState* boundSampler = nullptr;
+        ID3D11ShaderResourceView* boundTexture = nullptr;
+        ID3D11Buffer* boundVertexBuffer = nullptr;
+        ID3D11Buffer* boundIndexBuffer = nullptr;
+        ID3D11Buffer* boundConstantBuffer = nullptr;
+        unsigned int boundConstantOffset = ~0u;
+
+        unsigned int draws = 0;
+        unsigned int instancedDraws = 0;
+        unsigned int instances = 0;
+        unsigned long long vertexBytes = 0;
+        unsigned int bindsIssued = 0;
+        unsigned int bindsSkipped = 0;
+        unsigned int vertexBufferBinds = 0;
+        unsigned int indexBufferBinds = 0;
+
+        /**
+         * @brief Cuenta un enlace como enviado o como omitido.
+         * @return true si el enlace debe enviarse.
+         */
+        bool
+        countBind(bool changed) {
+            changed ? ++bindsIssued : ++bindsSkipped;
+            return changed;
+        }
+    };
+
+    /**
+     * @brief Dibujo de la lista ordenada: un paquete suelto o el primer paquete de un lote.
+     */
+    struct DrawItem {
+        unsigned int packet;        ///< Índice del paquete.
+        unsigned int batch;         ///< Lote instanciado (InstanceBatcher::kNoBatch si no tiene).
+    };
+
+    /**
+     * @brief Graba un rango de la lista de dibujos.
+     * @param range Rango a grabar.
+     * @param rangeCount Rangos en que se partió la lista.
+     */
+    void
+    drawRange(DeviceContext& deviceContext, unsigned int range, unsigned int rangeCount);
+
+    /**
+     * @brief Agrupa los paquetes instanciables y sube sus transformaciones.
+     */
+    void
+    buildInstances(DeviceContext& deviceContext);
+
+    /**
+     * @brief Sube las constantes por objeto de todos los paquetes del frame.
+     */
+    void
+    uploadConstants(DeviceContext& deviceContext);
+
+    /**
+     * @brief Enlaza el estado de un paquete omitiendo lo que ya está activo.
+     * @param shader Programa de shaders a usar (el del paquete o el instanciado).
+     * @param state Estado enlazado del rango que se está grabando.
+     */
+    void
+    bindPacket(DeviceContext& deviceContext,
+               unsigned int index,
+               ShaderProgram* shader,
+               BindState& state);
+
+    /**
+     * @brief Asigna un identificador compacto y estable a un recurso para la llave.
+     * @param resource Puntero al recurso (nullptr produce el identificador 0).
+     * @return Identificador del recurso.
+     */
+    unsigned int
+    resourceId(const void* resource);
+
+    /**
+     * @brief Cuantiza la profundidad en vista de una posición a 20 bits.
+     */
+    unsigned int
+    quantizeDepth(const XMFLOAT3& worldPosition) const;
+
+private:
+    std::vector<DrawPacket> m_packets;              ///< Paquetes enviados en el frame.
+    std::vector<unsigned long long> m_keys;         ///< Llaves a ordenar.
+    std::vector<unsigned int> m_order;              ///< Índices de paquetes en orden de llave.
+    std::vector<unsigned long long> m_scratchKeys;  ///< Buffer auxiliar del radix sort.
+    std::vector<unsigned int> m_scratchOrder;       ///< Buffer auxiliar del radix sort.
+    std::unordered_map<const void*, unsigned int> m_resourceIds; ///< Identificadores por recurso.
+
+    XMMATRIX m_view;                                ///< Matriz de vista del frame.
+    float m_farPlane = 100.0f;                      ///< Plano lejano para cuantizar profundidad.
+    RenderQueueStats m_stats;                       ///< Contadores del último frame.
+    FrustumCuller m_culler;                         ///< Prueba de visibilidad de los paquetes.
+
+    ShaderProgram* m_instancedShader = nullptr;     ///< Shader instanciado (nullptr = sin instanciado).
+    Buffer m_instanceBuffer;                        ///< Transformaciones por instancia del frame.
+    unsigned int m_maxInstances = 0;                ///< Capacidad del instance buffer.
+    InstanceBatcher m_batcher;                      ///< Agrupación de paquetes en lotes.
+    std::vector<bool> m_batchDrawn;                 ///< Lotes ya dibujados en el flush actual.
+
+    ConstantBufferRing* m_constantRing = nullptr;   ///< Anillo de constantes (opcional).
+    std::vector<ConstantAllocation> m_constantAllocations; ///< Bloque del anillo de cada paquete.
+
+    CommandListPool* m_commandLists = nullptr;      ///< Hilos de grabación (opcional).
+    std::vector<DrawItem> m_drawList;               ///< Dibujos del flush actual en orden de llave.
+    std::vector<BindState> m_rangeStates;           ///< Estado enlazado de cada rango del flush actual.
+};
@@ -15,7 +15,7 @@ DepthStencilView;
  * @brief Clase que representa una vista de renderizado en Direct3D 11.
  *
  * Se encarga de gestionar un ID3D11RenderTargetView, que se utiliza
- * para representar la superficie de renderizado a la que se dibujarn los grficos.
+ * para representar la superficie de renderizado a la que se dibujarán los gráficos.
  */
 class 
 RenderTargetView {
@@ -33,10 +33,10 @@ public:
     /**
      * @brief Inicializa la vista de renderizado.
      *
-     * @param device Referencia al dispositivo Direct3D utilizado para la creacin.
+     * @param device Referencia al dispositivo Direct3D utilizado para la creación.
      * @param backBuffer Referencia a la textura del back buffer.
      * @param Format Formato de la vista de renderizado (DXGI_FORMAT).
-     * @return HRESULT Cdigo de resultado indicando xito o error en la operacin.
+     * @return HRESULT Código de resultado indicando éxito o error en la operación.
      */
     HRESULT 
     init(Device& device, 
@@ -54,7 +54,7 @@ public:
      *
      * @param deviceContext Referencia al contexto del dispositivo.
      * @param depthStencilView Referencia a la vista de profundidad y stencil.
-     * @param numViews Nmero de vistas a establecer en el pipeline de renderizado.
+     * @param numViews Número de vistas a establecer en el pipeline de renderizado.
      * @param ClearColor Color utilizado para limpiar la vista de renderizado.
      */
     void 
@@ -9,7 +9,7 @@ DeviceContext;
 /**
  * @brief Clase que encapsula un Sampler State en Direct3D 11.
  *
- * Un sampler state define cmo se muestrean las texturas (filtrado, direccionamiento, etc.).
+ * Un sampler state define cómo se muestrean las texturas (filtrado, direccionamiento, etc.).
  */
 class 
 SamplerState
@@ -19,15 +19,15 @@ public:
     ~SamplerState() = default;
 
     /**
-     * @brief Inicializa el sampler state con una configuracin predeterminada.
+     * @brief Inicializa el sampler state con una configuración predeterminada.
      * @param device Referencia al dispositivo para crear el sampler.
-     * @return HRESULT Resultado de la operacin.
+     * @return HRESULT Resultado de la operación.
      */
     HRESULT
     init(Device& device);
 
     /**
-     * @brief Actualiza el estado del sampler. (Vaco por diseo, puede ser extendido).
+     * @brief Actualiza el estado del sampler. (Vacío por diseño, puede ser extendido).
      */
     void
     update();
@@ -36,7 +36,7 @@ public:
      * @brief Enlaza el sampler state al pipeline de renderizado.
      * @param deviceContext Contexto del dispositivo.
      * @param StartSlot Slot inicial donde se enlaza el sampler.
-     * @param numSampler Nmero de samplers a enlazar.
+     * @param numSampler Número de samplers a enlazar.
      */
     void
     render(DeviceContext& deviceContext,
@@ -49,6 +49,12 @@ public:
     void
     destroy();
 
+    /**
+     * @brief Obtiene el sampler state de Direct3D (útil para comparar enlaces).
+     */
+    ID3D11SamplerState*
+    getSamplerState() const { return m_samplerState; }
+
 private:
     ID3D11SamplerState* m_samplerState = nullptr; ///< Puntero al sampler state de Direct3D.
 };
@@ -1,6 +1,7 @@
 #pragma once
 #include "Prerequisites.h"
 #include "InputLayout.h"
+#include "VertexFormat.h"
 
 class 
 Device;
@@ -8,7 +9,7 @@ class
 DeviceContext;
 
 /**
- * @brief Clase que encapsula la creacin, compilacin y gestin de shaders en Direct3D 11.
+ * @brief Clase que encapsula la creación, compilación y gestión de shaders en Direct3D 11.
  *
  * Incluye vertex shader, pixel shader y su correspondiente input layout.
  */
@@ -23,8 +24,8 @@ public:
 	 * @brief Inicializa el shader program cargando y compilando shaders desde archivo.
 	 * @param device Referencia al dispositivo de render.
 	 * @param fileName Nombre del archivo de shader (HLSL).
-	 * @param Layout Descripcin del layout de entrada.
-	 * @return HRESULT Resultado de la operacin.
+	 * @param Layout Descripción del layout de entrada.
+	 * @return HRESULT Resultado de la operación.
 	 */
 	HRESULT
 	init(Device& device,
@@ -32,7 +33,7 @@ public:
 		 std::vector<D3D11_INPUT_ELEMENT_DESC> Layout);
 
 	/**
-	 * @brief Lgica de actualizacin del shader program. (Vaco por defecto).
+	 * @brief Lógica de actualización del shader program. (Vacío por defecto).
 	 */
 	void
 	update();
@@ -53,18 +54,37 @@ public:
 	/**
 	 * @brief Crea el input layout para el vertex shader.
 	 * @param device Referencia al dispositivo de render.
-	 * @param Layout Descripcin de la entrada del layout.
-	 * @return HRESULT Resultado de la operacin.
+	 * @param Layout Descripción de la entrada del layout.
+	 * @return HRESULT Resultado de la operación.
 	 */
 	HRESULT
 	CreateInputLayout(Device& device,
 					  std::vector<D3D11_INPUT_ELEMENT_DESC> Layout);
 
 	/**
-	 * @brief Crea un shader (vertex o pixel) segn el tipo especificado.
+	 * @brief Crea un input layout adicional para mallas empaquetadas en otro formato de vértice.
+	 * @param device Referencia al dispositivo de render.
+	 * @param format Formato de vértice del slot 0.
+	 * @param extraElements Elementos que siguen al formato (p. ej. las filas por instancia del slot 1).
+	 * @return HRESULT Resultado de la operación (S_OK si el formato ya estaba registrado).
+	 */
+	HRESULT
+	addInputLayout(Device& device,
+				   const VertexFormat& format,
+				   const std::vector<D3D11_INPUT_ELEMENT_DESC>& extraElements = {});
+
+	/**
+	 * @brief Input layout de un formato de vértice.
+	 * @param format Formato de la malla (nullptr o no registrado = el layout de init()).
+	 */
+	InputLayout&
+	getInputLayout(const VertexFormat* format);
+
+	/**
+	 * @brief Crea un shader (vertex o pixel) según el tipo especificado.
 	 * @param device Referencia al dispositivo de render.
 	 * @param type Tipo de shader a crear.
-	 * @return HRESULT Resultado de la operacin.
+	 * @return HRESULT Resultado de la operación.
 	 */
 	HRESULT
 	CreateShader(Device& device,
@@ -75,8 +95,8 @@ public:
 	 * @param szFileName Nombre del archivo del shader.
 	 * @param szEntryPoint Punto de entrada del shader.
 	 * @param szShaderModel Modelo de shader (ej. "vs_5_0", "ps_5_0").
-	 * @param ppBlobOut Puntero al blob resultante de la compilacin.
-	 * @return HRESULT Resultado de la compilacin.
+	 * @param ppBlobOut Puntero al blob resultante de la compilación.
+	 * @return HRESULT Resultado de la compilación.
 	 */
 	HRESULT
 	CompileShaderFromFile(char* szFileName,
@@ -88,9 +108,10 @@ private:
 	ID3D11VertexShader* m_VertexShader = nullptr; ///< Vertex Shader de Direct3D.
 	ID3D11PixelShader* m_PixelShader = nullptr;   ///< Pixel Shader de Direct3D.
 	InputLayout m_inputLayout;                    ///< Input Layout asociado al Vertex Shader.
+	std::vector<std::pair<VertexFormat, InputLayout>> m_formatLayouts; ///< Layouts de addInputLayout().
 
 public:
 	std::string m_shaderFileName;                 ///< Ruta o nombre del archivo de shader.
-	ID3DBlob* m_vertexShaderData = nullptr;       ///< Datos compilados del Vertex Shader.
+	ID3DBlob* m_vertexShaderData = nullptr;       ///< Datos compilados del Vertex Shader (se conservan para crear más layouts).
 	ID3DBlob* m_pixelShaderData = nullptr;        ///< Datos compilados del Pixel Shader.
 };
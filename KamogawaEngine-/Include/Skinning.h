@@ -0,0 +1,207 @@
+#pragma once
+#include "Prerequisites.h"
+#include "AnimationCompression.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+class MeshComponent;
+
+/**
+ * @brief Método de mezcla de las influencias de los huesos.
+ */
+enum
+SkinningMethod {
+    SKINNING_LINEAR_BLEND = 0,      ///< Suma ponderada de matrices (admite escala).
+    SKINNING_DUAL_QUATERNION = 1    ///< Suma de cuaterniones duales (sin pérdida de volumen en torsiones; solo rotación y traslación).
+};
+
+/**
+ * @brief Matriz de skinning afín por columnas: x' = dot(rows[0], (x, y, z, 1)), etc.
+ *
+ * Las dos primeras columnas ocupan un registro AVX y la tercera uno SSE.
+ */
+struct alignas(16)
+SkinMatrix {
+    float rows[3][4];
+};
+
+/**
+ * @brief Transformación rígida de un hueso como cuaternión dual (8 floats = un registro AVX).
+ */
+struct alignas(32)
+SkinDualQuaternion {
+    float real[4];  ///< Rotación (x, y, z, w).
+    float dual[4];  ///< Traslación codificada: 0.5 * t * real.
+};
+
+/**
+ * @brief Calcula el espacio del modelo de cada hueso (padres antes que hijos) y las
+ *        transformaciones de skinning de la pose.
+ * @param skeleton Esqueleto.
+ * @param pose Pose local evaluada.
+ * @param method Método para el que se generan las transformaciones.
+ * @param model Salida temporal: espacio del modelo de cada hueso.
+ * @param matrices Salida (SKINNING_LINEAR_BLEND): una matriz por hueso.
+ * @param dualQuaternions Salida (SKINNING_DUAL_QUATERNION): un cuaternión dual por hueso.
+ */
+void
+buildSkinTransforms(const Skeleton& skeleton,
+                    const PoseSoA& pose,
+                    SkinningMethod method,
+                    std::vector<XMFLOAT4X4>& model,
+                    std::vector<SkinMatrix>& matrices,
+                    std::vector<SkinDualQuaternion>& dualQuaternions);
+
+/**
+ * @brief Skinning lineal (LBS) de posiciones, normales y tangentes; el resto del vértice se copia.
+ */
+void
+skinVerticesLinear(const SimpleVertex* input,
+                   const VertexSkin* skin,
+                   unsigned int count,
+                   const SkinMatrix* matrices,
+                   SimpleVertex* output);
+
+/**
+ * @brief Skinning con cuaterniones duales (DQS) de posiciones, normales y tangentes; el resto del vértice se copia.
+ */
+void
+skinVerticesDualQuaternion(const SimpleVertex* input,
+                           const VertexSkin* skin,
+                           unsigned int count,
+                           const SkinDualQuaternion* dualQuaternions,
+                           SimpleVertex* output);
+
+/**
+ * @brief Personaje animado: fuentes compartidas y vértices deformados propios.
+ */
+struct
+SkinnedCharacter {
+    const Skeleton* skeleton = nullptr;                 ///< Esqueleto del modelo.
+    const AnimationClip* clip = nullptr;                ///< Clip a evaluar (nullptr = pose de enlace).
+    const CompressedAnimationClip* compressedClip = nullptr; ///< Clip comprimido (tiene prioridad sobre clip).
+    CompressedClipCursor cursor;                        ///< Posición en el flujo de compressedClip.
+    const std::vector<MeshComponent>* meshes = nullptr; ///< Mallas con m_skin.
+    float time = 0.0f;                                  ///< Instante del clip.
+    bool loop = true;                                   ///< El clip se repite.
+    SkinningMethod method = SKINNING_LINEAR_BLEND;      ///< Método de skinning.
+    std::vector<TrackedVector<SimpleVertex, MEMORY_TAG_MESH>> vertices; ///< Vértices deformados por malla (vacío sin skin).
+};
+
+/**
+ * @brief Contadores de la última llamada a SkinningSystem::update().
+ */
+struct
+SkinningStats {
+    unsigned int characters = 0;    ///< Personajes procesados.
+    unsigned long long vertices = 0;///< Vértices deformados.
+    double timeMs = 0.0;            ///< Tiempo de pared de update().
+};
+
+/**
+ * @brief Evalúa poses y deforma vértices de muchos personajes en paralelo.
+ *
+ * Los personajes se reparten dinámicamente entre el hilo que llama a update() y los hilos de
+ * trabajo (cada uno toma el siguiente con un contador atómico), así que personajes de costo
+ * distinto no dejan hilos ociosos. Cada hilo tiene su propia pose y matrices temporales.
+ * Por personaje: muestreo SoA del clip (8 huesos por instrucción), pasada jerárquica local a
+ * modelo y skinning LBS o DQS con AVX2 (escalar si el procesador no lo soporta).
+ */
+class
+SkinningSystem {
+public:
+    SkinningSystem() = default;
+    ~SkinningSystem() { destroy(); }
+
+    SkinningSystem(const SkinningSystem&) = delete;
+    SkinningSystem& operator=(const SkinningSystem&) = delete;
+
+    /**
+     * @brief Crea los hilos de trabajo.
+     * @param workerCount Hilos adicionales al que llama a update() (0 = solo el hilo actual).
+     */
+    HRESULT
+    init(unsigned int workerCount);
+
+    /**
+     * @brief Detiene los hilos de trabajo.
+     */
+    void
+    destroy();
+
+    /**
+     * @brief Evalúa y deforma todos los personajes; vuelve cuando terminaron.
+     */
+    void
+    update(SkinnedCharacter* const* characters, unsigned int count);
+
+    unsigned int
+    getThreadCount() const { return static_cast<unsigned int>(m_workers.size()) + 1; }
+
+    const SkinningStats&
+    getStats() const { return m_stats; }
+
+private:
+    /**
+     * @brief Datos temporales de un hilo.
+     */
+    struct Scratch {
+        PoseSoA pose;
+        std::vector<XMFLOAT4X4> model;
+        std::vector<SkinMatrix> matrices;
+        std::vector<SkinDualQuaternion> dualQuaternions;
+    };
+
+    void
+    processCharacter(SkinnedCharacter& character, Scratch& scratch);
+
+    /**
+     * @brief Toma personajes del lote hasta agotarlo.
+     */
+    void
+    processBatch(unsigned int thread);
+
+    void
+    workerLoop(unsigned int thread);
+
+private:
+    std::vector<std::thread> m_workers;                 ///< Hilos de trabajo.
+    std::vector<Scratch> m_scratch;                     ///< Datos temporales por hilo (0 = el que llama).
+    SkinnedCharacter* const* m_batch = nullptr;         ///< Personajes de la llamada actual.
+    unsigned int m_batchSize = 0;                       ///< Personajes en m_batch.
+    std::atomic<unsigned int> m_next{ 0 };              ///< Siguiente personaje a tomar.
+    std::atomic<unsigned long long> m_vertexCount{ 0 }; ///< Vértices deformados en la llamada.
+    SkinningStats m_stats;                              ///< Contadores.
+
+    std::mutex m_mutex;                                 ///< Protege el estado compartido con los hilos.
+    std::condition_variable m_startSignal;              ///< Despierta a los hilos al iniciar un lote.
+    std::condition_variable m_doneSignal;               ///< Avisa que todos los hilos terminaron.
+    unsigned int m_generation = 0;                      ///< Lote actual.
+    unsigned int m_pendingWorkers = 0;                  ///< Hilos aún procesando el lote.
+    bool m_quit = false;                                ///< Pide a los hilos terminar.
+};
+
+/**
+ * @brief Resultado de runSkinningBenchmark().
+ */
+struct
+SkinningBenchmarkResult {
+    unsigned int characters = 0;            ///< Personajes por frame.
+    unsigned int bones = 0;                 ///< Huesos por personaje.
+    unsigned int vertices = 0;              ///< Vértices por personaje.
+    unsigned int threads = 0;               ///< Hilos usados.
+    bool avx2 = false;                      ///< Se usaron los núcleos AVX2.
+    double linearCharactersPerMs = 0.0;     ///< Personajes por milisegundo con LBS.
+    double dualCharactersPerMs = 0.0;       ///< Personajes por milisegundo con DQS.
+};
+
+/**
+ * @brief Mide personajes por milisegundo (muestreo + jerarquía + skinning) sobre un personaje
+ *        sintético de 64 huesos y 4096 vértices con 4 influencias.
+ * @param system Sistema a medir (ya inicializado).
+ * @param characters Personajes por frame.
+ * @param frames Frames medidos por método.
+ */
+SkinningBenchmarkResult
+runSkinningBenchmark(SkinningSystem& system, unsigned int characters, unsigned int frames);
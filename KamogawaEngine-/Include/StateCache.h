@@ -0,0 +1,191 @@
+#pragma once
+#include <cstdint>
+
+/**
+ * @brief Contadores de llamadas de estado del frame actual.
+ */
+struct
+StateCacheStats {
+    unsigned int issued = 0;    ///< Llamadas enviadas a la API.
+    unsigned int filtered = 0;  ///< Llamadas descartadas por repetir el estado enlazado.
+};
+
+/**
+ * @brief Copia sombra del estado enlazado en el pipeline.
+ *
+ * Guarda los recursos enlazados como punteros opacos, sin depender de tipos de Direct3D,
+ * para que el filtrado pueda compilarse y probarse en cualquier plataforma. Cada método
+ * set* compara contra el estado guardado, lo actualiza y devuelve true solo si la llamada
+ * cambia algo y por lo tanto debe enviarse a la API.
+ *
+ * Los slots fuera de kMaxSlots no se rastrean y siempre se envían.
+ */
+class
+StateCache {
+public:
+    static const unsigned int kMaxSlots = 16; ///< Slots rastreados por etapa.
+
+    StateCache() { invalidate(); }
+    ~StateCache() = default;
+
+    /**
+     * @brief Olvida todo el estado guardado; la siguiente llamada de cada tipo se envía.
+     *
+     * Debe llamarse cuando otro código modifica el contexto sin pasar por la caché
+     * (p. ej. ImGui o ClearState).
+     */
+    void
+    invalidate();
+
+    /**
+     * @brief Reinicia los contadores del frame.
+     */
+    void
+    resetStats() { m_stats = StateCacheStats(); }
+
+    /**
+     * @brief Obtiene los contadores del frame actual.
+     */
+    const StateCacheStats&
+    getStats() const { return m_stats; }
+
+    bool
+    setInputLayout(const void* layout) { return track(m_inputLayout, layout); }
+
+    bool
+    setVertexShader(const void* shader) { return track(m_vertexShader, shader); }
+
+    bool
+    setPixelShader(const void* shader) { return track(m_pixelShader, shader); }
+
+    bool
+    setTopology(unsigned int topology) { return track(m_topology, topology); }
+
+    /**
+     * @brief Filtra el enlace de un index buffer.
+     */
+    bool
+    setIndexBuffer(const void* buffer, unsigned int format, unsigned int offset);
+
+    /**
+     * @brief Filtra el enlace de un rango de vertex buffers.
+     */
+    bool
+    setVertexBuffers(unsigned int startSlot,
+                     unsigned int count,
+                     const void* const* buffers,
+                     const unsigned int* strides,
+                     const unsigned int* offsets);
+
+    /**
+     * @brief Filtra el enlace de un rango de shader resource views de la etapa de píxeles.
+     */
+    bool
+    setPSShaderResources(unsigned int startSlot, unsigned int count, const void* const* views) {
+        return trackSlots(m_psShaderResources, startSlot, count, views);
+    }
+
+    /**
+     * @brief Filtra el enlace de un rango de samplers de la etapa de píxeles.
+     */
+    bool
+    setPSSamplers(unsigned int startSlot, unsigned int count, const void* const* samplers) {
+        return trackSlots(m_psSamplers, startSlot, count, samplers);
+    }
+
+    /**
+     * @brief Filtra el enlace de un rango de constant buffers de la etapa de vértices.
+     * @param firstConstants Primera constante de cada buffer (nullptr = buffer completo).
+     * @param numConstants Número de constantes de cada buffer (nullptr = buffer completo).
+     */
+    bool
+    setVSConstantBuffers(unsigned int startSlot,
+                         unsigned int count,
+                         const void* const* buffers,
+                         const unsigned int* firstConstants = nullptr,
+                         const unsigned int* numConstants = nullptr) {
+        return trackConstantBuffers(m_vsConstantBuffers, m_vsConstantRanges,
+                                    startSlot, count, buffers, firstConstants, numConstants);
+    }
+
+    /**
+     * @brief Filtra el enlace de un rango de constant buffers de la etapa de píxeles.
+     * @param firstConstants Primera constante de cada buffer (nullptr = buffer completo).
+     * @param numConstants Número de constantes de cada buffer (nullptr = buffer completo).
+     */
+    bool
+    setPSConstantBuffers(unsigned int startSlot,
+                         unsigned int count,
+                         const void* const* buffers,
+                         const unsigned int* firstConstants = nullptr,
+                         const unsigned int* numConstants = nullptr) {
+        return trackConstantBuffers(m_psConstantBuffers, m_psConstantRanges,
+                                    startSlot, count, buffers, firstConstants, numConstants);
+    }
+
+private:
+    template<typename T>
+    bool
+    track(T& current, T value) {
+        bool changed = current != value;
+        current = value;
+        return record(changed);
+    }
+
+    bool
+    trackSlots(const void** current,
+               unsigned int startSlot,
+               unsigned int count,
+               const void* const* values);
+
+    bool
+    trackConstantBuffers(const void** current,
+                         unsigned long long* currentRanges,
+                         unsigned int startSlot,
+                         unsigned int count,
+                         const void* const* buffers,
+                         const unsigned int* firstConstants,
+                         const unsigned int* numConstants);
+
+    /**
+     * @brief Cuenta la llamada y devuelve si debe enviarse.
+     */
+    bool
+    record(bool changed) {
+        if (changed) {
+            ++m_stats.issued;
+        }
+        else {
+            ++m_stats.filtered;
+        }
+        return changed;
+    }
+
+private:
+    /// Valor que nunca coincide con un recurso real; marca un slot como desconocido.
+    static const void*
+    unknown() { return reinterpret_cast<const void*>(~static_cast<uintptr_t>(0)); }
+
+private:
+    const void* m_inputLayout;
+    const void* m_vertexShader;
+    const void* m_pixelShader;
+    unsigned int m_topology;
+
+    const void* m_indexBuffer;
+    unsigned int m_indexFormat;
+    unsigned int m_indexOffset;
+
+    const void* m_vertexBuffers[kMaxSlots];
+    unsigned int m_vertexStrides[kMaxSlots];
+    unsigned int m_vertexOffsets[kMaxSlots];
+
+    const void* m_psShaderResources[kMaxSlots];
+    const void* m_psSamplers[kMaxSlots];
+    const void* m_vsConstantBuffers[kMaxSlots];
+    const void* m_psConstantBuffers[kMaxSlots];
+    unsigned long long m_vsConstantRanges[kMaxSlots]; ///< Primera constante (32 bits altos) y número (bajos).
+    unsigned long long m_psConstantRanges[kMaxSlots];
+
+    StateCacheStats m_stats;                    ///< Contadores del frame.
+};
@@ -10,13 +10,15 @@ class
 Window;
 class 
 Texture;
+class
+CommandRecorder;
 
 /**
  * @class SwapChain
  * @brief Clase que gestiona la cadena de intercambio de Direct3D 11.
  *
- * La cadena de intercambio es responsable de la presentacin de imgenes en pantalla,
- * permitiendo la renderizacin en un buffer y su posterior visualizacin.
+ * La cadena de intercambio es responsable de la presentación de imágenes en pantalla,
+ * permitiendo la renderización en un buffer y su posterior visualización.
  */
 class 
 SwapChain {
@@ -38,7 +40,7 @@ public:
      * @param deviceContext Referencia al contexto del dispositivo.
      * @param backBuffer Referencia a la textura del back buffer.
      * @param window Referencia a la ventana de renderizado.
-     * @return HRESULT Cdigo de resultado indicando xito o error en la operacin.
+     * @return HRESULT Código de resultado indicando éxito o error en la operación.
      */
     HRESULT init(Device& device,
                  DeviceContext& deviceContext,
@@ -46,7 +48,7 @@ public:
                  Window window);
 
     /**
-     * @brief Actualiza los parmetros de la cadena de intercambio si es necesario.
+     * @brief Actualiza los parámetros de la cadena de intercambio si es necesario.
      */
     void 
     update();
@@ -71,6 +73,30 @@ public:
     void 
     present();
 
+    /**
+     * @brief Selecciona la implementación de render; debe llamarse antes de init().
+     *
+     * Con NULL_BACKEND se crea el dispositivo con el driver nulo de Direct3D, que valida y
+     * acepta todas las llamadas sin dibujar, y el back buffer es una textura fuera de pantalla.
+     */
+    void
+    setBackend(RenderBackend backend) { m_backend = backend; }
+
+    RenderBackend
+    getBackend() const { return m_backend; }
+
+    /**
+     * @brief Muestras por píxel del back buffer; los demás render targets deben usar las mismas.
+     */
+    unsigned int
+    getSampleCount() const { return m_sampleCount; }
+
+    /**
+     * @brief Asigna el registro donde se anota cada presentación.
+     */
+    void
+    setRecorder(CommandRecorder* recorder) { m_recorder = recorder; }
+
 public:
     /// Puntero a la interfaz IDXGISwapChain que representa la cadena de intercambio.
     IDXGISwapChain* m_swapchain = nullptr;
@@ -79,23 +105,29 @@ public:
     D3D_DRIVER_TYPE m_driverType = D3D_DRIVER_TYPE_NULL;
 
 private:
-    /// Nivel de caractersticas de Direct3D utilizado (por defecto 11.0).
+    /// Nivel de características de Direct3D utilizado (por defecto 11.0).
     D3D_FEATURE_LEVEL m_featureLevel = D3D_FEATURE_LEVEL_11_0;
 
-    /// Nmero de muestras utilizadas para el antialiasing.
-    unsigned int m_sampleCount;
+    /// Número de muestras utilizadas para el antialiasing.
+    unsigned int m_sampleCount = 4;
 
     /// Niveles de calidad de las muestras de antialiasing.
-    unsigned int m_qualityLevels;
+    unsigned int m_qualityLevels = 0;
+
+    /// Implementación de render seleccionada.
+    RenderBackend m_backend = D3D11_BACKEND;
+
+    /// Registro de comandos (opcional).
+    CommandRecorder* m_recorder = nullptr;
 
-    // Punteros a las interfaces DXGI para la gestin de dispositivos y adaptadores grficos.
+    // Punteros a las interfaces DXGI para la gestión de dispositivos y adaptadores gráficos.
 
-    /// Puntero a la interfaz IDXGIDevice para la gestin del dispositivo DXGI.
+    /// Puntero a la interfaz IDXGIDevice para la gestión del dispositivo DXGI.
     IDXGIDevice* m_dxgiDevice = nullptr;
 
-    /// Puntero a la interfaz IDXGIAdapter para la gestin del adaptador grfico.
+    /// Puntero a la interfaz IDXGIAdapter para la gestión del adaptador gráfico.
     IDXGIAdapter* m_dxgiAdapter = nullptr;
 
-    /// Puntero a la interfaz IDXGIFactory para la creacin de la cadena de intercambio.
+    /// Puntero a la interfaz IDXGIFactory para la creación de la cadena de intercambio.
     IDXGIFactory* m_dxgiFactory = nullptr;
 };
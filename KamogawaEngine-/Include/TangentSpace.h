@@ -0,0 +1,42 @@
+#pragma once
+#include "Prerequisites.h"
+
+class MeshComponent;
+
+/**
+ * @brief Contadores de la generación de espacios tangentes.
+ */
+struct
+TangentSpaceStats {
+    unsigned int meshes = 0;                ///< Mallas procesadas.
+    unsigned int generatedNormals = 0;      ///< Vértices sin normal importada a los que se les calculó.
+    unsigned int splitVertices = 0;         ///< Vértices duplicados por simetría de UV.
+    unsigned int degenerateTriangles = 0;   ///< Triángulos sin área en UV (no aportan tangente).
+    unsigned int threads = 0;               ///< Hilos usados.
+    double timeMs = 0.0;                    ///< Tiempo de pared.
+};
+
+/**
+ * @brief Calcula las tangentes de una malla con las reglas de MikkTSpace.
+ *
+ * Por triángulo se obtiene la dirección de la U en espacio del objeto; en cada esquina se
+ * proyecta sobre el plano de la normal del vértice y se acumula ponderada por el ángulo de la
+ * esquina. El signo de la bitangente es la orientación del triángulo en UV
+ * (bitangente = w * cross(normal, tangente)). Un vértice compartido por triángulos de ambas
+ * orientaciones (UV espejadas) se duplica, como en MikkTSpace, junto con su skin.
+ * Los vértices sin normal reciben la normal de sus caras ponderada por ángulo.
+ * @param mesh Malla triangulada; se modifican vértices, índices y skin.
+ * @param stats Contadores a los que se suma el resultado.
+ */
+void
+computeTangentSpace(MeshComponent& mesh, TangentSpaceStats& stats);
+
+/**
+ * @brief Ejecuta computeTangentSpace() sobre varias mallas en paralelo.
+ *
+ * Cada hilo toma la siguiente malla con un contador atómico; el hilo que llama también trabaja.
+ * @param meshes Mallas a procesar.
+ * @param threadCount Hilos totales (incluido el que llama).
+ */
+TangentSpaceStats
+computeTangentSpaces(std::vector<MeshComponent>& meshes, unsigned int threadCount);
@@ -10,7 +10,7 @@ DeviceContext;
  * @class Texture
  * @brief Clase que representa una textura en Direct3D 11.
  *
- * Gestiona la creacin, actualizacin, renderizado y destruccin de texturas en la GPU.
+ * Gestiona la creación, actualización, renderizado y destrucción de texturas en la GPU.
  */
 class 
 Texture {
@@ -30,24 +30,24 @@ public:
      *
      * @param device Referencia al dispositivo Direct3D.
      * @param textureName Nombre del archivo de la textura.
-     * @param extensionType Tipo de extensin del archivo de la textura.
-     * @return HRESULT Cdigo de resultado indicando xito o error en la operacin.
+     * @param extensionType Tipo de extensión del archivo de la textura.
+     * @return HRESULT Código de resultado indicando éxito o error en la operación.
      */
     HRESULT init(Device device,
                  const std::string& textureName,
                  ExtensionType extensionType);
 
     /**
-     * @brief Inicializa una textura con dimensiones y formato especficos.
+     * @brief Inicializa una textura con dimensiones y formato específicos.
      *
      * @param device Referencia al dispositivo Direct3D.
-     * @param width Ancho de la textura en pxeles.
-     * @param height Alto de la textura en pxeles.
+     * @param width Ancho de la textura en píxeles.
+     * @param height Alto de la textura en píxeles.
      * @param Format Formato de la textura (DXGI_FORMAT).
      * @param BindFlags Flags que indican el uso de la textura.
-     * @param sampleCount Nmero de muestras para antialiasing (opcional, por defecto 1).
+     * @param sampleCount Número de muestras para antialiasing (opcional, por defecto 1).
      * @param qualityLevels Niveles de calidad del muestreo (opcional, por defecto 0).
-     * @return HRESULT Cdigo de resultado indicando xito o error en la operacin.
+     * @return HRESULT Código de resultado indicando éxito o error en la operación.
      */
     HRESULT init(Device device,
                  unsigned int width,
@@ -57,6 +57,22 @@ public:
                  unsigned int sampleCount = 1,
                  unsigned int qualityLevels = 0);
 
+    /**
+     * @brief Inicializa una textura RGBA8 desde datos en memoria, con su cadena de mips.
+     *
+     * @param device Referencia al dispositivo Direct3D.
+     * @param width Ancho del nivel 0 en píxeles.
+     * @param height Alto del nivel 0 en píxeles.
+     * @param mipData Arreglo de punteros a los píxeles de cada nivel de mip (4 bytes por píxel).
+     * @param mipLevels Número de niveles contenidos en mipData.
+     * @return HRESULT Código de resultado indicando éxito o error en la operación.
+     */
+    HRESULT init(Device device,
+                 unsigned int width,
+                 unsigned int height,
+                 const unsigned char* const* mipData,
+                 unsigned int mipLevels);
+
     /**
      * @brief Actualiza la textura si es necesario.
      */
@@ -67,8 +83,8 @@ public:
      * @brief Renderiza la textura en la etapa de shader.
      *
      * @param deviceContext Referencia al contexto del dispositivo.
-     * @param StartSlot Primer slot en el que se asignar la textura.
-     * @param NumViews Nmero de vistas de la textura a asignar.
+     * @param StartSlot Primer slot en el que se asignará la textura.
+     * @param NumViews Número de vistas de la textura a asignar.
      */
     void 
     render(DeviceContext& deviceContext, 
@@ -86,5 +102,5 @@ public:
     ID3D11Texture2D* m_texture = nullptr;
 
     /// Puntero a la interfaz ID3D11ShaderResourceView que representa la textura como imagen para los shaders.
-    ID3D11ShaderResourceView* m_textureFromImg;
+    ID3D11ShaderResourceView* m_textureFromImg = nullptr;
 };
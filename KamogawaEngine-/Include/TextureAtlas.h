@@ -0,0 +1,131 @@
+#pragma once
+#include "Prerequisites.h"
+#include "Texture.h"
+
+class Device;
+class MeshComponent;
+struct stbrp_rect;
+
+/**
+ * @brief Región que ocupa una textura de origen dentro de una página del atlas.
+ */
+struct
+AtlasRegion {
+    bool packed = false;        ///< Indica si la textura quedó dentro del atlas.
+    unsigned int page = 0;      ///< Página del atlas que contiene la textura.
+    unsigned int x = 0;         ///< Posición X del contenido (sin gutter) en píxeles.
+    unsigned int y = 0;         ///< Posición Y del contenido (sin gutter) en píxeles.
+    unsigned int width = 0;     ///< Ancho de la textura de origen.
+    unsigned int height = 0;    ///< Alto de la textura de origen.
+};
+
+/**
+ * @brief Constructor de atlas de texturas en tiempo de importación.
+ *
+ * Junta las texturas pequeñas de un modelo en una o varias páginas usando el empaquetador
+ * skyline de stb_rectpack, agrega un gutter con los bordes extruidos alrededor de cada
+ * textura y alinea cada región al tamaño del último mip para que el filtrado de mips no
+ * mezcle texturas vecinas. Después reescribe las UVs de las mallas para que todas las mallas
+ * del actor compartan la misma textura.
+ *
+ * Se asume la convención de Actor::render: la malla i usa la textura i.
+ */
+class
+TextureAtlas {
+public:
+    TextureAtlas() = default;
+    ~TextureAtlas() = default;
+
+    /**
+     * @brief Construye el atlas y reescribe las UVs de las mallas empaquetadas.
+     * @param device Referencia al dispositivo de render.
+     * @param textureNames Rutas de las texturas PNG, en el orden de las mallas.
+     * @param meshes Mallas del modelo; sus UVs se reescriben si su textura entra al atlas.
+     * @param meshTextures Salida: textura a enlazar por cada malla (página del atlas o textura propia).
+     * @return HRESULT Resultado de la operación.
+     */
+    HRESULT
+    init(Device& device,
+         const std::vector<std::string>& textureNames,
+         std::vector<MeshComponent>& meshes,
+         std::vector<Texture>& meshTextures);
+
+    /**
+     * @brief Libera los datos de CPU utilizados durante la construcción.
+     *
+     * Las texturas creadas pasan a ser propiedad de quien recibe meshTextures.
+     */
+    void
+    destroy();
+
+    /**
+     * @brief Tamaño de un texel en UVs de la página que contiene la textura de la malla.
+     * @param mesh Índice de la malla.
+     * @return 0 si la textura de la malla no entró al atlas (sus UVs no cambiaron).
+     */
+    float
+    getTexelSize(unsigned int mesh) const;
+
+private:
+    /**
+     * @brief Indica si las UVs de la malla caben en una sola celda [k, k + 1].
+     * @param mesh Malla a revisar.
+     * @param cellU Salida: origen entero de la celda en U.
+     * @param cellV Salida: origen entero de la celda en V.
+     * @return true si la malla no usa repetición (wrap) de la textura.
+     */
+    bool
+    fitsSingleCell(const MeshComponent& mesh, float& cellU, float& cellV) const;
+
+    /**
+     * @brief Empaqueta las texturas candidatas en páginas.
+     * @param candidates Índices de las texturas a empaquetar.
+     * @return Número de páginas utilizadas.
+     */
+    unsigned int
+    packCandidates(const std::vector<unsigned int>& candidates);
+
+    /**
+     * @brief Registra en m_regions los rectángulos empaquetados en una página.
+     * @param rects Rectángulos devueltos por stb_rectpack (en bloques).
+     * @param page Índice de la página.
+     * @param pageSize Tamaño de la página en píxeles.
+     * @param blockSize Tamaño del bloque de alineación en píxeles.
+     */
+    void
+    assignPage(const std::vector<stbrp_rect>& rects,
+               unsigned int page,
+               unsigned int pageSize,
+               unsigned int blockSize);
+
+    /**
+     * @brief Compone los píxeles de una página y genera su cadena de mips.
+     * @param device Referencia al dispositivo de render.
+     * @param page Índice de la página.
+     * @param texture Salida: textura creada para la página.
+     * @return HRESULT Resultado de la creación.
+     */
+    HRESULT
+    buildPage(Device& device, unsigned int page, Texture& texture);
+
+public:
+    unsigned int m_maxPageSize = 2048;    ///< Tamaño máximo de una página del atlas.
+    unsigned int m_maxTextureSize = 512;  ///< Tamaño máximo de una textura para considerarla pequeña.
+    unsigned int m_padding = 4;           ///< Gutter en píxeles alrededor de cada textura.
+    unsigned int m_mipLevels = 4;         ///< Niveles de mip generados para cada página.
+
+    unsigned int m_packedCount = 0;       ///< Texturas que terminaron dentro del atlas.
+    unsigned int m_standaloneCount = 0;   ///< Texturas que conservaron su propia textura.
+    unsigned int m_pageCount = 0;         ///< Páginas creadas.
+
+private:
+    struct SourceImage {
+        unsigned char* pixels = nullptr;  ///< Píxeles RGBA8 cargados con stb_image.
+        int width = 0;
+        int height = 0;
+    };
+
+    std::vector<SourceImage> m_images;    ///< Imágenes de origen en memoria.
+    std::vector<AtlasRegion> m_regions;   ///< Región asignada a cada textura de origen.
+    std::vector<unsigned int> m_pageSizes;///< Tamaño (cuadrado) de cada página.
+};
@@ -7,10 +7,11 @@
 #include "ImGuizmo.h"
 #include "ECS/Transform.h"
 #include "ECS/Actor.h"
+#include "FrameStats.h"
 
 
 /**
- * @brief Clase encargada de la interfaz grfica de usuario utilizando ImGui e ImGuizmo.
+ * @brief Clase encargada de la interfaz gráfica de usuario utilizando ImGui e ImGuizmo.
  *
  * Proporciona controles interactivos para manipular transformaciones y renderizar elementos UI.
  */
@@ -39,17 +40,30 @@ public:
 	update();
 
 	/**
-	 * @brief Renderiza la interfaz grfica, incluyendo manipuladores de transformacin.
-	 * @param position Vector de posicin del objeto.
-	 * @param rotation Vector de rotacin del objeto.
+	 * @brief Renderiza la interfaz gráfica, incluyendo manipuladores de transformación.
+	 * @param position Vector de posición del objeto.
+	 * @param rotation Vector de rotación del objeto.
 	 * @param scale Vector de escala del objeto.
 	 * @param modelMatrix Matriz del modelo.
 	 * @param viewMatrix Matriz de vista.
-	 * @param projectionMatrix Matriz de proyeccin.
+	 * @param projectionMatrix Matriz de proyección.
 	 */
 	void
 	render(std::vector<EngineUtilities::TSharedPointer<Actor>>& actors);
 
+	/**
+	 * @brief Selecciona un actor en el inspector (por ejemplo, al hacer clic sobre él en la escena).
+	 * @param index Índice del actor en la lista que recibe render().
+	 */
+	void
+	setSelectedActor(int index) { selectedActorIndex = index; }
+
+	/**
+	 * @brief Historial de estadísticas que muestra el panel "Stats" (nullptr = sin panel).
+	 */
+	void
+	setFrameStats(const FrameStats* stats) { m_frameStats = stats; }
+
 	/**
 	 * @brief Libera todos los recursos asociados a ImGui.
 	 */
@@ -71,6 +85,15 @@ public:
 			    float columnWidth = 100.0f);
 
 private:
-	ImGuizmo::OPERATION mode = ImGuizmo::TRANSLATE; ///< Modo actual de manipulacin (traslacin, rotacin o escala).
-	int selectedActorIndex = 0; ///< ndice del actor seleccionado
+	/**
+	 * @brief Dibuja el panel de estadísticas: gráfica y percentiles del tiempo de frame,
+	 *        contadores de render y memoria, y tiempos por bloque del profiler.
+	 */
+	void
+	statsWindow();
+
+private:
+	ImGuizmo::OPERATION mode = ImGuizmo::TRANSLATE; ///< Modo actual de manipulación (traslación, rotación o escala).
+	int selectedActorIndex = 0; ///< Índice del actor seleccionado
+	const FrameStats* m_frameStats = nullptr; ///< Estadísticas por frame (opcional).
 };
@@ -0,0 +1,477 @@
+#pragma once
+#include "MemoryTracker.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace EngineUtilities {
+	/**
+	 * @brief Estadísticas de un pool de objetos.
+	 */
+	struct PoolStats
+	{
+		size_t slotSize = 0;                    ///< Bytes por objeto (con alineación).
+		unsigned int slabs = 0;                 ///< Bloques reservados.
+		unsigned int capacity = 0;              ///< Objetos que caben en todos los bloques.
+		unsigned int live = 0;                  ///< Objetos vivos.
+		unsigned int peakLive = 0;              ///< Mayor número de objetos vivos.
+		unsigned int cached = 0;                ///< Huecos guardados en cachés de hilo.
+		unsigned int emptySlabs = 0;            ///< Bloques sin ningún objeto (liberables con trim()).
+		unsigned long long allocations = 0;     ///< Objetos creados desde el inicio.
+		unsigned long long deallocations = 0;   ///< Objetos destruidos desde el inicio.
+		float fragmentation = 0.0f;             ///< Huecos libres / capacidad de los bloques ocupados.
+	};
+
+	/**
+	 * @brief Pool de tamaño fijo para objetos de tipo T.
+	 *
+	 * Los objetos se guardan contiguos en bloques (slabs) alineados a su propio tamaño, de modo
+	 * que el bloque de un hueco se obtiene enmascarando su dirección. Los huecos libres forman
+	 * una lista enlazada dentro de la propia memoria libre. Cada hilo guarda hasta
+	 * 2 * kThreadCacheSize huecos propios para crear y destruir sin tomar el mutex; la caché
+	 * se rellena y se vacía por lotes.
+	 *
+	 * El pool nunca se destruye: los objetos pueden liberarse durante la destrucción estática
+	 * (por ejemplo, actores de la aplicación global) después de que terminen otros singletons.
+	 *
+	 * @tparam T Tipo de los objetos.
+	 */
+	template<typename T>
+	class TObjectPool
+	{
+	private:
+		static constexpr size_t kAlignment = alignof(T) > sizeof(void*) ? alignof(T) : sizeof(void*);
+		static constexpr size_t kHeaderSize = 64;  ///< Encabezado del bloque (una línea de caché).
+
+		static constexpr size_t
+		slabBytesFor(size_t slot) {
+			size_t bytes = 64 * 1024;
+			while (bytes < kHeaderSize + 8 * slot) {
+				bytes *= 2;
+			}
+			return bytes;
+		}
+
+	public:
+		static constexpr size_t kSlotSize = (sizeof(T) + kAlignment - 1) & ~(kAlignment - 1); ///< Bytes por hueco.
+		static constexpr size_t kSlabBytes = slabBytesFor(kSlotSize);                     ///< Bytes por bloque.
+		static constexpr unsigned int kSlotsPerSlab =
+			static_cast<unsigned int>((kSlabBytes - kHeaderSize) / kSlotSize);            ///< Huecos por bloque.
+		static constexpr unsigned int kThreadCacheSize = 32;                               ///< Huecos por lote de la caché.
+
+		/**
+		 * @brief Pool único del tipo T.
+		 */
+		static TObjectPool&
+		getInstance()
+		{
+			static TObjectPool* instance = new TObjectPool();
+			return *instance;
+		}
+
+		/**
+		 * @brief Entrega memoria sin inicializar para un T.
+		 */
+		void*
+		allocate()
+		{
+			void* slot = nullptr;
+			ThreadCache& cache = s_cache;
+			if (m_useThreadCache.load(std::memory_order_relaxed) && !cache.retired)
+			{
+				if (cache.count == 0)
+				{
+					// El primer uso en el hilo registra la devolución de la caché al terminar
+					(void)&s_cacheFlusher;
+					cache.count = popSlots(cache.slots, kThreadCacheSize);
+				}
+				slot = cache.slots[--cache.count];
+			}
+			else
+			{
+				popSlots(&slot, 1);
+			}
+
+			const unsigned long long live =
+				m_allocations.fetch_add(1, std::memory_order_relaxed) + 1 -
+				m_deallocations.load(std::memory_order_relaxed);
+			unsigned int peak = m_peakLive.load(std::memory_order_relaxed);
+			while (live > peak && !m_peakLive.compare_exchange_weak(peak, static_cast<unsigned int>(live)))
+			{
+			}
+			return slot;
+		}
+
+		/**
+		 * @brief Devuelve al pool la memoria de un T ya destruido.
+		 */
+		void
+		deallocate(void* memory)
+		{
+			if (!memory)
+			{
+				return;
+			}
+			m_deallocations.fetch_add(1, std::memory_order_relaxed);
+			ThreadCache& cache = s_cache;
+			if (m_useThreadCache.load(std::memory_order_relaxed) && !cache.retired)
+			{
+				(void)&s_cacheFlusher;
+				cache.slots[cache.count++] = memory;
+				if (cache.count == 2 * kThreadCacheSize)
+				{
+					// Devolver la mitad más antigua para que la caché no acapare huecos
+					pushSlots(cache.slots, kThreadCacheSize);
+					for (unsigned int i = 0; i < kThreadCacheSize; ++i)
+					{
+						cache.slots[i] = cache.slots[i + kThreadCacheSize];
+					}
+					cache.count = kThreadCacheSize;
+				}
+			}
+			else
+			{
+				pushSlots(&memory, 1);
+			}
+		}
+
+		/**
+		 * @brief Activa o desactiva las cachés por hilo (los huecos ya guardados se conservan
+		 *        hasta que su hilo termine).
+		 */
+		void
+		setThreadCacheEnabled(bool enabled)
+		{
+			m_useThreadCache.store(enabled, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Libera los bloques que no tienen objetos ni huecos en cachés de hilo.
+		 * @return Bloques liberados.
+		 */
+		unsigned int
+		trim()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			// Quitar de la lista libre los huecos de bloques vacíos
+			FreeSlot** link = &m_freeList;
+			while (*link)
+			{
+				if (slabOf(*link)->used == 0)
+				{
+					*link = (*link)->next;
+					--m_freeCount;
+				}
+				else
+				{
+					link = &(*link)->next;
+				}
+			}
+
+			unsigned int released = 0;
+			for (size_t i = 0; i < m_slabs.size();)
+			{
+				if (m_slabs[i]->used == 0)
+				{
+					::operator delete(m_slabs[i], std::align_val_t(kSlabBytes));
+					m_slabs[i] = m_slabs.back();
+					m_slabs.pop_back();
+					++released;
+				}
+				else
+				{
+					++i;
+				}
+			}
+			return released;
+		}
+
+		/**
+		 * @brief Estadísticas actuales, incluida la fragmentación de los bloques ocupados.
+		 */
+		PoolStats
+		getStats()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			PoolStats stats;
+			stats.slotSize = kSlotSize;
+			stats.slabs = static_cast<unsigned int>(m_slabs.size());
+			stats.capacity = stats.slabs * kSlotsPerSlab;
+			stats.allocations = m_allocations.load(std::memory_order_relaxed);
+			stats.deallocations = m_deallocations.load(std::memory_order_relaxed);
+			stats.live = static_cast<unsigned int>(stats.allocations - stats.deallocations);
+			stats.peakLive = m_peakLive.load(std::memory_order_relaxed);
+
+			unsigned int occupiedCapacity = 0;
+			unsigned int occupiedUsed = 0;
+			for (const Slab* slab : m_slabs)
+			{
+				if (slab->used == 0)
+				{
+					++stats.emptySlabs;
+					continue;
+				}
+				occupiedCapacity += kSlotsPerSlab;
+				occupiedUsed += slab->used;
+			}
+			// Los huecos fuera de la lista libre son objetos vivos o huecos en cachés de hilo
+			stats.cached = occupiedUsed > stats.live ? occupiedUsed - stats.live : 0;
+			stats.fragmentation = occupiedCapacity > 0 ?
+				1.0f - static_cast<float>(occupiedUsed) / occupiedCapacity : 0.0f;
+			return stats;
+		}
+
+	private:
+		TObjectPool() = default;
+
+		struct FreeSlot
+		{
+			FreeSlot* next;
+		};
+
+		/**
+		 * @brief Encabezado de un bloque; ocupa la primera línea de caché.
+		 */
+		struct Slab
+		{
+			unsigned int used;  ///< Huecos fuera de la lista libre (objetos vivos o en cachés).
+		};
+
+		/**
+		 * @brief Huecos propios de un hilo. Es trivial para seguir siendo accesible después de
+		 *        que el hilo destruya sus thread_local (objetos liberados en la destrucción estática).
+		 */
+		struct ThreadCache
+		{
+			void* slots[2 * kThreadCacheSize];
+			unsigned int count;
+			bool retired;   ///< El hilo terminó; crear y destruir va directo al pool.
+		};
+
+		/**
+		 * @brief Devuelve la caché del hilo al pool cuando el hilo termina.
+		 */
+		struct ThreadCacheFlusher
+		{
+			~ThreadCacheFlusher()
+			{
+				ThreadCache& cache = s_cache;
+				if (cache.count > 0)
+				{
+					TObjectPool::getInstance().pushSlots(cache.slots, cache.count);
+				}
+				cache.count = 0;
+				cache.retired = true;
+			}
+		};
+
+		static Slab*
+		slabOf(void* slot)
+		{
+			return reinterpret_cast<Slab*>(reinterpret_cast<size_t>(slot) & ~(kSlabBytes - 1));
+		}
+
+		/**
+		 * @brief Saca count huecos de la lista libre (reserva un bloque si hace falta).
+		 */
+		unsigned int
+		popSlots(void** slots, unsigned int count)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				if (!m_freeList)
+				{
+					addSlab();
+				}
+				FreeSlot* slot = m_freeList;
+				m_freeList = slot->next;
+				--m_freeCount;
+				++slabOf(slot)->used;
+				slots[i] = slot;
+			}
+			return count;
+		}
+
+		/**
+		 * @brief Devuelve count huecos a la lista libre.
+		 */
+		void
+		pushSlots(void* const* slots, unsigned int count)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				FreeSlot* slot = static_cast<FreeSlot*>(slots[i]);
+				--slabOf(slot)->used;
+				slot->next = m_freeList;
+				m_freeList = slot;
+				++m_freeCount;
+			}
+		}
+
+		/**
+		 * @brief Reserva un bloque y enlaza sus huecos en orden de dirección.
+		 */
+		void
+		addSlab()
+		{
+			unsigned char* memory =
+				static_cast<unsigned char*>(::operator new(kSlabBytes, std::align_val_t(kSlabBytes)));
+			Slab* slab = new (memory) Slab();
+			slab->used = 0;
+			m_slabs.push_back(slab);
+
+			unsigned char* first = memory + kHeaderSize;
+			for (unsigned int i = kSlotsPerSlab; i > 0; --i)
+			{
+				FreeSlot* slot = reinterpret_cast<FreeSlot*>(first + (i - 1) * kSlotSize);
+				slot->next = m_freeList;
+				m_freeList = slot;
+			}
+			m_freeCount += kSlotsPerSlab;
+		}
+
+	private:
+		std::mutex m_mutex;                                     ///< Protege la lista libre y los bloques.
+		FreeSlot* m_freeList = nullptr;                         ///< Huecos libres.
+		unsigned int m_freeCount = 0;                           ///< Huecos en la lista libre.
+		std::vector<Slab*> m_slabs;                             ///< Bloques reservados.
+		std::atomic<bool> m_useThreadCache{ true };             ///< Usar cachés por hilo.
+		std::atomic<unsigned long long> m_allocations{ 0 };     ///< Objetos creados.
+		std::atomic<unsigned long long> m_deallocations{ 0 };   ///< Objetos destruidos.
+		std::atomic<unsigned int> m_peakLive{ 0 };              ///< Mayor número de objetos vivos.
+
+		static thread_local ThreadCache s_cache;                ///< Caché del hilo actual.
+		static thread_local ThreadCacheFlusher s_cacheFlusher;  ///< Vacía s_cache al terminar el hilo.
+	};
+
+	template<typename T>
+	thread_local typename TObjectPool<T>::ThreadCache TObjectPool<T>::s_cache = {};
+
+	template<typename T>
+	thread_local typename TObjectPool<T>::ThreadCacheFlusher TObjectPool<T>::s_cacheFlusher;
+
+	/**
+	 * @brief Objeto de 64 bytes que usa runObjectPoolBenchmark() (tamaño de un componente pequeño).
+	 */
+	struct PoolBenchmarkObject
+	{
+		float values[16];
+	};
+
+	/**
+	 * @brief Resultado de runObjectPoolBenchmark().
+	 */
+	struct PoolBenchmarkResult
+	{
+		unsigned int objects = 0;       ///< Objetos creados y destruidos por ronda.
+		unsigned int threads = 0;       ///< Hilos que reparten los objetos.
+		double poolMs = 0.0;            ///< Tiempo de pared con TObjectPool.
+		double heapMs = 0.0;            ///< Tiempo de pared con ::operator new / delete.
+		double poolNsPerObject = 0.0;   ///< Crear + destruir un objeto con el pool (por hilo).
+		double heapNsPerObject = 0.0;   ///< Crear + destruir un objeto con el heap (por hilo).
+	};
+
+	/**
+	 * @brief Compara crear y destruir objetos con TObjectPool y con el heap general.
+	 *
+	 * Cada hilo crea su parte de los objetos (constructor que escribe los 64 bytes) y después los
+	 * destruye en el mismo orden. Se hace una ronda de calentamiento de cada variante antes de
+	 * medir; al terminar, trim() devuelve los bloques del pool.
+	 * @param objects Objetos por ronda.
+	 * @param threads Hilos (incluido el que llama).
+	 */
+	inline PoolBenchmarkResult
+	runObjectPoolBenchmark(unsigned int objects, unsigned int threads)
+	{
+		PoolBenchmarkResult result;
+		result.objects = objects;
+		result.threads = threads > 0 ? threads : 1;
+		TObjectPool<PoolBenchmarkObject>& pool = TObjectPool<PoolBenchmarkObject>::getInstance();
+
+		// Una ronda: devuelve el tiempo de pared y suma el tiempo de cada hilo en threadTime
+		auto round = [&](bool usePool, long long& threadTime) {
+			std::atomic<long long> total{ 0 };
+			auto work = [&](unsigned int thread) {
+				const unsigned int first = static_cast<unsigned int>(static_cast<unsigned long long>(objects) * thread / result.threads);
+				const unsigned int last = static_cast<unsigned int>(static_cast<unsigned long long>(objects) * (thread + 1) / result.threads);
+				std::vector<PoolBenchmarkObject*> live(last - first);
+				const auto start = std::chrono::steady_clock::now();
+				for (auto& object : live)
+				{
+					void* memory = usePool ? pool.allocate() : ::operator new(sizeof(PoolBenchmarkObject));
+					object = new (memory) PoolBenchmarkObject();
+				}
+				for (auto* object : live)
+				{
+					object->~PoolBenchmarkObject();
+					if (usePool)
+					{
+						pool.deallocate(object);
+					}
+					else
+					{
+						::operator delete(object);
+					}
+				}
+				total.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now() - start).count());
+			};
+
+			const auto start = std::chrono::steady_clock::now();
+			std::vector<std::thread> workers;
+			for (unsigned int thread = 1; thread < result.threads; ++thread)
+			{
+				workers.emplace_back(work, thread);
+			}
+			work(0);
+			for (auto& worker : workers)
+			{
+				worker.join();
+			}
+			threadTime = total.load();
+			return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		};
+
+		long long threadTime = 0;
+		round(true, threadTime);
+		result.poolMs = round(true, threadTime);
+		result.poolNsPerObject = objects > 0 ? static_cast<double>(threadTime) / objects : 0.0;
+		round(false, threadTime);
+		result.heapMs = round(false, threadTime);
+		result.heapNsPerObject = objects > 0 ? static_cast<double>(threadTime) / objects : 0.0;
+		pool.trim();
+		return result;
+	}
+}
+
+/**
+ * Enruta new/delete de una clase (y por lo tanto MakeShared/MakeUnique) a su TObjectPool y
+ * contabiliza los objetos en la etiqueta de memoria Tag. Las clases derivadas de otro tamaño
+ * vuelven al heap general (también contabilizadas: delete recibe el tamaño dinámico).
+ */
+#define DECLARE_POOL_ALLOCATION(Type, Tag)                                                  \
+public:                                                                                     \
+    static void* operator new(size_t size) {                                                \
+        void* memory = size == sizeof(Type) ?                                               \
+            EngineUtilities::TObjectPool<Type>::getInstance().allocate() : ::operator new(size); \
+        MEMORY_TRACK_ALLOC(Tag, memory, size);                                              \
+        return memory;                                                                      \
+    }                                                                                       \
+    static void operator delete(void* memory, size_t size) {                                \
+        if (!memory) {                                                                      \
+            return;                                                                         \
+        }                                                                                   \
+        MEMORY_TRACK_FREE(Tag, memory, size);                                               \
+        if (size == sizeof(Type)) {                                                         \
+            EngineUtilities::TObjectPool<Type>::getInstance().deallocate(memory);           \
+        }                                                                                   \
+        else {                                                                              \
+            ::operator delete(memory);                                                      \
+        }                                                                                   \
+    }
@@ -67,7 +67,7 @@ namespace EngineUtilities {
     }
 
     /**
-     * @brief Operador de asignacin de movimiento.
+     * @brief Operador de asignación de movimiento.
      *
      * Libera el objeto actual y transfiere la propiedad del puntero del otro
      * TUniquePtr al actual.
@@ -104,7 +104,7 @@ namespace EngineUtilities {
     TUniquePtr<T>& operator=(const TUniquePtr<T>&) = delete;
 
     /**
-     * @brief Operador de desreferenciacin.
+     * @brief Operador de desreferenciación.
      *
      * @return Referencia al objeto gestionado.
      */
@@ -165,7 +165,7 @@ namespace EngineUtilities {
   };
 
   /**
-   * @brief Funcin de utilidad para crear un TUniquePtr.
+   * @brief Función de utilidad para crear un TUniquePtr.
    *
    * @tparam T Tipo del objeto gestionado.
    * @tparam Args Tipos de los argumentos del constructor del objeto gestionado.
@@ -220,7 +220,7 @@ namespace EngineUtilities {
       MyClass* rawPtr = up2.release();
       rawPtr->display();
       delete rawPtr; // Manualmente liberar la memoria ya que fue liberada del TUniquePtr
-    } // Aqu, up1 y up2 se destruyen y la memoria de MyClass se libera automticamente si no fue liberada antes
+    } // Aquí, up1 y up2 se destruyen y la memoria de MyClass se libera automáticamente si no fue liberada antes
 
     return 0;
   }
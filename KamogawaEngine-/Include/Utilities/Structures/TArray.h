@@ -28,23 +28,31 @@
 */
 
 #pragma once
+#include "MemoryTracker.h"
+#include <memory>
+#include <new>
+#include <utility>
+
 namespace EngineUtilities {
 	/**
-	 * @brief TArray es una clase de array dinmica para almacenar elementos de tipo T.
+	 * @brief TArray es una clase de array dinámica para almacenar elementos de tipo T.
 	 *
-	 * Esta implementacin de TArray proporciona una forma sencilla de almacenar y gestionar
-	 * colecciones de elementos, con operaciones bsicas como agregar, eliminar y acceder a elementos.
-	 * La memoria se gestiona dinmicamente, aumentando la capacidad del array segn sea necesario.
+	 * Esta implementación de TArray proporciona una forma sencilla de almacenar y gestionar
+	 * colecciones de elementos, con operaciones básicas como agregar, eliminar y acceder a elementos.
+	 * La memoria se gestiona dinámicamente, aumentando la capacidad del array según sea necesario.
 	 *
 	 * @tparam T El tipo de elementos almacenados en el array.
+	 * @tparam Allocator Asignador de la memoria (p. ej. FrameAllocator para datos temporales del frame).
+	 *                   Por defecto se contabiliza en la etiqueta General del MemoryTracker.
 	 */
-	template<typename T>
+	template<typename T, typename Allocator = TrackedAllocator<T, MEMORY_TAG_GENERAL>>
 	class TArray
 	{
 	private:
 		T* Data;           ///< Puntero a la memoria donde se almacenan los elementos del array.
-		size_t Capacity;   ///< Capacidad actual del array (nmero de elementos que puede almacenar).
-		size_t Size;       ///< Nmero de elementos actualmente en el array.
+		size_t Capacity;   ///< Capacidad actual del array (número de elementos que puede almacenar).
+		size_t Size;       ///< Número de elementos actualmente en el array.
+		Allocator Alloc;   ///< Asignador de la memoria de los elementos.
 
 		/**
 		 * @brief Redimensiona el array para tener una nueva capacidad.
@@ -53,19 +61,23 @@ namespace EngineUtilities {
 		 */
 		void Resize(size_t NewCapacity)
 		{
-			T* NewData = new T[NewCapacity];  ///< Crear un nuevo bloque de memoria con la nueva capacidad.
+			T* NewData = Alloc.allocate(NewCapacity);  ///< Crear un nuevo bloque de memoria con la nueva capacidad.
 			for (size_t i = 0; i < Size; ++i)
 			{
-				NewData[i] = Data[i];  ///< Copiar los elementos existentes al nuevo bloque de memoria.
+				new (&NewData[i]) T(std::move(Data[i]));  ///< Mover los elementos existentes al nuevo bloque de memoria.
+				Data[i].~T();
+			}
+			if (Data)
+			{
+				Alloc.deallocate(Data, Capacity);  ///< Liberar la memoria del array antiguo.
 			}
-			delete[] Data;  ///< Liberar la memoria del array antiguo.
 			Data = NewData; ///< Actualizar el puntero Data para que apunte al nuevo bloque de memoria.
 			Capacity = NewCapacity;  ///< Actualizar la capacidad del array.
 		}
 
 	public:
 		/**
-		 * @brief Constructor por defecto que inicializa el array con capacidad y tamao cero.
+		 * @brief Constructor por defecto que inicializa el array con capacidad y tamaño cero.
 		 */
 		TArray() : Data(nullptr), Capacity(0), Size(0)	{}
 
@@ -73,13 +85,33 @@ namespace EngineUtilities {
 		 * @brief Destructor que libera la memoria asignada al array.
 		 */
 		~TArray()	{
-			delete[] Data;  ///< Liberar la memoria del array.
+			for (size_t i = 0; i < Size; ++i)
+			{
+				Data[i].~T();
+			}
+			if (Data)
+			{
+				Alloc.deallocate(Data, Capacity);  ///< Liberar la memoria del array.
+			}
+		}
+
+		/**
+		 * @brief Reserva memoria para al menos NewCapacity elementos sin cambiar el tamaño.
+		 *
+		 * @param NewCapacity La capacidad mínima deseada.
+		 */
+		void Reserve(size_t NewCapacity)
+		{
+			if (NewCapacity > Capacity)
+			{
+				Resize(NewCapacity);
+			}
 		}
 
 		/**
-		 * @brief Aade un nuevo elemento al final del array.
+		 * @brief Añade un nuevo elemento al final del array.
 		 *
-		 * @param Element El elemento a aadir al array.
+		 * @param Element El elemento a añadir al array.
 		 */
 		void Add(const T& Element)
 		{
@@ -87,68 +119,68 @@ namespace EngineUtilities {
 			{
 				Resize(Capacity == 0 ? 1 : Capacity * 2);  ///< Redimensionar si es necesario.
 			}
-			Data[Size++] = Element;  ///< Aadir el nuevo elemento y aumentar el tamao.
+			new (&Data[Size++]) T(Element);  ///< Añadir el nuevo elemento y aumentar el tamaño.
 		}
 
 		/**
-		 * @brief Elimina el elemento en la posicin especificada.
+		 * @brief Elimina el elemento en la posición especificada.
 		 *
-		 * @param Index La posicin del elemento a eliminar.
+		 * @param Index La posición del elemento a eliminar.
 		 */
 		void RemoveAt(size_t Index)
 		{
 			if (Index >= Size)
 			{
-				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de ndice fuera de rango.
+				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de índice fuera de rango.
 				return;
 			}
 			for (size_t i = Index; i < Size - 1; ++i)
 			{
-				Data[i] = Data[i + 1];  ///< Desplazar los elementos hacia la izquierda para llenar el hueco.
+				Data[i] = std::move(Data[i + 1]);  ///< Desplazar los elementos hacia la izquierda para llenar el hueco.
 			}
-			--Size;  ///< Disminuir el tamao del array.
+			Data[--Size].~T();  ///< Disminuir el tamaño del array.
 		}
 
 		/**
-		 * @brief Sobrecarga del operador [] para acceder a elementos por ndice.
+		 * @brief Sobrecarga del operador [] para acceder a elementos por índice.
 		 *
-		 * @param Index La posicin del elemento a acceder.
-		 * @return Referencia al elemento en la posicin especificada.
+		 * @param Index La posición del elemento a acceder.
+		 * @return Referencia al elemento en la posición especificada.
 		 */
 		T& operator[](size_t Index)
 		{
 			if (Index >= Size)
 			{
-				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de ndice fuera de rango.
+				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de índice fuera de rango.
 				exit(1);  ///< Salir del programa en caso de error.
 			}
-			return Data[Index];  ///< Devolver el elemento en la posicin especificada.
+			return Data[Index];  ///< Devolver el elemento en la posición especificada.
 		}
 
 		/**
-		 * @brief Versin constante de la sobrecarga del operador [] para acceder a elementos por ndice.
+		 * @brief Versión constante de la sobrecarga del operador [] para acceder a elementos por índice.
 		 *
-		 * @param Index La posicin del elemento a acceder.
-		 * @return Referencia constante al elemento en la posicin especificada.
+		 * @param Index La posición del elemento a acceder.
+		 * @return Referencia constante al elemento en la posición especificada.
 		 */
 		const T& operator[](size_t Index) const
 		{
 			if (Index >= Size)
 			{
-				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de ndice fuera de rango.
+				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de índice fuera de rango.
 				exit(1);  ///< Salir del programa en caso de error.
 			}
-			return Data[Index];  ///< Devolver el elemento en la posicin especificada.
+			return Data[Index];  ///< Devolver el elemento en la posición especificada.
 		}
 
 		/**
-		 * @brief Devuelve el nmero de elementos actualmente en el array.
+		 * @brief Devuelve el número de elementos actualmente en el array.
 		 *
-		 * @return El nmero de elementos en el array.
+		 * @return El número de elementos en el array.
 		 */
 		size_t Num() const
 		{
-			return Size;  ///< Devolver el tamao actual del array.
+			return Size;  ///< Devolver el tamaño actual del array.
 		}
 
 		/**
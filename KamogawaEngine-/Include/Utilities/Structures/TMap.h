@@ -29,11 +29,11 @@
 #pragma once
 namespace EngineUtilities {
 	/**
-	 * @brief TMap es una clase de mapa (diccionario) dinmica para almacenar pares clave-valor.
+	 * @brief TMap es una clase de mapa (diccionario) dinámica para almacenar pares clave-valor.
 	 *
-	 * Esta implementacin de TMap proporciona una forma sencilla de almacenar y gestionar
-	 * colecciones de pares clave-valor, con operaciones bsicas como agregar, eliminar y acceder a valores.
-	 * La memoria se gestiona dinmicamente, aumentando la capacidad del mapa segn sea necesario.
+	 * Esta implementación de TMap proporciona una forma sencilla de almacenar y gestionar
+	 * colecciones de pares clave-valor, con operaciones básicas como agregar, eliminar y acceder a valores.
+	 * La memoria se gestiona dinámicamente, aumentando la capacidad del mapa según sea necesario.
 	 *
 	 * @tparam K El tipo de las claves.
 	 * @tparam V El tipo de los valores.
@@ -52,8 +52,8 @@ namespace EngineUtilities {
 		};
 
 		Pair* Data;        ///< Puntero a la memoria donde se almacenan los pares clave-valor.
-		size_t Capacity;   ///< Capacidad actual del mapa (nmero de pares que puede almacenar).
-		size_t Size;       ///< Nmero de pares actualmente en el mapa.
+		size_t Capacity;   ///< Capacidad actual del mapa (número de pares que puede almacenar).
+		size_t Size;       ///< Número de pares actualmente en el mapa.
 
 		/**
 		 * @brief Redimensiona el mapa para tener una nueva capacidad.
@@ -74,7 +74,7 @@ namespace EngineUtilities {
 
 	public:
 		/**
-		 * @brief Constructor por defecto que inicializa el mapa con capacidad y tamao cero.
+		 * @brief Constructor por defecto que inicializa el mapa con capacidad y tamaño cero.
 		 */
 		TMap()
 			: Data(nullptr), Capacity(0), Size(0)
@@ -90,7 +90,7 @@ namespace EngineUtilities {
 		}
 
 		/**
-		 * @brief Aade un nuevo par clave-valor al mapa.
+		 * @brief Añade un nuevo par clave-valor al mapa.
 		 *
 		 * @param Key La clave del nuevo par.
 		 * @param Value El valor del nuevo par.
@@ -109,11 +109,11 @@ namespace EngineUtilities {
 			{
 				Resize(Capacity == 0 ? 1 : Capacity * 2);  ///< Redimensionar si es necesario.
 			}
-			Data[Size++] = Pair(Key, Value);  ///< Aadir el nuevo par y aumentar el tamao.
+			Data[Size++] = Pair(Key, Value);  ///< Añadir el nuevo par y aumentar el tamaño.
 		}
 
 		/**
-		 * @brief Elimina el par clave-valor en la posicin especificada.
+		 * @brief Elimina el par clave-valor en la posición especificada.
 		 *
 		 * @param Key La clave del par a eliminar.
 		 */
@@ -127,7 +127,7 @@ namespace EngineUtilities {
 					{
 						Data[j] = Data[j + 1];  ///< Desplazar los pares hacia la izquierda para llenar el hueco.
 					}
-					--Size;  ///< Disminuir el tamao del mapa.
+					--Size;  ///< Disminuir el tamaño del mapa.
 					return;
 				}
 			}
@@ -154,7 +154,7 @@ namespace EngineUtilities {
 		}
 
 		/**
-		 * @brief Versin constante de la sobrecarga del operador [] para acceder a valores por clave.
+		 * @brief Versión constante de la sobrecarga del operador [] para acceder a valores por clave.
 		 *
 		 * @param Key La clave del valor a acceder.
 		 * @return Referencia constante al valor asociado con la clave especificada.
@@ -173,13 +173,13 @@ namespace EngineUtilities {
 		}
 
 		/**
-		 * @brief Devuelve el nmero de pares actualmente en el mapa.
+		 * @brief Devuelve el número de pares actualmente en el mapa.
 		 *
-		 * @return El nmero de pares en el mapa.
+		 * @return El número de pares en el mapa.
 		 */
 		size_t Num() const
 		{
-			return Size;  ///< Devolver el tamao actual del mapa.
+			return Size;  ///< Devolver el tamaño actual del mapa.
 		}
 
 		/**
@@ -199,7 +199,7 @@ namespace EngineUtilities {
 	int main()
 	{
 		TMap<int, std::string> MyMap;  ///< Crear una instancia de TMap para claves enteras y valores string.
-		MyMap.Add(1, "One");  ///< Aadir pares clave-valor al mapa.
+		MyMap.Add(1, "One");  ///< Añadir pares clave-valor al mapa.
 		MyMap.Add(2, "Two");
 		MyMap.Add(3, "Three");
 
@@ -208,7 +208,7 @@ namespace EngineUtilities {
 		std::cout << "Key 1: " << MyMap[1] << std::endl;  ///< Acceder e imprimir el valor asociado con la clave 1.
 		std::cout << "Key 3: " << MyMap[3] << std::endl;  ///< Acceder e imprimir el valor asociado con la clave 3.
 
-		std::cout << "Size: " << MyMap.Num() << ", Capacity: " << MyMap.GetCapacity() << std::endl;  ///< Imprimir el tamao y la capacidad del mapa.
+		std::cout << "Size: " << MyMap.Num() << ", Capacity: " << MyMap.GetCapacity() << std::endl;  ///< Imprimir el tamaño y la capacidad del mapa.
 
 		return 0;
 	}
@@ -35,9 +35,9 @@ namespace EngineUtilities {
 	/**
 	 * @brief Clase TPair para representar un par de valores.
 	 *
-	 * La clase TPair almacena un par de valores de tipos especficos. Es similar a std::pair,
-	 * pero se ha diseado para ser simple y adaptable a tus necesidades. Esta clase proporciona
-	 * una manera eficiente de manejar pares de datos en tu cdigo.
+	 * La clase TPair almacena un par de valores de tipos específicos. Es similar a std::pair,
+	 * pero se ha diseñado para ser simple y adaptable a tus necesidades. Esta clase proporciona
+	 * una manera eficiente de manejar pares de datos en tu código.
 	 *
 	 * @tparam KeyType Tipo del primer valor (clave) del par.
 	 * @tparam ValueType Tipo del segundo valor (valor) del par.
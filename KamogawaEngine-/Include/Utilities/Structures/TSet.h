@@ -30,11 +30,11 @@
 
 namespace EngineUtilities {
 	/**
-	 * @brief TSet es una clase de conjunto dinmica para almacenar elementos nicos.
+	 * @brief TSet es una clase de conjunto dinámica para almacenar elementos únicos.
 	 *
-	 * Esta implementacin de TSet proporciona una forma sencilla de almacenar y gestionar
-	 * colecciones de elementos nicos, con operaciones bsicas como agregar, eliminar y verificar la existencia de elementos.
-	 * La memoria se gestiona dinmicamente, aumentando la capacidad del conjunto segn sea necesario.
+	 * Esta implementación de TSet proporciona una forma sencilla de almacenar y gestionar
+	 * colecciones de elementos únicos, con operaciones básicas como agregar, eliminar y verificar la existencia de elementos.
+	 * La memoria se gestiona dinámicamente, aumentando la capacidad del conjunto según sea necesario.
 	 *
 	 * @tparam T El tipo de los elementos almacenados en el conjunto.
 	 */
@@ -43,8 +43,8 @@ namespace EngineUtilities {
 	{
 	private:
 		T* Data;        ///< Puntero a la memoria donde se almacenan los elementos.
-		size_t Capacity;   ///< Capacidad actual del conjunto (nmero de elementos que puede almacenar).
-		size_t Size;       ///< Nmero de elementos actualmente en el conjunto.
+		size_t Capacity;   ///< Capacidad actual del conjunto (número de elementos que puede almacenar).
+		size_t Size;       ///< Número de elementos actualmente en el conjunto.
 
 		/**
 		 * @brief Redimensiona el conjunto para tener una nueva capacidad.
@@ -65,7 +65,7 @@ namespace EngineUtilities {
 
 	public:
 		/**
-		 * @brief Constructor por defecto que inicializa el conjunto con capacidad y tamao cero.
+		 * @brief Constructor por defecto que inicializa el conjunto con capacidad y tamaño cero.
 		 */
 		TSet()
 			: Data(nullptr), Capacity(0), Size(0)
@@ -81,21 +81,21 @@ namespace EngineUtilities {
 		}
 
 		/**
-		 * @brief Aade un nuevo elemento al conjunto.
+		 * @brief Añade un nuevo elemento al conjunto.
 		 *
-		 * @param Element El elemento a aadir.
+		 * @param Element El elemento a añadir.
 		 */
 		void Add(const T& Element)
 		{
 			if (Contains(Element))
 			{
-				return;  ///< No aadir duplicados.
+				return;  ///< No añadir duplicados.
 			}
 			if (Size == Capacity)
 			{
 				Resize(Capacity == 0 ? 1 : Capacity * 2);  ///< Redimensionar si es necesario.
 			}
-			Data[Size++] = Element;  ///< Aadir el nuevo elemento y aumentar el tamao.
+			Data[Size++] = Element;  ///< Añadir el nuevo elemento y aumentar el tamaño.
 		}
 
 		/**
@@ -113,7 +113,7 @@ namespace EngineUtilities {
 					{
 						Data[j] = Data[j + 1];  ///< Desplazar los elementos hacia la izquierda para llenar el hueco.
 					}
-					--Size;  ///< Disminuir el tamao del conjunto.
+					--Size;  ///< Disminuir el tamaño del conjunto.
 					return;
 				}
 			}
@@ -140,13 +140,13 @@ namespace EngineUtilities {
 		}
 
 		/**
-		 * @brief Devuelve el nmero de elementos actualmente en el conjunto.
+		 * @brief Devuelve el número de elementos actualmente en el conjunto.
 		 *
-		 * @return El nmero de elementos en el conjunto.
+		 * @return El número de elementos en el conjunto.
 		 */
 		size_t Num() const
 		{
-			return Size;  ///< Devolver el tamao actual del conjunto.
+			return Size;  ///< Devolver el tamaño actual del conjunto.
 		}
 
 		/**
@@ -166,7 +166,7 @@ namespace EngineUtilities {
 	int main()
 	{
 		TSet<int> MySet;  ///< Crear una instancia de TSet para elementos enteros.
-		MySet.Add(1);  ///< Aadir elementos al conjunto.
+		MySet.Add(1);  ///< Añadir elementos al conjunto.
 		MySet.Add(2);
 		MySet.Add(3);
 
@@ -175,7 +175,7 @@ namespace EngineUtilities {
 		std::cout << "Contains 1: " << MySet.Contains(1) << std::endl;  ///< Verificar e imprimir si el conjunto contiene el elemento 1.
 		std::cout << "Contains 2: " << MySet.Contains(2) << std::endl;  ///< Verificar e imprimir si el conjunto contiene el elemento 2.
 
-		std::cout << "Size: " << MySet.Num() << ", Capacity: " << MySet.GetCapacity() << std::endl;  ///< Imprimir el tamao y la capacidad del conjunto.
+		std::cout << "Size: " << MySet.Num() << ", Capacity: " << MySet.GetCapacity() << std::endl;  ///< Imprimir el tamaño y la capacidad del conjunto.
 
 		return 0;
 	}
@@ -29,7 +29,7 @@
 #pragma once
 namespace EngineUtilities {
 
-  // Constantes matemticas
+  // Constantes matemáticas
   constexpr float PI = 3.14159265358979323846f;
   constexpr float E = 2.71828182845904523536f;
 
@@ -54,7 +54,7 @@ namespace EngineUtilities {
 	}
 
   /**
-   * @brief Calcula el cuadrado de un nmero.
+   * @brief Calcula el cuadrado de un número.
    *
    * @param value El valor del cual se desea calcular el cuadrado.
    * @return El cuadrado del valor dado.
@@ -64,7 +64,7 @@ namespace EngineUtilities {
   }
 
   /**
-   * @brief Calcula el cubo de un nmero.
+   * @brief Calcula el cubo de un número.
    *
    * @param value El valor del cual se desea calcular el cubo.
    * @return El cubo del valor dado.
@@ -74,7 +74,7 @@ namespace EngineUtilities {
   }
 
   /**
-   * @brief Calcula la potencia de un nmero base elevado a un exponente usando el mtodo de exponenciacin rpida.
+   * @brief Calcula la potencia de un número base elevado a un exponente usando el método de exponenciación rápida.
    *
    * @param base La base de la potencia.
    * @param exponent El exponente al que se eleva la base.
@@ -93,7 +93,7 @@ namespace EngineUtilities {
   }
 
   /**
-   * @brief Calcula el valor absoluto de un nmero.
+   * @brief Calcula el valor absoluto de un número.
    *
    * @param value El valor del cual se desea calcular el valor absoluto.
    * @return El valor absoluto del valor dado.
@@ -103,7 +103,7 @@ namespace EngineUtilities {
   }
 
   /**
-   * @brief Devuelve el valor mximo de dos nmeros.
+   * @brief Devuelve el valor máximo de dos números.
    *
    * @param a El primer valor.
    * @param b El segundo valor.
@@ -114,7 +114,7 @@ namespace EngineUtilities {
   }
 
   /**
-   * @brief Devuelve el valor mnimo de dos nmeros.
+   * @brief Devuelve el valor mínimo de dos números.
    *
    * @param a El primer valor.
    * @param b El segundo valor.
@@ -125,17 +125,17 @@ namespace EngineUtilities {
   }
 
   /**
-   * @brief Redondea un nmero al entero ms cercano.
+   * @brief Redondea un número al entero más cercano.
    *
    * @param value El valor que se desea redondear.
-   * @return El valor redondeado al entero ms cercano.
+   * @return El valor redondeado al entero más cercano.
    */
   inline float round(float value) {
     return (value > 0) ? static_cast<int>(value + 0.5f) : static_cast<int>(value - 0.5f);
   }
 
   /**
-   * @brief Trunca un nmero a su parte entera, redondeando hacia abajo.
+   * @brief Trunca un número a su parte entera, redondeando hacia abajo.
    *
    * @param value El valor que se desea truncar.
    * @return La parte entera del valor dado, redondeada hacia abajo.
@@ -146,10 +146,10 @@ namespace EngineUtilities {
   }
 
   /**
-   * @brief Redondea un nmero hacia arriba al entero ms cercano.
+   * @brief Redondea un número hacia arriba al entero más cercano.
    *
    * @param value El valor que se desea redondear hacia arriba.
-   * @return El valor redondeado hacia arriba al entero ms cercano.
+   * @return El valor redondeado hacia arriba al entero más cercano.
    */
   inline float ceil(float value) {
     int intValue = static_cast<int>(value);
@@ -157,19 +157,19 @@ namespace EngineUtilities {
   }
 
   /**
-   * Calcula el valor absoluto de un nmero flotante.
+   * Calcula el valor absoluto de un número flotante.
    * @param value Valor flotante.
-   * @return Valor absoluto del nmero flotante.
+   * @return Valor absoluto del número flotante.
    */
   inline float fabs(float value) {
     return value < 0.0f ? -value : value;
   }
 
-  // Funciones Trigonomtricas
+  // Funciones Trigonométricas
   /**
-   * Calcula el seno de un ngulo en radianes.
-   * @param angle ngulo en radianes.
-   * @return Valor del seno del ngulo.
+   * Calcula el seno de un ángulo en radianes.
+   * @param angle Ángulo en radianes.
+   * @return Valor del seno del ángulo.
    */
   inline float sin(float angle) {
     float result = 0.0f;
@@ -185,32 +185,32 @@ namespace EngineUtilities {
   }
 
   /**
-   * Calcula el coseno de un ngulo en radianes.
-   * @param angle ngulo en radianes.
-   * @return Valor del coseno del ngulo.
+   * Calcula el coseno de un ángulo en radianes.
+   * @param angle Ángulo en radianes.
+   * @return Valor del coseno del ángulo.
    */
   inline float cos(float angle) {
     return sin(angle + PI / 2);
   }
 
   /**
-   * Calcula la tangente de un ngulo en radianes.
-   * @param angle ngulo en radianes.
-   * @return Valor de la tangente del ngulo.
+   * Calcula la tangente de un ángulo en radianes.
+   * @param angle Ángulo en radianes.
+   * @return Valor de la tangente del ángulo.
    */
   inline float tan(float angle) {
     float s = sin(angle);
     float c = cos(angle);
-    return c != 0.0f ? s / c : 0.0f; // Evita la divisin por cero
+    return c != 0.0f ? s / c : 0.0f; // Evita la división por cero
   }
 
   /**
    * Calcula el arco seno de un valor.
    * @param value Valor en el rango [-1, 1].
-   * @return ngulo en radianes.
+   * @return Ángulo en radianes.
    */
   inline float asin(float value) {
-    // Aproximacin con la serie de Taylor
+    // Aproximación con la serie de Taylor
     float x = value;
     float result = x;
     float term = x;
@@ -224,7 +224,7 @@ namespace EngineUtilities {
   /**
    * Calcula el arco coseno de un valor.
    * @param value Valor en el rango [-1, 1].
-   * @return ngulo en radianes.
+   * @return Ángulo en radianes.
    */
   inline float acos(float value) {
     return PI / 2 - asin(value);
@@ -233,10 +233,10 @@ namespace EngineUtilities {
   /**
    * Calcula el arco tangente de un valor.
    * @param value Valor.
-   * @return ngulo en radianes.
+   * @return Ángulo en radianes.
    */
   inline float atan(float value) {
-    // Aproximacin de la funcin arcotangente
+    // Aproximación de la función arcotangente
     float result = 0.0f;
     float term = value;
     for (int n = 0; n < 10; ++n) {
@@ -247,37 +247,37 @@ namespace EngineUtilities {
   }
 
   /**
-   * Calcula el seno hiperblico de un valor.
+   * Calcula el seno hiperbólico de un valor.
    * @param value Valor.
-   * @return Seno hiperblico.
+   * @return Seno hiperbólico.
    */
   inline float sinh(float value) {
     return (exp(value) - exp(-value)) / 2;
   }
 
   /**
-   * Calcula el coseno hiperblico de un valor.
+   * Calcula el coseno hiperbólico de un valor.
    * @param value Valor.
-   * @return Coseno hiperblico.
+   * @return Coseno hiperbólico.
    */
   inline float cosh(float value) {
     return (exp(value) + exp(-value)) / 2;
   }
 
   /**
-   * Calcula la tangente hiperblica de un valor.
+   * Calcula la tangente hiperbólica de un valor.
    * @param value Valor.
-   * @return Tangente hiperblica.
+   * @return Tangente hiperbólica.
    */
   inline float tanh(float value) {
     return sinh(value) / cosh(value);
   }
 
-  // Conversin entre Radianes y Grados
+  // Conversión entre Radianes y Grados
   /**
    * Convierte grados a radianes.
-   * @param degrees ngulo en grados.
-   * @return ngulo en radianes.
+   * @param degrees Ángulo en grados.
+   * @return Ángulo en radianes.
    */
   inline float radians(float degrees) {
     return degrees * PI / 180.0f;
@@ -285,16 +285,16 @@ namespace EngineUtilities {
 
   /**
    * Convierte radianes a grados.
-   * @param radians ngulo en radianes.
-   * @return ngulo en grados.
+   * @param radians Ángulo en radianes.
+   * @return Ángulo en grados.
    */
   inline float degrees(float radians) {
     return radians * 180.0f / PI;
   }
 
-  // Funciones Exponenciales y Logartmicas
+  // Funciones Exponenciales y Logarítmicas
   /**
-   * Calcula la funcin exponencial e^x.
+   * Calcula la función exponencial e^x.
    * @param value Exponente.
    * @return Valor de e^x.
    */
@@ -314,7 +314,7 @@ namespace EngineUtilities {
    * @return Logaritmo natural.
    */
   inline float log(float value) {
-    // Aproximacin usando la serie de Taylor
+    // Aproximación usando la serie de Taylor
     if (value <= 0) return 0;
     float x = (value - 1) / (value + 1);
     float x2 = x * x;
@@ -338,59 +338,59 @@ namespace EngineUtilities {
 
   // Operaciones de Redondeo Avanzadas
   /**
-   * Calcula el mdulo de dos nmeros.
+   * Calcula el módulo de dos números.
    * @param a Valor.
    * @param b Divisor.
-   * @return Mdulo.
+   * @return Módulo.
    */
   inline float mod(float a, float b) {
     return a - b * static_cast<int>(a / b);
   }
 
-  // Funciones de Geometra
+  // Funciones de Geometría
   /**
-   * Calcula el rea de un crculo dado su radio.
-   * @param radius Radio del crculo.
-   * @return rea del crculo.
+   * Calcula el área de un círculo dado su radio.
+   * @param radius Radio del círculo.
+   * @return Área del círculo.
    */
   inline float circleArea(float radius) {
     return PI * radius * radius;
   }
 
   /**
-   * Calcula la circunferencia de un crculo dado su radio.
-   * @param radius Radio del crculo.
-   * @return Circunferencia del crculo.
+   * Calcula la circunferencia de un círculo dado su radio.
+   * @param radius Radio del círculo.
+   * @return Circunferencia del círculo.
    */
   inline float circleCircumference(float radius) {
     return 2 * PI * radius;
   }
 
   /**
-   * Calcula el rea de un rectngulo dado su ancho y alto.
-   * @param width Ancho del rectngulo.
-   * @param height Alto del rectngulo.
-   * @return rea del rectngulo.
+   * Calcula el área de un rectángulo dado su ancho y alto.
+   * @param width Ancho del rectángulo.
+   * @param height Alto del rectángulo.
+   * @return Área del rectángulo.
    */
   inline float rectangleArea(float width, float height) {
     return width * height;
   }
 
   /**
-   * Calcula el permetro de un rectngulo dado su ancho y alto.
-   * @param width Ancho del rectngulo.
-   * @param height Alto del rectngulo.
-   * @return Permetro del rectngulo.
+   * Calcula el perímetro de un rectángulo dado su ancho y alto.
+   * @param width Ancho del rectángulo.
+   * @param height Alto del rectángulo.
+   * @return Perímetro del rectángulo.
    */
   inline float rectanglePerimeter(float width, float height) {
     return 2 * (width + height);
   }
 
   /**
-   * Calcula el rea de un tringulo dado su base y altura.
-   * @param base Base del tringulo.
-   * @param height Altura del tringulo.
-   * @return rea del tringulo.
+   * Calcula el área de un triángulo dado su base y altura.
+   * @param base Base del triángulo.
+   * @param height Altura del triángulo.
+   * @return Área del triángulo.
    */
   inline float triangleArea(float base, float height) {
     return 0.5f * base * height;
@@ -410,12 +410,12 @@ namespace EngineUtilities {
     return sqrt(dx * dx + dy * dy);
   }
 
-  // Funciones de Clculo Numrico
+  // Funciones de Cálculo Numérico
   /**
    * Interpola linealmente entre dos valores.
    * @param a Valor inicial.
    * @param b Valor final.
-   * @param t Parmetro de interpolacin entre 0 y 1.
+   * @param t Parámetro de interpolación entre 0 y 1.
    * @return Valor interpolado.
    */
   inline float lerp(float a, float b, float t) {
@@ -423,8 +423,8 @@ namespace EngineUtilities {
   }
 
   /**
-   * Calcula el factorial de un nmero entero.
-   * @param n Nmero entero no negativo.
+   * Calcula el factorial de un número entero.
+   * @param n Número entero no negativo.
    * @return Factorial de n.
    */
   inline int factorial(int n) {
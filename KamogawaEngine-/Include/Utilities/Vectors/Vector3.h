@@ -121,7 +121,7 @@ namespace EngineUtilities {
 			Vector3(1, 1, 1);
 		}
 
-		// Mtodo para obtener un puntero a los datos como un arreglo
+		// Método para obtener un puntero a los datos como un arreglo
 		// @return: Puntero a los componentes del vector
 		float* data() { return &x; }
 		const float* data() const { return &x; }
@@ -0,0 +1,237 @@
+#pragma once
+#include "Prerequisites.h"
+
+/**
+ * @brief Atributos que puede llevar un vértice en el vertex buffer.
+ */
+enum
+VertexAttribute {
+    VERTEX_ATTRIBUTE_POSITION = 0,  ///< SimpleVertex::Pos (POSITION).
+    VERTEX_ATTRIBUTE_NORMAL,        ///< SimpleVertex::Normal (NORMAL).
+    VERTEX_ATTRIBUTE_TANGENT,       ///< SimpleVertex::Tangent con el signo en w (TANGENT).
+    VERTEX_ATTRIBUTE_TEXCOORD0,     ///< SimpleVertex::Tex (TEXCOORD0).
+    VERTEX_ATTRIBUTE_TEXCOORD1,     ///< SimpleVertex::Tex1 (TEXCOORD1).
+    VERTEX_ATTRIBUTE_COLOR,         ///< SimpleVertex::Color (COLOR).
+    VERTEX_ATTRIBUTE_COUNT
+};
+
+/**
+ * @brief Codificación de un atributo en el vertex buffer.
+ */
+enum
+VertexEncoding {
+    VERTEX_ENCODING_NONE = 0,       ///< El atributo no está en el formato.
+    VERTEX_ENCODING_FLOAT,          ///< Floats de 32 bits (todas las componentes).
+    VERTEX_ENCODING_OCTAHEDRAL,     ///< Dirección unitaria octaédrica en 2 x 16 bits SNORM (normal).
+    VERTEX_ENCODING_SNORM8,         ///< 4 x 8 bits SNORM (tangente xyz y signo).
+    VERTEX_ENCODING_UNORM8,         ///< 4 x 8 bits UNORM (color).
+    VERTEX_ENCODING_UNORM16,        ///< 4 x 16 bits UNORM relativos a la caja de la malla (posición; w = 1).
+    VERTEX_ENCODING_HALF,           ///< 2 x 16 bits float (coordenadas de textura).
+    VERTEX_ENCODING_UNORM1010102    ///< 10:10:10:2 UNORM, xyz * 0.5 + 0.5 y el signo en los 2 bits (normal o tangente).
+};
+
+/**
+ * @brief Error máximo que introduce un formato respecto de los floats de SimpleVertex.
+ */
+struct
+VertexQuantizationError {
+    float position = 0.0f;      ///< Distancia en unidades del modelo.
+    float normal = 0.0f;        ///< Ángulo en grados.
+    float tangent = 0.0f;       ///< Ángulo en grados (180 si cambia el signo de la bitangente).
+    float texcoord = 0.0f;      ///< Diferencia absoluta en UV (TEXCOORD0 y TEXCOORD1).
+};
+
+struct VertexQuantizationSettings;
+
+/**
+ * @brief Descriptor de la disposición de un vértice en el vertex buffer.
+ *
+ * Los atributos van en el orden de VertexAttribute, sin huecos. Del mismo descriptor salen el
+ * stride, el empaquetado de SimpleVertex a bytes de GPU y la lista D3D11_INPUT_ELEMENT_DESC, así
+ * que el buffer y el input layout no pueden desincronizarse. Un shader puede ignorar atributos
+ * del formato que no lee.
+ */
+class
+VertexFormat {
+public:
+    VertexFormat() = default;
+
+    /**
+     * @brief Formato original del motor: posición y coordenadas de textura en floats (20 bytes).
+     */
+    static VertexFormat
+    simple();
+
+    /**
+     * @brief Formato de las mallas importadas: posición, normal octaédrica, tangente SNORM8 y
+     *        coordenadas de textura (28 bytes).
+     */
+    static VertexFormat
+    standard();
+
+    /**
+     * @brief Formato cuantizado: posición UNORM16 relativa a la caja de la malla, normal
+     *        octaédrica, tangente 10:10:10:2 y coordenadas de textura half (20 bytes).
+     *
+     * La posición se reconstruye con getPositionDecode(), que se multiplica por la matriz de mundo.
+     */
+    static VertexFormat
+    compact();
+
+    /**
+     * @brief Los mismos atributos, todos en floats de 32 bits (referencia sin cuantizar).
+     */
+    VertexFormat
+    unquantized() const;
+
+    /**
+     * @brief Agrega, cambia o quita (VERTEX_ENCODING_NONE) un atributo.
+     * @return El propio formato, para encadenar llamadas. Una codificación que el atributo no
+     *         admite se ignora con un error en el log.
+     */
+    VertexFormat&
+    set(VertexAttribute attribute, VertexEncoding encoding);
+
+    /**
+     * @brief Verdadero si la codificación es válida para el atributo.
+     */
+    static bool
+    isSupported(VertexAttribute attribute, VertexEncoding encoding);
+
+    VertexEncoding
+    getEncoding(VertexAttribute attribute) const { return m_encodings[attribute]; }
+
+    bool
+    has(VertexAttribute attribute) const { return m_encodings[attribute] != VERTEX_ENCODING_NONE; }
+
+    unsigned int
+    getOffset(VertexAttribute attribute) const { return m_offsets[attribute]; }
+
+    unsigned int
+    getStride() const { return m_stride; }
+
+    /**
+     * @brief Formato DXGI del atributo en el vertex buffer.
+     */
+    DXGI_FORMAT
+    getDxgiFormat(VertexAttribute attribute) const;
+
+    /**
+     * @brief Agrega al final de layout un elemento por atributo del formato.
+     * @param layout Lista de elementos del input layout.
+     * @param slot Slot de entrada del vertex buffer.
+     */
+    void
+    buildInputLayout(std::vector<D3D11_INPUT_ELEMENT_DESC>& layout, unsigned int slot = 0) const;
+
+    /**
+     * @brief Empaqueta vértices en el formato.
+     * @param vertices Vértices de la malla.
+     * @param count Número de vértices.
+     * @param output Destino de count * getStride() bytes.
+     * @param boundsMin Esquina mínima de la caja de la malla (posición UNORM16).
+     * @param boundsMax Esquina máxima de la caja de la malla (posición UNORM16).
+     */
+    void
+    pack(const SimpleVertex* vertices,
+         unsigned int count,
+         void* output,
+         const XMFLOAT3& boundsMin,
+         const XMFLOAT3& boundsMax) const;
+
+    /**
+     * @brief Decodifica vértices empaquetados con pack(); los atributos que el formato no
+     *        tiene quedan como estaban en vertices.
+     */
+    void
+    unpack(const void* input,
+           unsigned int count,
+           SimpleVertex* vertices,
+           const XMFLOAT3& boundsMin,
+           const XMFLOAT3& boundsMax) const;
+
+    /**
+     * @brief Error máximo de empaquetar y decodificar los vértices en el formato.
+     */
+    VertexQuantizationError
+    measureError(const SimpleVertex* vertices,
+                 unsigned int count,
+                 const XMFLOAT3& boundsMin,
+                 const XMFLOAT3& boundsMax) const;
+
+    /**
+     * @brief Copia del formato con los atributos que superan el error admitido en floats.
+     * @param vertices Vértices de la malla.
+     * @param count Número de vértices.
+     * @param boundsMin Esquina mínima de la caja de la malla.
+     * @param boundsMax Esquina máxima de la caja de la malla.
+     * @param settings Errores admitidos.
+     * @param error Salida: error del formato devuelto.
+     */
+    VertexFormat
+    fitError(const SimpleVertex* vertices,
+             unsigned int count,
+             const XMFLOAT3& boundsMin,
+             const XMFLOAT3& boundsMax,
+             const VertexQuantizationSettings& settings,
+             VertexQuantizationError& error) const;
+
+    /**
+     * @brief Matriz que lleva la posición del vertex buffer a espacio local.
+     *
+     * Con posición UNORM16 escala [0, 1] a la caja de la malla; con floats es la identidad. Se
+     * antepone a la matriz de mundo (decode * world), así que el shader no cambia.
+     */
+    XMMATRIX
+    getPositionDecode(const XMFLOAT3& boundsMin, const XMFLOAT3& boundsMax) const;
+
+    bool
+    operator==(const VertexFormat& other) const;
+
+    bool
+    operator!=(const VertexFormat& other) const { return !(*this == other); }
+
+private:
+    VertexEncoding m_encodings[VERTEX_ATTRIBUTE_COUNT] = {};    ///< Codificación por atributo.
+    unsigned int m_offsets[VERTEX_ATTRIBUTE_COUNT] = {};        ///< Desplazamiento en bytes por atributo.
+    unsigned int m_stride = 0;                                  ///< Tamaño del vértice en bytes.
+};
+
+/**
+ * @brief Parámetros de la elección del formato de vértice al importar una malla.
+ */
+struct
+VertexQuantizationSettings {
+    bool enabled = true;                            ///< Falso = todas las mallas en VertexFormat::standard().
+    VertexFormat format = VertexFormat::compact();  ///< Formato buscado; cada malla lo relaja por atributo.
+    float maxPositionError = 0.001f;                ///< Error de posición admitido en unidades del modelo.
+    float maxDirectionError = 1.0f;                 ///< Error de normal y tangente admitido en grados.
+    float maxTexcoordError = 1.0f / 4096.0f;        ///< Error de UV admitido (un cuarto de texel en 1024).
+};
+
+/**
+ * @brief Codifica una dirección unitaria en dos SNORM de 16 bits (proyección octaédrica).
+ */
+void
+encodeOctahedral(const XMFLOAT3& direction, short& x, short& y);
+
+/**
+ * @brief Reconstruye la dirección unitaria de encodeOctahedral().
+ *
+ * El shader hace lo mismo con el float2 que entrega el input layout:
+ * n = float3(e, 1 - |e.x| - |e.y|); si n.z < 0, n.xy = (1 - |n.yx|) * sign(n.xy); normalize(n).
+ */
+XMFLOAT3
+decodeOctahedral(short x, short y);
+
+/**
+ * @brief Convierte un float a half (redondeo al par más cercano; satura al máximo finito).
+ */
+unsigned short
+floatToHalf(float value);
+
+/**
+ * @brief Convierte un half a float.
+ */
+float
+halfToFloat(unsigned short value);
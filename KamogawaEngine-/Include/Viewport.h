@@ -9,7 +9,7 @@ DeviceContext;
 /**
  * @brief Clase que encapsula un viewport de Direct3D 11.
  *
- * Define la regin de la pantalla donde se renderizan los grficos.
+ * Define la región de la pantalla donde se renderizan los gráficos.
  */
 class 
 Viewport
@@ -21,22 +21,22 @@ public:
 	/**
 	 * @brief Inicializa el viewport usando las dimensiones de una ventana.
 	 * @param window Referencia a la ventana.
-	 * @return HRESULT Resultado de la operacin.
+	 * @return HRESULT Resultado de la operación.
 	 */
 	HRESULT
 	init(const Window& window);
 
 	/**
-	 * @brief Inicializa el viewport con un ancho y alto especficos.
+	 * @brief Inicializa el viewport con un ancho y alto específicos.
 	 * @param width Ancho del viewport.
 	 * @param height Alto del viewport.
-	 * @return HRESULT Resultado de la operacin.
+	 * @return HRESULT Resultado de la operación.
 	 */
 	HRESULT
 	init(unsigned int width, unsigned int height);
 
 	/**
-	 * @brief Actualiza la configuracin del viewport. (Vaco por diseo, puede ser extendido).
+	 * @brief Actualiza la configuración del viewport. (Vacío por diseño, puede ser extendido).
 	 */
 	void
 	update();
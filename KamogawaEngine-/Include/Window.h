@@ -5,7 +5,7 @@
  * @class Window
  * @brief Clase que gestiona una ventana en Windows para renderizado con Direct3D.
  *
- * Se encarga de la creacin, actualizacin, renderizado y destruccin de la ventana de la aplicacin.
+ * Se encarga de la creación, actualización, renderizado y destrucción de la ventana de la aplicación.
  */
 class 
 Window {
@@ -21,12 +21,12 @@ public:
     ~Window() = default;
 
     /**
-     * @brief Inicializa la ventana de la aplicacin.
+     * @brief Inicializa la ventana de la aplicación.
      *
-     * @param hInstance Identificador de la instancia de la aplicacin.
-     * @param nCmdShow Parmetro de control de visualizacin de la ventana.
-     * @param wndproc Puntero a la funcin de procedimiento de ventana.
-     * @return HRESULT Cdigo de resultado indicando xito o error en la operacin.
+     * @param hInstance Identificador de la instancia de la aplicación.
+     * @param nCmdShow Parámetro de control de visualización de la ventana.
+     * @param wndproc Puntero a la función de procedimiento de ventana.
+     * @return HRESULT Código de resultado indicando éxito o error en la operación.
      */
     HRESULT init(HINSTANCE hInstance, 
                  int nCmdShow, 
@@ -54,17 +54,17 @@ public:
     /// Identificador de la ventana en el sistema operativo.
     HWND m_hWnd = nullptr;
 
-    /// Ancho de la ventana en pxeles.
+    /// Ancho de la ventana en píxeles.
     unsigned int m_width;
 
-    /// Alto de la ventana en pxeles.
+    /// Alto de la ventana en píxeles.
     unsigned int m_height;
 
 private:
-    /// Identificador de la instancia de la aplicacin.
+    /// Identificador de la instancia de la aplicación.
     HINSTANCE m_hInst = nullptr;
 
-    /// Estructura que define los lmites de la ventana.
+    /// Estructura que define los límites de la ventana.
     RECT m_rect;
 
     /// Nombre de la ventana.
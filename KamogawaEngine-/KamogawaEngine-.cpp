@@ -31,6 +31,10 @@ WndProc(HWND hWnd, unsigned int message, WPARAM wParam, LPARAM lParam) {
 	
 	case WM_KEYDOWN:
 		app.keys[wParam] = true;
+		// F9 inicia/termina la captura del profiler (ignorando la repetición de tecla)
+		if (wParam == VK_F9 && !(lParam & (1 << 30))) {
+			app.toggleProfilerCapture();
+		}
 		break;
 
 	case WM_KEYUP:
@@ -47,6 +51,9 @@ WndProc(HWND hWnd, unsigned int message, WPARAM wParam, LPARAM lParam) {
 
 	case WM_LBUTTONDOWN:
 		app.mouseLeftDown = true;
+		if (!ImGui::GetIO().WantCaptureMouse) {
+			app.pickActor(LOWORD(lParam), HIWORD(lParam));
+		}
 		break;
 	
 	case WM_LBUTTONUP:
@@ -0,0 +1,715 @@
+#include "AABBTree.h"
+#include "FrustumCuller.h"
+#include "FrameArena.h"
+#include "FrameClock.h"
+#include <cfloat>
+#include <cmath>
+#include <random>
+
+namespace {
+	const unsigned int kBinCount = 16;     ///< Bins por eje del constructor SAH.
+	const unsigned int kMedianSplit = 8;   ///< Rangos de este tamaño o menos se parten por la mediana.
+
+	float
+	axisValue(const XMFLOAT3& v, unsigned int axis) {
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	}
+
+	/**
+	 * @brief Prueba de losas de un rayo contra una caja.
+	 * @param tEnter Salida: distancia de entrada (0 si el origen está dentro).
+	 */
+	bool
+	rayBox(const AABB& box,
+		   const XMFLOAT3& origin,
+		   const XMFLOAT3& inverseDirection,
+		   float maxDistance,
+		   float& tEnter) {
+		float tMin = 0.0f;
+		float tMax = maxDistance;
+		for (unsigned int axis = 0; axis < 3; ++axis) {
+			float o = axisValue(origin, axis);
+			float inv = axisValue(inverseDirection, axis);
+			float t1 = (axisValue(box.lower, axis) - o) * inv;
+			float t2 = (axisValue(box.upper, axis) - o) * inv;
+			// Un rayo paralelo al eje que empieza sobre la cara produce NaN; las comparaciones
+			// con NaN son falsas y la losa se ignora
+			tMin = std::max(tMin, std::min(t1, t2));
+			tMax = std::min(tMax, std::max(t1, t2));
+		}
+		tEnter = tMin;
+		return tMin <= tMax;
+	}
+}
+
+int
+AABBTree::insert(const AABB& box, void* userData) {
+	int leaf = allocateNode();
+	m_nodes[leaf].tight = box;
+	m_nodes[leaf].box = inflate(box);
+	m_nodes[leaf].userData = userData;
+	m_nodes[leaf].height = 0;
+	insertLeaf(leaf);
+	++m_leafCount;
+	return leaf;
+}
+
+void
+AABBTree::remove(int proxy) {
+	if (proxy < 0 || proxy >= static_cast<int>(m_nodes.size()) || m_nodes[proxy].height != 0) {
+		ERROR("AABBTree", "remove", "Invalid proxy");
+		return;
+	}
+	removeLeaf(proxy);
+	freeNode(proxy);
+	--m_leafCount;
+}
+
+bool
+AABBTree::move(int proxy, const AABB& box) {
+	m_nodes[proxy].tight = box;
+	if (m_nodes[proxy].box.contains(box)) {
+		return false;
+	}
+
+	removeLeaf(proxy);
+	m_nodes[proxy].box = inflate(box);
+	insertLeaf(proxy);
+	return true;
+}
+
+void
+AABBTree::build(const std::vector<AABB>& boxes,
+				const std::vector<void*>& userData,
+				std::vector<int>& proxies) {
+	clear();
+	const unsigned int count = static_cast<unsigned int>(boxes.size());
+	proxies.resize(count);
+	if (count == 0) {
+		return;
+	}
+
+	// Las hojas ocupan los primeros nodos para que los proxies coincidan con los índices de entrada
+	m_nodes.reserve(2 * count - 1);
+	m_nodes.resize(count);
+	for (unsigned int i = 0; i < count; ++i) {
+		Node& node = m_nodes[i];
+		node.tight = boxes[i];
+		node.box = inflate(boxes[i]);
+		node.userData = i < userData.size() ? userData[i] : nullptr;
+		proxies[i] = static_cast<int>(i);
+	}
+
+	std::vector<BuildEntry> entries(count);
+	for (unsigned int i = 0; i < count; ++i) {
+		const AABB& box = m_nodes[i].box;
+		entries[i].box = box;
+		entries[i].center = XMFLOAT3((box.lower.x + box.upper.x) * 0.5f,
+									 (box.lower.y + box.upper.y) * 0.5f,
+									 (box.lower.z + box.upper.z) * 0.5f);
+		entries[i].leaf = static_cast<int>(i);
+	}
+	m_root = buildRange(entries.data(), count);
+	m_nodes[m_root].parent = kNullNode;
+	m_leafCount = count;
+}
+
+void
+AABBTree::clear() {
+	m_nodes.clear();
+	m_root = kNullNode;
+	m_freeList = kNullNode;
+	m_leafCount = 0;
+}
+
+void
+AABBTree::queryFrustum(const XMMATRIX& viewProjection, std::vector<void*>& results) const {
+	if (m_root == kNullNode) {
+		return;
+	}
+
+	XMFLOAT4 planes[6];
+	FrustumCuller::extractPlanes(viewProjection, planes);
+
+	// Cada entrada lleva la máscara de planos que aún cortan al padre; un subárbol
+	// completamente dentro de un plano ya no se prueba contra él
+	FrameVector<std::pair<int, unsigned int>> stack;
+	stack.reserve(64);
+	stack.push_back(std::make_pair(m_root, 0x3Fu));
+	while (!stack.empty()) {
+		const int index = stack.back().first;
+		unsigned int mask = stack.back().second;
+		stack.pop_back();
+
+		const Node& node = m_nodes[index];
+		const AABB& box = node.isLeaf() ? node.tight : node.box;
+		const float cx = (box.lower.x + box.upper.x) * 0.5f;
+		const float cy = (box.lower.y + box.upper.y) * 0.5f;
+		const float cz = (box.lower.z + box.upper.z) * 0.5f;
+		const float ex = (box.upper.x - box.lower.x) * 0.5f;
+		const float ey = (box.upper.y - box.lower.y) * 0.5f;
+		const float ez = (box.upper.z - box.lower.z) * 0.5f;
+
+		bool outside = false;
+		for (unsigned int i = 0; i < 6 && !outside; ++i) {
+			if (!(mask & (1u << i))) {
+				continue;
+			}
+			const XMFLOAT4& plane = planes[i];
+			float distance = plane.x * cx + plane.y * cy + plane.z * cz + plane.w;
+			float radius = std::fabs(plane.x) * ex + std::fabs(plane.y) * ey + std::fabs(plane.z) * ez;
+			if (distance + radius < 0.0f) {
+				outside = true;
+			}
+			else if (distance - radius >= 0.0f) {
+				mask &= ~(1u << i);
+			}
+		}
+		if (outside) {
+			continue;
+		}
+
+		if (node.isLeaf()) {
+			results.push_back(node.userData);
+		}
+		else {
+			stack.push_back(std::make_pair(node.child1, mask));
+			stack.push_back(std::make_pair(node.child2, mask));
+		}
+	}
+}
+
+void
+AABBTree::queryOverlap(const AABB& box, std::vector<void*>& results) const {
+	if (m_root == kNullNode) {
+		return;
+	}
+
+	FrameVector<int> stack;
+	stack.reserve(64);
+	stack.push_back(m_root);
+	while (!stack.empty()) {
+		const Node& node = m_nodes[stack.back()];
+		stack.pop_back();
+		if (!node.box.overlaps(box)) {
+			continue;
+		}
+
+		if (node.isLeaf()) {
+			if (node.tight.overlaps(box)) {
+				results.push_back(node.userData);
+			}
+		}
+		else {
+			stack.push_back(node.child1);
+			stack.push_back(node.child2);
+		}
+	}
+}
+
+bool
+AABBTree::raycast(const XMFLOAT3& origin,
+				  const XMFLOAT3& direction,
+				  float maxDistance,
+				  RayHit& hit) const {
+	if (m_root == kNullNode) {
+		return false;
+	}
+
+	XMFLOAT3 inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+	float closest = maxDistance;
+	bool found = false;
+
+	FrameVector<int> stack;
+	stack.reserve(64);
+	stack.push_back(m_root);
+	while (!stack.empty()) {
+		const Node& node = m_nodes[stack.back()];
+		const int index = stack.back();
+		stack.pop_back();
+
+		float t = 0.0f;
+		if (!rayBox(node.box, origin, inverseDirection, closest, t)) {
+			continue;
+		}
+
+		if (node.isLeaf()) {
+			if (rayBox(node.tight, origin, inverseDirection, closest, t)) {
+				closest = t;
+				hit.userData = node.userData;
+				hit.proxy = index;
+				hit.distance = t;
+				found = true;
+			}
+			continue;
+		}
+
+		// Visitar primero el hijo más cercano para reducir pronto la distancia máxima
+		float t1 = 0.0f;
+		float t2 = 0.0f;
+		const bool hit1 = rayBox(m_nodes[node.child1].box, origin, inverseDirection, closest, t1);
+		const bool hit2 = rayBox(m_nodes[node.child2].box, origin, inverseDirection, closest, t2);
+		if (hit1 && hit2) {
+			stack.push_back(t1 <= t2 ? node.child2 : node.child1);
+			stack.push_back(t1 <= t2 ? node.child1 : node.child2);
+		}
+		else if (hit1) {
+			stack.push_back(node.child1);
+		}
+		else if (hit2) {
+			stack.push_back(node.child2);
+		}
+	}
+	return found;
+}
+
+float
+AABBTree::computeCost() const {
+	float cost = 0.0f;
+	for (const Node& node : m_nodes) {
+		if (node.height > 0) {
+			cost += node.box.surfaceArea();
+		}
+	}
+	return cost;
+}
+
+int
+AABBTree::allocateNode() {
+	if (m_freeList == kNullNode) {
+		m_nodes.push_back(Node());
+		return static_cast<int>(m_nodes.size() - 1);
+	}
+
+	int node = m_freeList;
+	m_freeList = m_nodes[node].parent;
+	m_nodes[node] = Node();
+	return node;
+}
+
+void
+AABBTree::freeNode(int node) {
+	m_nodes[node].parent = m_freeList;
+	m_nodes[node].height = -1;
+	m_nodes[node].userData = nullptr;
+	m_freeList = node;
+}
+
+void
+AABBTree::insertLeaf(int leaf) {
+	if (m_root == kNullNode) {
+		m_root = leaf;
+		m_nodes[leaf].parent = kNullNode;
+		return;
+	}
+
+	// 01. Elegir hermano
+	const int sibling = findBestSibling(m_nodes[leaf].box);
+
+	// 02. Crear el nuevo padre en el lugar del hermano
+	const int oldParent = m_nodes[sibling].parent;
+	const int newParent = allocateNode();
+	m_nodes[newParent].parent = oldParent;
+	m_nodes[newParent].child1 = sibling;
+	m_nodes[newParent].child2 = leaf;
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf].parent = newParent;
+
+	if (oldParent == kNullNode) {
+		m_root = newParent;
+	}
+	else if (m_nodes[oldParent].child1 == sibling) {
+		m_nodes[oldParent].child1 = newParent;
+	}
+	else {
+		m_nodes[oldParent].child2 = newParent;
+	}
+
+	// 03. Reajustar ancestros
+	refitAncestors(newParent);
+}
+
+void
+AABBTree::removeLeaf(int leaf) {
+	if (leaf == m_root) {
+		m_root = kNullNode;
+		return;
+	}
+
+	const int parent = m_nodes[leaf].parent;
+	const int grandParent = m_nodes[parent].parent;
+	const int sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+	// El hermano ocupa el lugar del padre
+	m_nodes[sibling].parent = grandParent;
+	if (grandParent == kNullNode) {
+		m_root = sibling;
+	}
+	else {
+		if (m_nodes[grandParent].child1 == parent) {
+			m_nodes[grandParent].child1 = sibling;
+		}
+		else {
+			m_nodes[grandParent].child2 = sibling;
+		}
+	}
+	freeNode(parent);
+
+	if (grandParent != kNullNode) {
+		refitAncestors(grandParent);
+	}
+}
+
+int
+AABBTree::findBestSibling(const AABB& box) {
+	// Ramificación y poda: el costo de elegir un nodo como hermano es el área del nuevo padre
+	// más lo que crecen todos sus ancestros; el costo heredado solo aumenta al bajar
+	const float boxArea = box.surfaceArea();
+	int best = m_root;
+	float bestCost = AABB::merge(box, m_nodes[m_root].box).surfaceArea();
+
+	auto compare = [](const std::pair<float, int>& a, const std::pair<float, int>& b) {
+		return a.first > b.first;
+	};
+	m_heap.clear();
+	m_heap.push_back(std::make_pair(0.0f, m_root));
+	while (!m_heap.empty()) {
+		std::pop_heap(m_heap.begin(), m_heap.end(), compare);
+		const float inherited = m_heap.back().first;
+		const int index = m_heap.back().second;
+		m_heap.pop_back();
+
+		const Node& node = m_nodes[index];
+		const float combinedArea = AABB::merge(box, node.box).surfaceArea();
+		const float cost = combinedArea + inherited;
+		if (cost < bestCost) {
+			bestCost = cost;
+			best = index;
+		}
+
+		if (node.isLeaf()) {
+			continue;
+		}
+
+		const float childInherited = inherited + combinedArea - node.box.surfaceArea();
+		if (boxArea + childInherited < bestCost) {
+			m_heap.push_back(std::make_pair(childInherited, node.child1));
+			std::push_heap(m_heap.begin(), m_heap.end(), compare);
+			m_heap.push_back(std::make_pair(childInherited, node.child2));
+			std::push_heap(m_heap.begin(), m_heap.end(), compare);
+		}
+	}
+	return best;
+}
+
+void
+AABBTree::refitAncestors(int node) {
+	while (node != kNullNode) {
+		Node& current = m_nodes[node];
+		const Node& child1 = m_nodes[current.child1];
+		const Node& child2 = m_nodes[current.child2];
+		current.box = AABB::merge(child1.box, child2.box);
+		current.height = 1 + std::max(child1.height, child2.height);
+
+		rotate(node);
+		node = m_nodes[node].parent;
+	}
+}
+
+void
+AABBTree::rotate(int node) {
+	const int b = m_nodes[node].child1;
+	const int c = m_nodes[node].child2;
+
+	// Candidatos: intercambiar un hijo con un nieto del otro lado. Solo cambia el área
+	// del hijo que recibe al nieto, así que se compara su área antes y después.
+	float bestDiff = 0.0f;
+	int swapChild = kNullNode;      // Hijo directo que baja
+	int swapGrandChild = kNullNode; // Nieto que sube
+
+	if (!m_nodes[c].isLeaf()) {
+		const float areaC = m_nodes[c].box.surfaceArea();
+		const int f = m_nodes[c].child1;
+		const int g = m_nodes[c].child2;
+		float diffBF = AABB::merge(m_nodes[b].box, m_nodes[g].box).surfaceArea() - areaC;
+		float diffBG = AABB::merge(m_nodes[b].box, m_nodes[f].box).surfaceArea() - areaC;
+		if (diffBF < bestDiff) {
+			bestDiff = diffBF;
+			swapChild = b;
+			swapGrandChild = f;
+		}
+		if (diffBG < bestDiff) {
+			bestDiff = diffBG;
+			swapChild = b;
+			swapGrandChild = g;
+		}
+	}
+	if (!m_nodes[b].isLeaf()) {
+		const float areaB = m_nodes[b].box.surfaceArea();
+		const int d = m_nodes[b].child1;
+		const int e = m_nodes[b].child2;
+		float diffCD = AABB::merge(m_nodes[c].box, m_nodes[e].box).surfaceArea() - areaB;
+		float diffCE = AABB::merge(m_nodes[c].box, m_nodes[d].box).surfaceArea() - areaB;
+		if (diffCD < bestDiff) {
+			bestDiff = diffCD;
+			swapChild = c;
+			swapGrandChild = d;
+		}
+		if (diffCE < bestDiff) {
+			bestDiff = diffCE;
+			swapChild = c;
+			swapGrandChild = e;
+		}
+	}
+
+	if (swapChild == kNullNode) {
+		return;
+	}
+
+	// El nieto sube al lugar del hijo y el hijo baja al lugar del nieto
+	const int other = m_nodes[swapGrandChild].parent;
+	Node& otherNode = m_nodes[other];
+	if (otherNode.child1 == swapGrandChild) {
+		otherNode.child1 = swapChild;
+	}
+	else {
+		otherNode.child2 = swapChild;
+	}
+	m_nodes[swapChild].parent = other;
+
+	Node& current = m_nodes[node];
+	if (current.child1 == swapChild) {
+		current.child1 = swapGrandChild;
+	}
+	else {
+		current.child2 = swapGrandChild;
+	}
+	m_nodes[swapGrandChild].parent = node;
+
+	otherNode.box = AABB::merge(m_nodes[otherNode.child1].box, m_nodes[otherNode.child2].box);
+	otherNode.height = 1 + std::max(m_nodes[otherNode.child1].height, m_nodes[otherNode.child2].height);
+	current.height = 1 + std::max(m_nodes[current.child1].height, m_nodes[current.child2].height);
+	++m_rotations;
+}
+
+int
+AABBTree::buildRange(BuildEntry* entries, unsigned int count) {
+	if (count == 1) {
+		return entries[0].leaf;
+	}
+
+	// 01. Caja de los centroides para ubicar los bins
+	XMFLOAT3 low = entries[0].center;
+	XMFLOAT3 high = entries[0].center;
+	for (unsigned int i = 1; i < count; ++i) {
+		const XMFLOAT3& c = entries[i].center;
+		low = XMFLOAT3(std::min(low.x, c.x), std::min(low.y, c.y), std::min(low.z, c.z));
+		high = XMFLOAT3(std::max(high.x, c.x), std::max(high.y, c.y), std::max(high.z, c.z));
+	}
+	const float lows[3] = { low.x, low.y, low.z };
+	const float extents[3] = { high.x - low.x, high.y - low.y, high.z - low.z };
+	float scales[3];
+	for (unsigned int axis = 0; axis < 3; ++axis) {
+		scales[axis] = extents[axis] > 0.0f ? kBinCount / extents[axis] : 0.0f;
+	}
+
+	// 02. Llenar los bins de los tres ejes en una sola pasada
+	unsigned int bestAxis = 0;
+	unsigned int bestSplit = 0;
+	float bestCost = FLT_MAX;
+	if (count > kMedianSplit) {
+		// Los bins empiezan como cajas vacías (invertidas) para unir sin ramas
+		AABB binBounds[3][kBinCount];
+		unsigned int binCounts[3][kBinCount] = {};
+		for (auto& axisBins : binBounds) {
+			for (auto& bin : axisBins) {
+				bin.lower = XMFLOAT3(FLT_MAX, FLT_MAX, FLT_MAX);
+				bin.upper = XMFLOAT3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+			}
+		}
+		for (unsigned int i = 0; i < count; ++i) {
+			const float centers[3] = { entries[i].center.x, entries[i].center.y, entries[i].center.z };
+			for (unsigned int axis = 0; axis < 3; ++axis) {
+				unsigned int bin = std::min(kBinCount - 1, static_cast<unsigned int>((centers[axis] - lows[axis]) * scales[axis]));
+				binBounds[axis][bin] = AABB::merge(binBounds[axis][bin], entries[i].box);
+				++binCounts[axis][bin];
+			}
+		}
+
+		// 03. Evaluar el costo SAH de cada frontera entre bins
+		for (unsigned int axis = 0; axis < 3; ++axis) {
+			if (scales[axis] == 0.0f) {
+				continue;
+			}
+
+			// Barrido de derecha a izquierda para las áreas del lado derecho
+			float rightArea[kBinCount];
+			unsigned int rightCount[kBinCount];
+			AABB accumulated;
+			unsigned int accumulatedCount = 0;
+			for (unsigned int bin = kBinCount - 1; bin > 0; --bin) {
+				if (binCounts[axis][bin]) {
+					accumulated = accumulatedCount ? AABB::merge(accumulated, binBounds[axis][bin]) : binBounds[axis][bin];
+					accumulatedCount += binCounts[axis][bin];
+				}
+				rightArea[bin] = accumulatedCount ? accumulated.surfaceArea() : 0.0f;
+				rightCount[bin] = accumulatedCount;
+			}
+
+			accumulatedCount = 0;
+			for (unsigned int bin = 0; bin < kBinCount - 1; ++bin) {
+				if (binCounts[axis][bin]) {
+					accumulated = accumulatedCount ? AABB::merge(accumulated, binBounds[axis][bin]) : binBounds[axis][bin];
+					accumulatedCount += binCounts[axis][bin];
+				}
+				if (accumulatedCount == 0 || rightCount[bin + 1] == 0) {
+					continue;
+				}
+				float cost = accumulated.surfaceArea() * accumulatedCount + rightArea[bin + 1] * rightCount[bin + 1];
+				if (cost < bestCost) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = bin;
+				}
+			}
+		}
+	}
+
+	// 04. Partir las hojas; en rangos pequeños (o sin división válida) por la mediana del eje más largo
+	unsigned int middle = count / 2;
+	if (bestCost == FLT_MAX) {
+		const unsigned int axis = extents[0] >= extents[1] ?
+								  (extents[0] >= extents[2] ? 0 : 2) :
+								  (extents[1] >= extents[2] ? 1 : 2);
+		std::nth_element(entries, entries + middle, entries + count, [axis](const BuildEntry& a, const BuildEntry& b) {
+			return axisValue(a.center, axis) < axisValue(b.center, axis);
+		});
+	}
+	else {
+		const float axisLow = lows[bestAxis];
+		const float axisScale = scales[bestAxis];
+		BuildEntry* split = std::partition(entries, entries + count, [&](const BuildEntry& entry) {
+			float center = axisValue(entry.center, bestAxis);
+			return std::min(kBinCount - 1, static_cast<unsigned int>((center - axisLow) * axisScale)) <= bestSplit;
+		});
+		middle = static_cast<unsigned int>(split - entries);
+	}
+
+	const int child1 = buildRange(entries, middle);
+	const int child2 = buildRange(entries + middle, count - middle);
+
+	const int node = allocateNode();
+	m_nodes[node].child1 = child1;
+	m_nodes[node].child2 = child2;
+	m_nodes[node].box = AABB::merge(m_nodes[child1].box, m_nodes[child2].box);
+	m_nodes[node].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+	m_nodes[child1].parent = node;
+	m_nodes[child2].parent = node;
+	return node;
+}
+
+AABB
+AABBTree::inflate(const AABB& box) const {
+	AABB fat;
+	fat.lower = XMFLOAT3(box.lower.x - m_margin, box.lower.y - m_margin, box.lower.z - m_margin);
+	fat.upper = XMFLOAT3(box.upper.x + m_margin, box.upper.y + m_margin, box.upper.z + m_margin);
+	return fat;
+}
+
+AABBTreeBenchmarkResult
+runAABBTreeBenchmark(unsigned int objects, unsigned int queries) {
+	constexpr unsigned int kQueryBatch = 256;   // Consultas entre vaciados de la arena del frame
+	AABBTreeBenchmarkResult result;
+	result.objects = objects;
+	queries = queries > 0 ? queries : 1;
+
+	// 01. Cajas aleatorias; el dato de cada objeto es su índice
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(-1000.0f, 1000.0f);
+	std::uniform_real_distribution<float> extent(0.5f, 2.0f);
+	std::vector<AABB> boxes(objects);
+	std::vector<void*> userData(objects);
+	for (unsigned int i = 0; i < objects; ++i) {
+		const XMFLOAT3 center(position(random), position(random), position(random));
+		const XMFLOAT3 half(extent(random), extent(random), extent(random));
+		boxes[i].lower = XMFLOAT3(center.x - half.x, center.y - half.y, center.z - half.z);
+		boxes[i].upper = XMFLOAT3(center.x + half.x, center.y + half.y, center.z + half.z);
+		userData[i] = reinterpret_cast<void*>(static_cast<size_t>(i) + 1);
+	}
+
+	// 02. Construcción
+	AABBTree tree;
+	std::vector<int> proxies;
+	long long start = FrameClock::now();
+	tree.build(boxes, userData, proxies);
+	result.buildMs = (FrameClock::now() - start) / 1.0e6;
+	result.height = tree.getHeight();
+	FrameArena::getInstance().endFrame();
+
+	// 03. Frustums desde el centro en direcciones repartidas alrededor del eje Y
+	const unsigned int frustumQueries = std::max(8u, queries / 1000);
+	const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 500.0f);
+	std::vector<void*> results;
+	unsigned long long found = 0;
+	long long elapsed = 0;
+	for (unsigned int q = 0; q < frustumQueries; ++q) {
+		const float yaw = XM_2PI * q / frustumQueries;
+		const XMMATRIX view = XMMatrixLookAtLH(XMVectorZero(),
+											   XMVectorSet(std::sin(yaw), 0.0f, std::cos(yaw), 0.0f),
+											   XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+		results.clear();
+		start = FrameClock::now();
+		tree.queryFrustum(view * projection, results);
+		elapsed += FrameClock::now() - start;
+		found += results.size();
+		FrameArena::getInstance().endFrame();
+	}
+	result.frustumQueryMs = elapsed / 1.0e6 / frustumQueries;
+	result.frustumResults = static_cast<double>(found) / frustumQueries;
+
+	// 04. Rayos entre dos puntos aleatorios del cubo
+	unsigned int hits = 0;
+	elapsed = 0;
+	for (unsigned int first = 0; first < queries; first += kQueryBatch) {
+		const unsigned int last = std::min(queries, first + kQueryBatch);
+		std::vector<std::pair<XMFLOAT3, XMFLOAT3>> rays(last - first);
+		for (auto& ray : rays) {
+			ray.first = XMFLOAT3(position(random), position(random), position(random));
+			const XMFLOAT3 target(position(random), position(random), position(random));
+			ray.second = XMFLOAT3(target.x - ray.first.x, target.y - ray.first.y, target.z - ray.first.z);
+		}
+		start = FrameClock::now();
+		for (const auto& ray : rays) {
+			RayHit hit;
+			hits += tree.raycast(ray.first, ray.second, 1.0f, hit) ? 1 : 0;
+		}
+		elapsed += FrameClock::now() - start;
+		FrameArena::getInstance().endFrame();
+	}
+	result.raycastsPerMs = elapsed > 0 ? queries / (elapsed / 1.0e6) : 0.0;
+	result.raycastHitRate = static_cast<double>(hits) / queries;
+
+	// 05. Cajas de consulta de 20 unidades
+	found = 0;
+	elapsed = 0;
+	for (unsigned int first = 0; first < queries; first += kQueryBatch) {
+		const unsigned int last = std::min(queries, first + kQueryBatch);
+		std::vector<AABB> queryBoxes(last - first);
+		for (auto& box : queryBoxes) {
+			const XMFLOAT3 center(position(random), position(random), position(random));
+			box.lower = XMFLOAT3(center.x - 10.0f, center.y - 10.0f, center.z - 10.0f);
+			box.upper = XMFLOAT3(center.x + 10.0f, center.y + 10.0f, center.z + 10.0f);
+		}
+		start = FrameClock::now();
+		for (const auto& box : queryBoxes) {
+			results.clear();
+			tree.queryOverlap(box, results);
+			found += results.size();
+		}
+		elapsed += FrameClock::now() - start;
+		FrameArena::getInstance().endFrame();
+	}
+	result.overlapQueriesPerMs = elapsed > 0 ? queries / (elapsed / 1.0e6) : 0.0;
+	result.overlapResults = static_cast<double>(found) / queries;
+	return result;
+}
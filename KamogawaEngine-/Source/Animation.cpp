@@ -0,0 +1,281 @@
+#include "Animation.h"
+#include "FrameArena.h"
+#include "CpuFeatures.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	unsigned int
+	padBones(unsigned int boneCount) {
+		return (boneCount + PoseSoA::kLanes - 1) / PoseSoA::kLanes * PoseSoA::kLanes;
+	}
+
+	/**
+	 * @brief Llena una pose SoA con la identidad.
+	 */
+	void
+	fillIdentity(float* channels, unsigned int paddedBones) {
+		for (int c = 0; c < POSE_CHANNEL_COUNT; ++c) {
+			const float value = (c == POSE_ROTATION_W || c >= POSE_SCALE_X) ? 1.0f : 0.0f;
+			std::fill(channels + static_cast<size_t>(c) * paddedBones,
+					  channels + static_cast<size_t>(c + 1) * paddedBones, value);
+		}
+	}
+
+	BoneTransform
+	readTransform(const float* channels, unsigned int paddedBones, unsigned int bone) {
+		auto at = [&](PoseChannel c) { return channels[static_cast<size_t>(c) * paddedBones + bone]; };
+		BoneTransform transform;
+		transform.translation = XMFLOAT3(at(POSE_TRANSLATION_X), at(POSE_TRANSLATION_Y), at(POSE_TRANSLATION_Z));
+		transform.rotation = XMFLOAT4(at(POSE_ROTATION_X), at(POSE_ROTATION_Y), at(POSE_ROTATION_Z), at(POSE_ROTATION_W));
+		transform.scale = XMFLOAT3(at(POSE_SCALE_X), at(POSE_SCALE_Y), at(POSE_SCALE_Z));
+		return transform;
+	}
+
+	void
+	writeTransform(float* channels, unsigned int paddedBones, unsigned int bone, const BoneTransform& transform) {
+		const float values[POSE_CHANNEL_COUNT] = { transform.translation.x, transform.translation.y, transform.translation.z,
+												   transform.rotation.x, transform.rotation.y, transform.rotation.z, transform.rotation.w,
+												   transform.scale.x, transform.scale.y, transform.scale.z };
+		for (int c = 0; c < POSE_CHANNEL_COUNT; ++c) {
+			channels[static_cast<size_t>(c) * paddedBones + bone] = values[c];
+		}
+	}
+
+	/**
+	 * @brief Interpola dos poses SoA canal por canal y normaliza los cuaterniones, 8 huesos por paso.
+	 */
+	void
+	blendPosesAVX2(const float* from, const float* to, float factor, unsigned int paddedBones, float* out) {
+		const __m256 weight = _mm256_set1_ps(factor);
+		const size_t channelCount = static_cast<size_t>(POSE_CHANNEL_COUNT) * paddedBones;
+		for (size_t i = 0; i < channelCount; i += PoseSoA::kLanes) {
+			const __m256 a = _mm256_loadu_ps(from + i);
+			const __m256 b = _mm256_loadu_ps(to + i);
+			_mm256_storeu_ps(out + i, _mm256_add_ps(a, _mm256_mul_ps(_mm256_sub_ps(b, a), weight)));
+		}
+
+		const __m256 one = _mm256_set1_ps(1.0f);
+		float* qx = out + static_cast<size_t>(POSE_ROTATION_X) * paddedBones;
+		float* qy = out + static_cast<size_t>(POSE_ROTATION_Y) * paddedBones;
+		float* qz = out + static_cast<size_t>(POSE_ROTATION_Z) * paddedBones;
+		float* qw = out + static_cast<size_t>(POSE_ROTATION_W) * paddedBones;
+		for (unsigned int bone = 0; bone < paddedBones; bone += PoseSoA::kLanes) {
+			const __m256 x = _mm256_loadu_ps(qx + bone);
+			const __m256 y = _mm256_loadu_ps(qy + bone);
+			const __m256 z = _mm256_loadu_ps(qz + bone);
+			const __m256 w = _mm256_loadu_ps(qw + bone);
+			__m256 length = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)),
+										  _mm256_add_ps(_mm256_mul_ps(z, z), _mm256_mul_ps(w, w)));
+			const __m256 inverse = _mm256_div_ps(one, _mm256_sqrt_ps(length));
+			_mm256_storeu_ps(qx + bone, _mm256_mul_ps(x, inverse));
+			_mm256_storeu_ps(qy + bone, _mm256_mul_ps(y, inverse));
+			_mm256_storeu_ps(qz + bone, _mm256_mul_ps(z, inverse));
+			_mm256_storeu_ps(qw + bone, _mm256_mul_ps(w, inverse));
+		}
+	}
+
+	void
+	blendPosesScalar(const float* from, const float* to, float factor, unsigned int paddedBones, float* out) {
+		const size_t channelCount = static_cast<size_t>(POSE_CHANNEL_COUNT) * paddedBones;
+		for (size_t i = 0; i < channelCount; ++i) {
+			out[i] = from[i] + (to[i] - from[i]) * factor;
+		}
+
+		float* qx = out + static_cast<size_t>(POSE_ROTATION_X) * paddedBones;
+		float* qy = out + static_cast<size_t>(POSE_ROTATION_Y) * paddedBones;
+		float* qz = out + static_cast<size_t>(POSE_ROTATION_Z) * paddedBones;
+		float* qw = out + static_cast<size_t>(POSE_ROTATION_W) * paddedBones;
+		for (unsigned int bone = 0; bone < paddedBones; ++bone) {
+			const float inverse = 1.0f / std::sqrt(qx[bone] * qx[bone] + qy[bone] * qy[bone] +
+												   qz[bone] * qz[bone] + qw[bone] * qw[bone]);
+			qx[bone] *= inverse;
+			qy[bone] *= inverse;
+			qz[bone] *= inverse;
+			qw[bone] *= inverse;
+		}
+	}
+	XMMATRIX
+	composeTransform(const BoneTransform& transform) {
+		return XMMatrixScalingFromVector(XMLoadFloat3(&transform.scale)) *
+			   XMMatrixRotationQuaternion(XMLoadFloat4(&transform.rotation)) *
+			   XMMatrixTranslationFromVector(XMLoadFloat3(&transform.translation));
+	}
+}
+
+int
+Skeleton::findBone(const std::string& name) const {
+	for (size_t i = 0; i < bones.size(); ++i) {
+		if (bones[i].name == name) {
+			return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
+
+void
+Skeleton::getBindPose(std::vector<BoneTransform>& pose) const {
+	pose.resize(bones.size());
+	for (size_t i = 0; i < bones.size(); ++i) {
+		pose[i] = bones[i].bindPose;
+	}
+}
+
+void
+Skeleton::computeSkinMatrices(const std::vector<BoneTransform>& pose,
+							  std::vector<XMFLOAT4X4>& skinMatrices) const {
+	const size_t count = std::min(pose.size(), bones.size());
+	skinMatrices.resize(bones.size());
+
+	// Los padres van antes que los hijos: un solo recorrido acumula el espacio del modelo
+	FrameVector<XMMATRIX> model(bones.size());
+	for (size_t i = 0; i < bones.size(); ++i) {
+		const XMMATRIX local = i < count ? composeTransform(pose[i]) : composeTransform(bones[i].bindPose);
+		const int parent = bones[i].parent;
+		model[i] = parent >= 0 ? local * model[parent] : local;
+		XMStoreFloat4x4(&skinMatrices[i], XMLoadFloat4x4(&bones[i].inverseBindPose) * model[i]);
+	}
+}
+
+void
+PoseSoA::resize(unsigned int boneCount) {
+	if (boneCount == m_boneCount && !m_channels.empty()) {
+		return;
+	}
+	m_boneCount = boneCount;
+	m_paddedBones = padBones(boneCount);
+	m_channels.resize(static_cast<size_t>(POSE_CHANNEL_COUNT) * m_paddedBones);
+	fillIdentity(m_channels.data(), m_paddedBones);
+}
+
+BoneTransform
+PoseSoA::get(unsigned int bone) const {
+	return readTransform(m_channels.data(), m_paddedBones, bone);
+}
+
+void
+PoseSoA::set(unsigned int bone, const BoneTransform& transform) {
+	writeTransform(m_channels.data(), m_paddedBones, bone, transform);
+}
+
+void
+AnimationClip::init(const std::string& clipName, float clipDuration, float rate, unsigned int samples, unsigned int bones) {
+	name = clipName;
+	duration = clipDuration;
+	sampleRate = rate;
+	m_sampleCount = samples;
+	m_boneCount = bones;
+	m_paddedBones = padBones(bones);
+
+	const size_t poseSize = static_cast<size_t>(POSE_CHANNEL_COUNT) * m_paddedBones;
+	m_samples.resize(poseSize * samples);
+	for (unsigned int sample = 0; sample < samples; ++sample) {
+		fillIdentity(m_samples.data() + poseSize * sample, m_paddedBones);
+	}
+}
+
+BoneTransform
+AnimationClip::getTransform(unsigned int sample, unsigned int bone) const {
+	return readTransform(samplePointer(sample), m_paddedBones, bone);
+}
+
+void
+AnimationClip::setTransform(unsigned int sample, unsigned int bone, const BoneTransform& transform) {
+	writeTransform(samplePointer(sample), m_paddedBones, bone, transform);
+}
+
+void
+AnimationClip::sample(float time, bool loop, PoseSoA& pose) const {
+	pose.resize(m_boneCount);
+	if (m_sampleCount == 0 || m_boneCount == 0) {
+		return;
+	}
+
+	// 01. Tiempo dentro del clip
+	if (duration > 0.0f) {
+		if (loop) {
+			time = std::fmod(time, duration);
+			if (time < 0.0f) {
+				time += duration;
+			}
+		}
+		else {
+			time = std::max(0.0f, std::min(time, duration));
+		}
+	}
+	else {
+		time = 0.0f;
+	}
+
+	// 02. Muestras vecinas y peso entre ellas
+	const float position = time * sampleRate;
+	const unsigned int first = std::min(static_cast<unsigned int>(position), m_sampleCount - 1);
+	const unsigned int second = std::min(first + 1, m_sampleCount - 1);
+	const float factor = std::min(1.0f, position - static_cast<float>(first));
+
+	// 03. Interpolación lineal de todos los canales; nlerp para la rotación
+	float* out = pose.channel(POSE_TRANSLATION_X);
+	if (getCpuFeatures().avx2) {
+		blendPosesAVX2(samplePointer(first), samplePointer(second), factor, m_paddedBones, out);
+	}
+	else {
+		blendPosesScalar(samplePointer(first), samplePointer(second), factor, m_paddedBones, out);
+	}
+}
+
+void
+AnimationClip::sample(float time, bool loop, std::vector<BoneTransform>& pose) const {
+	PoseSoA soa;
+	sample(time, loop, soa);
+	pose.resize(m_boneCount);
+	for (unsigned int bone = 0; bone < m_boneCount; ++bone) {
+		pose[bone] = soa.get(bone);
+	}
+}
+
+VertexSkin
+quantizeSkinWeights(const unsigned int* bones, const float* weights, unsigned int count) {
+	VertexSkin skin;
+
+	// 01. Las 4 influencias de mayor peso, de mayor a menor
+	unsigned int order[4] = { 0, 0, 0, 0 };
+	unsigned int kept = 0;
+	for (unsigned int i = 0; i < count; ++i) {
+		if (!(weights[i] > 0.0f)) {
+			continue;
+		}
+		unsigned int slot = kept < 4 ? kept++ : 4;
+		while (slot > 0 && weights[order[slot - 1]] < weights[i]) {
+			if (slot < 4) {
+				order[slot] = order[slot - 1];
+			}
+			--slot;
+		}
+		if (slot < 4) {
+			order[slot] = i;
+		}
+	}
+	if (kept == 0) {
+		return skin;
+	}
+
+	// 02. Normalizar y cuantizar; el error de redondeo va a la influencia mayor
+	float total = 0.0f;
+	for (unsigned int i = 0; i < kept; ++i) {
+		total += weights[order[i]];
+	}
+	int sum = 0;
+	int quantized[4] = { 0, 0, 0, 0 };
+	for (unsigned int i = 0; i < kept; ++i) {
+		quantized[i] = static_cast<int>(weights[order[i]] / total * 255.0f + 0.5f);
+		sum += quantized[i];
+	}
+	quantized[0] += 255 - sum;
+
+	for (unsigned int i = 0; i < kept; ++i) {
+		skin.bones[i] = static_cast<unsigned char>(bones[order[i]]);
+		skin.weights[i] = static_cast<unsigned char>(quantized[i]);
+	}
+	return skin;
+}
@@ -0,0 +1,549 @@
+#include "AnimationCompression.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace {
+	constexpr float kSqrt2 = 1.41421356f;
+	constexpr unsigned int kRotationBits = 15;
+	constexpr float kRotationMax = static_cast<float>((1u << kRotationBits) - 1);
+	constexpr float kRangeMax = 65535.0f;
+	constexpr unsigned int kMaxIndex = 65535;
+
+	unsigned int
+	componentCount(unsigned char type) {
+		return type == TRACK_ROTATION ? 4 : 3;
+	}
+
+	PoseChannel
+	firstChannel(unsigned char type) {
+		return type == TRACK_TRANSLATION ? POSE_TRANSLATION_X : type == TRACK_ROTATION ? POSE_ROTATION_X : POSE_SCALE_X;
+	}
+
+	void
+	readTrack(const BoneTransform& transform, unsigned char type, float* value) {
+		if (type == TRACK_TRANSLATION) {
+			value[0] = transform.translation.x; value[1] = transform.translation.y; value[2] = transform.translation.z;
+		}
+		else if (type == TRACK_ROTATION) {
+			value[0] = transform.rotation.x; value[1] = transform.rotation.y;
+			value[2] = transform.rotation.z; value[3] = transform.rotation.w;
+		}
+		else {
+			value[0] = transform.scale.x; value[1] = transform.scale.y; value[2] = transform.scale.z;
+		}
+	}
+
+	/**
+	 * @brief Cuaternión en 48 bits: índice de la mayor componente (2 bits) y las otras tres en
+	 *        [-1/sqrt(2), 1/sqrt(2)] con 15 bits cada una. La mayor se reconstruye con la norma.
+	 */
+	void
+	encodeRotation(const float* q, unsigned short* out) {
+		const float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+		const float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+		unsigned int largest = 0;
+		for (unsigned int i = 1; i < 4; ++i) {
+			if (std::fabs(q[i]) > std::fabs(q[largest])) {
+				largest = i;
+			}
+		}
+		// q y -q son la misma rotación: se guarda con la mayor componente positiva
+		const float sign = q[largest] < 0.0f ? -inverse : inverse;
+
+		unsigned long long bits = largest;
+		for (unsigned int i = 0; i < 4; ++i) {
+			if (i == largest) {
+				continue;
+			}
+			const float normalized = (q[i] * sign * kSqrt2 + 1.0f) * 0.5f;
+			const float quantized = std::round(std::max(0.0f, std::min(1.0f, normalized)) * kRotationMax);
+			bits = (bits << kRotationBits) | static_cast<unsigned long long>(quantized);
+		}
+		out[0] = static_cast<unsigned short>(bits >> 32);
+		out[1] = static_cast<unsigned short>(bits >> 16);
+		out[2] = static_cast<unsigned short>(bits);
+	}
+
+	void
+	decodeRotation(const unsigned short* in, float* q) {
+		unsigned long long bits = (static_cast<unsigned long long>(in[0]) << 32) |
+								  (static_cast<unsigned long long>(in[1]) << 16) | in[2];
+		const unsigned int largest = static_cast<unsigned int>(bits >> (3 * kRotationBits)) & 3;
+		float sum = 0.0f;
+		for (int i = 3; i >= 0; --i) {
+			if (static_cast<unsigned int>(i) == largest) {
+				continue;
+			}
+			const float quantized = static_cast<float>(bits & ((1u << kRotationBits) - 1));
+			bits >>= kRotationBits;
+			q[i] = (quantized / kRotationMax * 2.0f - 1.0f) / kSqrt2;
+			sum += q[i] * q[i];
+		}
+		q[largest] = std::sqrt(std::max(0.0f, 1.0f - sum));
+	}
+
+	void
+	encodeRange(const float* value, const float* origin, const float* extent, unsigned short* out) {
+		for (int i = 0; i < 3; ++i) {
+			const float normalized = extent[i] > 0.0f ? (value[i] - origin[i]) / extent[i] : 0.0f;
+			out[i] = static_cast<unsigned short>(std::round(std::max(0.0f, std::min(1.0f, normalized)) * kRangeMax));
+		}
+	}
+
+	void
+	decodeRange(const unsigned short* in, const float* origin, const float* extent, float* value) {
+		for (int i = 0; i < 3; ++i) {
+			value[i] = origin[i] + in[i] / kRangeMax * extent[i];
+		}
+	}
+
+	/**
+	 * @brief Pone q en el mismo hemisferio que reference para interpolar con nlerp.
+	 */
+	void
+	alignHemisphere(const float* reference, float* q) {
+		if (reference[0] * q[0] + reference[1] * q[1] + reference[2] * q[2] + reference[3] * q[3] < 0.0f) {
+			q[0] = -q[0]; q[1] = -q[1]; q[2] = -q[2]; q[3] = -q[3];
+		}
+	}
+
+	void
+	interpolate(unsigned char type, const float* from, const float* to, float factor, float* out) {
+		const unsigned int count = componentCount(type);
+		for (unsigned int i = 0; i < count; ++i) {
+			out[i] = from[i] + (to[i] - from[i]) * factor;
+		}
+		if (type == TRACK_ROTATION) {
+			const float length = std::sqrt(out[0] * out[0] + out[1] * out[1] + out[2] * out[2] + out[3] * out[3]);
+			const float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+			for (unsigned int i = 0; i < 4; ++i) {
+				out[i] *= inverse;
+			}
+		}
+	}
+
+	/**
+	 * @brief Diferencia entre dos valores de una pista: ángulo en radianes para la rotación,
+	 *        mayor diferencia por componente para traslación y escala.
+	 */
+	float
+	trackError(unsigned char type, const float* a, const float* b) {
+		if (type == TRACK_ROTATION) {
+			const float dot = std::fabs(a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]);
+			return 2.0f * std::acos(std::min(1.0f, dot));
+		}
+		float error = 0.0f;
+		for (int i = 0; i < 3; ++i) {
+			error = std::max(error, std::fabs(a[i] - b[i]));
+		}
+		return error;
+	}
+
+	XMMATRIX
+	composeTransform(const BoneTransform& transform) {
+		return XMMatrixScalingFromVector(XMLoadFloat3(&transform.scale)) *
+			   XMMatrixRotationQuaternion(XMLoadFloat4(&transform.rotation)) *
+			   XMMatrixTranslationFromVector(XMLoadFloat3(&transform.translation));
+	}
+
+	/**
+	 * @brief Espacio del modelo de cada hueso (los padres van antes que los hijos).
+	 */
+	void
+	computeModel(const BoneTransform* pose, const std::vector<int>& parents, std::vector<XMFLOAT4X4>& model) {
+		model.resize(parents.size());
+		for (size_t i = 0; i < parents.size(); ++i) {
+			XMMATRIX matrix = composeTransform(pose[i]);
+			if (parents[i] >= 0) {
+				matrix = matrix * XMLoadFloat4x4(&model[parents[i]]);
+			}
+			XMStoreFloat4x4(&model[i], matrix);
+		}
+	}
+
+	/**
+	 * @brief Llaves conservadas de una pista animada.
+	 */
+	struct
+	TrackKeys {
+		std::vector<unsigned short> samples;            ///< Muestra de cada llave.
+		std::vector<std::array<unsigned short, 3>> values; ///< Valor cuantizado de cada llave.
+	};
+
+	/**
+	 * @brief Cuantiza una pista y conserva las llaves mínimas para que la interpolación lineal
+	 *        entre ellas quede bajo la tolerancia en cada muestra original.
+	 */
+	void
+	reduceTrack(const std::vector<std::array<float, 4>>& values,
+				unsigned char type,
+				const CompressedTrack& track,
+				float tolerance,
+				TrackKeys& keys) {
+		const unsigned int sampleCount = static_cast<unsigned int>(values.size());
+		std::vector<std::array<unsigned short, 3>> quantized(sampleCount);
+		std::vector<std::array<float, 4>> decoded(sampleCount);
+		for (unsigned int s = 0; s < sampleCount; ++s) {
+			if (type == TRACK_ROTATION) {
+				encodeRotation(values[s].data(), quantized[s].data());
+				decodeRotation(quantized[s].data(), decoded[s].data());
+			}
+			else {
+				encodeRange(values[s].data(), track.origin, track.extent, quantized[s].data());
+				decodeRange(quantized[s].data(), track.origin, track.extent, decoded[s].data());
+			}
+		}
+
+		auto segmentFits = [&](unsigned int left, unsigned int right) {
+			std::array<float, 4> to = decoded[right];
+			if (type == TRACK_ROTATION) {
+				alignHemisphere(decoded[left].data(), to.data());
+			}
+			float value[4];
+			for (unsigned int s = left + 1; s < right; ++s) {
+				interpolate(type, decoded[left].data(), to.data(), static_cast<float>(s - left) / (right - left), value);
+				if (trackError(type, value, values[s].data()) > tolerance) {
+					return false;
+				}
+			}
+			return true;
+		};
+
+		// Segmentos voraces: cada llave se extiende hasta la última muestra que aún interpola bien
+		keys.samples.assign(1, 0);
+		keys.values.assign(1, quantized[0]);
+		const unsigned int last = sampleCount - 1;
+		unsigned int left = 0;
+		while (left < last) {
+			unsigned int right = left + 1;
+			while (right < last && segmentFits(left, right + 1)) {
+				++right;
+			}
+			keys.samples.push_back(static_cast<unsigned short>(right));
+			keys.values.push_back(quantized[right]);
+			left = right;
+		}
+	}
+}
+
+bool
+CompressedAnimationClip::compress(const AnimationClip& clip,
+								  const Skeleton& skeleton,
+								  const AnimationCompressionSettings& settings,
+								  AnimationCompressionReport* report) {
+	PROFILE_SCOPE("CompressedAnimationClip::compress");
+
+	const unsigned int boneCount = clip.getBoneCount();
+	const unsigned int sampleCount = clip.getSampleCount();
+	if (sampleCount == 0 || sampleCount - 1 > kMaxIndex || boneCount * 3 > kMaxIndex) {
+		LOG_WARNING(LOG_CATEGORY_RESOURCE, "Animation '%s' cannot be compressed (%u samples, %u bones)",
+					clip.name, sampleCount, boneCount);
+		return false;
+	}
+
+	name = clip.name;
+	duration = clip.duration;
+	sampleRate = clip.sampleRate;
+	m_sampleCount = sampleCount;
+	m_boneCount = boneCount;
+
+	// 01. Muestras originales y jerarquía
+	std::vector<BoneTransform> raw(static_cast<size_t>(sampleCount) * boneCount);
+	for (unsigned int s = 0; s < sampleCount; ++s) {
+		for (unsigned int bone = 0; bone < boneCount; ++bone) {
+			raw[static_cast<size_t>(s) * boneCount + bone] = clip.getTransform(s, bone);
+		}
+	}
+	std::vector<int> parents(boneCount, -1);
+	std::vector<BoneTransform> bindPose(raw.begin(), raw.begin() + boneCount);
+	for (unsigned int bone = 0; bone < boneCount && bone < skeleton.getBoneCount(); ++bone) {
+		parents[bone] = skeleton.bones[bone].parent;
+		bindPose[bone] = skeleton.bones[bone].bindPose;
+	}
+
+	// 02. Alcance de cada hueso: un error angular de e radianes desplaza hasta e * alcance los
+	//     puntos virtuales del hueso y de sus descendientes
+	std::vector<XMFLOAT4X4> rawModel;
+	std::vector<XMFLOAT4X4> compressedModel;
+	computeModel(bindPose.data(), parents, rawModel);
+	std::vector<float> reach(boneCount, settings.virtualVertexDistance);
+	for (unsigned int bone = boneCount; bone-- > 0;) {
+		const int parent = parents[bone];
+		if (parent >= 0) {
+			const float dx = rawModel[bone]._41 - rawModel[parent]._41;
+			const float dy = rawModel[bone]._42 - rawModel[parent]._42;
+			const float dz = rawModel[bone]._43 - rawModel[parent]._43;
+			reach[parent] = std::max(reach[parent], reach[bone] + std::sqrt(dx * dx + dy * dy + dz * dz));
+		}
+	}
+
+	std::vector<float> precision(boneCount, 1.0f);
+	std::vector<float> boneError(boneCount, 0.0f);
+	std::vector<std::array<float, 4>> values(sampleCount);
+	std::vector<TrackKeys> trackKeys;
+	CompressedClipCursor cursor;
+	PoseSoA pose;
+	std::vector<BoneTransform> decodedPose(boneCount);
+	AnimationCompressionReport result;
+	const unsigned int iterations = std::max(1u, settings.maxIterations);
+
+	for (unsigned int iteration = 0; iteration < iterations; ++iteration) {
+		// 03. Pistas: constantes o cuantizadas y reducidas con la tolerancia de su hueso
+		m_tracks.clear();
+		m_keys.clear();
+		trackKeys.assign(static_cast<size_t>(boneCount) * 3, TrackKeys());
+		m_animatedTracks = 0;
+		result.constantTracks = 0;
+		result.keptKeys = 0;
+		for (unsigned int bone = 0; bone < boneCount; ++bone) {
+			for (unsigned char type = TRACK_TRANSLATION; type <= TRACK_SCALE; ++type) {
+				const float allowed = settings.maxError * precision[bone];
+				const float tolerance = type == TRACK_TRANSLATION ? allowed : allowed / reach[bone];
+				const unsigned int components = componentCount(type);
+				for (unsigned int s = 0; s < sampleCount; ++s) {
+					readTrack(raw[static_cast<size_t>(s) * boneCount + bone], type, values[s].data());
+				}
+
+				CompressedTrack track;
+				track.bone = static_cast<unsigned short>(bone);
+				track.type = type;
+				track.constant = 1;
+				for (unsigned int s = 1; s < sampleCount && track.constant; ++s) {
+					track.constant = trackError(type, values[s].data(), values[0].data()) <= tolerance ? 1 : 0;
+				}
+
+				if (track.constant) {
+					std::copy(values[0].begin(), values[0].begin() + components, track.origin);
+					++result.constantTracks;
+				}
+				else {
+					if (type != TRACK_ROTATION) {
+						for (int c = 0; c < 3; ++c) {
+							float low = values[0][c];
+							float high = values[0][c];
+							for (unsigned int s = 1; s < sampleCount; ++s) {
+								low = std::min(low, values[s][c]);
+								high = std::max(high, values[s][c]);
+							}
+							track.origin[c] = low;
+							track.extent[c] = high - low;
+						}
+					}
+					reduceTrack(values, type, track, tolerance, trackKeys[m_tracks.size()]);
+					result.keptKeys += static_cast<unsigned int>(trackKeys[m_tracks.size()].samples.size());
+					++m_animatedTracks;
+				}
+				m_tracks.push_back(track);
+			}
+		}
+
+		// 04. Flujo: las dos primeras llaves de cada pista y después cada llave en el orden en que
+		//     se necesita (al pasar la muestra de la llave anterior de su pista)
+		struct StreamEntry {
+			unsigned short neededAt;
+			unsigned short track;
+			unsigned short key;
+		};
+		std::vector<StreamEntry> stream;
+		for (size_t t = 0; t < m_tracks.size(); ++t) {
+			const TrackKeys& keys = trackKeys[t];
+			for (size_t k = 0; k < keys.samples.size(); ++k) {
+				const unsigned short neededAt = k < 2 ? 0 : keys.samples[k - 1];
+				stream.push_back({ neededAt, static_cast<unsigned short>(t), static_cast<unsigned short>(k) });
+			}
+		}
+		std::stable_sort(stream.begin(), stream.end(), [](const StreamEntry& a, const StreamEntry& b) {
+			const bool aInitial = a.key < 2;
+			const bool bInitial = b.key < 2;
+			if (aInitial != bInitial) {
+				return aInitial;
+			}
+			return a.neededAt < b.neededAt;
+		});
+		m_keys.reserve(stream.size());
+		for (const StreamEntry& entry : stream) {
+			CompressedKey key;
+			key.sample = trackKeys[entry.track].samples[entry.key];
+			key.track = entry.track;
+			std::copy(trackKeys[entry.track].values[entry.key].begin(), trackKeys[entry.track].values[entry.key].end(), key.value);
+			m_keys.push_back(key);
+		}
+
+		// 05. Error en espacio del modelo: puntos virtuales de cada hueso con la pose original y
+		//     con la decodificada por el mismo camino de reproducción
+		std::fill(boneError.begin(), boneError.end(), 0.0f);
+		double errorSum = 0.0;
+		cursor.reset();
+		const float d = settings.virtualVertexDistance;
+		const XMVECTOR points[4] = { XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f), XMVectorSet(d, 0.0f, 0.0f, 1.0f),
+									 XMVectorSet(0.0f, d, 0.0f, 1.0f), XMVectorSet(0.0f, 0.0f, d, 1.0f) };
+		for (unsigned int s = 0; s < sampleCount; ++s) {
+			evaluate(static_cast<float>(s), cursor, pose);
+			for (unsigned int bone = 0; bone < boneCount; ++bone) {
+				decodedPose[bone] = pose.get(bone);
+			}
+			computeModel(&raw[static_cast<size_t>(s) * boneCount], parents, rawModel);
+			computeModel(decodedPose.data(), parents, compressedModel);
+			for (unsigned int bone = 0; bone < boneCount; ++bone) {
+				const XMMATRIX rawMatrix = XMLoadFloat4x4(&rawModel[bone]);
+				const XMMATRIX compressedMatrix = XMLoadFloat4x4(&compressedModel[bone]);
+				float error = 0.0f;
+				for (const XMVECTOR& point : points) {
+					const XMVECTOR delta = XMVectorSubtract(XMVector4Transform(point, rawMatrix),
+															XMVector4Transform(point, compressedMatrix));
+					error = std::max(error, XMVectorGetX(XMVector3Length(delta)));
+				}
+				boneError[bone] = std::max(boneError[bone], error);
+				errorSum += error;
+			}
+		}
+
+		result.iterations = iteration + 1;
+		result.maxError = 0.0f;
+		result.worstBone = -1;
+		for (unsigned int bone = 0; bone < boneCount; ++bone) {
+			if (boneError[bone] > result.maxError) {
+				result.maxError = boneError[bone];
+				result.worstBone = static_cast<int>(bone);
+			}
+		}
+		result.averageError = boneCount > 0 ? static_cast<float>(errorSum / (static_cast<double>(sampleCount) * boneCount)) : 0.0f;
+		if (result.maxError <= settings.maxError) {
+			break;
+		}
+
+		// 06. Los huesos que superan el error y sus ancestros se comprimen con la mitad de tolerancia
+		std::vector<bool> tighten(boneCount, false);
+		for (unsigned int bone = 0; bone < boneCount; ++bone) {
+			if (boneError[bone] > settings.maxError) {
+				for (int b = static_cast<int>(bone); b >= 0 && !tighten[b]; b = parents[b]) {
+					tighten[b] = true;
+				}
+			}
+		}
+		for (unsigned int bone = 0; bone < boneCount; ++bone) {
+			if (tighten[bone]) {
+				precision[bone] *= 0.5f;
+			}
+		}
+	}
+
+	result.rawBytes = static_cast<size_t>(sampleCount) * boneCount * POSE_CHANNEL_COUNT * sizeof(float);
+	result.compressedBytes = getMemoryBytes();
+	result.ratio = result.compressedBytes > 0 ? static_cast<double>(result.rawBytes) / result.compressedBytes : 0.0;
+	result.animatedTracks = m_animatedTracks;
+	result.rawKeys = m_animatedTracks * sampleCount;
+	if (report) {
+		*report = result;
+	}
+	return true;
+}
+
+void
+CompressedAnimationClip::sample(float time, bool loop, CompressedClipCursor& cursor, PoseSoA& pose) const {
+	if (duration > 0.0f) {
+		if (loop) {
+			time = std::fmod(time, duration);
+			if (time < 0.0f) {
+				time += duration;
+			}
+		}
+		else {
+			time = std::max(0.0f, std::min(time, duration));
+		}
+	}
+	else {
+		time = 0.0f;
+	}
+	evaluate(time * sampleRate, cursor, pose);
+}
+
+void
+CompressedAnimationClip::evaluate(float position, CompressedClipCursor& cursor, PoseSoA& pose) const {
+	pose.resize(m_boneCount);
+	if (m_sampleCount == 0) {
+		return;
+	}
+	position = std::max(0.0f, std::min(position, static_cast<float>(m_sampleCount - 1)));
+
+	// 01. Reproducir hacia adelante solo lee llaves nuevas; retroceder reinicia el flujo
+	if (cursor.m_clip != this || position < cursor.m_samplePosition) {
+		rewind(cursor);
+	}
+	advance(cursor, static_cast<unsigned int>(position));
+	cursor.m_samplePosition = position;
+
+	// 02. Valor de cada pista en los canales SoA de la pose
+	float value[4];
+	for (size_t t = 0; t < m_tracks.size(); ++t) {
+		const CompressedTrack& track = m_tracks[t];
+		const float* source = track.origin;
+		if (!track.constant) {
+			const CompressedClipCursor::TrackState& state = cursor.m_tracks[t];
+			const float span = static_cast<float>(state.right - state.left);
+			const float factor = span > 0.0f ? std::min(1.0f, std::max(0.0f, (position - state.left) / span)) : 0.0f;
+			interpolate(track.type, state.from, state.to, factor, value);
+			source = value;
+		}
+		const PoseChannel first = firstChannel(track.type);
+		for (unsigned int c = 0; c < componentCount(track.type); ++c) {
+			pose.channel(static_cast<PoseChannel>(first + c))[track.bone] = source[c];
+		}
+	}
+}
+
+void
+CompressedAnimationClip::rewind(CompressedClipCursor& cursor) const {
+	cursor.m_clip = this;
+	cursor.m_tracks.resize(m_tracks.size());
+	cursor.m_samplePosition = 0.0f;
+
+	// Las dos primeras llaves de cada pista animada abren el flujo, en orden de pista
+	const size_t initialKeys = static_cast<size_t>(m_animatedTracks) * 2;
+	for (size_t i = 0; i + 1 < initialKeys; i += 2) {
+		const CompressedKey& first = m_keys[i];
+		const CompressedKey& second = m_keys[i + 1];
+		CompressedClipCursor::TrackState& state = cursor.m_tracks[first.track];
+		state.left = first.sample;
+		state.right = second.sample;
+		decodeKey(first, state.from);
+		decodeKey(second, state.to);
+		if (m_tracks[first.track].type == TRACK_ROTATION) {
+			alignHemisphere(state.from, state.to);
+		}
+	}
+	cursor.m_position = initialKeys;
+}
+
+void
+CompressedAnimationClip::advance(CompressedClipCursor& cursor, unsigned int frame) const {
+	// El flujo está ordenado por la muestra de la llave anterior de cada pista, que es la llave
+	// derecha actual: si la siguiente llave aún no se necesita, ninguna de las posteriores tampoco
+	while (cursor.m_position < m_keys.size()) {
+		const CompressedKey& key = m_keys[cursor.m_position];
+		CompressedClipCursor::TrackState& state = cursor.m_tracks[key.track];
+		if (state.right > frame) {
+			break;
+		}
+		state.left = state.right;
+		std::copy(state.to, state.to + 4, state.from);
+		state.right = key.sample;
+		decodeKey(key, state.to);
+		if (m_tracks[key.track].type == TRACK_ROTATION) {
+			alignHemisphere(state.from, state.to);
+		}
+		++cursor.m_position;
+	}
+}
+
+void
+CompressedAnimationClip::decodeKey(const CompressedKey& key, float* value) const {
+	const CompressedTrack& track = m_tracks[key.track];
+	if (track.type == TRACK_ROTATION) {
+		decodeRotation(key.value, value);
+	}
+	else {
+		decodeRange(key.value, track.origin, track.extent, value);
+	}
+}
@@ -2,13 +2,27 @@
 
 HRESULT
 BaseApp::init() {
+	PROFILE_SCOPE("BaseApp::init");
 	HRESULT hr = S_OK;
 
+	// Registrar la memoria de los recursos y los comandos desde el primer recurso creado
+	m_device.setRecorder(&m_recorder);
+	m_deviceContext.setRecorder(&m_recorder);
+	m_swapchain.setRecorder(&m_recorder);
+
+	// Presupuestos de memoria de CPU por etiqueta (al superarse se avisa en el log)
+	MemoryTracker& memory = MemoryTracker::getInstance();
+	memory.setBudget(MEMORY_TAG_MESH, kMeshMemoryBudget);
+	memory.setBudget(MEMORY_TAG_TEXTURE, kTextureMemoryBudget);
+	memory.setBudget(MEMORY_TAG_ECS, kEcsMemoryBudget);
+	memory.setBudget(MEMORY_TAG_UI, kUiMemoryBudget);
+
 	// Create Swapchain and BackBuffer
 	hr = m_swapchain.init(m_device, m_deviceContext, m_backBuffer, m_window);
 	if (FAILED(hr)) {
 		return hr;
 	}
+	m_deviceContext.init();
 
 	// Create a render target view
 	hr = m_renderTargetView.init(m_device,
@@ -25,7 +39,7 @@ BaseApp::init() {
 		m_window.m_height,
 		DXGI_FORMAT_D24_UNORM_S8_UINT,
 		D3D11_BIND_DEPTH_STENCIL,
-		4,
+		m_swapchain.getSampleCount(),
 		0);
 	if (FAILED(hr))
 		return hr;
@@ -45,32 +59,39 @@ BaseApp::init() {
 	if (FAILED(hr))
 		return hr;
 
-	// Define the input layout
+	// Define the input layout (the same format the meshes pack their vertex buffers with)
 	std::vector<D3D11_INPUT_ELEMENT_DESC> Layout;
-
-	D3D11_INPUT_ELEMENT_DESC position;
-	position.SemanticName = "POSITION";
-	position.SemanticIndex = 0;
-	position.Format = DXGI_FORMAT_R32G32B32_FLOAT;
-	position.InputSlot = 0;
-	position.AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT /*0*/;
-	position.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	position.InstanceDataStepRate = 0;
-	Layout.push_back(position);
-
-	D3D11_INPUT_ELEMENT_DESC texcoord;
-	texcoord.SemanticName = "TEXCOORD";
-	texcoord.SemanticIndex = 0;
-	texcoord.Format = DXGI_FORMAT_R32G32_FLOAT;
-	texcoord.InputSlot = 0;
-	texcoord.AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT /*12*/;
-	texcoord.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
-	texcoord.InstanceDataStepRate = 0;
-	Layout.push_back(texcoord);
+	VertexFormat::standard().buildInputLayout(Layout);
 
 	// Create the Shader Program
 	hr = m_shaderProgram.init(m_device, "KamogawaEngine-.fx", Layout);
 
+	if (FAILED(hr))
+		return hr;
+
+	// La variante instanciada agrega la matriz de mundo por instancia (3 filas) en el slot 1
+	std::vector<D3D11_INPUT_ELEMENT_DESC> InstanceRows;
+	for (unsigned int row = 0; row < 3; ++row) {
+		D3D11_INPUT_ELEMENT_DESC instanceRow;
+		instanceRow.SemanticName = "INSTANCEROW";
+		instanceRow.SemanticIndex = row;
+		instanceRow.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+		instanceRow.InputSlot = 1;
+		instanceRow.AlignedByteOffset = D3D11_APPEND_ALIGNED_ELEMENT;
+		instanceRow.InputSlotClass = D3D11_INPUT_PER_INSTANCE_DATA;
+		instanceRow.InstanceDataStepRate = 1;
+		InstanceRows.push_back(instanceRow);
+	}
+	std::vector<D3D11_INPUT_ELEMENT_DESC> InstancedLayout = Layout;
+	InstancedLayout.insert(InstancedLayout.end(), InstanceRows.begin(), InstanceRows.end());
+
+	hr = m_instancedShader.init(m_device, "KamogawaEngine-Instanced.fx", InstancedLayout);
+
+	if (FAILED(hr))
+		return hr;
+
+	hr = m_renderQueue.initInstancing(m_device, m_instancedShader, 1024);
+
 	if (FAILED(hr))
 		return hr;
 
@@ -84,6 +105,17 @@ BaseApp::init() {
 	if (FAILED(hr))
 		return hr;
 
+	// La proyección solo cambia al redimensionar la ventana
+	m_Projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, m_window.m_width / (float)m_window.m_height, 0.01f, 100.0f);
+	cbChangesOnResize.mProjection = XMMatrixTranspose(m_Projection);
+	m_changeOnResize.update(m_deviceContext, 0, nullptr, &cbChangesOnResize, 0, 0);
+
+	// Anillo de constantes por objeto (1 MB = 4096 bloques de 256 bytes)
+	hr = m_constantRing.init(m_device, m_deviceContext, 1 << 20);
+	if (FAILED(hr))
+		return hr;
+	m_renderQueue.setConstantRing(&m_constantRing);
+
 	// Initialize the view matrix
 	XMVECTOR Eye = XMVectorSet(0.0f, 3.0f, -6.0f, 0.0f);
 	XMVECTOR At = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
@@ -92,40 +124,47 @@ BaseApp::init() {
 	
 	//IMGUI
 	m_UI.init(m_window.m_hWnd, m_device.m_device, m_deviceContext.m_deviceContext);
+	m_UI.setFrameStats(&m_frameStats);
 	
 
 	// Set Vela Actor
 	// Load the Texture
-	Texture cuerpo;
-	cuerpo.init(m_device, "Textures/cuerpo.png", ExtensionType::PNG);
-	Texture color;
-	color.init(m_device, "Textures/color.png", ExtensionType::PNG);
-	Texture espalda;
-	espalda.init(m_device, "Textures/espalda.png", ExtensionType::PNG);
-	Texture pecho;
-	pecho.init(m_device, "Textures/pecho.png", ExtensionType::PNG);
-	Texture cara;
-	cara.init(m_device, "Textures/cara.png", ExtensionType::PNG);
-	Texture cara2;
-	cara2.init(m_device, "Textures/cara2.png", ExtensionType::PNG);
-	m_default.init(m_device, "Textures/Default.png", ExtensionType::PNG);
-
-	m_modelTextures.push_back(cuerpo);
-	m_modelTextures.push_back(color);
-	m_modelTextures.push_back(espalda);
-	m_modelTextures.push_back(pecho);
-	m_modelTextures.push_back(cara);
-	m_modelTextures.push_back(cara2);
-	m_modelTextures.push_back(m_default);
-
-	m_model.LoadFBXModel("Models/invincible.fbx");
+	hr = m_default.init(m_device, "Textures/Default.png", ExtensionType::PNG);
+	if (FAILED(hr))
+		return hr;
+
+	// Las texturas pequeñas de cada malla se juntan en un atlas al importar el modelo
+	std::vector<std::string> modelTextureNames = { "Textures/cuerpo.png",
+												   "Textures/color.png",
+												   "Textures/espalda.png",
+												   "Textures/pecho.png",
+												   "Textures/cara.png",
+												   "Textures/cara2.png" };
+
+	// ERROR ya no termina el proceso: un modelo que no carga detiene la inicialización aquí
+	if (!m_model.LoadFBXModel("Models/invincible.fbx")) {
+		ERROR("BaseApp", "init", "Failed to load Models/invincible.fbx");
+		return E_FAIL;
+	}
+	TextureAtlas modelAtlas;
+	hr = modelAtlas.init(m_device, modelTextureNames, m_model.meshes, m_modelTextures);
+	if (FAILED(hr))
+		return hr;
+	// El atlas reescribió las UVs: el error de cuantización se vuelve a medir sobre las UVs finales
+	m_model.RefitVertexFormats("Models/invincible.fbx", modelAtlas);
+
+	// Las mallas sin textura propia reutilizan m_default en lugar de volver a subirla en el atlas
+	while (m_modelTextures.size() < m_model.meshes.size()) {
+		m_modelTextures.push_back(m_default);
+	}
+
 	AModel = EngineUtilities::MakeShared<Actor>(m_device);
 	if (!AModel.isNull()) {
 		AModel->getComponent<Transform>()->setTransform(EngineUtilities::Vector3(0.7f, 1.0f, -0.4f),
 														EngineUtilities::Vector3(XM_PI / -2.0f, 1.0f, XM_PI / 2.0f),
 														EngineUtilities::Vector3(1.0f, 1.0f, 1.0f));
 
-		AModel->setMesh(m_device, m_model.meshes);
+		AModel->setMesh(m_device, m_model.meshes, m_mergeMeshBuffers);
 		AModel->setTextures(m_modelTextures);
 
 		std::string msg = AModel->getName() + "- Actor accessed successfully.";
@@ -138,20 +177,25 @@ BaseApp::init() {
 	// Set Actor
 	// Load the Texture
 	Texture Mordecai;
-	Mordecai.init(m_device, "Textures/Mordecai.png", ExtensionType::PNG);
+	hr = Mordecai.init(m_device, "Textures/Mordecai.png", ExtensionType::PNG);
+	if (FAILED(hr))
+		return hr;
 
 	
 	m_modelTextures2.push_back(Mordecai);
 	m_modelTextures2.push_back(m_default);
 
-	m_model2.LoadFBXModel("Models/mordecai.fbx");
+	if (!m_model2.LoadFBXModel("Models/mordecai.fbx")) {
+		ERROR("BaseApp", "init", "Failed to load Models/mordecai.fbx");
+		return E_FAIL;
+	}
 	AModel2 = EngineUtilities::MakeShared<Actor>(m_device);
 	if (!AModel2.isNull()) {
 		AModel2->getComponent<Transform>()->setTransform(EngineUtilities::Vector3(2.0f, 1.0f, 1.0f),
 														EngineUtilities::Vector3(XM_PI / -2.0f, 0.0f, XM_PI / 2.0f),
 														EngineUtilities::Vector3(1.0f, 1.0f, 1.0f));
 
-		AModel2->setMesh(m_device, m_model2.meshes);
+		AModel2->setMesh(m_device, m_model2.meshes, m_mergeMeshBuffers);
 		AModel2->setTextures(m_modelTextures2);
 
 		std::string msg = AModel2->getName() + "- Actor accessed successfully.";
@@ -163,41 +207,36 @@ BaseApp::init() {
 
 	// Set Actor
 	// Load the Texture
-	Texture gorra;
-	gorra.init(m_device, "Textures/gorra.png", ExtensionType::PNG);
-	Texture manos;
-	manos.init(m_device, "Textures/manos.png", ExtensionType::PNG);
-	Texture cejas;
-	cejas.init(m_device, "Textures/cejas.png", ExtensionType::PNG);
-	Texture rojo;
-	rojo.init(m_device, "Textures/rojo.png", ExtensionType::PNG);
-	Texture ropa;
-	ropa.init(m_device, "Textures/ropa.png", ExtensionType::PNG);
-	Texture pelo;
-	pelo.init(m_device, "Textures/pelo.png", ExtensionType::PNG);
-	Texture bigote;
-	bigote.init(m_device, "Textures/bigote.png", ExtensionType::PNG);
-	Texture ojos;
-	ojos.init(m_device, "Textures/ojos.png", ExtensionType::PNG);
-
-	m_modelTexturesOBJ.push_back(gorra);
-	m_modelTexturesOBJ.push_back(bigote);
-	m_modelTexturesOBJ.push_back(manos);
-	m_modelTexturesOBJ.push_back(ojos);
-	m_modelTexturesOBJ.push_back(ropa);
-	m_modelTexturesOBJ.push_back(rojo);
-	m_modelTexturesOBJ.push_back(pelo);
-	m_modelTexturesOBJ.push_back(cejas);
-	m_modelTexturesOBJ.push_back(m_default);
-
-	m_modelOBJ.LoadOBJModel("Models/Mario.obj");
+	std::vector<std::string> modelOBJTextureNames = { "Textures/gorra.png",
+													  "Textures/bigote.png",
+													  "Textures/manos.png",
+													  "Textures/ojos.png",
+													  "Textures/ropa.png",
+													  "Textures/rojo.png",
+													  "Textures/pelo.png",
+													  "Textures/cejas.png" };
+
+	if (!m_modelOBJ.LoadOBJModel("Models/Mario.obj")) {
+		ERROR("BaseApp", "init", "Failed to load Models/Mario.obj");
+		return E_FAIL;
+	}
+	TextureAtlas modelOBJAtlas;
+	hr = modelOBJAtlas.init(m_device, modelOBJTextureNames, m_modelOBJ.meshes, m_modelTexturesOBJ);
+	if (FAILED(hr))
+		return hr;
+	m_modelOBJ.RefitVertexFormats("Models/Mario.obj", modelOBJAtlas);
+
+	while (m_modelTexturesOBJ.size() < m_modelOBJ.meshes.size()) {
+		m_modelTexturesOBJ.push_back(m_default);
+	}
+
 	AModelOBJ = EngineUtilities::MakeShared<Actor>(m_device);
 	if (!AModelOBJ.isNull()) {
 		AModelOBJ->getComponent<Transform>()->setTransform(EngineUtilities::Vector3(-3.2f, -1.2f, 10.0f),
 															EngineUtilities::Vector3( 3.1f, 6.3f, 3.15f),
 															EngineUtilities::Vector3(1.0f, 1.0f, 1.0f));
 
-		AModelOBJ->setMesh(m_device, m_modelOBJ.meshes);
+		AModelOBJ->setMesh(m_device, m_modelOBJ.meshes, m_mergeMeshBuffers);
 		AModelOBJ->setTextures(m_modelTexturesOBJ); 
 
 		std::string msg = AModelOBJ->getName() + "- Actor accessed successfully.";
@@ -207,46 +246,228 @@ BaseApp::init() {
 		MESSAGE("Actor", "Actor", "Actor resource not found. ");
 	}
 
+	// Cada formato de vértice elegido al importar (mallas cuantizadas) necesita su input layout
+	const std::vector<MeshComponent>* loadedMeshes[] = { &m_model.meshes, &m_model2.meshes, &m_modelOBJ.meshes };
+	for (const auto* meshes : loadedMeshes) {
+		for (const auto& mesh : *meshes) {
+			if (mesh.m_format == VertexFormat::standard()) {
+				continue;
+			}
+			hr = m_shaderProgram.addInputLayout(m_device, mesh.m_format);
+			if (FAILED(hr))
+				return hr;
+			hr = m_instancedShader.addInputLayout(m_device, mesh.m_format, InstanceRows);
+			if (FAILED(hr))
+				return hr;
+		}
+	}
+
+	// Árbol de cajas sobre los actores para culling y selección con el mouse
+	m_actors = { AModel, AModel2, AModelOBJ };
+	// Las copias comparten los buffers y la textura de Mordecai, así que la cola las instancia
+	for (unsigned int i = 0; i < m_actorCopies; ++i) {
+		EngineUtilities::TSharedPointer<Actor> copy = EngineUtilities::MakeShared<Actor>(m_device);
+		if (copy.isNull()) {
+			continue;
+		}
+		copy->shareMesh(m_device, *AModel2);
+		copy->getComponent<Transform>()->setTransform(EngineUtilities::Vector3(2.0f + 1.5f * (i % 16), 1.0f, 3.0f + 1.5f * (i / 16)),
+													  EngineUtilities::Vector3(XM_PI / -2.0f, 0.0f, XM_PI / 2.0f),
+													  EngineUtilities::Vector3(1.0f, 1.0f, 1.0f));
+		m_actors.push_back(copy);
+	}
+	m_previousCameraPosition = m_camera.position;
+	std::vector<AABB> actorBounds;
+	std::vector<void*> actorData;
+	for (auto& actor : m_actors) {
+		AABB bounds;
+		actor->getWorldBounds(bounds);
+		actorBounds.push_back(bounds);
+		actorData.push_back(actor.get());
+	}
+	m_sceneTree.build(actorBounds, actorData, m_actorProxies);
+	for (size_t i = 0; i < m_actors.size(); ++i) {
+		m_actorIndex[m_actors[i].get()] = static_cast<unsigned int>(i);
+	}
+
+	// Los dos personajes FBX ocultan lo que quede detrás de ellos
+	AModel->setOccluder(true);
+	AModel2->setOccluder(true);
+	unsigned int cores = std::thread::hardware_concurrency();
+	hr = m_occlusionCuller.init(320, 192, cores > 1 ? std::min(cores - 1, 3u) : 0);
+	if (FAILED(hr))
+		return hr;
+
+	// Grabación de dibujos en varios hilos; cada lista vuelve a enlazar el estado común del frame
+	hr = m_commandLists.init(m_device, cores > 1 ? std::min(cores - 1, 3u) : 0);
+	if (FAILED(hr))
+		return hr;
+	m_commandLists.setRecorder(&m_recorder);
+	m_commandLists.setStateSetup([this](DeviceContext& deviceContext) {
+		deviceContext.OMSetRenderTargets(1,
+										 &m_renderTargetView.m_renderTargetView,
+										 m_depthStencilView.m_depthStencilView);
+		m_viewport.render(deviceContext);
+		m_shaderProgram.render(deviceContext);
+		m_neverChanges.render(deviceContext, 0, 1);
+		m_changeOnResize.render(deviceContext, 1, 1);
+	});
+	m_renderQueue.setCommandLists(&m_commandLists);
+
+	// Skinning por CPU repartido entre hilos por personaje
+	hr = m_skinning.init(cores > 1 ? std::min(cores - 1, 3u) : 0);
+	if (FAILED(hr))
+		return hr;
+
 	return S_OK;
 }
 
 void
 BaseApp::update() {
-
-	// Actualizar tiempo y rotacin
-	static float t = 0.0f;
-	if (m_swapchain.m_driverType == D3D_DRIVER_TYPE_REFERENCE) {
-		t += (float)XM_PI * 0.0125f;
+	PROFILE_SCOPE("BaseApp::update");
+
+	// Con los drivers de referencia y nulo se simula un paso fijo por frame (corridas
+	// reproducibles); con hardware, los pasos que quepan en el tiempo real transcurrido
+	m_clock.tick();
+	unsigned int steps = 1;
+	float alpha = 1.0f;
+	if (m_swapchain.m_driverType != D3D_DRIVER_TYPE_REFERENCE &&
+		m_swapchain.m_driverType != D3D_DRIVER_TYPE_NULL) {
+		steps = m_timestep.advance(m_clock.getDeltaSeconds());
+		alpha = m_timestep.getAlpha();
 	}
-	else {
-		static DWORD dwTimeStart = 0;
-		DWORD dwTimeCur = GetTickCount();
-		if (dwTimeStart == 0)
-			dwTimeStart = dwTimeCur;
-		t = (dwTimeCur - dwTimeStart) / 1000.0f;
+	{
+		PROFILE_SCOPE("Simulation");
+		for (unsigned int step = 0; step < steps; ++step) {
+			simulate(static_cast<float>(m_timestep.getStep()));
+		}
 	}
-	InputActionMap(0.016f);
-
-	// Actualizar la matriz de proyeccin
-	m_Projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, m_window.m_width / (float)m_window.m_height, 0.01f, 100.0f);
+	m_simulationSteps = steps;
+	m_interpolationAlpha = alpha;
 
-	// Actualizar la vista (si es necesario cambiar dinmicamente)
-	/*cbNeverChanges.mView = XMMatrixTranspose(m_View);
-	m_neverChanges.update(m_deviceContext, 0, nullptr, &cbNeverChanges, 0, 0);*/
+	// Estado de render: interpolado entre los dos últimos pasos de simulación
 	updateCamera();
-	// Actualizar la proyeccin en el buffer constante
-	cbChangesOnResize.mProjection = XMMatrixTranspose(m_Projection);
-	m_changeOnResize.update(m_deviceContext, 0, nullptr, &cbChangesOnResize, 0, 0);
+	// La proyección se actualiza en resizeWindow, no cada frame
+	for (auto& actor : m_actors) {
+		actor->interpolate(alpha);
+	}
+
+	// Reajustar el árbol de la escena con las transformaciones nuevas
+	PROFILE_SCOPE("Scene tree");
+	for (size_t i = 0; i < m_actors.size(); ++i) {
+		AABB bounds;
+		if (m_actors[i]->getWorldBounds(bounds)) {
+			m_sceneTree.move(m_actorProxies[i], bounds);
+		}
+	}
+}
+
+void
+BaseApp::simulate(float deltaTime) {
+	PROFILE_SCOPE("BaseApp::simulate");
+	m_simulationTime += deltaTime;
+
+	// El estado anterior se guarda antes de cualquier lógica que mueva la cámara o los actores
+	m_previousCameraPosition = m_camera.position;
+	for (auto& actor : m_actors) {
+		actor->savePreviousState();
+	}
+	InputActionMap(deltaTime);
 
 	// Actualizar info logica del mesh
-	AModel->update(0, m_deviceContext);
-	AModel2->update(0, m_deviceContext);
-	AModelOBJ->update(0, m_deviceContext);
+	for (auto& actor : m_actors) {
+		actor->update(deltaTime, m_deviceContext);
+	}
+}
+
+void
+BaseApp::buildFramePacket(FramePacket& packet) {
+	PROFILE_SCOPE("BaseApp::buildFramePacket");
+	packet.frame = ++m_packetCount;
+	packet.simulationSteps = m_simulationSteps;
+	packet.interpolationAlpha = m_interpolationAlpha;
+	packet.jitterMs = m_framePacer.getStats().jitterMs;
+	XMStoreFloat4x4(&packet.view, m_View);
+	XMStoreFloat4x4(&packet.projection, m_Projection);
+	XMStoreFloat3(&packet.cameraPosition, XMVectorLerp(XMLoadFloat3(&m_previousCameraPosition),
+													   XMLoadFloat3(&m_camera.position),
+													   m_interpolationAlpha));
+
+	// Los paquetes se reciclan, así que los vectores conservan su capacidad entre frames
+	packet.actors.resize(m_actors.size());
+	for (size_t i = 0; i < m_actors.size(); ++i) {
+		m_actors[i]->writeSnapshot(packet.actors[i]);
+	}
+
+	// Actores dentro del frustum (el árbol de la escena pertenece a la simulación)
+	m_visibleActors.clear();
+	{
+		PROFILE_SCOPE("Frustum query");
+		m_sceneTree.queryFrustum(m_View * m_Projection, m_visibleActors);
+	}
+	packet.visible.clear();
+	for (void* actor : m_visibleActors) {
+		auto found = m_actorIndex.find(actor);
+		if (found != m_actorIndex.end()) {
+			packet.visible.push_back(found->second);
+		}
+	}
+}
+
+void
+BaseApp::simulationLoop(unsigned int packetCount) {
+	PROFILE_THREAD("Simulation");
+	// La arena temporal de este hilo se libera al publicar cada paquete, no en el endFrame() del render
+	FrameArena& arena = FrameArena::getInstance();
+	arena.endThreadFrame();
+
+	for (unsigned int published = 0; packetCount == 0 || published < packetCount; ++published) {
+		m_framePacer.wait();
+		FramePacket* packet = m_packets.beginWrite();
+		if (!packet) {
+			break;
+		}
+
+		const long long inputTime = FrameClock::now();
+		{
+			PROFILE_SCOPE("Simulation frame");
+			std::lock_guard<std::mutex> lock(m_worldMutex);
+			update();
+			buildFramePacket(*packet);
+		}
+		packet->inputTime = inputTime;
+		m_packets.publish();
+		arena.endThreadFrame();
+	}
+}
+
+void
+BaseApp::startSimulation(unsigned int packetCount, bool lockstep) {
+	m_packets.setLockstep(lockstep);
+	m_simulationThread = std::thread(&BaseApp::simulationLoop, this, packetCount);
+}
 
+void
+BaseApp::stopSimulation() {
+	m_packets.shutdown();
+	if (m_simulationThread.joinable()) {
+		m_simulationThread.join();
+	}
 }
 
 void
-BaseApp::render() {
+BaseApp::render(const FramePacket& packet) {
+	PROFILE_SCOPE("BaseApp::render");
+	// Reiniciar la caché de estado: ImGui enlazó su propio estado en el frame anterior
+	m_deviceContext.beginFrame();
+	m_constantRing.update(m_deviceContext);
+
+	// Vista del paquete (la proyección se sube en resizeWindow)
+	const XMMATRIX view = XMLoadFloat4x4(&packet.view);
+	const XMMATRIX viewProjection = view * XMLoadFloat4x4(&packet.projection);
+	cbNeverChanges.mView = XMMatrixTranspose(view);
+	m_neverChanges.update(m_deviceContext, 0, nullptr, &cbNeverChanges, 0, 0);
+
 	// Limpiar los buffers
 	const float ClearColor[4] = { 0.0f, 0.125f, 0.3f, 1.0f }; // red, green, blue, alpha
 
@@ -262,27 +483,63 @@ BaseApp::render() {
 	// Configurar los buffers y shaders para el pipeline
 	m_shaderProgram.render(m_deviceContext);
 
-	//render the models
-	AModel->render(m_deviceContext);
-	AModel2->render(m_deviceContext);
-	AModelOBJ->render(m_deviceContext);
-
 	// Asignar shaders y buffers constantes
 	// Renderizar buffers constantes en el Vertex Shader
 	m_neverChanges.render(m_deviceContext, 0, 1);
 	m_changeOnResize.render(m_deviceContext, 1, 1);
 
-	// Renderizar el modelo 
-	std::vector<EngineUtilities::TSharedPointer<Actor>> actors = { AModel, AModel2, AModelOBJ }; 
-	m_UI.render(actors); 
+	// Enviar los modelos a la cola, ordenarlos por estado y dibujarlos
+	// (solo los actores que la simulación encontró en el frustum; la cola descarta además mallas sueltas)
+	m_renderQueue.begin(view, 100.0f);
+
+	// Rasterizar los oclusores y descartar los actores que quedan completamente detrás
+	{
+		PROFILE_SCOPE("Occlusion");
+		m_occlusionCuller.begin(viewProjection);
+		for (unsigned int index : packet.visible) {
+			const ActorSnapshot& snapshot = packet.actors[index];
+			snapshot.actor->submitOccluder(m_occlusionCuller, snapshot);
+		}
+		m_occlusionCuller.rasterize();
+	}
+
+	{
+		PROFILE_SCOPE("Submit");
+		for (unsigned int index : packet.visible) {
+			const ActorSnapshot& snapshot = packet.actors[index];
+			if (snapshot.hasBounds && !m_occlusionCuller.isVisible(snapshot.bounds)) {
+				continue;
+			}
+			snapshot.actor->submit(m_renderQueue, m_shaderProgram, snapshot);
+		}
+	}
+	{
+		PROFILE_SCOPE("Cull and sort");
+		m_renderQueue.cull(viewProjection);
+		m_renderQueue.sort();
+	}
+	{
+		PROFILE_SCOPE("Flush");
+		m_renderQueue.flush(m_deviceContext);
+		m_constantRing.endFrame(m_deviceContext);
+	}
+
+	// La interfaz edita los transforms de los actores: se dibuja con la simulación detenida
+	{
+		PROFILE_SCOPE("UI");
+		std::lock_guard<std::mutex> lock(m_worldMutex);
+		m_UI.render(m_actors);
+	}
 
 	// Presentar el frame en pantalla
+	PROFILE_SCOPE("Present");
 	m_swapchain.present();
 }
 
 void
 BaseApp::destroy() {
 	if (m_deviceContext.m_deviceContext) m_deviceContext.m_deviceContext->ClearState();
+	m_deviceContext.invalidateState();
 	m_UI.destroy(); // Liberar ImGui antes de destruir DirectX
 
 	AModel->destroy();
@@ -292,6 +549,12 @@ BaseApp::destroy() {
 	m_changeOnResize.destroy();
 	m_changeEveryFrame.destroy();
 	m_shaderProgram.destroy();
+	m_instancedShader.destroy();
+	m_renderQueue.destroy();
+	m_constantRing.destroy();
+	m_occlusionCuller.destroy();
+	m_commandLists.destroy();
+	m_skinning.destroy();
 
 	m_depthStencil.destroy();
 	m_depthStencilView.destroy();
@@ -299,6 +562,9 @@ BaseApp::destroy() {
 	m_swapchain.destroy();
 	m_deviceContext.destroy();
 	m_device.destroy();
+
+	// Escribir los mensajes pendientes antes de salir
+	Logger::getInstance().flush();
 }
 
 HRESULT
@@ -348,7 +614,7 @@ BaseApp::resizeWindow(HWND hWnd, LPARAM lParam) {
 			m_window.m_height,
 			DXGI_FORMAT_D24_UNORM_S8_UINT,
 			D3D11_BIND_DEPTH_STENCIL,
-			4,
+			m_swapchain.getSampleCount(),
 			0);
 		if (FAILED(hr)) {
 			ERROR("DepthStencil", "Resize", "Failed to create new DepthStencil");
@@ -371,27 +637,29 @@ BaseApp::resizeWindow(HWND hWnd, LPARAM lParam) {
 			return hr;
 		}
 
-		// Actualizar la proyeccin
-		m_Projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, m_window.m_width / (float)m_window.m_height, 0.01f, 100.0f);
-		cbChangesOnResize.mProjection = XMMatrixTranspose(m_Projection);
+		// Actualizar la proyección (la simulación la copia en cada paquete)
+		{
+			std::lock_guard<std::mutex> lock(m_worldMutex);
+			m_Projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, m_window.m_width / (float)m_window.m_height, 0.01f, 100.0f);
+			cbChangesOnResize.mProjection = XMMatrixTranspose(m_Projection);
+		}
 		m_changeOnResize.update(m_deviceContext, 0, nullptr, &cbChangesOnResize, 0, 0);
 	}
 }
 
 void 
 BaseApp::updateCamera(){
-	XMVECTOR pos = XMLoadFloat3(&m_camera.position);
+	// Posición entre el paso anterior y el actual, igual que los actores
+	XMVECTOR pos = XMVectorLerp(XMLoadFloat3(&m_previousCameraPosition),
+								XMLoadFloat3(&m_camera.position), m_interpolationAlpha);
 	XMVECTOR dir = XMLoadFloat3(&m_camera.forward);
 	XMVECTOR up = XMLoadFloat3(&m_camera.up);
-	//Calcular la nueva vista
+	//Calcular la nueva vista (el render la sube al buffer desde el paquete)
 	m_View = XMMatrixLookAtLH(pos, pos + dir, up);
-
-	//Trasponer y actualizar el buffer de la vista
-	cbNeverChanges.mView = XMMatrixTranspose(m_View);
-	m_neverChanges.update(m_deviceContext, 0, nullptr, &cbNeverChanges, 0, 0);
 }
 
 void BaseApp::rotateCamera(int mouseX, int mouseY){
+	std::lock_guard<std::mutex> lock(m_worldMutex);
 	float offsetX = (mouseX - lastX) * sensitivity;
 	float offsetY = (mouseY - lastY) * sensitivity;
 
@@ -419,6 +687,37 @@ void BaseApp::rotateCamera(int mouseX, int mouseY){
 	XMStoreFloat3(&m_camera.right, XMVector3Normalize(right));
 }
 
+void
+BaseApp::pickActor(int mouseX, int mouseY) {
+	if (m_window.m_width == 0 || m_window.m_height == 0) {
+		return;
+	}
+
+	// Rayo desde el plano cercano hasta el lejano a través del píxel
+	std::lock_guard<std::mutex> lock(m_worldMutex);
+	float ndcX = 2.0f * mouseX / m_window.m_width - 1.0f;
+	float ndcY = 1.0f - 2.0f * mouseY / m_window.m_height;
+	XMVECTOR determinant;
+	XMMATRIX inverseViewProjection = XMMatrixInverse(&determinant, m_View * m_Projection);
+	XMVECTOR nearPoint = XMVector3TransformCoord(XMVectorSet(ndcX, ndcY, 0.0f, 1.0f), inverseViewProjection);
+	XMVECTOR farPoint = XMVector3TransformCoord(XMVectorSet(ndcX, ndcY, 1.0f, 1.0f), inverseViewProjection);
+
+	XMFLOAT3 origin;
+	XMFLOAT3 direction;
+	XMStoreFloat3(&origin, nearPoint);
+	XMStoreFloat3(&direction, XMVectorSubtract(farPoint, nearPoint));
+
+	RayHit hit;
+	if (!m_sceneTree.raycast(origin, direction, 1.0f, hit)) {
+		return;
+	}
+	for (size_t i = 0; i < m_actors.size(); ++i) {
+		if (m_actors[i].get() == hit.userData) {
+			m_UI.setSelectedActor(static_cast<int>(i));
+		}
+	}
+}
+
 void
 BaseApp::InputActionMap(float deltaTime) {
 	float speed = 1.0f * deltaTime; 
@@ -455,6 +754,58 @@ BaseApp::InputActionMap(float deltaTime) {
 	XMStoreFloat3(&m_camera.position, pos);
 }
 
+void
+BaseApp::updateFrameStats(const FramePacket& packet) {
+	const RecordedFrame& recorded = m_recorder.getLastFrame();
+	const RenderQueueStats& queue = m_renderQueue.getStats();
+
+	FrameSample sample;
+	sample.draws = recorded.draws;
+	sample.stateChanges = recorded.stateChanges;
+	sample.bindsSkipped = queue.bindsSkipped;
+	sample.vertexBufferBinds = queue.vertexBufferBinds;
+	sample.indexBufferBinds = queue.indexBufferBinds;
+	sample.trianglesSubmitted = queue.trianglesSubmitted;
+	sample.trianglesCulled = queue.trianglesCulled;
+	sample.trianglesDrawn = recorded.indices / 3;
+	sample.vertexBytes = queue.vertexBytes;
+	sample.actorsOccluded = m_occlusionCuller.getStats().occluded;
+	sample.uploads = recorded.uploads;
+	sample.uploadBytes = recorded.uploadBytes;
+	sample.allocations = recorded.resourcesCreated;
+	sample.ringAllocations = m_constantRing.getStats().allocations;
+	sample.bufferBytes = m_recorder.getResourceBytes(RESOURCE_BUFFER);
+	sample.textureBytes = m_recorder.getResourceBytes(RESOURCE_TEXTURE);
+	const FrameArenaStats& arena = FrameArena::getInstance().getStats();
+	sample.arenaAllocations = arena.allocations;
+	sample.arenaBytes = arena.bytes;
+	sample.arenaHeapBlocks = arena.heapBlocks;
+	sample.simulationSteps = packet.simulationSteps;
+	sample.interpolationAlpha = packet.interpolationAlpha;
+	sample.jitterMs = packet.jitterMs;
+	sample.latencyMs = static_cast<float>((FrameClock::now() - packet.inputTime) / 1.0e6);
+	sample.packetsDropped = m_packets.getStats().dropped;
+	m_frameStats.endFrame(sample);
+
+	MemoryTracker::getInstance().checkBudgets();
+}
+
+void
+BaseApp::toggleProfilerCapture() {
+	Profiler& profiler = Profiler::getInstance();
+	if (!profiler.isCapturing()) {
+		profiler.beginCapture();
+		MESSAGE("BaseApp", "toggleProfilerCapture", "Profiler capture started");
+		return;
+	}
+	if (profiler.endCapture("ProfileTrace.json")) {
+		MESSAGE("BaseApp", "toggleProfilerCapture", "Profiler capture written to ProfileTrace.json");
+	}
+	else {
+		MESSAGE("BaseApp", "toggleProfilerCapture", "Failed to write ProfileTrace.json");
+	}
+}
+
 int
 BaseApp::run(HINSTANCE hInstance,
 			 HINSTANCE hPrevInstance,
@@ -462,7 +813,130 @@ BaseApp::run(HINSTANCE hInstance,
 			 int nCmdShow,
 			 WNDPROC wndproc) {
 			 UNREFERENCED_PARAMETER(hPrevInstance);
-			 UNREFERENCED_PARAMETER(lpCmdLine);
+	PROFILE_THREAD("Main");
+
+	// "-headless [frames] [reporte]" corre sin ventana visible sobre el driver nulo
+	// "-skinbench [personajes]" mide el skinning por CPU al iniciar
+	// "-instbench [instancias]" mide el agrupado de instancias en CPU al iniciar
+	// "-cullbench [objetos]" mide el frustum culling al iniciar
+	// "-bvhbench [objetos]" mide la construcción y las consultas del AABBTree al iniciar
+	// "-occbench [cajas]" mide el rasterizador de oclusión al iniciar
+	// "-cmdbench [dibujos]" mide la grabación por cantidad de hilos (con "-headless", en el driver nulo)
+	// "-logbench [hilos]" mide el costo de una llamada al log con varios hilos a la vez
+	// "-poolbench [objetos]" compara TObjectPool con el heap con 1 y con 4 hilos
+	// "-arenabench [frames]" cuenta las reservas del heap por frame de los temporales que usan FrameArena
+	// "-copies [n]" agrega copias de Mordecai que comparten su malla (se dibujan instanciadas)
+	// "-separatebuffers" crea un vertex e index buffer por malla en lugar de uno por modelo
+	unsigned int headlessFrames = 0;
+	unsigned int skinBenchmarkCharacters = 0;
+	unsigned int instancingBenchmarkInstances = 0;
+	unsigned int cullingBenchmarkObjects = 0;
+	unsigned int treeBenchmarkObjects = 0;
+	unsigned int occlusionBenchmarkBoxes = 0;
+	unsigned int commandListBenchmarkDraws = 0;
+	unsigned int loggerBenchmarkThreads = 0;
+	unsigned int poolBenchmarkObjects = 0;
+	unsigned int arenaBenchmarkFrames = 0;
+	std::string reportPath = "HeadlessReport.json";
+	if (lpCmdLine) {
+		std::wistringstream arguments(lpCmdLine);
+		std::wstring argument;
+		while (arguments >> argument) {
+			if (argument == L"-headless") {
+				headlessFrames = 600;
+				std::wstring value;
+				if (arguments >> value) {
+					headlessFrames = std::max(1, _wtoi(value.c_str()));
+				}
+				if (arguments >> value) {
+					reportPath = std::string(value.begin(), value.end());
+				}
+			}
+			else if (argument == L"-skinbench") {
+				skinBenchmarkCharacters = 256;
+				std::wstring value;
+				if (arguments >> value) {
+					skinBenchmarkCharacters = std::max(1, _wtoi(value.c_str()));
+				}
+			}
+			else if (argument == L"-instbench") {
+				instancingBenchmarkInstances = 10000;
+				std::wstring value;
+				if (arguments >> value) {
+					instancingBenchmarkInstances = std::max(1, _wtoi(value.c_str()));
+				}
+			}
+			else if (argument == L"-cullbench") {
+				cullingBenchmarkObjects = 100000;
+				std::wstring value;
+				if (arguments >> value) {
+					cullingBenchmarkObjects = std::max(1, _wtoi(value.c_str()));
+				}
+			}
+			else if (argument == L"-bvhbench") {
+				treeBenchmarkObjects = 1000000;
+				std::wstring value;
+				if (arguments >> value) {
+					treeBenchmarkObjects = std::max(1, _wtoi(value.c_str()));
+				}
+			}
+			else if (argument == L"-occbench") {
+				occlusionBenchmarkBoxes = 10000;
+				std::wstring value;
+				if (arguments >> value) {
+					occlusionBenchmarkBoxes = std::max(1, _wtoi(value.c_str()));
+				}
+			}
+			else if (argument == L"-cmdbench") {
+				commandListBenchmarkDraws = 10000;
+				std::wstring value;
+				if (arguments >> value) {
+					commandListBenchmarkDraws = std::max(1, _wtoi(value.c_str()));
+				}
+			}
+			else if (argument == L"-logbench") {
+				loggerBenchmarkThreads = 4;
+				std::wstring value;
+				if (arguments >> value) {
+					loggerBenchmarkThreads = std::max(1, _wtoi(value.c_str()));
+				}
+			}
+			else if (argument == L"-poolbench") {
+				poolBenchmarkObjects = 1000000;
+				std::wstring value;
+				if (arguments >> value) {
+					poolBenchmarkObjects = std::max(1, _wtoi(value.c_str()));
+				}
+			}
+			else if (argument == L"-arenabench") {
+				arenaBenchmarkFrames = 600;
+				std::wstring value;
+				if (arguments >> value) {
+					arenaBenchmarkFrames = std::max(1, _wtoi(value.c_str()));
+				}
+			}
+			else if (argument == L"-copies") {
+				m_actorCopies = 64;
+				std::wstring value;
+				if (arguments >> value) {
+					m_actorCopies = std::max(1, _wtoi(value.c_str()));
+				}
+			}
+			else if (argument == L"-separatebuffers") {
+				m_mergeMeshBuffers = false;
+			}
+		}
+	}
+	Logger& logger = Logger::getInstance();
+	if (!logger.openFile("KamogawaEngine.log")) {
+		LOG_WARNING(LOG_CATEGORY_CORE, "Failed to open log file %s", "KamogawaEngine.log");
+	}
+	if (headlessFrames > 0) {
+		m_swapchain.setBackend(NULL_BACKEND);
+		nCmdShow = SW_HIDE;
+		logger.setSinks(logger.getSinks() | LOG_SINK_STDOUT);
+		LOG_INFO(LOG_CATEGORY_CORE, "Headless run: %u frames, report %s", headlessFrames, reportPath);
+	}
 
 	if (FAILED(m_window.init(hInstance, nCmdShow, wndproc)))
 		return 0;
@@ -472,7 +946,125 @@ BaseApp::run(HINSTANCE hInstance,
 		return 0;
 	}
 
+	if (skinBenchmarkCharacters > 0) {
+		const SkinningBenchmarkResult bench = runSkinningBenchmark(m_skinning, skinBenchmarkCharacters, 60);
+		LOG_INFO(LOG_CATEGORY_CORE, "Skinning benchmark: %u characters x %u bones x %u vertices, %u threads, AVX2 %d",
+				 bench.characters, bench.bones, bench.vertices, bench.threads, bench.avx2 ? 1 : 0);
+		LOG_INFO(LOG_CATEGORY_CORE, "Skinning benchmark: LBS %.2f characters/ms, DQS %.2f characters/ms",
+				 bench.linearCharactersPerMs, bench.dualCharactersPerMs);
+	}
+
+	if (instancingBenchmarkInstances > 0) {
+		const InstancingBenchmarkResult bench = runInstancingBenchmark(instancingBenchmarkInstances, 16, 120);
+		LOG_INFO(LOG_CATEGORY_CORE, "Instancing benchmark: %u instances over %u meshes in %u batches, %.3f ms/frame (%.1f ns/instance)",
+				 bench.instances, bench.keys, bench.batches, bench.submitMs, bench.nsPerInstance);
+	}
+
+	if (cullingBenchmarkObjects > 0) {
+		const CullingBenchmarkResult bench = runCullingBenchmark(cullingBenchmarkObjects, 120);
+		LOG_INFO(LOG_CATEGORY_CORE, "Culling benchmark: %u boxes, %u visible, cullTimeMs %.3f (%.2f ns/box)",
+				 bench.objects, bench.visible, bench.cullTimeMs, bench.nsPerObject);
+	}
+
+	if (treeBenchmarkObjects > 0) {
+		const AABBTreeBenchmarkResult bench = runAABBTreeBenchmark(treeBenchmarkObjects, 100000);
+		LOG_INFO(LOG_CATEGORY_CORE, "AABBTree benchmark: %u objects, height %d, build %.1f ms",
+				 bench.objects, bench.height, bench.buildMs);
+		LOG_INFO(LOG_CATEGORY_CORE, "AABBTree benchmark: frustum %.3f ms (%.0f results), raycast %.1f/ms (%.0f%% hit), overlap %.1f/ms (%.2f results)",
+				 bench.frustumQueryMs, bench.frustumResults, bench.raycastsPerMs, bench.raycastHitRate * 100.0,
+				 bench.overlapQueriesPerMs, bench.overlapResults);
+	}
+
+	if (occlusionBenchmarkBoxes > 0) {
+		const OcclusionBenchmarkResult bench = runOcclusionBenchmark(m_occlusionCuller, 64, occlusionBenchmarkBoxes, 120);
+		LOG_INFO(LOG_CATEGORY_CORE, "Occlusion benchmark: %ux%u, %u occluder triangles (%u rasterized), raster %.3f ms",
+				 bench.width, bench.height, bench.occluderTriangles, bench.rasterizedTriangles, bench.rasterTimeMs);
+		LOG_INFO(LOG_CATEGORY_CORE, "Occlusion benchmark: %u of %u boxes occluded (%.1f%%), %.1f ns/box",
+				 bench.occluded, bench.tested, bench.tested > 0 ? 100.0 * bench.occluded / bench.tested : 0.0,
+				 bench.testNsPerBox);
+	}
+
+	if (loggerBenchmarkThreads > 0) {
+		const LoggerBenchmarkResult bench = runLoggerBenchmark(loggerBenchmarkThreads, 200000);
+		LOG_INFO(LOG_CATEGORY_CORE, "Logger benchmark: %u threads, %llu calls, %.1f ns/call, %u dropped",
+				 bench.threads, bench.calls, bench.nsPerCall, bench.dropped);
+	}
+
+	if (poolBenchmarkObjects > 0) {
+		const unsigned int threadCounts[] = { 1, 4 };
+		for (unsigned int threads : threadCounts) {
+			const EngineUtilities::PoolBenchmarkResult bench = EngineUtilities::runObjectPoolBenchmark(poolBenchmarkObjects, threads);
+			LOG_INFO(LOG_CATEGORY_CORE, "Pool benchmark: %u objects, %u threads, pool %.1f ms (%.1f ns/object), heap %.1f ms (%.1f ns/object)",
+					 bench.objects, bench.threads, bench.poolMs, bench.poolNsPerObject, bench.heapMs, bench.heapNsPerObject);
+		}
+	}
+
+	if (arenaBenchmarkFrames > 0) {
+		// Los temporales que pasaron a la arena: pilas de las consultas del árbol de la escena,
+		// arreglos del agrupado de instancias y matrices de modelo del esqueleto
+		InstanceBatcher batcher;
+		std::vector<void*> results;
+		std::vector<BoneTransform> pose;
+		std::vector<XMFLOAT4X4> skinMatrices;
+		std::vector<InstanceKey> keys(m_actors.size());
+		std::vector<XMFLOAT4X4> worlds(m_actors.size());
+		for (size_t i = 0; i < m_actors.size(); ++i) {
+			keys[i].vertexBuffer = m_actors[i].get();
+			keys[i].indexCount = 36;
+			XMStoreFloat4x4(&worlds[i], m_actors[i]->getComponent<Transform>()->matrix);
+		}
+		const XMMATRIX viewProjection = m_View * m_Projection;
+		const XMFLOAT3 origin = m_camera.position;
+		const XMFLOAT3 direction(0.0f, 0.0f, 100.0f);
+		const unsigned int instances = 1024;
+
+		const FrameArenaBenchmarkResult bench = runFrameArenaBenchmark([&]() {
+			results.clear();
+			m_sceneTree.queryFrustum(viewProjection, results);
+			RayHit hit;
+			m_sceneTree.raycast(origin, direction, 1.0f, hit);
+			batcher.clear();
+			for (unsigned int i = 0; i < instances; ++i) {
+				const size_t actor = i % keys.size();
+				batcher.add(keys[actor], &worlds[actor]._11, i);
+			}
+			batcher.build(2, instances);
+			m_model.skeleton.getBindPose(pose);
+			m_model.skeleton.computeSkinMatrices(pose, skinMatrices);
+		}, arenaBenchmarkFrames, 8);
+		LOG_INFO(LOG_CATEGORY_CORE, "Arena benchmark: first frame %llu heap allocations + %u arena blocks",
+				 bench.firstFrameHeapCalls, bench.firstFrameArenaBlocks);
+		LOG_INFO(LOG_CATEGORY_CORE, "Arena benchmark: after %u warm-up frames, %.2f heap allocations/frame + %u arena blocks over %u frames (%u arena allocations/frame)",
+				 bench.warmupFrames, bench.heapCallsPerFrame, bench.arenaBlocks, bench.frames, bench.arenaAllocationsPerFrame);
+	}
+
+	if (commandListBenchmarkDraws > 0) {
+		// Los dibujos del benchmark no van al registro de comandos del primer frame
+		const unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+		std::vector<CommandListBenchmarkEntry> entries;
+		m_deviceContext.setRecorder(nullptr);
+		HRESULT hr = runCommandListBenchmark(m_device, m_deviceContext, commandListBenchmarkDraws,
+											 std::min(cores, 8u) - 1, 30, entries);
+		m_deviceContext.setRecorder(&m_recorder);
+		if (FAILED(hr)) {
+			ERROR("BaseApp", "run", "Command list benchmark failed");
+		}
+		for (const auto& entry : entries) {
+			LOG_INFO(LOG_CATEGORY_CORE, "Command list benchmark: %u draws, %u workers, record %.3f ms, execute %.3f ms, %.1f draws/ms",
+					 commandListBenchmarkDraws, entry.workers, entry.recordTimeMs, entry.executeTimeMs, entry.drawsPerMs);
+		}
+	}
+
+	if (headlessFrames > 0) {
+		return runHeadless(headlessFrames, reportPath);
+	}
+
 	// Main message loop
+	// En modo interactivo solo se usa el último frame del registro
+	m_recorder.setKeepFrames(false);
+	// La simulación avanza a su propio ritmo; el render dibuja el paquete más reciente
+	m_framePacer.setTargetFps(kTargetFps);
+	startSimulation(0, false);
 	MSG msg = { 0 };
 	while (WM_QUIT != msg.message) {
 		if (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
@@ -480,12 +1072,111 @@ BaseApp::run(HINSTANCE hInstance,
 			DispatchMessage(&msg);
 		}
 		else {
-			update();
-			render();
+			// Espera corta para seguir atendiendo la ventana si la simulación se retrasa
+			const FramePacket* packet = m_packets.acquire(std::chrono::milliseconds(kPacketWaitMs));
+			if (!packet) {
+				continue;
+			}
+			PROFILE_BEGIN_FRAME();
+			m_frameStats.beginFrame();
+			m_recorder.beginFrame();
+			{
+				PROFILE_SCOPE("Frame");
+				render(*packet);
+			}
+			m_recorder.endFrame();
+			FrameArena::getInstance().endFrame();
+			updateFrameStats(*packet);
+			PROFILE_END_FRAME();
 		}
 	}
+	stopSimulation();
 
+	// Si la captura sigue abierta al cerrar, guardarla de todas formas
+	if (Profiler::getInstance().isCapturing()) {
+		toggleProfilerCapture();
+	}
+	if (!MemoryTracker::getInstance().writeReport("MemoryReport.json")) {
+		MESSAGE("BaseApp", "run", "Failed to write MemoryReport.json");
+	}
 	destroy();
 
 	return (int)msg.wParam;
 }
+
+int
+BaseApp::runHeadless(unsigned int frameCount, const std::string& reportPath) {
+#ifdef PROFILE
+	// Toda la corrida queda en una traza junto al reporte
+	Profiler::getInstance().beginCapture();
+#endif
+	// En lockstep cada paquete publicado se dibuja: la secuencia de paquetes solo depende de la
+	// simulación y su hash debe repetirse entre corridas
+	startSimulation(frameCount, true);
+	unsigned long long snapshotHash = 14695981039346656037ULL;
+	unsigned int frame = 0;
+	unsigned long long vertexBufferBinds = 0;
+	unsigned long long indexBufferBinds = 0;
+	unsigned long long boxesTested = 0;
+	unsigned long long boxesOccluded = 0;
+	MSG msg = { 0 };
+	while (frame < frameCount && WM_QUIT != msg.message) {
+		while (PeekMessage(&msg, nullptr, 0, 0, PM_REMOVE)) {
+			TranslateMessage(&msg);
+			DispatchMessage(&msg);
+		}
+		const FramePacket* packet = m_packets.acquire(std::chrono::milliseconds(kPacketWaitMs));
+		if (!packet) {
+			continue;
+		}
+		++frame;
+		snapshotHash = (snapshotHash ^ packet->hash()) * 1099511628211ULL;
+		PROFILE_BEGIN_FRAME();
+		m_frameStats.beginFrame();
+		m_recorder.beginFrame();
+		{
+			PROFILE_SCOPE("Frame");
+			render(*packet);
+		}
+		m_recorder.endFrame();
+		FrameArena::getInstance().endFrame();
+		updateFrameStats(*packet);
+		vertexBufferBinds += m_renderQueue.getStats().vertexBufferBinds;
+		indexBufferBinds += m_renderQueue.getStats().indexBufferBinds;
+		boxesTested += m_occlusionCuller.getStats().tested;
+		boxesOccluded += m_occlusionCuller.getStats().occluded;
+		PROFILE_END_FRAME();
+	}
+	stopSimulation();
+	LOG_INFO(LOG_CATEGORY_CORE, "Snapshot hash %016llx over %u packets", snapshotHash, frame);
+	if (frame > 0) {
+		LOG_INFO(LOG_CATEGORY_CORE, "Buffer binds per frame: %.1f vertex, %.1f index (%s buffers)",
+				 static_cast<double>(vertexBufferBinds) / frame, static_cast<double>(indexBufferBinds) / frame,
+				 m_mergeMeshBuffers ? "merged" : "separate");
+	}
+	LOG_INFO(LOG_CATEGORY_CORE, "Occlusion: %llu of %llu actor boxes occluded (%.1f%%)",
+			 boxesOccluded, boxesTested, boxesTested > 0 ? 100.0 * boxesOccluded / boxesTested : 0.0);
+
+	size_t extension = reportPath.rfind('.');
+	const std::string reportStem = extension == std::string::npos ? reportPath : reportPath.substr(0, extension);
+	if (!MemoryTracker::getInstance().writeReport(reportStem + "Memory.json")) {
+		MESSAGE("BaseApp", "runHeadless", ("Failed to write memory report: " + reportStem + "Memory.json").c_str());
+	}
+
+#ifdef PROFILE
+	std::string tracePath = reportStem + "Trace.json";
+	if (!Profiler::getInstance().endCapture(tracePath)) {
+		MESSAGE("BaseApp", "runHeadless", ("Failed to write trace: " + tracePath).c_str());
+	}
+#endif
+
+	LOG_INFO(LOG_CATEGORY_CORE, "Headless run finished: %u errors, %u dropped log records",
+			 Logger::getInstance().getErrorCount(), Logger::getInstance().getDroppedRecords());
+	bool written = m_recorder.writeReport(reportPath);
+	if (!written) {
+		MESSAGE("BaseApp", "runHeadless", ("Failed to write report: " + reportPath).c_str());
+	}
+	destroy();
+
+	return written ? 0 : 1;
+}
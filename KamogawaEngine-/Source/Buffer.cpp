@@ -27,39 +27,101 @@ HRESULT
 Buffer::init(Device& device, 
              const MeshComponent& mesh, 
              unsigned int bindFlag) {
+    return init(device, std::vector<const MeshComponent*>(1, &mesh), bindFlag);
+}
+
+HRESULT
+Buffer::init(Device& device,
+             const std::vector<const MeshComponent*>& meshes,
+             unsigned int bindFlag) {
     if (!device.m_device) {
         ERROR("Buffer", "init", "Device is nullptr");
         return E_POINTER;
     }
 
-    if ((bindFlag & D3D11_BIND_VERTEX_BUFFER) && mesh.m_vertex.empty()) {
+    // Totales y formato común de las mallas
+    unsigned int vertexCount = 0;
+    unsigned int indexCount = 0;
+    for (const MeshComponent* mesh : meshes) {
+        if ((bindFlag & D3D11_BIND_VERTEX_BUFFER) && mesh->m_format != meshes[0]->m_format) {
+            ERROR("Buffer", "init", "Meshes in one vertex buffer must share their vertex format");
+            return E_INVALIDARG;
+        }
+        if ((bindFlag & D3D11_BIND_INDEX_BUFFER) && mesh->m_indexFormat != meshes[0]->m_indexFormat) {
+            ERROR("Buffer", "init", "Meshes in one index buffer must share their index format");
+            return E_INVALIDARG;
+        }
+        vertexCount += static_cast<unsigned int>(mesh->m_vertex.size());
+        indexCount += static_cast<unsigned int>(mesh->m_index.size());
+    }
+    const bool shortIndices = !meshes.empty() && meshes[0]->m_indexFormat == DXGI_FORMAT_R16_UINT;
+
+    if ((bindFlag & D3D11_BIND_VERTEX_BUFFER) && vertexCount == 0) {
         ERROR("Buffer", "init", "Vertex buffer is empty");
         return E_INVALIDARG;
     }
 
-    if ((bindFlag & D3D11_BIND_INDEX_BUFFER) && mesh.m_index.empty()) {
+    if ((bindFlag & D3D11_BIND_INDEX_BUFFER) && indexCount == 0) {
         ERROR("Buffer", "init", "Index buffer is empty");
         return E_INVALIDARG;
     }
 
     D3D11_BUFFER_DESC desc = {};
     D3D11_SUBRESOURCE_DATA InitData = {};
+    std::vector<unsigned char> packed;
 
     desc.Usage = D3D11_USAGE_DEFAULT;
     desc.CPUAccessFlags = 0;
     m_bindFlag = bindFlag;
 
     if (bindFlag & D3D11_BIND_VERTEX_BUFFER) {
-        m_stride = sizeof(SimpleVertex);
-        desc.ByteWidth = m_stride * static_cast<unsigned int>(mesh.m_vertex.size());
+        // Los vértices se empaquetan en el formato de cada malla (la posición cuantizada es relativa a su caja)
+        m_stride = meshes[0]->m_format.getStride();
+        packed.resize(static_cast<size_t>(m_stride) * vertexCount);
+        size_t offset = 0;
+        for (const MeshComponent* mesh : meshes) {
+            const unsigned int meshVertices = static_cast<unsigned int>(mesh->m_vertex.size());
+            mesh->m_format.pack(mesh->m_vertex.data(), meshVertices, packed.data() + offset, mesh->m_boundsMin, mesh->m_boundsMax);
+            offset += static_cast<size_t>(m_stride) * meshVertices;
+        }
+        desc.ByteWidth = m_stride * vertexCount;
         desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
-        InitData.pSysMem = mesh.m_vertex.data();
+        InitData.pSysMem = packed.data();
     }
     else if (bindFlag & D3D11_BIND_INDEX_BUFFER) {
-        m_stride = sizeof(unsigned int);
-        desc.ByteWidth = m_stride * static_cast<unsigned int>(mesh.m_index.size());
+        // Los índices quedan relativos al primer vértice de su malla (o de su trozo): cada malla
+        // se dibuja con su propio baseVertex
+        m_indexFormat = shortIndices ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+        m_stride = shortIndices ? sizeof(unsigned short) : sizeof(unsigned int);
+        packed.resize(static_cast<size_t>(m_stride) * indexCount);
+        unsigned char* output = packed.data();
+        for (const MeshComponent* mesh : meshes) {
+            MeshChunk whole;
+            whole.indexCount = static_cast<unsigned int>(mesh->m_index.size());
+            const MeshChunk* chunks = mesh->m_chunks.empty() ? &whole : mesh->m_chunks.data();
+            const size_t chunkCount = mesh->m_chunks.empty() ? 1 : mesh->m_chunks.size();
+            for (size_t c = 0; c < chunkCount; ++c) {
+                const MeshChunk& chunk = chunks[c];
+                for (unsigned int i = chunk.startIndex; i < chunk.startIndex + chunk.indexCount; ++i) {
+                    const unsigned int index = mesh->m_index[i] - chunk.baseVertex;
+                    if (shortIndices && index > 0xFFFF) {
+                        ERROR("Buffer", "init", "Index " << mesh->m_index[i] << " does not fit in 16 bits");
+                        return E_INVALIDARG;
+                    }
+                    if (shortIndices) {
+                        const unsigned short shortIndex = static_cast<unsigned short>(index);
+                        memcpy(output + static_cast<size_t>(i) * m_stride, &shortIndex, sizeof(shortIndex));
+                    }
+                    else {
+                        memcpy(output + static_cast<size_t>(i) * m_stride, &index, sizeof(index));
+                    }
+                }
+            }
+            output += static_cast<size_t>(m_stride) * mesh->m_index.size();
+        }
+        desc.ByteWidth = m_stride * indexCount;
         desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
-        InitData.pSysMem = mesh.m_index.data();
+        InitData.pSysMem = packed.data();
     }
 
     return createBuffer(device, desc, &InitData);
@@ -84,6 +146,53 @@ Buffer::init(Device& device,
     return createBuffer(device, desc, nullptr);
 }
 
+HRESULT 
+Buffer::init(Device& device, 
+             unsigned int stride, 
+             unsigned int count, 
+             unsigned int bindFlag) {
+    if (!device.m_device || stride == 0 || count == 0) {
+        ERROR("Buffer", "init", "Invalid parameters");
+        return E_INVALIDARG;
+    }
+
+    m_stride = stride;
+    m_bindFlag = bindFlag;
+    m_byteWidth = stride * count;
+
+    D3D11_BUFFER_DESC desc = {};
+    desc.Usage = D3D11_USAGE_DYNAMIC;
+    desc.ByteWidth = m_byteWidth;
+    desc.BindFlags = bindFlag;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+
+    return createBuffer(device, desc, nullptr);
+}
+
+HRESULT 
+Buffer::write(DeviceContext& deviceContext, 
+              const void* pSrcData, 
+              unsigned int byteSize) {
+    if (!m_buffer || !pSrcData) {
+        ERROR("Buffer", "write", "Buffer or source data is nullptr");
+        return E_POINTER;
+    }
+    if (byteSize > m_byteWidth) {
+        ERROR("Buffer", "write", "Data exceeds buffer size");
+        return E_INVALIDARG;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped = {};
+    HRESULT hr = deviceContext.Map(m_buffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped);
+    if (FAILED(hr)) {
+        ERROR("Buffer", "write", "Failed to map buffer");
+        return hr;
+    }
+    memcpy(mapped.pData, pSrcData, byteSize);
+    deviceContext.Unmap(m_buffer, 0);
+    return S_OK;
+}
+
 void 
 Buffer::update(DeviceContext& deviceContext,
                const unsigned int DstSubresource,
@@ -0,0 +1,239 @@
+#include "CommandListPool.h"
+#include "Device.h"
+#include "Buffer.h"
+#include <algorithm>
+#include <chrono>
+
+HRESULT
+CommandListPool::init(Device& device, unsigned int workerCount) {
+	destroy();
+
+	m_contexts.resize(workerCount);
+	m_commandLists.assign(workerCount, nullptr);
+	m_recorders.resize(workerCount);
+	for (unsigned int worker = 0; worker < workerCount; ++worker) {
+		HRESULT hr = m_contexts[worker].initDeferred(device);
+		if (FAILED(hr)) {
+			ERROR("CommandListPool", "init", "Failed to create deferred context");
+			destroy();
+			return hr;
+		}
+	}
+	setRecorder(m_recorder);
+
+	m_quit = false;
+	m_generation = 0;
+	for (unsigned int worker = 0; worker < workerCount; ++worker) {
+		m_workers.push_back(std::thread(&CommandListPool::workerLoop, this, worker));
+	}
+	return S_OK;
+}
+
+void
+CommandListPool::destroy() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_quit = true;
+	}
+	m_startSignal.notify_all();
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+	m_workers.clear();
+
+	for (auto& commandList : m_commandLists) {
+		SAFE_RELEASE(commandList);
+	}
+	for (auto& context : m_contexts) {
+		context.destroy();
+	}
+	m_commandLists.clear();
+	m_contexts.clear();
+	m_recorders.clear();
+}
+
+void
+CommandListPool::setRecorder(CommandRecorder* recorder) {
+	m_recorder = recorder;
+	for (size_t worker = 0; worker < m_contexts.size(); ++worker) {
+		m_contexts[worker].setRecorder(recorder ? &m_recorders[worker] : nullptr);
+	}
+}
+
+void
+CommandListPool::dispatch(DeviceContext& immediate, unsigned int rangeCount, const RecordTask& task) {
+	PROFILE_SCOPE("CommandListPool::dispatch");
+	auto start = std::chrono::high_resolution_clock::now();
+	rangeCount = std::max(1u, std::min(rangeCount, getMaxRanges()));
+	m_stats = CommandListStats();
+	m_stats.ranges = rangeCount;
+
+	const bool parallel = rangeCount > 1;
+	if (parallel) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_task = &task;
+			m_rangeCount = rangeCount;
+			m_pendingWorkers = static_cast<unsigned int>(m_workers.size());
+			++m_generation;
+		}
+		m_startSignal.notify_all();
+	}
+
+	// El primer rango se graba directo en el contexto inmediato
+	task(immediate, 0);
+
+	if (!parallel) {
+		auto end = std::chrono::high_resolution_clock::now();
+		m_stats.recordTimeMs = std::chrono::duration<double, std::milli>(end - start).count();
+		return;
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_doneSignal.wait(lock, [this] { return m_pendingWorkers == 0; });
+		m_task = nullptr;
+	}
+	auto recorded = std::chrono::high_resolution_clock::now();
+	m_stats.recordTimeMs = std::chrono::duration<double, std::milli>(recorded - start).count();
+
+	// Reproducir en orden de rango; el contexto queda en el estado por defecto tras cada lista
+	PROFILE_SCOPE("Execute command lists");
+	for (unsigned int worker = 0; worker + 1 < rangeCount; ++worker) {
+		if (!m_commandLists[worker]) {
+			continue;
+		}
+		immediate.ExecuteCommandList(m_commandLists[worker], false);
+		SAFE_RELEASE(m_commandLists[worker]);
+		++m_stats.lists;
+		if (m_recorder) {
+			m_recorder->append(m_recorders[worker].getCommands());
+		}
+	}
+	if (m_stateSetup) {
+		m_stateSetup(immediate);
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+	m_stats.executeTimeMs = std::chrono::duration<double, std::milli>(end - recorded).count();
+}
+
+void
+CommandListPool::recordWorker(unsigned int worker) {
+	PROFILE_SCOPE("CommandListPool::recordWorker");
+	DeviceContext& context = m_contexts[worker];
+	if (m_recorder) {
+		m_recorders[worker].beginFrame();
+	}
+	if (m_stateSetup) {
+		m_stateSetup(context);
+	}
+	(*m_task)(context, worker + 1);
+
+	HRESULT hr = context.FinishCommandList(false, &m_commandLists[worker]);
+	if (FAILED(hr)) {
+		ERROR("CommandListPool", "recordWorker", "Failed to finish command list");
+		m_commandLists[worker] = nullptr;
+	}
+}
+
+void
+CommandListPool::workerLoop(unsigned int worker) {
+	PROFILE_THREAD("Command list worker");
+	unsigned int seenGeneration = 0;
+	for (;;) {
+		bool hasRange = false;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_startSignal.wait(lock, [&] { return m_quit || m_generation != seenGeneration; });
+			if (m_quit) {
+				return;
+			}
+			seenGeneration = m_generation;
+			hasRange = worker + 1 < m_rangeCount;
+		}
+
+		if (hasRange) {
+			recordWorker(worker);
+		}
+
+		bool last = false;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			last = --m_pendingWorkers == 0;
+		}
+		if (last) {
+			m_doneSignal.notify_one();
+		}
+	}
+}
+
+HRESULT
+runCommandListBenchmark(Device& device,
+						DeviceContext& immediate,
+						unsigned int draws,
+						unsigned int maxWorkers,
+						unsigned int frames,
+						std::vector<CommandListBenchmarkEntry>& entries) {
+	constexpr unsigned int kConstantBuffers = 16;
+	entries.clear();
+	frames = frames > 0 ? frames : 1;
+
+	// 01. Buffers que alternan los dibujos para que cada enlace sea un cambio real
+	std::vector<Buffer> constantBuffers(kConstantBuffers);
+	for (auto& buffer : constantBuffers) {
+		HRESULT hr = buffer.init(device, 64);
+		if (FAILED(hr)) {
+			ERROR("CommandListPool", "runCommandListBenchmark", "Failed to create constant buffer");
+			for (auto& created : constantBuffers) {
+				created.destroy();
+			}
+			return hr;
+		}
+	}
+
+	// 02. Cada rango graba su parte contigua de los dibujos
+	for (unsigned int workers = 0; workers <= maxWorkers; ++workers) {
+		CommandListPool pool;
+		HRESULT hr = pool.init(device, workers);
+		if (FAILED(hr)) {
+			for (auto& buffer : constantBuffers) {
+				buffer.destroy();
+			}
+			return hr;
+		}
+
+		const unsigned int ranges = workers + 1;
+		CommandListPool::RecordTask task = [&](DeviceContext& deviceContext, unsigned int range) {
+			const unsigned int first = static_cast<unsigned int>(static_cast<unsigned long long>(draws) * range / ranges);
+			const unsigned int last = static_cast<unsigned int>(static_cast<unsigned long long>(draws) * (range + 1) / ranges);
+			deviceContext.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+			for (unsigned int draw = first; draw < last; ++draw) {
+				ID3D11Buffer* buffer = constantBuffers[draw % kConstantBuffers].getBuffer();
+				deviceContext.VSSetConstantBuffers(2, 1, &buffer);
+				deviceContext.DrawIndexed(36, 0, 0);
+			}
+		};
+
+		// Un frame de calentamiento crea las listas antes de medir
+		pool.dispatch(immediate, ranges, task);
+		CommandListBenchmarkEntry entry;
+		entry.workers = workers;
+		for (unsigned int frame = 0; frame < frames; ++frame) {
+			pool.dispatch(immediate, ranges, task);
+			entry.recordTimeMs += pool.getStats().recordTimeMs;
+			entry.executeTimeMs += pool.getStats().executeTimeMs;
+		}
+		entry.recordTimeMs /= frames;
+		entry.executeTimeMs /= frames;
+		const double frameMs = entry.recordTimeMs + entry.executeTimeMs;
+		entry.drawsPerMs = frameMs > 0.0 ? draws / frameMs : 0.0;
+		entries.push_back(entry);
+		pool.destroy();
+	}
+
+	for (auto& buffer : constantBuffers) {
+		buffer.destroy();
+	}
+	return S_OK;
+}
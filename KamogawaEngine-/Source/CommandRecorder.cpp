@@ -0,0 +1,186 @@
+#include "CommandRecorder.h"
+#include <algorithm>
+#include <fstream>
+
+namespace {
+	const char* const g_commandNames[CMD_TYPE_COUNT] = {
+		"SetInputLayout",
+		"SetVertexShader",
+		"SetPixelShader",
+		"SetVertexBuffers",
+		"SetIndexBuffer",
+		"SetTopology",
+		"SetShaderResources",
+		"SetSamplers",
+		"SetVSConstantBuffers",
+		"SetPSConstantBuffers",
+		"SetRasterizerState",
+		"SetBlendState",
+		"SetRenderTargets",
+		"SetViewports",
+		"ClearRenderTarget",
+		"ClearDepthStencil",
+		"UpdateSubresource",
+		"Map",
+		"DrawIndexed",
+		"DrawIndexedInstanced",
+		"Present"
+	};
+
+	/**
+	 * @brief Percentil (0-1) de una lista ya ordenada.
+	 */
+	double
+	percentile(const std::vector<double>& sorted, double p) {
+		if (sorted.empty()) {
+			return 0.0;
+		}
+		size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+		return sorted[std::min(index, sorted.size() - 1)];
+	}
+}
+
+void
+CommandRecorder::beginFrame() {
+	m_commands.clear();
+	m_current = RecordedFrame();
+	m_frameStart = std::chrono::steady_clock::now();
+}
+
+void
+CommandRecorder::endFrame() {
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_frameStart;
+	m_current.cpuTimeMs = elapsed.count();
+	m_current.commands = static_cast<unsigned int>(m_commands.size());
+	m_lastFrame = m_current;
+	if (m_keepFrames) {
+		m_frames.push_back(m_current);
+	}
+}
+
+void
+CommandRecorder::record(RecordedCommandType type,
+						unsigned int slot,
+						unsigned int count,
+						const void* resource,
+						unsigned int bytes) {
+	RecordedCommand command;
+	command.type = type;
+	command.slot = slot;
+	command.count = count;
+	command.resource = resource;
+	command.bytes = bytes;
+	m_commands.push_back(command);
+
+	switch (type) {
+	case CMD_DRAW_INDEXED:
+	case CMD_DRAW_INDEXED_INSTANCED:
+		// En los dibujos slot guarda las instancias y count los índices por instancia
+		m_current.draws++;
+		m_current.instances += slot;
+		m_current.indices += static_cast<unsigned long long>(count) * slot;
+		break;
+	case CMD_UPDATE_SUBRESOURCE:
+	case CMD_MAP:
+		m_current.uploads++;
+		m_current.uploadBytes += bytes;
+		break;
+	case CMD_CLEAR_RENDER_TARGET:
+	case CMD_CLEAR_DEPTH_STENCIL:
+	case CMD_PRESENT:
+		break;
+	default:
+		m_current.stateChanges++;
+		break;
+	}
+}
+
+void
+CommandRecorder::append(const std::vector<RecordedCommand>& commands) {
+	for (const RecordedCommand& command : commands) {
+		record(command.type, command.slot, command.count, command.resource, command.bytes);
+	}
+}
+
+void
+CommandRecorder::recordResource(RecordedResourceType type, unsigned long long bytes) {
+	m_resourceBytes[type] += bytes;
+	m_resourceCount[type]++;
+	m_current.resourcesCreated++;
+}
+
+void
+CommandRecorder::reset() {
+	m_commands.clear();
+	m_frames.clear();
+	m_current = RecordedFrame();
+	m_lastFrame = RecordedFrame();
+	for (unsigned int type = 0; type < RESOURCE_TYPE_COUNT; ++type) {
+		m_resourceBytes[type] = 0;
+		m_resourceCount[type] = 0;
+	}
+}
+
+const char*
+CommandRecorder::getCommandName(RecordedCommandType type) {
+	return type < CMD_TYPE_COUNT ? g_commandNames[type] : "Unknown";
+}
+
+bool
+CommandRecorder::writeReport(const std::string& path) const {
+	std::ofstream file(path);
+	if (!file) {
+		return false;
+	}
+
+	std::vector<double> times;
+	times.reserve(m_frames.size());
+	double totalTime = 0.0;
+	double totalDraws = 0.0;
+	double totalStateChanges = 0.0;
+	double totalUploadBytes = 0.0;
+	for (const RecordedFrame& frame : m_frames) {
+		times.push_back(frame.cpuTimeMs);
+		totalTime += frame.cpuTimeMs;
+		totalDraws += frame.draws;
+		totalStateChanges += frame.stateChanges;
+		totalUploadBytes += static_cast<double>(frame.uploadBytes);
+	}
+	std::sort(times.begin(), times.end());
+	double frameCount = m_frames.empty() ? 1.0 : static_cast<double>(m_frames.size());
+
+	file << "{\n";
+	file << "  \"frames\": " << m_frames.size() << ",\n";
+	file << "  \"frameTimeMs\": { \"avg\": " << totalTime / frameCount
+		 << ", \"min\": " << (times.empty() ? 0.0 : times.front())
+		 << ", \"p50\": " << percentile(times, 0.5)
+		 << ", \"p99\": " << percentile(times, 0.99)
+		 << ", \"max\": " << (times.empty() ? 0.0 : times.back()) << " },\n";
+	file << "  \"avgDraws\": " << totalDraws / frameCount << ",\n";
+	file << "  \"avgStateChanges\": " << totalStateChanges / frameCount << ",\n";
+	file << "  \"avgUploadBytes\": " << totalUploadBytes / frameCount << ",\n";
+	file << "  \"resources\": { \"buffers\": " << m_resourceCount[RESOURCE_BUFFER]
+		 << ", \"bufferBytes\": " << m_resourceBytes[RESOURCE_BUFFER]
+		 << ", \"textures\": " << m_resourceCount[RESOURCE_TEXTURE]
+		 << ", \"textureBytes\": " << m_resourceBytes[RESOURCE_TEXTURE] << " },\n";
+
+	file << "  \"frameTimes\": [";
+	for (size_t i = 0; i < m_frames.size(); ++i) {
+		file << (i ? ", " : "") << m_frames[i].cpuTimeMs;
+	}
+	file << "],\n";
+
+	file << "  \"lastFrameCommands\": [\n";
+	for (size_t i = 0; i < m_commands.size(); ++i) {
+		const RecordedCommand& command = m_commands[i];
+		file << "    { \"cmd\": \"" << getCommandName(command.type)
+			 << "\", \"slot\": " << command.slot
+			 << ", \"count\": " << command.count
+			 << ", \"resource\": \"" << command.resource
+			 << "\", \"bytes\": " << command.bytes << " }"
+			 << (i + 1 < m_commands.size() ? ",\n" : "\n");
+	}
+	file << "  ]\n";
+	file << "}\n";
+	return true;
+}
@@ -0,0 +1,213 @@
+#include "ConstantBufferRing.h"
+#include "Device.h"
+#include "DeviceContext.h"
+
+HRESULT
+ConstantBufferRing::init(Device& device, DeviceContext& deviceContext, unsigned int byteWidth) {
+	if (!device.m_device || byteWidth == 0) {
+		ERROR("ConstantBufferRing", "init", "Invalid parameters");
+		return E_INVALIDARG;
+	}
+
+	// 01. Los desplazamientos en constant buffers y NO_OVERWRITE sobre ellos son de Direct3D 11.1
+	D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+	HRESULT hr = device.CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+	if (FAILED(hr) || !deviceContext.m_deviceContext1 ||
+		!options.ConstantBufferOffsetting || !options.MapNoOverwriteOnDynamicConstantBuffer) {
+		MESSAGE("ConstantBufferRing", "init", "Constant buffer offsets not supported, using per-object buffers");
+		return S_FALSE;
+	}
+
+	// 02. Crear el buffer dinámico (un constant buffer no puede pasar de 4096 constantes por enlace,
+	// pero el buffer completo sí puede ser más grande)
+	m_size = (byteWidth + kAlignment - 1) / kAlignment * kAlignment;
+
+	D3D11_BUFFER_DESC desc = {};
+	desc.Usage = D3D11_USAGE_DYNAMIC;
+	desc.ByteWidth = m_size;
+	desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+	desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+	hr = device.CreateBuffer(&desc, nullptr, &m_buffer);
+	if (FAILED(hr)) {
+		ERROR("ConstantBufferRing", "init", "Failed to create ring buffer");
+		return hr;
+	}
+
+	// 03. Un evento por frame en vuelo
+	D3D11_QUERY_DESC queryDesc = {};
+	queryDesc.Query = D3D11_QUERY_EVENT;
+	for (auto& frame : m_frames) {
+		hr = device.CreateQuery(&queryDesc, &frame.query);
+		if (FAILED(hr)) {
+			destroy();
+			return hr;
+		}
+	}
+
+	m_head = m_tail = m_used = m_frameBytes = 0;
+	m_firstFrame = m_frameCount = 0;
+	m_stats = ConstantRingStats();
+	m_stats.capacity = m_size;
+	return S_OK;
+}
+
+void
+ConstantBufferRing::update(DeviceContext& deviceContext) {
+	while (m_frameCount > 0 && retireOldest(deviceContext, false)) {
+	}
+
+	m_stats.allocations = 0;
+	m_stats.bytesAllocated = 0;
+	m_stats.bytesWasted = 0;
+	m_stats.framesInFlight = m_frameCount;
+}
+
+HRESULT
+ConstantBufferRing::map(DeviceContext& deviceContext) {
+	if (!m_buffer) {
+		ERROR("ConstantBufferRing", "map", "Ring buffer is not initialized");
+		return E_POINTER;
+	}
+
+	// Con el anillo vacío se puede descartar todo y empezar desde el inicio
+	D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+	if (m_used == 0) {
+		mapType = D3D11_MAP_WRITE_DISCARD;
+		m_head = m_tail = 0;
+	}
+
+	D3D11_MAPPED_SUBRESOURCE mapped = {};
+	HRESULT hr = deviceContext.Map(m_buffer, 0, mapType, 0, &mapped);
+	if (FAILED(hr)) {
+		ERROR("ConstantBufferRing", "map", "Failed to map ring buffer");
+		return hr;
+	}
+	m_mapped = static_cast<unsigned char*>(mapped.pData);
+	return S_OK;
+}
+
+bool
+ConstantBufferRing::allocate(DeviceContext& deviceContext, unsigned int size, ConstantAllocation& allocation) {
+	const unsigned int aligned = (size + kAlignment - 1) / kAlignment * kAlignment;
+	if (!m_mapped || aligned == 0 || aligned > m_size) {
+		return false;
+	}
+
+	for (;;) {
+		const unsigned int free = m_size - m_used;
+		bool fits = false;
+		if (m_head >= m_tail) {
+			// Libre: [head, size) y [0, tail)
+			if (m_size - m_head >= aligned && free >= aligned) {
+				fits = true;
+			}
+			else if (m_tail >= aligned && free >= (m_size - m_head) + aligned) {
+				// Saltar el final del buffer y continuar desde el inicio
+				const unsigned int waste = m_size - m_head;
+				m_used += waste;
+				m_frameBytes += waste;
+				m_stats.bytesWasted += waste;
+				++m_stats.wraps;
+				m_head = 0;
+				fits = true;
+			}
+		}
+		else if (m_tail - m_head >= aligned) {
+			fits = true;
+		}
+
+		if (fits) {
+			allocation.data = m_mapped + m_head;
+			allocation.offset = m_head;
+			allocation.firstConstant = m_head / 16;
+			allocation.numConstants = aligned / 16;
+
+			m_head = (m_head + aligned) % m_size;
+			m_used += aligned;
+			m_frameBytes += aligned;
+			++m_stats.allocations;
+			m_stats.bytesAllocated += aligned;
+			m_stats.peakBytes = m_used > m_stats.peakBytes ? m_used : m_stats.peakBytes;
+			return true;
+		}
+
+		// Sin espacio: esperar a que la GPU termine el frame más antiguo
+		if (!retireOldest(deviceContext, true)) {
+			ERROR("ConstantBufferRing", "allocate", "Frame constants exceed ring capacity");
+			return false;
+		}
+		++m_stats.stalls;
+	}
+}
+
+void
+ConstantBufferRing::unmap(DeviceContext& deviceContext) {
+	if (m_mapped) {
+		deviceContext.Unmap(m_buffer, 0);
+		m_mapped = nullptr;
+	}
+}
+
+void
+ConstantBufferRing::render(DeviceContext& deviceContext,
+						   const ConstantAllocation& allocation,
+						   unsigned int StartSlot,
+						   bool setPixelShader) {
+	deviceContext.VSSetConstantBuffers1(StartSlot, 1, &m_buffer,
+										&allocation.firstConstant, &allocation.numConstants);
+	if (setPixelShader) {
+		deviceContext.PSSetConstantBuffers1(StartSlot, 1, &m_buffer,
+											&allocation.firstConstant, &allocation.numConstants);
+	}
+}
+
+void
+ConstantBufferRing::endFrame(DeviceContext& deviceContext) {
+	if (!m_buffer || m_frameBytes == 0) {
+		return;
+	}
+
+	if (m_frameCount == kMaxFrames) {
+		retireOldest(deviceContext, true);
+		++m_stats.stalls;
+	}
+
+	FrameFence& frame = m_frames[(m_firstFrame + m_frameCount) % kMaxFrames];
+	frame.bytes = m_frameBytes;
+	deviceContext.End(frame.query);
+	++m_frameCount;
+	m_frameBytes = 0;
+}
+
+void
+ConstantBufferRing::destroy() {
+	for (auto& frame : m_frames) {
+		SAFE_RELEASE(frame.query);
+	}
+	SAFE_RELEASE(m_buffer);
+	m_mapped = nullptr;
+	m_frameCount = 0;
+}
+
+bool
+ConstantBufferRing::retireOldest(DeviceContext& deviceContext, bool wait) {
+	if (m_frameCount == 0) {
+		return false;
+	}
+
+	FrameFence& frame = m_frames[m_firstFrame];
+	HRESULT hr = deviceContext.GetData(frame.query, nullptr, 0, 0);
+	while (wait && hr == S_FALSE) {
+		std::this_thread::yield();
+		hr = deviceContext.GetData(frame.query, nullptr, 0, 0);
+	}
+	if (hr != S_OK) {
+		return false;
+	}
+
+	m_tail = (m_tail + frame.bytes) % m_size;
+	m_used -= frame.bytes;
+	m_firstFrame = (m_firstFrame + 1) % kMaxFrames;
+	--m_frameCount;
+	return true;
+}
@@ -0,0 +1,28 @@
+#include "CpuFeatures.h"
+#include <intrin.h>
+#include <immintrin.h>
+
+namespace {
+	CpuFeatures
+	detectCpuFeatures() {
+		CpuFeatures features;
+		int info[4] = {};
+		__cpuid(info, 1);
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+		if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+			return features;
+		}
+		features.avx = true;
+
+		__cpuidex(info, 7, 0);
+		features.avx2 = (info[1] & (1 << 5)) != 0;
+		return features;
+	}
+}
+
+const CpuFeatures&
+getCpuFeatures() {
+	static const CpuFeatures features = detectCpuFeatures();
+	return features;
+}
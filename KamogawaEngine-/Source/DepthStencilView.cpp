@@ -17,7 +17,7 @@ HRESULT DepthStencilView::init(Device& device,
 
     HRESULT hr = S_OK;
 
-    // Configurar la descripcin de la vista del Depth Stencil
+    // Configurar la descripción de la vista del Depth Stencil
     D3D11_DEPTH_STENCIL_VIEW_DESC descDSV;
     memset(&descDSV, 0, sizeof(descDSV));
     descDSV.Format = format;
@@ -1,5 +1,47 @@
 #include "Device.h"
 
+namespace {
+    /**
+     * @brief Bits por píxel de los formatos que usa el motor (32 para los demás).
+     */
+    unsigned int
+    bitsPerPixel(DXGI_FORMAT format) {
+        switch (format) {
+        case DXGI_FORMAT_R32G32B32A32_FLOAT:
+            return 128;
+        case DXGI_FORMAT_R32G32B32_FLOAT:
+            return 96;
+        case DXGI_FORMAT_R16G16B16A16_FLOAT:
+        case DXGI_FORMAT_R32G32_FLOAT:
+            return 64;
+        case DXGI_FORMAT_R16_UINT:
+            return 16;
+        default:
+            return 32;
+        }
+    }
+
+    /**
+     * @brief Memoria aproximada de una textura 2D, con todos sus niveles de mip.
+     */
+    unsigned long long
+    textureBytes(const D3D11_TEXTURE2D_DESC& desc) {
+        unsigned long long bytes = 0;
+        unsigned int width = desc.Width;
+        unsigned int height = desc.Height;
+        unsigned int levels = desc.MipLevels;
+        for (unsigned int level = 0; levels == 0 || level < levels; ++level) {
+            bytes += static_cast<unsigned long long>(width) * height * bitsPerPixel(desc.Format) / 8;
+            if (width == 1 && height == 1) {
+                break;
+            }
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+        return bytes * desc.ArraySize * (desc.SampleDesc.Count ? desc.SampleDesc.Count : 1);
+    }
+}
+
 void
 Device::destroy() {
     SAFE_RELEASE(m_device);
@@ -55,6 +97,9 @@ Device::CreateTexture2D(const D3D11_TEXTURE2D_DESC* pDesc,
 
     if (SUCCEEDED(hr)) {
         MESSAGE("Device", "CreateTexture2D", "Texture2D created successfully");
+        if (m_recorder) {
+            m_recorder->recordResource(RESOURCE_TEXTURE, textureBytes(*pDesc));
+        }
     }
     else {
         ERROR("Device", "CreateTexture2D",
@@ -203,6 +248,9 @@ Device::CreateBuffer(const D3D11_BUFFER_DESC* pDesc,
 
     if (SUCCEEDED(hr)) {
         MESSAGE("Device", "CreateBuffer", "Buffer created successfully");
+        if (m_recorder) {
+            m_recorder->recordResource(RESOURCE_BUFFER, pDesc->ByteWidth);
+        }
     }
     else {
         ERROR("Device", "CreateBuffer",
@@ -290,3 +338,62 @@ Device::CreateBlendState(const D3D11_BLEND_DESC* pBlendStateDesc,
     return hr;
 }
 
+
+HRESULT
+Device::CreateQuery(const D3D11_QUERY_DESC* pQueryDesc,
+                    ID3D11Query** ppQuery) {
+    if (!pQueryDesc) {
+        ERROR("Device", "CreateQuery", "pQueryDesc is nullptr");
+        return E_INVALIDARG;
+    }
+    if (!ppQuery) {
+        ERROR("Device", "CreateQuery", "ppQuery is nullptr");
+        return E_POINTER;
+    }
+
+    HRESULT hr = m_device->CreateQuery(pQueryDesc, 
+                                       ppQuery);
+
+    if (FAILED(hr)) {
+        ERROR("Device", "CreateQuery",
+            ("Failed to create Query. HRESULT: " + std::to_string(hr)).c_str());
+    }
+
+    return hr;
+}
+
+HRESULT
+Device::CreateDeferredContext(unsigned int ContextFlags,
+                              ID3D11DeviceContext** ppDeferredContext) {
+    if (!ppDeferredContext) {
+        ERROR("Device", "CreateDeferredContext", "ppDeferredContext is nullptr");
+        return E_POINTER;
+    }
+
+    HRESULT hr = m_device->CreateDeferredContext(ContextFlags, 
+                                                 ppDeferredContext);
+
+    if (SUCCEEDED(hr)) {
+        MESSAGE("Device", "CreateDeferredContext", "Deferred context created successfully");
+    }
+    else {
+        ERROR("Device", "CreateDeferredContext",
+            ("Failed to create deferred context. HRESULT: " + std::to_string(hr)).c_str());
+    }
+
+    return hr;
+}
+
+HRESULT
+Device::CheckFeatureSupport(D3D11_FEATURE Feature,
+                            void* pFeatureSupportData,
+                            unsigned int FeatureSupportDataSize) {
+    if (!pFeatureSupportData) {
+        ERROR("Device", "CheckFeatureSupport", "pFeatureSupportData is nullptr");
+        return E_POINTER;
+    }
+
+    return m_device->CheckFeatureSupport(Feature, 
+                                         pFeatureSupportData, 
+                                         FeatureSupportDataSize);
+}
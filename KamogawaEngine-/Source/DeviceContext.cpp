@@ -1,10 +1,51 @@
 #include "DeviceContext.h"
+#include "Device.h"
+
+void
+DeviceContext::init() {
+	if (!m_deviceContext) {
+		ERROR("DeviceContext", "init", "m_deviceContext is nullptr");
+		return;
+	}
+
+	// Direct3D 11.1 es opcional: solo habilita los constant buffers con desplazamiento
+	HRESULT hr = m_deviceContext->QueryInterface(__uuidof(ID3D11DeviceContext1),
+												 reinterpret_cast<void**>(&m_deviceContext1));
+	if (FAILED(hr)) {
+		m_deviceContext1 = nullptr;
+		MESSAGE("DeviceContext", "init", "ID3D11DeviceContext1 not available");
+	}
+}
+
+HRESULT
+DeviceContext::initDeferred(Device& device) {
+	if (!device.m_device) {
+		ERROR("DeviceContext", "initDeferred", "Device is nullptr");
+		return E_POINTER;
+	}
+
+	HRESULT hr = device.CreateDeferredContext(0, &m_deviceContext);
+	if (FAILED(hr)) {
+		return hr;
+	}
+	init();
+	m_stateCache.invalidate();
+	return S_OK;
+}
 
 void
 DeviceContext::destroy() {
+	m_stateCache.invalidate();
+	SAFE_RELEASE(m_deviceContext1);
 	SAFE_RELEASE(m_deviceContext);
 }
 
+void
+DeviceContext::beginFrame() {
+	m_stateCache.invalidate();
+	m_stateCache.resetStats();
+}
+
 void
 DeviceContext::RSSetViewports(unsigned int NumViewports,
 							  const D3D11_VIEWPORT* pViewports) {
@@ -12,6 +53,9 @@ DeviceContext::RSSetViewports(unsigned int NumViewports,
 		ERROR("DeviceContext", "RSSetViewports", "pViewports is nullptr");
 		return;
 	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_VIEWPORTS, 0, NumViewports, nullptr);
+	}
 	m_deviceContext->RSSetViewports(NumViewports, 
 									pViewports);
 }
@@ -24,6 +68,13 @@ DeviceContext::PSSetShaderResources(unsigned int StartSlot,
 		ERROR("DeviceContext", "PSSetShaderResources", "ppShaderResourceViews is nullptr");
 		return;
 	}
+	if (!m_stateCache.setPSShaderResources(StartSlot, NumViews,
+		reinterpret_cast<const void* const*>(ppShaderResourceViews))) {
+		return;
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_SHADER_RESOURCES, StartSlot, NumViews, ppShaderResourceViews[0]);
+	}
 	m_deviceContext->PSSetShaderResources(StartSlot, 
 										 NumViews, 
 										 ppShaderResourceViews);
@@ -35,6 +86,12 @@ DeviceContext::IASetInputLayout(ID3D11InputLayout* pInputLayout) {
 		ERROR("DeviceContext", "IASetInputLayout", "pInputLayout is nullptr");
 		return;
 	}
+	if (!m_stateCache.setInputLayout(pInputLayout)) {
+		return;
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_INPUT_LAYOUT, 0, 1, pInputLayout);
+	}
 	m_deviceContext->IASetInputLayout(pInputLayout);
 }
 
@@ -46,6 +103,16 @@ DeviceContext::VSSetShader(ID3D11VertexShader* pVertexShader,
 		ERROR("DeviceContext", "VSSetShader", "pVertexShader is nullptr");
 		return;
 	}
+	// Las instancias de clase no se rastrean; solo se filtra el caso sin ellas
+	if (NumClassInstances == 0 && !m_stateCache.setVertexShader(pVertexShader)) {
+		return;
+	}
+	if (NumClassInstances > 0) {
+		m_stateCache.invalidate();
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_VERTEX_SHADER, 0, 1, pVertexShader);
+	}
 	m_deviceContext->VSSetShader(pVertexShader, 
 								ppClassInstances, 
 								NumClassInstances);
@@ -59,6 +126,15 @@ DeviceContext::PSSetShader(ID3D11PixelShader* pPixelShader,
 		ERROR("DeviceContext", "PSSetShader", "pPixelShader is nullptr");
 		return;
 	}
+	if (NumClassInstances == 0 && !m_stateCache.setPixelShader(pPixelShader)) {
+		return;
+	}
+	if (NumClassInstances > 0) {
+		m_stateCache.invalidate();
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_PIXEL_SHADER, 0, 1, pPixelShader);
+	}
 	m_deviceContext->PSSetShader(pPixelShader, 
 								ppClassInstances, 
 								NumClassInstances);
@@ -76,6 +152,18 @@ DeviceContext::UpdateSubresource(ID3D11Resource* pDstResource,
 			"Invalid arguments: pDstResource or pSrcData is nullptr");
 		return;
 	}
+	if (m_recorder) {
+		// Los buffers se actualizan completos (o el rango de la caja); las texturas por pitch
+		unsigned int bytes = SrcDepthPitch ? SrcDepthPitch : SrcRowPitch;
+		D3D11_RESOURCE_DIMENSION dimension;
+		pDstResource->GetType(&dimension);
+		if (dimension == D3D11_RESOURCE_DIMENSION_BUFFER) {
+			D3D11_BUFFER_DESC desc;
+			static_cast<ID3D11Buffer*>(pDstResource)->GetDesc(&desc);
+			bytes = pDstBox ? (pDstBox->right - pDstBox->left) : desc.ByteWidth;
+		}
+		m_recorder->record(CMD_UPDATE_SUBRESOURCE, DstSubresource, 1, pDstResource, bytes);
+	}
 	m_deviceContext->UpdateSubresource(pDstResource,
 										DstSubresource,
 										pDstBox,
@@ -95,6 +183,13 @@ DeviceContext::IASetVertexBuffers(unsigned int StartSlot,
 			"Invalid arguments: ppVertexBuffers, pStrides, or pOffsets is nullptr");
 		return;
 	}
+	if (!m_stateCache.setVertexBuffers(StartSlot, NumBuffers,
+		reinterpret_cast<const void* const*>(ppVertexBuffers), pStrides, pOffsets)) {
+		return;
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_VERTEX_BUFFERS, StartSlot, NumBuffers, ppVertexBuffers[0]);
+	}
 	m_deviceContext->IASetVertexBuffers(StartSlot,
 										NumBuffers,
 										ppVertexBuffers,
@@ -110,6 +205,12 @@ DeviceContext::IASetIndexBuffer(ID3D11Buffer* pIndexBuffer,
 		ERROR("DeviceContext", "IASetIndexBuffer", "pIndexBuffer is nullptr");
 		return;
 	}
+	if (!m_stateCache.setIndexBuffer(pIndexBuffer, Format, Offset)) {
+		return;
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_INDEX_BUFFER, 0, 1, pIndexBuffer);
+	}
 	m_deviceContext->IASetIndexBuffer(pIndexBuffer, 
 									 Format, 
 									 Offset);
@@ -123,6 +224,13 @@ DeviceContext::PSSetSamplers(unsigned int StartSlot,
 		ERROR("DeviceContext", "PSSetSamplers", "ppSamplers is nullptr");
 		return;
 	}
+	if (!m_stateCache.setPSSamplers(StartSlot, NumSamplers,
+		reinterpret_cast<const void* const*>(ppSamplers))) {
+		return;
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_SAMPLERS, StartSlot, NumSamplers, ppSamplers[0]);
+	}
 	m_deviceContext->PSSetSamplers(StartSlot, 
 									NumSamplers, 
 									ppSamplers);
@@ -134,6 +242,9 @@ DeviceContext::RSSetState(ID3D11RasterizerState* pRasterizerState) {
 		ERROR("DeviceContext", "RSSetState", "pRasterizerState is nullptr");
 		return;
 	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_RASTERIZER_STATE, 0, 1, pRasterizerState);
+	}
 	m_deviceContext->RSSetState(pRasterizerState);
 }
 
@@ -145,6 +256,9 @@ DeviceContext::OMSetBlendState(ID3D11BlendState* pBlendState,
 		ERROR("DeviceContext", "OMSetBlendState", "pBlendState is nullptr");
 		return;
 	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_BLEND_STATE, 0, 1, pBlendState);
+	}
 	m_deviceContext->OMSetBlendState(pBlendState, 
 									BlendFactor, 
 									SampleMask);
@@ -154,7 +268,7 @@ void
 DeviceContext::OMSetRenderTargets(unsigned int NumViews,
 								  ID3D11RenderTargetView* const* ppRenderTargetViews,
 								  ID3D11DepthStencilView* pDepthStencilView) {
-	// Validar los parmetros
+	// Validar los parámetros
 	if (!ppRenderTargetViews && !pDepthStencilView) {
 		ERROR("DeviceContext", "OMSetRenderTargets",
 			"Both ppRenderTargetViews and pDepthStencilView are nullptr");
@@ -168,26 +282,35 @@ DeviceContext::OMSetRenderTargets(unsigned int NumViews,
 	}
 
 	// Asignar los render targets y el depth stencil
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_RENDER_TARGETS, 0, NumViews, pDepthStencilView);
+	}
 	m_deviceContext->OMSetRenderTargets(NumViews, ppRenderTargetViews, pDepthStencilView);
 }
 
 void
 DeviceContext::IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY Topology) {
-	// Validar el parmetro Topology
+	// Validar el parámetro Topology
 	if (Topology == D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED) {
 		ERROR("DeviceContext", "IASetPrimitiveTopology",
 			"Topology is D3D11_PRIMITIVE_TOPOLOGY_UNDEFINED");
 		return;
 	}
 
-	// Asignar la topologa al Input Assembler
+	// Asignar la topología al Input Assembler
+	if (!m_stateCache.setTopology(Topology)) {
+		return;
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_TOPOLOGY, 0, static_cast<unsigned int>(Topology), nullptr);
+	}
 	m_deviceContext->IASetPrimitiveTopology(Topology);
 }
 
 void
 DeviceContext::ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView,
 									const float ColorRGBA[4]) {
-	// Validar parmetros
+	// Validar parámetros
 	if (!pRenderTargetView) {
 		ERROR("DeviceContext", "ClearRenderTargetView", "pRenderTargetView is nullptr");
 		return;
@@ -198,6 +321,9 @@ DeviceContext::ClearRenderTargetView(ID3D11RenderTargetView* pRenderTargetView,
 	}
 
 	// Limpiar el render target
+	if (m_recorder) {
+		m_recorder->record(CMD_CLEAR_RENDER_TARGET, 0, 1, pRenderTargetView);
+	}
 	m_deviceContext->ClearRenderTargetView(pRenderTargetView, 
 										   ColorRGBA);
 }
@@ -207,7 +333,7 @@ DeviceContext::ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView,
 									unsigned int ClearFlags,
 									float Depth,
 									UINT8 Stencil) {
-	// Validar parmetros
+	// Validar parámetros
 	if (!pDepthStencilView) {
 		ERROR("DeviceContext", "ClearDepthStencilView",
 			"pDepthStencilView is nullptr");
@@ -222,6 +348,9 @@ DeviceContext::ClearDepthStencilView(ID3D11DepthStencilView* pDepthStencilView,
 	}
 
 	// Limpiar el depth stencil
+	if (m_recorder) {
+		m_recorder->record(CMD_CLEAR_DEPTH_STENCIL, 0, ClearFlags, pDepthStencilView);
+	}
 	m_deviceContext->ClearDepthStencilView(pDepthStencilView, 
 											ClearFlags, 
 											Depth, 
@@ -232,13 +361,20 @@ void
 DeviceContext::VSSetConstantBuffers(unsigned int StartSlot,
 									unsigned int NumBuffers,
 									ID3D11Buffer* const* ppConstantBuffers) {
-	// Validar parmetros
+	// Validar parámetros
 	if (!ppConstantBuffers) {
 		ERROR("DeviceContext", "VSSetConstantBuffers", "ppConstantBuffers is nullptr");
 		return;
 	}
 
 	// Asignar los constant buffers al vertex shader
+	if (!m_stateCache.setVSConstantBuffers(StartSlot, NumBuffers,
+		reinterpret_cast<const void* const*>(ppConstantBuffers))) {
+		return;
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_VS_CONSTANT_BUFFERS, StartSlot, NumBuffers, ppConstantBuffers[0]);
+	}
 	m_deviceContext->VSSetConstantBuffers(StartSlot, 
 											NumBuffers, 
 											ppConstantBuffers);
@@ -248,13 +384,20 @@ void
 DeviceContext::PSSetConstantBuffers(unsigned int StartSlot,
 									unsigned int NumBuffers,
 									ID3D11Buffer* const* ppConstantBuffers) {
-	// Validar parmetros
+	// Validar parámetros
 	if (!ppConstantBuffers) {
 		ERROR("DeviceContext", "PSSetConstantBuffers", "ppConstantBuffers is nullptr");
 		return;
 	}
 
 	// Asignar los constant buffers al pixel shader
+	if (!m_stateCache.setPSConstantBuffers(StartSlot, NumBuffers,
+		reinterpret_cast<const void* const*>(ppConstantBuffers))) {
+		return;
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_PS_CONSTANT_BUFFERS, StartSlot, NumBuffers, ppConstantBuffers[0]);
+	}
 	m_deviceContext->PSSetConstantBuffers(StartSlot, 
 										  NumBuffers, 
 										  ppConstantBuffers);
@@ -264,14 +407,189 @@ void
 DeviceContext::DrawIndexed(unsigned int IndexCount,
 							unsigned int StartIndexLocation,
 							int BaseVertexLocation) {
-	// Validar parmetros
+	// Validar parámetros
 	if (IndexCount == 0) {
 		ERROR("DeviceContext", "DrawIndexed", "IndexCount is zero");
 		return;
 	}
 
 	// Ejecutar el dibujo
+	if (m_recorder) {
+		m_recorder->record(CMD_DRAW_INDEXED, 1, IndexCount, nullptr);
+	}
 	m_deviceContext->DrawIndexed(IndexCount, 
 								StartIndexLocation, 
 								BaseVertexLocation);
 }
+
+void
+DeviceContext::DrawIndexedInstanced(unsigned int IndexCountPerInstance,
+									unsigned int InstanceCount,
+									unsigned int StartIndexLocation,
+									int BaseVertexLocation,
+									unsigned int StartInstanceLocation) {
+	// Validar parámetros
+	if (IndexCountPerInstance == 0 || InstanceCount == 0) {
+		ERROR("DeviceContext", "DrawIndexedInstanced", "IndexCountPerInstance or InstanceCount is zero");
+		return;
+	}
+
+	// Ejecutar el dibujo instanciado
+	if (m_recorder) {
+		m_recorder->record(CMD_DRAW_INDEXED_INSTANCED, InstanceCount, IndexCountPerInstance, nullptr);
+	}
+	m_deviceContext->DrawIndexedInstanced(IndexCountPerInstance,
+										  InstanceCount,
+										  StartIndexLocation,
+										  BaseVertexLocation,
+										  StartInstanceLocation);
+}
+
+HRESULT
+DeviceContext::Map(ID3D11Resource* pResource,
+				   unsigned int Subresource,
+				   D3D11_MAP MapType,
+				   unsigned int MapFlags,
+				   D3D11_MAPPED_SUBRESOURCE* pMappedResource) {
+	// Validar parámetros
+	if (!pResource || !pMappedResource) {
+		ERROR("DeviceContext", "Map", "Invalid arguments: pResource or pMappedResource is nullptr");
+		return E_INVALIDARG;
+	}
+
+	if (m_recorder) {
+		m_recorder->record(CMD_MAP, Subresource, static_cast<unsigned int>(MapType), pResource);
+	}
+	return m_deviceContext->Map(pResource, 
+								Subresource, 
+								MapType, 
+								MapFlags, 
+								pMappedResource);
+}
+
+void
+DeviceContext::Unmap(ID3D11Resource* pResource,
+					 unsigned int Subresource) {
+	if (!pResource) {
+		ERROR("DeviceContext", "Unmap", "pResource is nullptr");
+		return;
+	}
+	m_deviceContext->Unmap(pResource, Subresource);
+}
+
+void
+DeviceContext::VSSetConstantBuffers1(unsigned int StartSlot,
+									 unsigned int NumBuffers,
+									 ID3D11Buffer* const* ppConstantBuffers,
+									 const unsigned int* pFirstConstant,
+									 const unsigned int* pNumConstants) {
+	// Validar parámetros
+	if (!m_deviceContext1) {
+		ERROR("DeviceContext", "VSSetConstantBuffers1", "Direct3D 11.1 context not available");
+		return;
+	}
+	if (!ppConstantBuffers || !pFirstConstant || !pNumConstants) {
+		ERROR("DeviceContext", "VSSetConstantBuffers1", "Invalid arguments");
+		return;
+	}
+
+	// Asignar los rangos de constant buffers al vertex shader
+	if (!m_stateCache.setVSConstantBuffers(StartSlot, NumBuffers,
+		reinterpret_cast<const void* const*>(ppConstantBuffers), pFirstConstant, pNumConstants)) {
+		return;
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_VS_CONSTANT_BUFFERS, StartSlot, NumBuffers, ppConstantBuffers[0]);
+	}
+	m_deviceContext1->VSSetConstantBuffers1(StartSlot,
+											NumBuffers,
+											ppConstantBuffers,
+											pFirstConstant,
+											pNumConstants);
+}
+
+void
+DeviceContext::PSSetConstantBuffers1(unsigned int StartSlot,
+									 unsigned int NumBuffers,
+									 ID3D11Buffer* const* ppConstantBuffers,
+									 const unsigned int* pFirstConstant,
+									 const unsigned int* pNumConstants) {
+	// Validar parámetros
+	if (!m_deviceContext1) {
+		ERROR("DeviceContext", "PSSetConstantBuffers1", "Direct3D 11.1 context not available");
+		return;
+	}
+	if (!ppConstantBuffers || !pFirstConstant || !pNumConstants) {
+		ERROR("DeviceContext", "PSSetConstantBuffers1", "Invalid arguments");
+		return;
+	}
+
+	// Asignar los rangos de constant buffers al pixel shader
+	if (!m_stateCache.setPSConstantBuffers(StartSlot, NumBuffers,
+		reinterpret_cast<const void* const*>(ppConstantBuffers), pFirstConstant, pNumConstants)) {
+		return;
+	}
+	if (m_recorder) {
+		m_recorder->record(CMD_SET_PS_CONSTANT_BUFFERS, StartSlot, NumBuffers, ppConstantBuffers[0]);
+	}
+	m_deviceContext1->PSSetConstantBuffers1(StartSlot,
+											NumBuffers,
+											ppConstantBuffers,
+											pFirstConstant,
+											pNumConstants);
+}
+
+void
+DeviceContext::End(ID3D11Asynchronous* pAsync) {
+	if (!pAsync) {
+		ERROR("DeviceContext", "End", "pAsync is nullptr");
+		return;
+	}
+	m_deviceContext->End(pAsync);
+}
+
+HRESULT
+DeviceContext::GetData(ID3D11Asynchronous* pAsync,
+					   void* pData,
+					   unsigned int DataSize,
+					   unsigned int GetDataFlags) {
+	if (!pAsync) {
+		ERROR("DeviceContext", "GetData", "pAsync is nullptr");
+		return E_INVALIDARG;
+	}
+	return m_deviceContext->GetData(pAsync, 
+									pData, 
+									DataSize, 
+									GetDataFlags);
+}
+
+HRESULT
+DeviceContext::FinishCommandList(bool RestoreDeferredContextState,
+								 ID3D11CommandList** ppCommandList) {
+	if (!ppCommandList) {
+		ERROR("DeviceContext", "FinishCommandList", "ppCommandList is nullptr");
+		return E_POINTER;
+	}
+
+	HRESULT hr = m_deviceContext->FinishCommandList(RestoreDeferredContextState ? TRUE : FALSE,
+													ppCommandList);
+	// Sin conservar el estado el contexto vuelve al estado por defecto
+	if (!RestoreDeferredContextState) {
+		m_stateCache.invalidate();
+	}
+	return hr;
+}
+
+void
+DeviceContext::ExecuteCommandList(ID3D11CommandList* pCommandList,
+								  bool RestoreContextState) {
+	if (!pCommandList) {
+		ERROR("DeviceContext", "ExecuteCommandList", "pCommandList is nullptr");
+		return;
+	}
+	m_deviceContext->ExecuteCommandList(pCommandList, 
+										RestoreContextState ? TRUE : FALSE);
+	if (!RestoreContextState) {
+		m_stateCache.invalidate();
+	}
+}
@@ -1,6 +1,11 @@
 #include "ECS/Actor.h"
 #include "MeshComponent.h"
 #include "Device.h"
+#include "RenderQueue.h"
+#include "AABBTree.h"
+#include "OcclusionCuller.h"
+#include "FramePacket.h"
+#include <algorithm>
 
 Actor::Actor(Device& device) {
 	// Componentes por defecto
@@ -25,30 +30,66 @@ Actor::Actor(Device& device) {
 
 void
 Actor::update(float deltaTime, DeviceContext& deviceContext) {
+	PROFILE_SCOPE("Actor::update");
 	// Update Transform Component
 	getComponent<Transform>()->update(deltaTime);
 
-	m_model.mWorld = XMMatrixTranspose(getComponent<Transform>()->matrix);
+	// La matriz de mundo se escribe en interpolate(), con el estado interpolado
 	m_model.vMeshColor = XMFLOAT4(0.7f, 0.7f, 0.7f, 1.0f);
 
-	// Update attributes
-	m_modelBuffer.update(deviceContext, 0, nullptr, &m_model, 0, 0);
+	// Las constantes se suben al dibujar (render() o RenderQueue::flush)
+}
+
+void
+Actor::savePreviousState() {
+	getComponent<Transform>()->savePreviousState();
+}
 
+void
+Actor::interpolate(float alpha) {
+	EngineUtilities::TSharedPointer<Transform> transform = getComponent<Transform>();
+	transform->interpolate(alpha);
+	m_model.mWorld = XMMatrixTranspose(transform->matrix);
 }
 
 void
 Actor::render(DeviceContext& deviceContext) {
+	PROFILE_SCOPE("Actor::render");
+	// Sin sus constantes o su sampler (falló el constructor) el actor no se dibuja
+	if (!m_modelBuffer.getBuffer() || !m_sampler.getSamplerState()) {
+		return;
+	}
+	m_modelBuffer.update(deviceContext, 0, nullptr, &m_model, 0, 0);
 	m_sampler.render(deviceContext, 0, 1);
 
+	// Las mallas que comparten textura (p. ej. una página de atlas) no la vuelven a enlazar
+	ID3D11ShaderResourceView* boundTexture = nullptr;
+
 	// Update buffers for each individual mesh on the actor
+	const XMMATRIX world = getComponent<Transform>()->matrix;
 	for (unsigned int i = 0; i < m_meshes.size(); i++) {
-		m_vertexBuffers[i].render(deviceContext, 0, 1);
-		m_indexBuffers[i].render(deviceContext, 0, 1, false, DXGI_FORMAT_R32_UINT);
+		// La posición cuantizada se decodifica con la matriz de mundo de la malla
+		if (hasPositionDecode(i)) {
+			CBChangesEveryFrame meshConstants = m_model;
+			meshConstants.mWorld = XMMatrixTranspose(m_meshes[i].m_format.getPositionDecode(m_meshes[i].m_boundsMin,
+																							  m_meshes[i].m_boundsMax) * world);
+			m_modelBuffer.update(deviceContext, 0, nullptr, &meshConstants, 0, 0);
+		}
+		else if (i > 0 && hasPositionDecode(i - 1)) {
+			m_modelBuffer.update(deviceContext, 0, nullptr, &m_model, 0, 0);
+		}
+
+		// Los buffers compartidos por varias mallas los filtra la caché de estado del contexto
+		const MeshRange& range = m_meshRanges[i];
+		m_vertexBuffers[range.buffer].render(deviceContext, 0, 1);
+		m_indexBuffers[range.buffer].render(deviceContext, 0, 1, false, m_indexBuffers[range.buffer].getIndexFormat());
 
 		if (m_textures.size() > 0) {
 			if (i < m_textures.size()) {
-
-				m_textures[i].render(deviceContext, 0, 1);
+				if (m_textures[i].m_textureFromImg != boundTexture) {
+					m_textures[i].render(deviceContext, 0, 1);
+					boundTexture = m_textures[i].m_textureFromImg;
+				}
 			}
 			else {
 				
@@ -58,12 +99,156 @@ Actor::render(DeviceContext& deviceContext) {
 		m_modelBuffer.render(deviceContext, 2, 1, true);
 
 		deviceContext.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-		deviceContext.DrawIndexed(m_meshes[i].m_numIndex, 0, 0);
+		if (m_meshes[i].m_chunks.empty()) {
+			deviceContext.DrawIndexed(m_meshes[i].m_numIndex, range.startIndex, range.baseVertex);
+		}
+		for (const auto& chunk : m_meshes[i].m_chunks) {
+			deviceContext.DrawIndexed(chunk.indexCount, range.startIndex + chunk.startIndex, range.baseVertex + chunk.baseVertex);
+		}
 	}
 }
 
+void
+Actor::writeSnapshot(ActorSnapshot& snapshot) {
+	snapshot.actor = this;
+	XMStoreFloat4x4(&snapshot.world, getComponent<Transform>()->matrix);
+	snapshot.constants = m_model;
+	snapshot.hasBounds = getWorldBounds(snapshot.bounds);
+
+	// Constantes propias solo si alguna malla tiene la posición cuantizada
+	snapshot.meshConstants.clear();
+	const XMMATRIX world = XMLoadFloat4x4(&snapshot.world);
+	for (unsigned int i = 0; i < m_meshes.size(); i++) {
+		if (!hasPositionDecode(i)) {
+			continue;
+		}
+		snapshot.meshConstants.resize(m_meshes.size(), m_model);
+		snapshot.meshConstants[i].mWorld = XMMatrixTranspose(m_meshes[i].m_format.getPositionDecode(m_meshes[i].m_boundsMin,
+																									 m_meshes[i].m_boundsMax) * world);
+	}
+}
+
+void
+Actor::submit(RenderQueue& queue, ShaderProgram& shader, const ActorSnapshot& snapshot) {
+	PROFILE_SCOPE("Actor::submit");
+	if (!m_modelBuffer.getBuffer() || !m_sampler.getSamplerState()) {
+		return;
+	}
+	const XMMATRIX world = XMLoadFloat4x4(&snapshot.world);
+	XMFLOAT3 worldPosition(snapshot.world._41, snapshot.world._42, snapshot.world._43);
+
+	for (unsigned int i = 0; i < m_meshes.size(); i++) {
+		const MeshRange& range = m_meshRanges[i];
+		if (!m_vertexBuffers[range.buffer].getBuffer() || !m_indexBuffers[range.buffer].getBuffer()) {
+			continue;
+		}
+
+		DrawPacket packet;
+		packet.shader = &shader;
+		packet.sampler = &m_sampler;
+		packet.texture = i < m_textures.size() ? &m_textures[i] : nullptr;
+		packet.vertexBuffer = &m_vertexBuffers[range.buffer];
+		packet.vertexFormat = &m_meshes[i].m_format;
+		packet.indexBuffer = &m_indexBuffers[range.buffer];
+		packet.constantBuffer = &m_modelBuffer;
+		packet.constants = &snapshot.constants;
+		packet.constantSize = sizeof(CBChangesEveryFrame);
+		packet.indexFormat = m_indexBuffers[range.buffer].getIndexFormat();
+		packet.indexCount = m_meshes[i].m_numIndex;
+		packet.startIndex = range.startIndex;
+		packet.baseVertex = range.baseVertex;
+		packet.instanceable = true;
+		packet.world = snapshot.world;
+
+		// Posición cuantizada: la decodificación va antepuesta al mundo (también en las instancias)
+		if (hasPositionDecode(i) && i < snapshot.meshConstants.size()) {
+			packet.constants = &snapshot.meshConstants[i];
+			if (i < m_meshConstantBuffers.size() && m_meshConstantBuffers[i].getBuffer()) {
+				packet.constantBuffer = &m_meshConstantBuffers[i];
+			}
+			XMStoreFloat4x4(&packet.world, m_meshes[i].m_format.getPositionDecode(m_meshes[i].m_boundsMin,
+																				   m_meshes[i].m_boundsMax) * world);
+		}
+
+		// Caja de la malla en mundo para el culling; su centro ordena mejor que el origen del actor
+		packet.hasBounds = m_meshes[i].m_numVertex > 0;
+		if (packet.hasBounds) {
+			FrustumCuller::transformBox(m_meshes[i].m_boundsMin,
+										m_meshes[i].m_boundsMax,
+										world,
+										packet.boundsCenter,
+										packet.boundsExtents);
+		}
+		packet.sortKey = queue.makeSortKey(OPAQUE_PASS, packet,
+										   packet.hasBounds ? packet.boundsCenter : worldPosition);
+
+		// Una malla partida para índices de 16 bits se dibuja por trozos sobre los mismos buffers
+		if (m_meshes[i].m_chunks.empty()) {
+			queue.submit(packet);
+		}
+		for (const auto& chunk : m_meshes[i].m_chunks) {
+			packet.indexCount = chunk.indexCount;
+			packet.startIndex = range.startIndex + chunk.startIndex;
+			packet.baseVertex = range.baseVertex + chunk.baseVertex;
+			queue.submit(packet);
+		}
+	}
+}
+
+void
+Actor::submitOccluder(OcclusionCuller& culler, const ActorSnapshot& snapshot) {
+	if (!m_occluder) {
+		return;
+	}
+
+	const XMMATRIX world = XMLoadFloat4x4(&snapshot.world);
+	for (const auto& mesh : m_meshes) {
+		if (mesh.m_vertex.empty() || mesh.m_index.empty()) {
+			continue;
+		}
+		culler.addOccluder(&mesh.m_vertex[0].Pos,
+						   sizeof(SimpleVertex),
+						   static_cast<unsigned int>(mesh.m_vertex.size()),
+						   mesh.m_index.data(),
+						   static_cast<unsigned int>(mesh.m_index.size()),
+						   world);
+	}
+}
+
+bool
+Actor::getWorldBounds(AABB& bounds) {
+	EngineUtilities::TSharedPointer<Transform> transform = getComponent<Transform>();
+	bool found = false;
+	for (const auto& mesh : m_meshes) {
+		if (mesh.m_numVertex <= 0) {
+			continue;
+		}
+
+		XMFLOAT3 center;
+		XMFLOAT3 extents;
+		FrustumCuller::transformBox(mesh.m_boundsMin, mesh.m_boundsMax, transform->matrix, center, extents);
+
+		AABB meshBounds;
+		meshBounds.lower = XMFLOAT3(center.x - extents.x, center.y - extents.y, center.z - extents.z);
+		meshBounds.upper = XMFLOAT3(center.x + extents.x, center.y + extents.y, center.z + extents.z);
+		bounds = found ? AABB::merge(bounds, meshBounds) : meshBounds;
+		found = true;
+	}
+	return found;
+}
+
 void
 Actor::destroy() {
+	if (!m_ownsGeometry) {
+		// Los recursos compartidos los libera el actor de origen
+		for (auto& constantBuffer : m_meshConstantBuffers) {
+			constantBuffer.destroy();
+		}
+		m_modelBuffer.destroy();
+		m_sampler.destroy();
+		return;
+	}
+
 	for (auto& vertexBuffer : m_vertexBuffers) {
 		vertexBuffer.destroy();
 	}
@@ -72,7 +257,17 @@ Actor::destroy() {
 		indexBuffer.destroy();
 	}
 
+	for (auto& constantBuffer : m_meshConstantBuffers) {
+		constantBuffer.destroy();
+	}
+
+	// Una textura compartida por varias mallas se libera una sola vez
+	std::vector<ID3D11ShaderResourceView*> released;
 	for (auto& tex : m_textures) {
+		if (std::find(released.begin(), released.end(), tex.m_textureFromImg) != released.end()) {
+			continue;
+		}
+		released.push_back(tex.m_textureFromImg);
 		tex.destroy();
 	}
 	m_modelBuffer.destroy();
@@ -83,28 +278,93 @@ Actor::destroy() {
 }
 
 void
-Actor::setMesh(Device& device, std::vector<MeshComponent> meshes) {
+Actor::setMesh(Device& device, std::vector<MeshComponent> meshes, bool mergeBuffers) {
 	m_meshes = meshes;
+	m_meshRanges.assign(m_meshes.size(), MeshRange());
 	HRESULT hr;
-	for (auto& mesh : m_meshes) {
-		// Crear vertex buffer
+
+	// 01. Agrupar las mallas: una por grupo, o todas las del mismo formato de vértice y de índice
+	//     (una malla de 32 bits no obliga a las de 16 a duplicar sus índices)
+	std::vector<std::vector<const MeshComponent*>> groups;
+	for (unsigned int i = 0; i < m_meshes.size(); i++) {
+		const MeshComponent& mesh = m_meshes[i];
+		unsigned int group = static_cast<unsigned int>(groups.size());
+		if (mergeBuffers) {
+			for (unsigned int g = 0; g < groups.size(); ++g) {
+				if (groups[g][0]->m_format == mesh.m_format && groups[g][0]->m_indexFormat == mesh.m_indexFormat) {
+					group = g;
+					break;
+				}
+			}
+		}
+		if (group == groups.size()) {
+			groups.push_back(std::vector<const MeshComponent*>());
+		}
+
+		// Cada malla empieza donde terminan las anteriores de su grupo
+		MeshRange& range = m_meshRanges[i];
+		range.buffer = group;
+		for (const MeshComponent* previous : groups[group]) {
+			range.startIndex += static_cast<unsigned int>(previous->m_index.size());
+			range.baseVertex += static_cast<int>(previous->m_vertex.size());
+		}
+		groups[group].push_back(&mesh);
+	}
+
+	// 02. Un vertex y un index buffer por grupo; los grupos fallidos quedan vacíos y no se dibujan
+	for (const auto& group : groups) {
 		Buffer vertexBuffer;
-		hr = vertexBuffer.init(device, mesh, D3D11_BIND_VERTEX_BUFFER);
+		hr = vertexBuffer.init(device, group, D3D11_BIND_VERTEX_BUFFER);
 		if (FAILED(hr)) {
 			ERROR("Actor", "setMesh", "Failed to create new vertexBuffer");
 		}
-		else {
-			m_vertexBuffers.push_back(vertexBuffer);
-		}
+		m_vertexBuffers.push_back(vertexBuffer);
 
-		// Crear index buffer
 		Buffer indexBuffer;
-		hr = indexBuffer.init(device, mesh, D3D11_BIND_INDEX_BUFFER);
+		hr = indexBuffer.init(device, group, D3D11_BIND_INDEX_BUFFER);
 		if (FAILED(hr)) {
 			ERROR("Actor", "setMesh", "Failed to create new indexBuffer");
 		}
-		else {
-			m_indexBuffers.push_back(indexBuffer);
+		m_indexBuffers.push_back(indexBuffer);
+	}
+
+	// 03. Las mallas con posición cuantizada necesitan su propia matriz de mundo
+	createMeshConstantBuffers(device);
+
+	LOG_INFO(LOG_CATEGORY_RESOURCE, "%s: %u meshes in %u vertex and %u index buffers (%u each without merging)",
+			 m_name, static_cast<unsigned int>(m_meshes.size()), static_cast<unsigned int>(m_vertexBuffers.size()),
+			 static_cast<unsigned int>(m_indexBuffers.size()), static_cast<unsigned int>(m_meshes.size()));
+}
+
+bool
+Actor::hasPositionDecode(unsigned int mesh) const {
+	return m_meshes[mesh].m_format.getEncoding(VERTEX_ATTRIBUTE_POSITION) == VERTEX_ENCODING_UNORM16;
+}
+
+void
+Actor::createMeshConstantBuffers(Device& device) {
+	m_meshConstantBuffers.clear();
+	for (unsigned int i = 0; i < m_meshes.size(); ++i) {
+		Buffer constantBuffer;
+		if (hasPositionDecode(i)) {
+			HRESULT hr = constantBuffer.init(device, sizeof(CBChangesEveryFrame));
+			if (FAILED(hr)) {
+				ERROR("Actor", "createMeshConstantBuffers", "Failed to create new mesh constant buffer");
+			}
 		}
+		m_meshConstantBuffers.push_back(constantBuffer);
 	}
 }
+
+void
+Actor::shareMesh(Device& device, const Actor& source) {
+	m_meshes = source.m_meshes;
+	m_vertexBuffers = source.m_vertexBuffers;
+	m_indexBuffers = source.m_indexBuffers;
+	m_meshRanges = source.m_meshRanges;
+	m_textures = source.m_textures;
+	m_ownsGeometry = false;
+
+	// Las constantes por malla llevan la matriz de mundo de este actor: no se comparten
+	createMeshConstantBuffers(device);
+}
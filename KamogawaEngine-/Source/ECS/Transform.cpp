@@ -10,15 +10,29 @@ Transform::init(){
 
 void 
 Transform::update(float deltaTime) {
-	//aplicar escala
-	XMMATRIX scaleMatrix = XMMatrixScaling(scale.x, scale.y, scale.z);
-	//aplicar rotacion
-	XMMATRIX rotationMatrix = XMMatrixRotationRollPitchYaw(rotation.x, rotation.y, rotation.z);
-	//aplicar traslacion
-	XMMATRIX traslationMatrix = XMMatrixTranslation(position.x, position.y, position.z);
-
-	//componer la matrix final en el orden: scale -> rotation -> translation
-	matrix = scaleMatrix * rotationMatrix * traslationMatrix;
+	// La matriz final se construye solo en interpolate(), a partir del estado interpolado
+}
+
+void
+Transform::savePreviousState() {
+	previousPosition = position;
+	previousRotation = rotation;
+	previousScale = scale;
+}
+
+void
+Transform::interpolate(float alpha) {
+	XMVECTOR previousPos = XMVectorSet(previousPosition.x, previousPosition.y, previousPosition.z, 0.0f);
+	XMVECTOR currentPos = XMVectorSet(position.x, position.y, position.z, 0.0f);
+	XMVECTOR previousSca = XMVectorSet(previousScale.x, previousScale.y, previousScale.z, 0.0f);
+	XMVECTOR currentSca = XMVectorSet(scale.x, scale.y, scale.z, 0.0f);
+	// La rotación se interpola como cuaternión para no depender del orden de los ángulos
+	XMVECTOR previousRot = XMQuaternionRotationRollPitchYaw(previousRotation.x, previousRotation.y, previousRotation.z);
+	XMVECTOR currentRot = XMQuaternionRotationRollPitchYaw(rotation.x, rotation.y, rotation.z);
+
+	matrix = XMMatrixScalingFromVector(XMVectorLerp(previousSca, currentSca, alpha)) *
+			 XMMatrixRotationQuaternion(XMQuaternionSlerp(previousRot, currentRot, alpha)) *
+			 XMMatrixTranslationFromVector(XMVectorLerp(previousPos, currentPos, alpha));
 }
 
 void 
@@ -28,6 +42,10 @@ Transform::setTransform(const EngineUtilities::Vector3& newPos,
 	position = newPos;
 	rotation = newRot;
 	scale = newSca;
+	// Colocar el objeto de golpe: sin interpolar desde el estado previo
+	previousPosition = newPos;
+	previousRotation = newRot;
+	previousScale = newSca;
 }
 
 void
@@ -0,0 +1,175 @@
+#include "FrameArena.h"
+#include "MemoryTracker.h"
+#include <algorithm>
+#include <new>
+
+namespace {
+	thread_local void* t_frameArena = nullptr;
+}
+
+void*
+LinearAllocator::allocate(size_t size, size_t alignment) {
+	// Buscar espacio en el bloque actual o en los siguientes ya reservados
+	while (m_current < m_blocks.size()) {
+		const Block& block = m_blocks[m_current];
+		const size_t start = (m_offset + alignment - 1) & ~(alignment - 1);
+		if (start + size <= block.size) {
+			m_used += start + size - m_offset;
+			m_offset = start + size;
+			++m_allocations;
+			return block.data + start;
+		}
+		m_used += block.size - m_offset;
+		++m_current;
+		m_offset = 0;
+	}
+
+	// Bloque nuevo (el inicio ya está alineado a kBlockAlignment)
+	Block block;
+	block.size = std::max(m_blockSize, size);
+	block.data = static_cast<unsigned char*>(::operator new(block.size, std::align_val_t(kBlockAlignment)));
+	m_blocks.push_back(block);
+	m_capacity += block.size;
+	++m_heapBlocks;
+
+	m_current = m_blocks.size() - 1;
+	m_offset = size;
+	m_used += size;
+	++m_allocations;
+	return block.data;
+}
+
+void
+LinearAllocator::reset() {
+	// Varios bloques: fusionarlos en uno que alcance para un frame igual
+	if (m_blocks.size() > 1) {
+		const size_t capacity = m_capacity;
+		release();
+		Block block;
+		block.size = capacity;
+		block.data = static_cast<unsigned char*>(::operator new(block.size, std::align_val_t(kBlockAlignment)));
+		m_blocks.push_back(block);
+		m_capacity = block.size;
+	}
+	m_current = 0;
+	m_offset = 0;
+	m_used = 0;
+	m_allocations = 0;
+	m_heapBlocks = 0;
+}
+
+void
+LinearAllocator::release() {
+	for (const Block& block : m_blocks) {
+		::operator delete(block.data, std::align_val_t(kBlockAlignment));
+	}
+	m_blocks.clear();
+	m_capacity = 0;
+	m_current = 0;
+	m_offset = 0;
+	m_used = 0;
+}
+
+FrameArena&
+FrameArena::getInstance() {
+	static FrameArena instance;
+	return instance;
+}
+
+FrameArena::ThreadArena&
+FrameArena::getThreadArena() {
+	if (!t_frameArena) {
+		std::lock_guard<std::mutex> lock(m_registryMutex);
+		m_arenas.push_back(std::unique_ptr<ThreadArena>(new ThreadArena()));
+		t_frameArena = m_arenas.back().get();
+	}
+	return *static_cast<ThreadArena*>(t_frameArena);
+}
+
+void*
+FrameArena::allocate(size_t size, size_t alignment) {
+	return getThreadArena().frame.allocate(size, alignment);
+}
+
+void*
+FrameArena::allocateTwoFrames(size_t size, size_t alignment) {
+	ThreadArena& arena = getThreadArena();
+	const unsigned int parity = arena.ownFrame ? arena.parity : m_parity.load(std::memory_order_relaxed);
+	return arena.twoFrames[parity].allocate(size, alignment);
+}
+
+void
+FrameArena::endFrame() {
+	std::lock_guard<std::mutex> lock(m_registryMutex);
+	const unsigned int parity = m_parity.load(std::memory_order_relaxed);
+	const unsigned int next = parity ^ 1;
+
+	FrameArenaStats stats;
+	stats.peakBytes = m_stats.peakBytes;
+	stats.threads = static_cast<unsigned int>(m_arenas.size());
+	for (auto& arena : m_arenas) {
+		if (arena->ownFrame) {
+			continue;
+		}
+		LinearAllocator* used[] = { &arena->frame, &arena->twoFrames[parity] };
+		for (LinearAllocator* allocator : used) {
+			stats.allocations += allocator->getAllocations();
+			stats.bytes += allocator->getUsed();
+			stats.heapBlocks += allocator->getHeapBlocks();
+		}
+		stats.capacity += arena->frame.getCapacity() +
+						  arena->twoFrames[0].getCapacity() + arena->twoFrames[1].getCapacity();
+
+		// Lo del frame se libera; el par de dos frames libera lo del frame anterior
+		arena->frame.reset();
+		arena->twoFrames[next].reset();
+	}
+	stats.peakBytes = std::max(stats.peakBytes, stats.bytes);
+	m_stats = stats;
+	m_parity.store(next, std::memory_order_relaxed);
+}
+
+void
+FrameArena::endThreadFrame() {
+	ThreadArena& arena = getThreadArena();
+	if (!arena.ownFrame) {
+		// endFrame() lee la bandera bajo el mismo mutex
+		std::lock_guard<std::mutex> lock(m_registryMutex);
+		arena.ownFrame = true;
+		arena.parity = m_parity.load(std::memory_order_relaxed);
+	}
+	arena.parity ^= 1;
+	arena.frame.reset();
+	arena.twoFrames[arena.parity].reset();
+}
+
+FrameArenaBenchmarkResult
+runFrameArenaBenchmark(const std::function<void()>& frame, unsigned int frames, unsigned int warmupFrames) {
+	FrameArenaBenchmarkResult result;
+	result.frames = frames > 0 ? frames : 1;
+	result.warmupFrames = warmupFrames > 0 ? warmupFrames : 1;
+	FrameArena& arena = FrameArena::getInstance();
+	arena.endFrame();
+
+	// 01. Calentamiento: el primer frame se reporta aparte
+	for (unsigned int i = 0; i < result.warmupFrames; ++i) {
+		const unsigned long long before = MemoryTracker::getThreadHeapAllocations();
+		frame();
+		arena.endFrame();
+		if (i == 0) {
+			result.firstFrameHeapCalls = MemoryTracker::getThreadHeapAllocations() - before;
+			result.firstFrameArenaBlocks = arena.getStats().heapBlocks;
+		}
+	}
+
+	// 02. Frames medidos
+	const unsigned long long before = MemoryTracker::getThreadHeapAllocations();
+	for (unsigned int i = 0; i < result.frames; ++i) {
+		frame();
+		arena.endFrame();
+		result.arenaBlocks += arena.getStats().heapBlocks;
+	}
+	result.heapCallsPerFrame = static_cast<double>(MemoryTracker::getThreadHeapAllocations() - before) / result.frames;
+	result.arenaAllocationsPerFrame = arena.getStats().allocations;
+	return result;
+}
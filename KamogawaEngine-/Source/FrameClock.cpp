@@ -0,0 +1,186 @@
+#include "FrameClock.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace {
+	constexpr double kNanoseconds = 1.0e9;
+}
+
+FrameClock::FrameClock() {
+	m_start = now();
+	m_last = m_start;
+}
+
+long long
+FrameClock::now() {
+#ifdef _WIN32
+	static const long long frequency = [] {
+		LARGE_INTEGER value;
+		QueryPerformanceFrequency(&value);
+		return value.QuadPart;
+	}();
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	// Separar segundos y resto para no desbordar al multiplicar por 1e9
+	const long long seconds = counter.QuadPart / frequency;
+	const long long remainder = counter.QuadPart % frequency;
+	return seconds * 1000000000LL + remainder * 1000000000LL / frequency;
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+void
+FrameClock::tick() {
+	const long long current = now();
+	m_deltaSeconds = (current - m_last) / kNanoseconds;
+	m_last = current;
+}
+
+double
+FrameClock::getTotalSeconds() const {
+	return (now() - m_start) / kNanoseconds;
+}
+
+unsigned int
+FixedTimestep::advance(double frameSeconds) {
+	m_accumulator += std::max(0.0, frameSeconds);
+	const double limit = m_step * m_maxSteps;
+	if (m_accumulator > limit) {
+		m_droppedSeconds += m_accumulator - limit;
+		m_accumulator = limit;
+	}
+
+	unsigned int steps = 0;
+	while (m_accumulator >= m_step) {
+		m_accumulator -= m_step;
+		++steps;
+	}
+	m_stepCount += steps;
+	return steps;
+}
+
+FramePacer::FramePacer() {
+#ifdef _WIN32
+	// Temporizador de alta resolución (Windows 10 1803+); si no existe, uno normal
+	m_timer = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+	if (!m_timer) {
+		m_timer = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+	}
+#endif
+}
+
+FramePacer::~FramePacer() {
+#ifdef _WIN32
+	if (m_timer) {
+		CloseHandle(m_timer);
+	}
+#endif
+}
+
+void
+FramePacer::setTargetFps(double fps) {
+	m_targetSeconds = fps > 0.0 ? 1.0 / fps : 0.0;
+	m_stats.targetMs = static_cast<float>(m_targetSeconds * 1000.0);
+	m_nextFrame = 0;
+}
+
+void
+FramePacer::wait() {
+	long long current = FrameClock::now();
+	float sleepMs = 0.0f;
+	float spinMs = 0.0f;
+
+	if (m_targetSeconds > 0.0 && m_nextFrame > 0) {
+		// 01. Dormir hasta kSpinSeconds antes del objetivo
+		const long long spinStart = m_nextFrame - static_cast<long long>(kSpinSeconds * kNanoseconds);
+		if (current < spinStart) {
+#ifdef _WIN32
+			if (m_timer) {
+				LARGE_INTEGER due;
+				due.QuadPart = -(spinStart - current) / 100;  // Relativo, en unidades de 100 ns
+				if (SetWaitableTimer(m_timer, &due, 0, nullptr, nullptr, FALSE)) {
+					WaitForSingleObject(m_timer, INFINITE);
+				}
+			}
+			else {
+				Sleep(static_cast<DWORD>((spinStart - current) / 1000000));
+			}
+#else
+			std::this_thread::sleep_for(std::chrono::nanoseconds(spinStart - current));
+#endif
+			const long long woke = FrameClock::now();
+			sleepMs = static_cast<float>((woke - current) / 1.0e6);
+			current = woke;
+		}
+
+		// 02. Espera activa el resto (el temporizador puede despertar unos cientos de µs tarde)
+		const long long spinBegin = current;
+		while (current < m_nextFrame) {
+			std::this_thread::yield();
+			current = FrameClock::now();
+		}
+		spinMs = static_cast<float>((current - spinBegin) / 1.0e6);
+	}
+
+	// 03. Programar el siguiente frame; si este llegó tarde se reprograma desde ahora
+	if (m_targetSeconds > 0.0) {
+		const long long period = static_cast<long long>(m_targetSeconds * kNanoseconds);
+		m_nextFrame = (m_nextFrame == 0 || current - m_nextFrame > period / 2) ? current + period
+																			 : m_nextFrame + period;
+	}
+
+	if (m_lastFrame > 0) {
+		updateStats((current - m_lastFrame) / kNanoseconds);
+	}
+	m_lastFrame = current;
+	m_stats.sleepMs = sleepMs;
+	m_stats.spinMs = spinMs;
+}
+
+void
+FramePacer::updateStats(double periodSeconds) {
+	m_periods[m_next] = static_cast<float>(periodSeconds * 1000.0);
+	m_next = (m_next + 1) % kHistory;
+	m_count = std::min(m_count + 1, kHistory);
+
+	double total = 0.0;
+	for (unsigned int i = 0; i < m_count; ++i) {
+		total += m_periods[i];
+	}
+	const double average = total / m_count;
+	const double reference = m_targetSeconds > 0.0 ? m_targetSeconds * 1000.0 : average;
+
+	double deviation = 0.0;
+	double variance = 0.0;
+	double maxDeviation = 0.0;
+	unsigned int missed = 0;
+	for (unsigned int i = 0; i < m_count; ++i) {
+		const double offset = std::abs(m_periods[i] - reference);
+		deviation += offset;
+		variance += (m_periods[i] - average) * (m_periods[i] - average);
+		maxDeviation = std::max(maxDeviation, offset);
+		if (m_targetSeconds > 0.0 && m_periods[i] > reference * 1.5) {
+			++missed;
+		}
+	}
+
+	m_stats.averageMs = static_cast<float>(average);
+	m_stats.jitterMs = static_cast<float>(deviation / m_count);
+	m_stats.stdDevMs = static_cast<float>(std::sqrt(variance / m_count));
+	m_stats.maxDeviationMs = static_cast<float>(maxDeviation);
+	m_stats.missedFrames = missed;
+}
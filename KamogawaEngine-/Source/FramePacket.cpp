@@ -0,0 +1,95 @@
+#include "FramePacket.h"
+
+namespace {
+	constexpr unsigned long long kFnvOffset = 14695981039346656037ULL;
+	constexpr unsigned long long kFnvPrime = 1099511628211ULL;
+
+	void
+	hashBytes(unsigned long long& hash, const void* data, size_t bytes) {
+		const unsigned char* byte = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < bytes; ++i) {
+			hash = (hash ^ byte[i]) * kFnvPrime;
+		}
+	}
+}
+
+unsigned long long
+FramePacket::hash() const {
+	// Se excluyen los tiempos medidos (inputTime, alpha, jitter): varían entre corridas aunque la
+	// simulación sea la misma
+	unsigned long long result = kFnvOffset;
+	hashBytes(result, &frame, sizeof(frame));
+	hashBytes(result, &view, sizeof(view));
+	hashBytes(result, &projection, sizeof(projection));
+	hashBytes(result, &cameraPosition, sizeof(cameraPosition));
+	for (const ActorSnapshot& snapshot : actors) {
+		hashBytes(result, &snapshot.world, sizeof(snapshot.world));
+		hashBytes(result, &snapshot.constants.vMeshColor, sizeof(snapshot.constants.vMeshColor));
+	}
+	if (!visible.empty()) {
+		hashBytes(result, visible.data(), visible.size() * sizeof(unsigned int));
+	}
+	return result;
+}
+
+void
+FramePacketBuffer::setLockstep(bool lockstep) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_lockstep = lockstep;
+	m_signal.notify_all();
+}
+
+FramePacket*
+FramePacketBuffer::beginWrite() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	if (m_lockstep) {
+		m_signal.wait(lock, [this] { return m_closed || !m_hasReady; });
+	}
+	return m_closed ? nullptr : &m_packets[m_write];
+}
+
+void
+FramePacketBuffer::publish() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_hasReady) {
+			++m_stats.dropped;
+		}
+		std::swap(m_write, m_ready);
+		m_hasReady = true;
+		++m_stats.published;
+	}
+	m_signal.notify_all();
+}
+
+const FramePacket*
+FramePacketBuffer::acquire(std::chrono::milliseconds timeout) {
+	const FramePacket* packet = nullptr;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		if (!m_signal.wait_for(lock, timeout, [this] { return m_hasReady; })) {
+			return nullptr;
+		}
+		std::swap(m_read, m_ready);
+		m_hasReady = false;
+		++m_stats.consumed;
+		packet = &m_packets[m_read];
+	}
+	m_signal.notify_all();
+	return packet;
+}
+
+void
+FramePacketBuffer::shutdown() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_closed = true;
+	}
+	m_signal.notify_all();
+}
+
+FramePacketStats
+FramePacketBuffer::getStats() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
@@ -0,0 +1,62 @@
+#include "FrameStats.h"
+#include <algorithm>
+
+void
+FrameStats::beginFrame() {
+	auto now = std::chrono::steady_clock::now();
+	if (m_started) {
+		m_frameMs = std::chrono::duration<float, std::milli>(now - m_frameStart).count();
+	}
+	m_frameStart = now;
+	m_started = true;
+}
+
+void
+FrameStats::endFrame(const FrameSample& sample) {
+	auto start = std::chrono::steady_clock::now();
+
+	FrameSample& slot = m_samples[m_next];
+	slot = sample;
+	slot.cpuMs = std::chrono::duration<float, std::milli>(start - m_frameStart).count();
+	// El primer frame aún no tiene intervalo; se usa su tiempo de CPU
+	slot.frameMs = m_frameMs > 0.0f ? m_frameMs : slot.cpuMs;
+	m_frameTimes[m_next] = slot.frameMs;
+	m_cpuTimes[m_next] = slot.cpuMs;
+
+	m_next = (m_next + 1) % kHistory;
+	m_count = std::min(m_count + 1, kHistory);
+
+	auto end = std::chrono::steady_clock::now();
+	m_updateTimeMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+FrameTimePercentiles
+FrameStats::computePercentiles() const {
+	FrameTimePercentiles result;
+	if (m_count == 0) {
+		return result;
+	}
+
+	float sorted[kHistory];
+	std::copy(m_frameTimes, m_frameTimes + m_count, sorted);
+	float total = 0.0f;
+	for (unsigned int i = 0; i < m_count; ++i) {
+		total += sorted[i];
+	}
+	result.average = total / m_count;
+
+	// Percentiles crecientes: cada nth_element solo reordena la parte superior que queda
+	auto select = [&](unsigned int first, float p) {
+		unsigned int index = std::min(m_count - 1, static_cast<unsigned int>(p * (m_count - 1) + 0.5f));
+		std::nth_element(sorted + first, sorted + index, sorted + m_count);
+		return index;
+	};
+	unsigned int index = select(0, 0.50f);
+	result.p50 = sorted[index];
+	index = select(index, 0.95f);
+	result.p95 = sorted[index];
+	index = select(index, 0.99f);
+	result.p99 = sorted[index];
+	result.max = *std::max_element(sorted + index, sorted + m_count);
+	return result;
+}
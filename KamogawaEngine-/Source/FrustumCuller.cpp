@@ -0,0 +1,222 @@
+#include "FrustumCuller.h"
+#include "CpuFeatures.h"
+#include <immintrin.h>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+void
+FrustumCuller::setFrustum(const XMMATRIX& viewProjection) {
+	extractPlanes(viewProjection, m_planes);
+}
+
+void
+FrustumCuller::extractPlanes(const XMMATRIX& viewProjection, XMFLOAT4 planes[6]) {
+	// Con clip = v * M, cada plano es una combinación de columnas de M (Gribb/Hartmann).
+	// Las columnas de M son las filas de su transpuesta.
+	XMMATRIX columns = XMMatrixTranspose(viewProjection);
+	XMVECTOR combined[6] = {
+		XMVectorAdd(columns.r[3], columns.r[0]),       // Izquierdo
+		XMVectorSubtract(columns.r[3], columns.r[0]),  // Derecho
+		XMVectorAdd(columns.r[3], columns.r[1]),       // Inferior
+		XMVectorSubtract(columns.r[3], columns.r[1]),  // Superior
+		columns.r[2],                                  // Cercano (z en [0, 1] en Direct3D)
+		XMVectorSubtract(columns.r[3], columns.r[2])   // Lejano
+	};
+	for (unsigned int i = 0; i < 6; ++i) {
+		// Normalizar para que n·p + d sea una distancia en unidades de mundo
+		XMVECTOR length = XMVector3Length(combined[i]);
+		XMStoreFloat4(&planes[i], XMVectorDivide(combined[i], length));
+	}
+}
+
+void
+FrustumCuller::clear() {
+	m_centerX.clear();
+	m_centerY.clear();
+	m_centerZ.clear();
+	m_extentX.clear();
+	m_extentY.clear();
+	m_extentZ.clear();
+	m_count = 0;
+}
+
+unsigned int
+FrustumCuller::add(const XMFLOAT3& center, const XMFLOAT3& extents) {
+	m_centerX.push_back(center.x);
+	m_centerY.push_back(center.y);
+	m_centerZ.push_back(center.z);
+	m_extentX.push_back(extents.x);
+	m_extentY.push_back(extents.y);
+	m_extentZ.push_back(extents.z);
+	return m_count++;
+}
+
+void
+FrustumCuller::cull() {
+	auto start = std::chrono::high_resolution_clock::now();
+
+	// Rellenar hasta múltiplo de 8; los bits de relleno se ignoran
+	const unsigned int groups = (m_count + 7) / 8;
+	const unsigned int padded = groups * 8;
+	m_centerX.resize(padded, 0.0f);
+	m_centerY.resize(padded, 0.0f);
+	m_centerZ.resize(padded, 0.0f);
+	m_extentX.resize(padded, 0.0f);
+	m_extentY.resize(padded, 0.0f);
+	m_extentZ.resize(padded, 0.0f);
+	m_visibleMask.assign(groups, 0);
+
+	if (getCpuFeatures().avx) {
+		cullAVX(groups);
+	}
+	else {
+		cullSSE(groups);
+	}
+
+	m_stats.tested = m_count;
+	m_stats.visible = 0;
+	for (unsigned int i = 0; i < m_count; ++i) {
+		m_stats.visible += isVisible(i) ? 1 : 0;
+	}
+	m_stats.culled = m_count - m_stats.visible;
+
+	// Quitar el relleno para que add() siga agregando después de la última caja real
+	m_centerX.resize(m_count);
+	m_centerY.resize(m_count);
+	m_centerZ.resize(m_count);
+	m_extentX.resize(m_count);
+	m_extentY.resize(m_count);
+	m_extentZ.resize(m_count);
+
+	auto end = std::chrono::high_resolution_clock::now();
+	m_stats.cullTimeMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void
+FrustumCuller::cullAVX(unsigned int groups) {
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	const __m256 zero = _mm256_setzero_ps();
+
+	for (unsigned int group = 0; group < groups; ++group) {
+		const unsigned int i = group * 8;
+		const __m256 cx = _mm256_loadu_ps(&m_centerX[i]);
+		const __m256 cy = _mm256_loadu_ps(&m_centerY[i]);
+		const __m256 cz = _mm256_loadu_ps(&m_centerZ[i]);
+		const __m256 ex = _mm256_loadu_ps(&m_extentX[i]);
+		const __m256 ey = _mm256_loadu_ps(&m_extentY[i]);
+		const __m256 ez = _mm256_loadu_ps(&m_extentZ[i]);
+
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (const auto& plane : m_planes) {
+			const __m256 nx = _mm256_set1_ps(plane.x);
+			const __m256 ny = _mm256_set1_ps(plane.y);
+			const __m256 nz = _mm256_set1_ps(plane.z);
+
+			// Distancia del centro al plano + radio proyectado de la caja sobre la normal
+			__m256 distance = _mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_set1_ps(plane.w));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(ny, cy));
+			distance = _mm256_add_ps(distance, _mm256_mul_ps(nz, cz));
+
+			__m256 radius = _mm256_mul_ps(_mm256_andnot_ps(signMask, nx), ex);
+			radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_andnot_ps(signMask, ny), ey));
+			radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_andnot_ps(signMask, nz), ez));
+
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+		}
+		m_visibleMask[group] = static_cast<unsigned char>(_mm256_movemask_ps(inside));
+	}
+}
+
+void
+FrustumCuller::cullSSE(unsigned int groups) {
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	const __m128 zero = _mm_setzero_ps();
+
+	for (unsigned int group = 0; group < groups; ++group) {
+		unsigned char mask = 0;
+		for (unsigned int half = 0; half < 2; ++half) {
+			const unsigned int i = group * 8 + half * 4;
+			const __m128 cx = _mm_loadu_ps(&m_centerX[i]);
+			const __m128 cy = _mm_loadu_ps(&m_centerY[i]);
+			const __m128 cz = _mm_loadu_ps(&m_centerZ[i]);
+			const __m128 ex = _mm_loadu_ps(&m_extentX[i]);
+			const __m128 ey = _mm_loadu_ps(&m_extentY[i]);
+			const __m128 ez = _mm_loadu_ps(&m_extentZ[i]);
+
+			__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			for (const auto& plane : m_planes) {
+				const __m128 nx = _mm_set1_ps(plane.x);
+				const __m128 ny = _mm_set1_ps(plane.y);
+				const __m128 nz = _mm_set1_ps(plane.z);
+
+				__m128 distance = _mm_add_ps(_mm_mul_ps(nx, cx), _mm_set1_ps(plane.w));
+				distance = _mm_add_ps(distance, _mm_mul_ps(ny, cy));
+				distance = _mm_add_ps(distance, _mm_mul_ps(nz, cz));
+
+				__m128 radius = _mm_mul_ps(_mm_andnot_ps(signMask, nx), ex);
+				radius = _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(signMask, ny), ey));
+				radius = _mm_add_ps(radius, _mm_mul_ps(_mm_andnot_ps(signMask, nz), ez));
+
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+			}
+			mask |= static_cast<unsigned char>(_mm_movemask_ps(inside) << (half * 4));
+		}
+		m_visibleMask[group] = mask;
+	}
+}
+
+void
+FrustumCuller::transformBox(const XMFLOAT3& localMin,
+							const XMFLOAT3& localMax,
+							const XMMATRIX& world,
+							XMFLOAT3& center,
+							XMFLOAT3& extents) {
+	XMVECTOR minV = XMLoadFloat3(&localMin);
+	XMVECTOR maxV = XMLoadFloat3(&localMax);
+	XMVECTOR localCenter = XMVectorScale(XMVectorAdd(minV, maxV), 0.5f);
+	XMVECTOR localExtents = XMVectorScale(XMVectorSubtract(maxV, minV), 0.5f);
+
+	// El centro se transforma como punto; la extensión con el valor absoluto de la rotación/escala
+	XMVECTOR worldCenter = XMVector3TransformCoord(localCenter, world);
+	XMVECTOR worldExtents = XMVectorMultiply(XMVectorAbs(world.r[0]), XMVectorSplatX(localExtents));
+	worldExtents = XMVectorMultiplyAdd(XMVectorAbs(world.r[1]), XMVectorSplatY(localExtents), worldExtents);
+	worldExtents = XMVectorMultiplyAdd(XMVectorAbs(world.r[2]), XMVectorSplatZ(localExtents), worldExtents);
+
+	XMStoreFloat3(&center, worldCenter);
+	XMStoreFloat3(&extents, worldExtents);
+}
+
+CullingBenchmarkResult
+runCullingBenchmark(unsigned int objects, unsigned int frames) {
+	CullingBenchmarkResult result;
+	result.objects = objects;
+	frames = frames > 0 ? frames : 1;
+
+	// 01. Cajas de 1 a 4 unidades en un cubo de 1000 unidades centrado en la cámara
+	FrustumCuller culler;
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+	std::uniform_real_distribution<float> extent(0.5f, 2.0f);
+	for (unsigned int i = 0; i < objects; ++i) {
+		culler.add(XMFLOAT3(position(random), position(random), position(random)),
+				   XMFLOAT3(extent(random), extent(random), extent(random)));
+	}
+
+	// 02. La cámara gira alrededor del eje Y; cull() mide su propio tiempo
+	const XMMATRIX projection = XMMatrixPerspectiveFovLH(XM_PIDIV4, 16.0f / 9.0f, 0.1f, 1000.0f);
+	double totalMs = 0.0;
+	for (unsigned int frame = 0; frame < frames; ++frame) {
+		const float yaw = XM_2PI * frame / frames;
+		const XMVECTOR forward = XMVectorSet(std::sin(yaw), 0.0f, std::cos(yaw), 0.0f);
+		const XMMATRIX view = XMMatrixLookAtLH(XMVectorZero(), forward, XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f));
+		culler.setFrustum(view * projection);
+		culler.cull();
+		totalMs += culler.getStats().cullTimeMs;
+		result.visible = culler.getStats().visible;
+	}
+
+	result.cullTimeMs = totalMs / frames;
+	result.nsPerObject = objects > 0 ? result.cullTimeMs * 1.0e6 / objects : 0.0;
+	return result;
+}
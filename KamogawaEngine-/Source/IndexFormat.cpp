@@ -0,0 +1,112 @@
+#include "IndexFormat.h"
+#include "MeshComponent.h"
+#include <algorithm>
+
+namespace {
+	const unsigned int kUnmapped = ~0u;
+
+	/**
+	 * @brief Reordena la malla en trozos de vértices contiguos de hasta maxVertices.
+	 * @return Vértices repetidos.
+	 */
+	unsigned int
+	splitIntoChunks(MeshComponent& mesh, unsigned int maxVertices) {
+		const size_t vertexCount = mesh.m_vertex.size();
+		const bool hasSkin = mesh.m_skin.size() == vertexCount;
+		TrackedVector<SimpleVertex, MEMORY_TAG_MESH> vertices;
+		TrackedVector<VertexSkin, MEMORY_TAG_MESH> skin;
+		TrackedVector<unsigned int, MEMORY_TAG_MESH> indices;
+		vertices.reserve(vertexCount);
+		indices.reserve(mesh.m_index.size());
+
+		std::vector<unsigned int> remap(vertexCount, kUnmapped);
+		std::vector<unsigned int> touched;
+		MeshChunk chunk;
+		mesh.m_chunks.clear();
+
+		auto closeChunk = [&]() {
+			chunk.indexCount = static_cast<unsigned int>(indices.size()) - chunk.startIndex;
+			if (chunk.indexCount > 0) {
+				mesh.m_chunks.push_back(chunk);
+			}
+			for (unsigned int vertex : touched) {
+				remap[vertex] = kUnmapped;
+			}
+			touched.clear();
+			chunk.startIndex = static_cast<unsigned int>(indices.size());
+			chunk.baseVertex = static_cast<int>(vertices.size());
+		};
+
+		for (size_t i = 0; i + 2 < mesh.m_index.size(); i += 3) {
+			// 01. Vértices nuevos que agrega el triángulo (sin contar repetidos dentro de él)
+			const unsigned int corners[3] = { mesh.m_index[i], mesh.m_index[i + 1], mesh.m_index[i + 2] };
+			unsigned int added = 0;
+			for (int c = 0; c < 3; ++c) {
+				const bool repeated = (c > 0 && corners[c] == corners[0]) || (c > 1 && corners[c] == corners[1]);
+				if (remap[corners[c]] == kUnmapped && !repeated) {
+					++added;
+				}
+			}
+
+			// 02. Si no entra, se cierra el trozo y el triángulo empieza el siguiente
+			const unsigned int chunkVertices = static_cast<unsigned int>(vertices.size()) - chunk.baseVertex;
+			if (chunkVertices + added > maxVertices) {
+				closeChunk();
+			}
+
+			// 03. Copiar los vértices que faltan y escribir los índices absolutos
+			for (int c = 0; c < 3; ++c) {
+				unsigned int& mapped = remap[corners[c]];
+				if (mapped == kUnmapped) {
+					mapped = static_cast<unsigned int>(vertices.size());
+					vertices.push_back(mesh.m_vertex[corners[c]]);
+					if (hasSkin) {
+						skin.push_back(mesh.m_skin[corners[c]]);
+					}
+					touched.push_back(corners[c]);
+				}
+				indices.push_back(mapped);
+			}
+		}
+		closeChunk();
+
+		const unsigned int duplicated = vertices.size() > vertexCount ? static_cast<unsigned int>(vertices.size() - vertexCount) : 0;
+		mesh.m_vertex.swap(vertices);
+		mesh.m_index.swap(indices);
+		if (hasSkin) {
+			mesh.m_skin.swap(skin);
+		}
+		mesh.m_numVertex = static_cast<int>(mesh.m_vertex.size());
+		mesh.m_numIndex = static_cast<int>(mesh.m_index.size());
+		return duplicated;
+	}
+}
+
+void
+selectIndexFormat(MeshComponent& mesh,
+				  bool allowSplit,
+				  IndexFormatStats& stats,
+				  unsigned int maxVertices) {
+	maxVertices = std::max(3u, std::min(maxVertices, kMaxShortIndexVertices));
+	mesh.m_chunks.clear();
+
+	if (mesh.m_vertex.size() <= maxVertices) {
+		mesh.m_indexFormat = DXGI_FORMAT_R16_UINT;
+		++stats.shortMeshes;
+	}
+	else if (allowSplit) {
+		stats.duplicatedVertices += splitIntoChunks(mesh, maxVertices);
+		mesh.m_indexFormat = DXGI_FORMAT_R16_UINT;
+		++stats.shortMeshes;
+		++stats.splitMeshes;
+		stats.chunks += static_cast<unsigned int>(mesh.m_chunks.size());
+	}
+	else {
+		mesh.m_indexFormat = DXGI_FORMAT_R32_UINT;
+		++stats.longMeshes;
+	}
+
+	const unsigned long long indexCount = mesh.m_index.size();
+	stats.bytes += indexCount * (mesh.m_indexFormat == DXGI_FORMAT_R16_UINT ? sizeof(unsigned short) : sizeof(unsigned int));
+	stats.longBytes += indexCount * sizeof(unsigned int);
+}
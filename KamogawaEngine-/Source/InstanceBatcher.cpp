@@ -0,0 +1,168 @@
+#include "InstanceBatcher.h"
+#include "FrameArena.h"
+#include "FrameClock.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+	/**
+	 * @brief Casilla inicial de una llave en una tabla de tamaño potencia de 2.
+	 *
+	 * Los punteros están alineados, así que se mezclan los bits antes de tomar los bajos.
+	 */
+	size_t
+	groupSlot(size_t hash, size_t mask) {
+		return static_cast<size_t>((static_cast<unsigned long long>(hash) * 0x9E3779B97F4A7C15ULL) >> 32) & mask;
+	}
+}
+
+void
+InstanceBatcher::clear() {
+	m_items.clear();
+	m_groupKeys.clear();
+	// La tabla se vacía sin liberarla: un frame estable no pide memoria al heap
+	std::fill(m_groupTable.begin(), m_groupTable.end(), kNoBatch);
+	m_batches.clear();
+	m_transforms.clear();
+	m_itemBatch.clear();
+}
+
+void
+InstanceBatcher::add(const InstanceKey& key, const float* world, unsigned int item) {
+	if ((m_groupKeys.size() + 1) * 2 > m_groupTable.size()) {
+		growGroupTable();
+	}
+	const size_t mask = m_groupTable.size() - 1;
+	size_t slot = groupSlot(KeyHash()(key), mask);
+	while (m_groupTable[slot] != kNoBatch && !(m_groupKeys[m_groupTable[slot]] == key)) {
+		slot = (slot + 1) & mask;
+	}
+	unsigned int group = m_groupTable[slot];
+	if (group == kNoBatch) {
+		group = static_cast<unsigned int>(m_groupKeys.size());
+		m_groupTable[slot] = group;
+		m_groupKeys.push_back(key);
+	}
+
+	// Empaquetar las tres primeras columnas de la matriz (la cuarta siempre es 0, 0, 0, 1)
+	Item entry;
+	entry.item = item;
+	entry.group = group;
+	for (unsigned int row = 0; row < 3; ++row) {
+		for (unsigned int column = 0; column < 4; ++column) {
+			entry.transform.rows[row][column] = world[column * 4 + row];
+		}
+	}
+	m_items.push_back(entry);
+}
+
+void
+InstanceBatcher::growGroupTable() {
+	m_groupTable.assign(std::max<size_t>(64, m_groupTable.size() * 2), kNoBatch);
+	const size_t mask = m_groupTable.size() - 1;
+	for (unsigned int group = 0; group < m_groupKeys.size(); ++group) {
+		size_t slot = groupSlot(KeyHash()(m_groupKeys[group]), mask);
+		while (m_groupTable[slot] != kNoBatch) {
+			slot = (slot + 1) & mask;
+		}
+		m_groupTable[slot] = group;
+	}
+}
+
+void
+InstanceBatcher::build(unsigned int minInstances, unsigned int maxInstances) {
+	m_batches.clear();
+	m_transforms.clear();
+	m_itemBatch.clear();
+
+	// 01. Contar elementos por grupo y encontrar el identificador más alto
+	FrameVector<unsigned int> groupCount(m_groupKeys.size(), 0);
+	FrameVector<unsigned int> groupFirstItem(m_groupKeys.size(), 0);
+	unsigned int maxItem = 0;
+	for (const auto& entry : m_items) {
+		if (groupCount[entry.group]++ == 0) {
+			groupFirstItem[entry.group] = entry.item;
+		}
+		maxItem = entry.item > maxItem ? entry.item : maxItem;
+	}
+
+	// 02. Convertir en lote cada grupo suficientemente grande que quepa en el buffer
+	FrameVector<unsigned int> groupBatch(m_groupKeys.size(), kNoBatch);
+	unsigned int usedInstances = 0;
+	for (unsigned int group = 0; group < m_groupKeys.size(); ++group) {
+		const unsigned int count = groupCount[group];
+		if (count < minInstances || usedInstances + count > maxInstances) {
+			continue;
+		}
+
+		InstanceBatch batch;
+		batch.key = m_groupKeys[group];
+		batch.firstItem = groupFirstItem[group];
+		batch.firstInstance = usedInstances;
+		groupBatch[group] = static_cast<unsigned int>(m_batches.size());
+		m_batches.push_back(batch);
+		usedInstances += count;
+	}
+
+	// 03. Dejar las transformaciones de cada lote contiguas
+	m_transforms.resize(usedInstances);
+	m_itemBatch.assign(m_items.empty() ? 0 : maxItem + 1, kNoBatch);
+	for (const auto& entry : m_items) {
+		const unsigned int batchIndex = groupBatch[entry.group];
+		if (batchIndex == kNoBatch) {
+			continue;
+		}
+		InstanceBatch& batch = m_batches[batchIndex];
+		m_transforms[batch.firstInstance + batch.instanceCount++] = entry.transform;
+		m_itemBatch[entry.item] = batchIndex;
+	}
+}
+
+InstancingBenchmarkResult
+runInstancingBenchmark(unsigned int instances, unsigned int keys, unsigned int frames) {
+	InstancingBenchmarkResult result;
+	result.instances = instances;
+	result.keys = keys > 0 ? keys : 1;
+	frames = frames > 0 ? frames : 1;
+
+	// 01. Llaves sintéticas: solo se comparan como punteros opacos
+	std::vector<InstanceKey> instanceKeys(result.keys);
+	for (unsigned int k = 0; k < result.keys; ++k) {
+		InstanceKey& key = instanceKeys[k];
+		key.shader = reinterpret_cast<const void*>(static_cast<uintptr_t>(0x1000));
+		key.material = reinterpret_cast<const void*>(static_cast<uintptr_t>(0x2000 + k * 0x10));
+		key.vertexBuffer = reinterpret_cast<const void*>(static_cast<uintptr_t>(0x100000 + k * 0x10));
+		key.indexBuffer = reinterpret_cast<const void*>(static_cast<uintptr_t>(0x200000 + k * 0x10));
+		key.indexCount = 36;
+	}
+
+	// 02. Matrices de mundo en una rejilla (traslación pura)
+	std::vector<float> worlds(static_cast<size_t>(instances) * 16, 0.0f);
+	for (unsigned int i = 0; i < instances; ++i) {
+		float* world = &worlds[static_cast<size_t>(i) * 16];
+		world[0] = world[5] = world[10] = world[15] = 1.0f;
+		world[12] = static_cast<float>(i % 100);
+		world[14] = static_cast<float>(i / 100);
+	}
+
+	// 03. Un frame de calentamiento reserva la memoria antes de medir
+	InstanceBatcher batcher;
+	long long elapsed = 0;
+	for (unsigned int frame = 0; frame <= frames; ++frame) {
+		const long long start = FrameClock::now();
+		batcher.clear();
+		for (unsigned int i = 0; i < instances; ++i) {
+			batcher.add(instanceKeys[i % result.keys], &worlds[static_cast<size_t>(i) * 16], i);
+		}
+		batcher.build(2, instances);
+		if (frame > 0) {
+			elapsed += FrameClock::now() - start;
+		}
+		result.batches = static_cast<unsigned int>(batcher.getBatches().size());
+		FrameArena::getInstance().endFrame();
+	}
+
+	result.submitMs = elapsed / 1.0e6 / frames;
+	result.nsPerInstance = instances > 0 ? static_cast<double>(elapsed) / frames / instances : 0.0;
+	return result;
+}
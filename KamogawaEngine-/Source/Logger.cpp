@@ -0,0 +1,380 @@
+#include "Logger.h"
+#include <algorithm>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace {
+	thread_local LogThreadBuffer* t_logBuffer = nullptr;
+
+	const char* const g_severityNames[LOG_SEVERITY_COUNT] = { "TRACE", "INFO", "WARN", "ERROR" };
+
+	/**
+	 * @brief Nombre de la primera categoría activa en el bit de un mensaje.
+	 */
+	const char*
+	categoryName(unsigned int category) {
+		switch (category) {
+		case LOG_CATEGORY_CORE: return "Core";
+		case LOG_CATEGORY_RENDER: return "Render";
+		case LOG_CATEGORY_RESOURCE: return "Resource";
+		case LOG_CATEGORY_ASSET: return "Asset";
+		case LOG_CATEGORY_UI: return "UI";
+		default: return "General";
+		}
+	}
+
+	/**
+	 * @brief Formatea un argumento con la especificación printf recibida (sin modificador de
+	 *        longitud) adaptándola al tipo guardado.
+	 */
+	void
+	appendArg(std::string& out, const LogRecord& record, const LogArg& arg, std::string& spec, char conversion) {
+		char buffer[512];
+		int written = 0;
+		switch (conversion) {
+		case 'c':
+			spec += 'c';
+			written = snprintf(buffer, sizeof(buffer), spec.c_str(), static_cast<int>(arg.i));
+			break;
+		case 'd': case 'i': case 'u': case 'o': case 'x': case 'X': {
+			spec += "ll";
+			spec += conversion;
+			long long value = arg.type == LogArg::DOUBLE ? static_cast<long long>(arg.d) : arg.i;
+			written = snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+			break;
+		}
+		case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A': {
+			spec += conversion;
+			double value = arg.type == LogArg::DOUBLE ? arg.d :
+						   arg.type == LogArg::UINT ? static_cast<double>(arg.u) : static_cast<double>(arg.i);
+			written = snprintf(buffer, sizeof(buffer), spec.c_str(), value);
+			break;
+		}
+		case 's':
+			spec += 's';
+			written = snprintf(buffer, sizeof(buffer), spec.c_str(),
+							   arg.type == LogArg::TEXT ? record.text + arg.text : "(not text)");
+			break;
+		default:
+			spec += 'p';
+			written = snprintf(buffer, sizeof(buffer), spec.c_str(), arg.p);
+			break;
+		}
+		if (written > 0) {
+			out.append(buffer, std::min<size_t>(written, sizeof(buffer) - 1));
+		}
+	}
+
+	/**
+	 * @brief Sustituye los argumentos guardados en la cadena de formato del mensaje.
+	 */
+	void
+	formatRecord(std::string& out, const LogRecord& record) {
+		std::string spec;
+		unsigned int argIndex = 0;
+		for (const char* c = record.format ? record.format : ""; *c; ++c) {
+			if (*c != '%') {
+				out += *c;
+				continue;
+			}
+			if (c[1] == '%') {
+				out += '%';
+				++c;
+				continue;
+			}
+
+			// Banderas, ancho y precisión se conservan; el modificador de longitud se descarta
+			spec = "%";
+			const char* p = c + 1;
+			while (*p && strchr("-+ #0123456789.*", *p)) {
+				spec += *p++;
+			}
+			while (*p && strchr("hljztL", *p)) {
+				++p;
+			}
+			if (!*p) {
+				break;
+			}
+			if (argIndex < record.argCount) {
+				appendArg(out, record, record.args[argIndex++], spec, *p);
+			}
+			else {
+				out += "<missing>";
+			}
+			c = p;
+		}
+		if (record.truncated) {
+			out += " <truncated>";
+		}
+	}
+}
+
+Logger&
+Logger::getInstance() {
+	static Logger instance;
+	return instance;
+}
+
+Logger::Logger() {
+	m_startTime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Logger::~Logger() {
+	shutdown();
+}
+
+LogThreadBuffer&
+Logger::getThreadBuffer() {
+	if (!t_logBuffer) {
+		std::lock_guard<std::mutex> lock(m_registryMutex);
+		m_buffers.push_back(std::unique_ptr<LogThreadBuffer>(new LogThreadBuffer()));
+		t_logBuffer = m_buffers.back().get();
+		t_logBuffer->m_thread = static_cast<unsigned int>(m_buffers.size() - 1);
+	}
+	if (!m_running) {
+		std::lock_guard<std::mutex> lock(m_registryMutex);
+		std::lock_guard<std::mutex> sinkLock(m_sinkMutex);
+		if (!m_running) {
+			m_quit = false;
+			m_running = true;
+			m_sinkThread = std::thread(&Logger::sinkLoop, this);
+		}
+	}
+	return *t_logBuffer;
+}
+
+void
+Logger::encodeText(LogRecord& record, LogArg& arg, const char* text, size_t length) {
+	arg.type = LogArg::TEXT;
+	const size_t room = LogRecord::kTextSize - record.textUsed;
+	if (room == 0) {
+		// Sin espacio: apunta al terminador del último texto
+		arg.text = LogRecord::kTextSize - 1;
+		record.truncated = 1;
+		return;
+	}
+	if (length >= room) {
+		length = room - 1;
+		record.truncated = 1;
+	}
+	arg.text = record.textUsed;
+	memcpy(record.text + record.textUsed, text, length);
+	record.text[record.textUsed + length] = '\0';
+	record.textUsed += static_cast<unsigned int>(length + 1);
+}
+
+bool
+Logger::openFile(const std::string& path) {
+	std::lock_guard<std::mutex> lock(m_sinkMutex);
+	if (m_file) {
+		fclose(m_file);
+	}
+	m_file = fopen(path.c_str(), "w");
+	if (!m_file) {
+		return false;
+	}
+	m_sinks.fetch_or(LOG_SINK_FILE, std::memory_order_relaxed);
+	return true;
+}
+
+unsigned int
+Logger::getDroppedRecords() const {
+	// Un hilo nuevo puede estar registrando su buffer
+	std::lock_guard<std::mutex> lock(m_registryMutex);
+	unsigned int dropped = 0;
+	for (const auto& buffer : m_buffers) {
+		dropped += buffer->m_dropped.load(std::memory_order_relaxed);
+	}
+	return dropped;
+}
+
+void
+Logger::flush() {
+	std::unique_lock<std::mutex> lock(m_sinkMutex);
+	if (!m_running) {
+		return;
+	}
+	const unsigned long long request = ++m_flushRequest;
+	m_wakeSignal.notify_one();
+	m_flushedSignal.wait(lock, [&] { return m_flushDone >= request || !m_running; });
+}
+
+void
+Logger::shutdown() {
+	{
+		std::lock_guard<std::mutex> lock(m_sinkMutex);
+		if (!m_running) {
+			return;
+		}
+		m_quit = true;
+	}
+	m_wakeSignal.notify_one();
+	m_sinkThread.join();
+
+	{
+		std::lock_guard<std::mutex> lock(m_sinkMutex);
+		m_running = false;
+		if (m_file) {
+			fclose(m_file);
+			m_file = nullptr;
+		}
+	}
+	m_flushedSignal.notify_all();
+}
+
+void
+Logger::sinkLoop() {
+	for (;;) {
+		bool quit = false;
+		unsigned long long request = 0;
+		{
+			std::unique_lock<std::mutex> lock(m_sinkMutex);
+			// Sin errores ni flush pendientes se escribe en lotes cada pocos milisegundos
+			m_wakeSignal.wait_for(lock, std::chrono::milliseconds(10),
+				[this] { return m_quit || m_flushRequest != m_flushDone; });
+			quit = m_quit;
+			request = m_flushRequest;
+		}
+
+		drain();
+
+		{
+			std::lock_guard<std::mutex> lock(m_sinkMutex);
+			if (m_file) {
+				fflush(m_file);
+			}
+			m_flushDone = request;
+		}
+		m_flushedSignal.notify_all();
+
+		if (quit) {
+			return;
+		}
+	}
+}
+
+void
+Logger::drain() {
+	std::vector<LogThreadBuffer*> buffers;
+	{
+		std::lock_guard<std::mutex> lock(m_registryMutex);
+		for (auto& buffer : m_buffers) {
+			buffers.push_back(buffer.get());
+		}
+	}
+
+	// 01. Tomar los mensajes publicados de cada hilo y ordenarlos por tiempo
+	struct Pending {
+		const LogRecord* record;
+		long long time;
+	};
+	std::vector<Pending> pending;
+	std::vector<unsigned int> writes(buffers.size());
+	for (size_t b = 0; b < buffers.size(); ++b) {
+		LogThreadBuffer* buffer = buffers[b];
+		const unsigned int read = buffer->m_read.load(std::memory_order_relaxed);
+		writes[b] = buffer->m_write.load(std::memory_order_acquire);
+		for (unsigned int i = read; i != writes[b]; ++i) {
+			const LogRecord& record = buffer->m_records[i & (LogThreadBuffer::kCapacity - 1)];
+			pending.push_back({ &record, record.time });
+		}
+	}
+	std::stable_sort(pending.begin(), pending.end(),
+		[](const Pending& a, const Pending& b) { return a.time < b.time; });
+
+	// 02. Formatear y escribir
+	for (const Pending& entry : pending) {
+		const LogRecord& record = *entry.record;
+		char prefix[64];
+		snprintf(prefix, sizeof(prefix), "[%10.3f][%-5s][%-8s][T%u] ",
+				 (record.time - m_startTime) / 1.0e9,
+				 g_severityNames[std::min<unsigned int>(record.severity, LOG_SEVERITY_COUNT - 1)],
+				 categoryName(record.category), record.thread);
+		m_line = prefix;
+		formatRecord(m_line, record);
+		m_line += '\n';
+		writeLine(m_line);
+	}
+
+	// 03. Liberar los mensajes escritos
+	for (size_t b = 0; b < buffers.size(); ++b) {
+		buffers[b]->m_read.store(writes[b], std::memory_order_release);
+	}
+}
+
+void
+Logger::writeLine(const std::string& line) {
+	const unsigned int sinks = m_sinks.load(std::memory_order_relaxed);
+	if (sinks & LOG_SINK_DEBUGGER) {
+#ifdef _WIN32
+		OutputDebugStringA(line.c_str());
+#else
+		fwrite(line.data(), 1, line.size(), stderr);
+#endif
+	}
+	if (sinks & LOG_SINK_STDOUT) {
+		fwrite(line.data(), 1, line.size(), stdout);
+	}
+	if (sinks & LOG_SINK_FILE) {
+		std::lock_guard<std::mutex> lock(m_sinkMutex);
+		if (m_file) {
+			fwrite(line.data(), 1, line.size(), m_file);
+		}
+	}
+}
+
+LoggerBenchmarkResult
+runLoggerBenchmark(unsigned int threads, unsigned int callsPerThread) {
+	constexpr unsigned int kBurst = LogThreadBuffer::kCapacity / 2;
+	Logger& logger = Logger::getInstance();
+	LoggerBenchmarkResult result;
+	result.threads = std::max(1u, threads);
+
+	// 01. Vaciar lo pendiente y apagar los destinos
+	logger.flush();
+	const unsigned int sinks = logger.getSinks();
+	logger.setSinks(0);
+	const unsigned int droppedBefore = logger.getDroppedRecords();
+
+	// 02. Los hilos arrancan juntos y miden solo sus ráfagas
+	std::atomic<unsigned int> ready{ 0 };
+	std::atomic<long long> elapsed{ 0 };
+	auto work = [&]() {
+		ready.fetch_add(1);
+		while (ready.load() < result.threads) {
+			std::this_thread::yield();
+		}
+		long long local = 0;
+		for (unsigned int first = 0; first < callsPerThread; first += kBurst) {
+			const unsigned int last = std::min(callsPerThread, first + kBurst);
+			const auto start = std::chrono::steady_clock::now();
+			for (unsigned int i = first; i < last; ++i) {
+				logger.log(LOG_SEVERITY_INFO, LOG_CATEGORY_CORE, "Logger benchmark %u %.2f %s", i, 0.5 * i, "record");
+			}
+			local += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+			logger.flush();
+		}
+		elapsed.fetch_add(local);
+	};
+	std::vector<std::thread> workers;
+	for (unsigned int i = 1; i < result.threads; ++i) {
+		workers.emplace_back(work);
+	}
+	work();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+
+	// 03. Restaurar los destinos
+	logger.flush();
+	logger.setSinks(sinks);
+	result.calls = static_cast<unsigned long long>(callsPerThread) * result.threads;
+	result.nsPerCall = result.calls > 0 ? static_cast<double>(elapsed.load()) / result.calls : 0.0;
+	result.dropped = logger.getDroppedRecords() - droppedBefore;
+	return result;
+}
@@ -0,0 +1,241 @@
+#include "MemoryTracker.h"
+#include "Logger.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+
+namespace {
+	const char* const g_tagNames[MEMORY_TAG_COUNT] = { "General", "Mesh", "Texture", "ECS", "UI", "Animation" };
+
+	thread_local unsigned long long t_heapAllocations = 0;
+
+	/**
+	 * @brief Encabezado de trackedMalloc(): guarda el tamaño pedido y mantiene la alineación.
+	 */
+	constexpr size_t kHeaderSize = 16;
+
+	/**
+	 * @brief Escribe una cadena JSON escapando comillas y barras.
+	 */
+	void
+	writeJsonString(std::ofstream& file, const char* text) {
+		file << '"';
+		for (const char* c = text ? text : ""; *c; ++c) {
+			if (*c == '"' || *c == '\\') {
+				file << '\\';
+			}
+			file << *c;
+		}
+		file << '"';
+	}
+}
+
+MemoryTracker&
+MemoryTracker::getInstance() {
+	static MemoryTracker* instance = new MemoryTracker();
+	return *instance;
+}
+
+unsigned long long
+MemoryTracker::getThreadHeapAllocations() {
+	return t_heapAllocations;
+}
+
+const char*
+MemoryTracker::getTagName(MemoryTag tag) {
+	return tag < MEMORY_TAG_COUNT ? g_tagNames[tag] : "Unknown";
+}
+
+unsigned int
+MemoryTracker::checkBudgets() {
+	unsigned int over = 0;
+	for (int tag = 0; tag < MEMORY_TAG_COUNT; ++tag) {
+		TagCounters& counters = m_tags[tag];
+		const unsigned long long budget = counters.budget.load(std::memory_order_relaxed);
+		const long long bytes = counters.bytes.load(std::memory_order_relaxed);
+		const bool exceeded = budget > 0 && bytes > static_cast<long long>(budget);
+		if (exceeded) {
+			++over;
+			if (!counters.overBudget) {
+				LOG_WARNING(LOG_CATEGORY_RESOURCE, "Memoria '%s' por encima del presupuesto: %.2f MB de %.2f MB",
+							g_tagNames[tag], bytes / (1024.0 * 1024.0), budget / (1024.0 * 1024.0));
+			}
+		}
+		counters.overBudget = exceeded;
+	}
+	return over;
+}
+
+MemoryTagStats
+MemoryTracker::getTagStats(MemoryTag tag) const {
+	const TagCounters& counters = m_tags[tag];
+	MemoryTagStats stats;
+	stats.bytes = counters.bytes.load(std::memory_order_relaxed);
+	stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+	stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+	stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+	stats.budget = counters.budget.load(std::memory_order_relaxed);
+	return stats;
+}
+
+std::vector<MemoryCallSite>
+MemoryTracker::getCallSites() const {
+	std::vector<MemoryCallSite> sites;
+#ifdef MEMORY_TRACK_CALLSITES
+	{
+		std::lock_guard<std::mutex> lock(m_siteMutex);
+		sites = m_sites;
+	}
+	std::sort(sites.begin(), sites.end(),
+		[](const MemoryCallSite& a, const MemoryCallSite& b) { return a.bytes > b.bytes; });
+#endif
+	return sites;
+}
+
+bool
+MemoryTracker::writeReport(const std::string& path) const {
+	std::ofstream file(path);
+	if (!file) {
+		return false;
+	}
+
+	file << "{\n  \"callSites\": " <<
+#ifdef MEMORY_TRACK_CALLSITES
+		"true"
+#else
+		"false"
+#endif
+		<< ",\n  \"tags\": [\n";
+	for (int tag = 0; tag < MEMORY_TAG_COUNT; ++tag) {
+		const MemoryTagStats stats = getTagStats(static_cast<MemoryTag>(tag));
+		file << "    {\"name\": \"" << g_tagNames[tag] << "\", \"bytes\": " << stats.bytes
+			 << ", \"peakBytes\": " << stats.peakBytes << ", \"allocations\": " << stats.allocations
+			 << ", \"totalAllocations\": " << stats.totalAllocations << ", \"budget\": " << stats.budget
+			 << ", \"overBudget\": " << (stats.budget > 0 && stats.bytes > static_cast<long long>(stats.budget) ? "true" : "false")
+			 << "}" << (tag + 1 < MEMORY_TAG_COUNT ? ",\n" : "\n");
+	}
+	file << "  ],\n  \"sites\": [";
+
+	const std::vector<MemoryCallSite> sites = getCallSites();
+	for (size_t i = 0; i < sites.size(); ++i) {
+		const MemoryCallSite& site = sites[i];
+		file << (i > 0 ? ",\n" : "\n") << "    {\"file\": ";
+		writeJsonString(file, site.file);
+		file << ", \"line\": " << site.line << ", \"tag\": \"" << g_tagNames[site.tag]
+			 << "\", \"bytes\": " << site.bytes << ", \"peakBytes\": " << site.peakBytes
+			 << ", \"allocations\": " << site.allocations << ", \"totalAllocations\": " << site.totalAllocations << "}";
+	}
+	file << (sites.empty() ? "]\n}\n" : "\n  ]\n}\n");
+	return true;
+}
+
+#ifdef MEMORY_TRACK_CALLSITES
+void
+MemoryTracker::recordSite(MemoryTag tag, const void* memory, size_t bytes, const char* file, unsigned int line) {
+	std::lock_guard<std::mutex> lock(m_siteMutex);
+	auto key = std::make_tuple(file, line, static_cast<int>(tag));
+	auto found = m_siteIndex.find(key);
+	size_t index = 0;
+	if (found == m_siteIndex.end()) {
+		index = m_sites.size();
+		MemoryCallSite site;
+		site.file = file ? file : "";
+		site.line = line;
+		site.tag = tag;
+		m_sites.push_back(site);
+		m_siteIndex.emplace(key, index);
+	}
+	else {
+		index = found->second;
+	}
+
+	MemoryCallSite& site = m_sites[index];
+	site.bytes += static_cast<long long>(bytes);
+	site.peakBytes = std::max(site.peakBytes, site.bytes);
+	++site.allocations;
+	++site.totalAllocations;
+	m_liveSites[memory] = index;
+}
+
+void
+MemoryTracker::releaseSite(const void* memory, size_t bytes) {
+	std::lock_guard<std::mutex> lock(m_siteMutex);
+	auto found = m_liveSites.find(memory);
+	if (found == m_liveSites.end()) {
+		return;
+	}
+	MemoryCallSite& site = m_sites[found->second];
+	site.bytes -= static_cast<long long>(bytes);
+	--site.allocations;
+	m_liveSites.erase(found);
+}
+#endif
+
+void*
+trackedMalloc(MemoryTag tag, size_t bytes, const char* file, unsigned int line) {
+	unsigned char* block = static_cast<unsigned char*>(malloc(bytes + kHeaderSize));
+	if (!block) {
+		return nullptr;
+	}
+	memcpy(block, &bytes, sizeof(bytes));
+	void* memory = block + kHeaderSize;
+	MemoryTracker::getInstance().recordAllocation(tag, memory, bytes, file, line);
+	return memory;
+}
+
+void
+trackedFree(MemoryTag tag, void* memory) {
+	if (!memory) {
+		return;
+	}
+	unsigned char* block = static_cast<unsigned char*>(memory) - kHeaderSize;
+	size_t bytes = 0;
+	memcpy(&bytes, block, sizeof(bytes));
+	MemoryTracker::getInstance().recordFree(tag, memory, bytes);
+	free(block);
+}
+
+void*
+trackedRealloc(MemoryTag tag, void* memory, size_t bytes, const char* file, unsigned int line) {
+	if (!memory) {
+		return trackedMalloc(tag, bytes, file, line);
+	}
+	void* resized = trackedMalloc(tag, bytes, file, line);
+	if (!resized) {
+		return nullptr;
+	}
+	size_t oldBytes = 0;
+	memcpy(&oldBytes, static_cast<unsigned char*>(memory) - kHeaderSize, sizeof(oldBytes));
+	memcpy(resized, memory, std::min(oldBytes, bytes));
+	trackedFree(tag, memory);
+	return resized;
+}
+
+// Reemplazo del operator new global: igual al de la biblioteca, más el contador del hilo. Las
+// versiones de arreglos y nothrow de la biblioteca llaman a estas.
+void*
+operator new(size_t bytes) {
+	++t_heapAllocations;
+	for (;;) {
+		if (void* memory = std::malloc(bytes > 0 ? bytes : 1)) {
+			return memory;
+		}
+		std::new_handler handler = std::get_new_handler();
+		if (!handler) {
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+}
+
+void
+operator delete(void* memory) noexcept {
+	std::free(memory);
+}
+
+void
+operator delete(void* memory, size_t) noexcept {
+	std::free(memory);
+}
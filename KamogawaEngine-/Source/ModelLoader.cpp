@@ -1,5 +1,74 @@
 #include "ModelLoader.h"
 #include "obj/OBJ_Loader.h"
+#include "FrameClock.h"
+#include "TangentSpace.h"
+#include "IndexFormat.h"
+#include "TextureAtlas.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	/**
+	 * @brief Copia una matriz FBX; su traslación está en la fila 3, como en las del motor.
+	 */
+	XMFLOAT4X4
+	toFloat4x4(const FbxAMatrix& matrix) {
+		XMFLOAT4X4 result;
+		for (int row = 0; row < 4; ++row) {
+			for (int column = 0; column < 4; ++column) {
+				result.m[row][column] = static_cast<float>(matrix.Get(row, column));
+			}
+		}
+		return result;
+	}
+
+	BoneTransform
+	toBoneTransform(const FbxAMatrix& matrix) {
+		const FbxVector4 translation = matrix.GetT();
+		const FbxQuaternion rotation = matrix.GetQ();
+		const FbxVector4 scale = matrix.GetS();
+		BoneTransform transform;
+		transform.translation = XMFLOAT3((float)translation[0], (float)translation[1], (float)translation[2]);
+		transform.rotation = XMFLOAT4((float)rotation[0], (float)rotation[1], (float)rotation[2], (float)rotation[3]);
+		transform.scale = XMFLOAT3((float)scale[0], (float)scale[1], (float)scale[2]);
+		return transform;
+	}
+
+	/**
+	 * @brief Recorre los vértices de polígono de una malla y entrega el punto de control y el
+	 *        valor del elemento de geometría (normal, UV, color) que le corresponde.
+	 *
+	 * Solo se importan los modos por punto de control y por vértice de polígono.
+	 */
+	template<typename TValue, typename TApply>
+	void
+	forEachElementValue(FbxMesh* mesh, FbxLayerElementTemplate<TValue>* element, TApply apply) {
+		const FbxGeometryElement::EMappingMode mappingMode = element->GetMappingMode();
+		const FbxGeometryElement::EReferenceMode referenceMode = element->GetReferenceMode();
+		int polygonVertex = 0;
+		for (int polyIndex = 0; polyIndex < mesh->GetPolygonCount(); polyIndex++) {
+			for (int vertIndex = 0; vertIndex < mesh->GetPolygonSize(polyIndex); vertIndex++, polygonVertex++) {
+				const int controlPointIndex = mesh->GetPolygonVertex(polyIndex, vertIndex);
+				int index = -1;
+				if (mappingMode == FbxGeometryElement::eByControlPoint) {
+					index = controlPointIndex;
+				}
+				else if (mappingMode == FbxGeometryElement::eByPolygonVertex) {
+					index = polygonVertex;
+				}
+				else {
+					continue;
+				}
+				if (referenceMode == FbxGeometryElement::eIndexToDirect) {
+					index = element->GetIndexArray().GetAt(index);
+				}
+				if (index >= 0 && index < element->GetDirectArray().GetCount()) {
+					apply(controlPointIndex, element->GetDirectArray().GetAt(index));
+				}
+			}
+		}
+	}
+}
 
 bool
 ModelLoader::InitializeFBXManager() {
@@ -24,6 +93,7 @@ ModelLoader::InitializeFBXManager() {
 
 bool
 ModelLoader::LoadFBXModel(const std::string& filePath) {
+	PROFILE_SCOPE("ModelLoader::LoadFBXModel");
 	// 00. Initialize the SDK from FBX Manager
 	if (InitializeFBXManager()) {
 		// 01. Create an importer using the SDK manager
@@ -36,8 +106,13 @@ ModelLoader::LoadFBXModel(const std::string& filePath) {
 			return false;
 		}
 
-		// 03. Import the scene
-		if (!lImporter->Import(lScene)) {
+		// 03. Import the scene (el scope mide solo la importación)
+		bool imported;
+		{
+			PROFILE_SCOPE("FBX Import");
+			imported = lImporter->Import(lScene);
+		}
+		if (!imported) {
 			ERROR("ModelLoader", "lImporter->Import", "Unable to import the FBX scene from file : " << filePath.c_str());
 			lImporter->Destroy();
 			return false;
@@ -47,14 +122,32 @@ ModelLoader::LoadFBXModel(const std::string& filePath) {
 		lImporter->Destroy();
 		MESSAGE("ModelLoader", "LoadFBXModel", "Successfully imported the FBX scene from file: " << filePath.c_str());
 
-		// 05. Process the scene
+		// 05. Process the scene (the skeleton first, so skin clusters can refer to its bones)
+		const long long processStart = FrameClock::now();
 		FbxNode* lRootNode = lScene->GetRootNode();
 
 		if (lRootNode) {
+			ProcessFBXSkeleton(lRootNode);
 			for (int i = 0; i < lRootNode->GetChildCount(); i++) {
 				ProcessFBXNode(lRootNode->GetChild(i));
 			}
 		}
+		ProcessTangentSpaces(filePath);
+		ProcessVertexFormats(filePath);
+		ProcessIndexFormats(filePath);
+		const long long meshesEnd = FrameClock::now();
+		ProcessFBXAnimations();
+		const long long animationsEnd = FrameClock::now();
+
+		if (!skeleton.bones.empty()) {
+			size_t animationBytes = 0;
+			for (const auto& clip : animations) {
+				animationBytes += clip.getMemoryBytes();
+			}
+			LOG_INFO(LOG_CATEGORY_RESOURCE, "%s: %u bones, %u clips (%.1f KB); meshes %.2f ms, animations %.2f ms",
+					 filePath, skeleton.getBoneCount(), static_cast<unsigned int>(animations.size()),
+					 animationBytes / 1024.0, (meshesEnd - processStart) / 1.0e6, (animationsEnd - meshesEnd) / 1.0e6);
+		}
 
 		// 06. Process the materials
 		int materialCount = lScene->GetMaterialCount();
@@ -86,12 +179,13 @@ ModelLoader::ProcessFBXNode(FbxNode* node) {
 
 void
 ModelLoader::ProcessFBXMesh(FbxNode* node) {
+	PROFILE_SCOPE("ModelLoader::ProcessFBXMesh");
 	// 01. Get the mesh from the node. If there is no mesh, exit early.
 	FbxMesh* mesh = node->GetMesh();
 	if (!mesh) return;
 
-	std::vector<SimpleVertex> vertices;
-	std::vector<unsigned int> indices;
+	TrackedVector<SimpleVertex, MEMORY_TAG_MESH> vertices;
+	TrackedVector<unsigned int, MEMORY_TAG_MESH> indices;
 
 	// 02. Process vertices: extract positions from control points.
 	for (int i = 0; i < mesh->GetControlPointsCount(); i++) {
@@ -145,6 +239,29 @@ ModelLoader::ProcessFBXMesh(FbxNode* node) {
 		}
 	}
 
+	// 03.2 Normals, second UV set and vertex colors if available.
+	if (mesh->GetElementNormalCount() > 0) {
+		forEachElementValue(mesh, mesh->GetElementNormal(0), [&](int controlPointIndex, const FbxVector4& normal) {
+			vertices[controlPointIndex].Normal = XMFLOAT3((float)normal[0], (float)normal[1], (float)normal[2]);
+		});
+	}
+	if (mesh->GetElementUVCount() > 1) {
+		forEachElementValue(mesh, mesh->GetElementUV(1), [&](int controlPointIndex, const FbxVector2& uv) {
+			vertices[controlPointIndex].Tex1 = XMFLOAT2((float)uv[0], -(float)uv[1]);
+		});
+	}
+	if (mesh->GetElementVertexColorCount() > 0) {
+		forEachElementValue(mesh, mesh->GetElementVertexColor(0), [&](int controlPointIndex, const FbxColor& color) {
+			const double channels[4] = { color.mRed, color.mGreen, color.mBlue, color.mAlpha };
+			unsigned int packed = 0;
+			for (int c = 0; c < 4; ++c) {
+				const double value = std::max(0.0, std::min(1.0, channels[c]));
+				packed |= static_cast<unsigned int>(value * 255.0 + 0.5) << (8 * c);
+			}
+			vertices[controlPointIndex].Color = packed;
+		});
+	}
+
 	// 04. Process indices: store each polygon vertex index.
 	for (int i = 0; i < mesh->GetPolygonCount(); i++) {
 		for (int j = 0; j < mesh->GetPolygonSize(i); j++) {
@@ -159,11 +276,166 @@ ModelLoader::ProcessFBXMesh(FbxNode* node) {
 	meshData.m_index = indices;
 	meshData.m_numVertex = vertices.size();
 	meshData.m_numIndex = indices.size();
+	ComputeMeshBounds(meshData);
+	ProcessFBXSkin(mesh, meshData);
 
 	// 06. Add the processed mesh data to the collection.
 	meshes.push_back(meshData);
 }
 
+void
+ModelLoader::ProcessFBXSkeleton(FbxNode* node) {
+	if (node->GetNodeAttribute() &&
+		node->GetNodeAttribute()->GetAttributeType() == FbxNodeAttribute::eSkeleton) {
+		AddFBXBone(node);
+	}
+	for (int i = 0; i < node->GetChildCount(); i++) {
+		ProcessFBXSkeleton(node->GetChild(i));
+	}
+}
+
+int
+ModelLoader::AddFBXBone(FbxNode* node) {
+	auto found = std::find(boneNodes.begin(), boneNodes.end(), node);
+	if (found != boneNodes.end()) {
+		return static_cast<int>(found - boneNodes.begin());
+	}
+
+	// Un hueso sin padre en el esqueleto guarda su transformación global como local
+	Bone bone;
+	bone.name = node->GetName();
+	auto parent = std::find(boneNodes.begin(), boneNodes.end(), node->GetParent());
+	bone.parent = parent != boneNodes.end() ? static_cast<int>(parent - boneNodes.begin()) : -1;
+	bone.bindPose = toBoneTransform(bone.parent >= 0 ? node->EvaluateLocalTransform()
+													 : node->EvaluateGlobalTransform());
+	// Sin cluster que la defina, la pose de enlace es la pose por defecto del nodo
+	bone.inverseBindPose = toFloat4x4(node->EvaluateGlobalTransform().Inverse());
+
+	skeleton.bones.push_back(bone);
+	boneNodes.push_back(node);
+	return static_cast<int>(boneNodes.size()) - 1;
+}
+
+void
+ModelLoader::ProcessFBXSkin(FbxMesh* fbxMesh, MeshComponent& mesh) {
+	const int skinCount = fbxMesh->GetDeformerCount(FbxDeformer::eSkin);
+	if (skinCount == 0) {
+		return;
+	}
+	PROFILE_SCOPE("ModelLoader::ProcessFBXSkin");
+
+	// 01. Influencias de cada punto de control en todos los clusters
+	const int controlPointCount = fbxMesh->GetControlPointsCount();
+	std::vector<std::vector<std::pair<unsigned int, float>>> influences(controlPointCount);
+	unsigned int skippedBones = 0;
+	for (int skinIndex = 0; skinIndex < skinCount; ++skinIndex) {
+		FbxSkin* skin = static_cast<FbxSkin*>(fbxMesh->GetDeformer(skinIndex, FbxDeformer::eSkin));
+		for (int clusterIndex = 0; clusterIndex < skin->GetClusterCount(); ++clusterIndex) {
+			FbxCluster* cluster = skin->GetCluster(clusterIndex);
+			if (!cluster->GetLink()) {
+				continue;
+			}
+			const int bone = AddFBXBone(cluster->GetLink());
+			if (bone >= static_cast<int>(Skeleton::kMaxSkinBones)) {
+				++skippedBones;
+				continue;
+			}
+
+			// Malla a espacio del hueso en la pose de enlace
+			FbxAMatrix meshBind;
+			FbxAMatrix linkBind;
+			cluster->GetTransformMatrix(meshBind);
+			cluster->GetTransformLinkMatrix(linkBind);
+			skeleton.bones[bone].inverseBindPose = toFloat4x4(linkBind.Inverse() * meshBind);
+
+			const int* controlPoints = cluster->GetControlPointIndices();
+			const double* weights = cluster->GetControlPointWeights();
+			for (int i = 0; i < cluster->GetControlPointIndicesCount(); ++i) {
+				if (controlPoints[i] >= 0 && controlPoints[i] < controlPointCount && weights[i] > 0.0) {
+					influences[controlPoints[i]].push_back(std::make_pair(static_cast<unsigned int>(bone),
+																		  static_cast<float>(weights[i])));
+				}
+			}
+		}
+	}
+	if (skippedBones > 0) {
+		LOG_WARNING(LOG_CATEGORY_RESOURCE, "%s: %u bones beyond the %u addressable by skin weights were ignored",
+					mesh.m_name, skippedBones, Skeleton::kMaxSkinBones);
+	}
+
+	// 02. Las 4 mayores, normalizadas y cuantizadas a 8 bits
+	mesh.m_skin.resize(controlPointCount);
+	std::vector<unsigned int> bones;
+	std::vector<float> weights;
+	for (int i = 0; i < controlPointCount; ++i) {
+		bones.clear();
+		weights.clear();
+		for (const auto& influence : influences[i]) {
+			bones.push_back(influence.first);
+			weights.push_back(influence.second);
+		}
+		mesh.m_skin[i] = quantizeSkinWeights(bones.data(), weights.data(), static_cast<unsigned int>(bones.size()));
+	}
+}
+
+void
+ModelLoader::ProcessFBXAnimations() {
+	if (skeleton.bones.empty()) {
+		return;
+	}
+	PROFILE_SCOPE("ModelLoader::ProcessFBXAnimations");
+
+	const unsigned int boneCount = skeleton.getBoneCount();
+	const int stackCount = lScene->GetSrcObjectCount<FbxAnimStack>();
+	for (int stackIndex = 0; stackIndex < stackCount; ++stackIndex) {
+		FbxAnimStack* stack = lScene->GetSrcObject<FbxAnimStack>(stackIndex);
+		lScene->SetCurrentAnimationStack(stack);
+		const FbxTimeSpan span = stack->GetLocalTimeSpan();
+		const double start = span.GetStart().GetSecondDouble();
+		const double duration = std::max(0.0, span.GetDuration().GetSecondDouble());
+
+		const unsigned int sampleCount = static_cast<unsigned int>(std::ceil(duration * kAnimationSampleRate)) + 1;
+		AnimationClip clip;
+		clip.init(stack->GetName(), static_cast<float>(duration), kAnimationSampleRate, sampleCount, boneCount);
+
+		for (unsigned int sample = 0; sample < sampleCount; ++sample) {
+			FbxTime time;
+			time.SetSecondDouble(start + std::min(sample / static_cast<double>(kAnimationSampleRate), duration));
+			for (unsigned int bone = 0; bone < boneCount; ++bone) {
+				FbxNode* node = boneNodes[bone];
+				BoneTransform transform = toBoneTransform(skeleton.bones[bone].parent >= 0 ? node->EvaluateLocalTransform(time)
+																						  : node->EvaluateGlobalTransform(time));
+
+				// Mismo hemisferio que la muestra anterior para interpolar con nlerp
+				if (sample > 0) {
+					const XMFLOAT4 previous = clip.getTransform(sample - 1, bone).rotation;
+					XMFLOAT4& rotation = transform.rotation;
+					if (previous.x * rotation.x + previous.y * rotation.y + previous.z * rotation.z + previous.w * rotation.w < 0.0f) {
+						rotation = XMFLOAT4(-rotation.x, -rotation.y, -rotation.z, -rotation.w);
+					}
+				}
+				clip.setTransform(sample, bone, transform);
+			}
+		}
+
+		// Solo se conserva el clip comprimido
+		CompressedAnimationClip compressed;
+		AnimationCompressionReport report;
+		if (!compressed.compress(clip, skeleton, animationCompression, &report)) {
+			continue;
+		}
+		LOG_INFO(LOG_CATEGORY_RESOURCE, "Animation '%s': %.1f KB (%.1fx smaller), %u/%u keys, %u constant tracks, max error %.4f at '%s'",
+				 compressed.name, report.compressedBytes / 1024.0, report.ratio,
+				 report.keptKeys, report.rawKeys, report.constantTracks, report.maxError,
+				 report.worstBone >= 0 ? skeleton.bones[report.worstBone].name : std::string("-"));
+		if (report.maxError > animationCompression.maxError) {
+			LOG_WARNING(LOG_CATEGORY_RESOURCE, "Animation '%s' exceeds the error budget (%.4f > %.4f); quantization limits precision",
+						compressed.name, report.maxError, animationCompression.maxError);
+		}
+		animations.push_back(std::move(compressed));
+	}
+}
+
 void
 ModelLoader::ProcessFBXMaterials(FbxSurfaceMaterial* material) {
 	if (material) {
@@ -182,6 +454,7 @@ ModelLoader::ProcessFBXMaterials(FbxSurfaceMaterial* material) {
 
 bool 
 ModelLoader::LoadOBJModel(const std::string& filePath) {
+	PROFILE_SCOPE("ModelLoader::LoadOBJModel");
 	objl::Loader loader; // Load the OBJ file using objl::Loader
 	bool result = loader.LoadFile(filePath);// Load the OBJ file
 	if (!result) {
@@ -190,17 +463,18 @@ ModelLoader::LoadOBJModel(const std::string& filePath) {
 	}
 	// 01. Process the loaded OBJ file
 	for (const auto& mesh : loader.LoadedMeshes) {
-		std::vector<SimpleVertex> vertices;
-		std::vector<unsigned int> indices;
+		TrackedVector<SimpleVertex, MEMORY_TAG_MESH> vertices;
+		TrackedVector<unsigned int, MEMORY_TAG_MESH> indices;
 		// 02. Process vertices: extract positions and texture coordinates
 		for (const auto& vertex : mesh.Vertices) {
 			SimpleVertex v;
 			v.Pos = XMFLOAT3(vertex.Position.X, vertex.Position.Y, vertex.Position.Z);
 			v.Tex = XMFLOAT2(vertex.TextureCoordinate.X, 1.0f - vertex.TextureCoordinate.Y); // Flip Y
+			v.Normal = XMFLOAT3(vertex.Normal.X, vertex.Normal.Y, vertex.Normal.Z);
 			vertices.push_back(v);
 		}
 		// 03. Process indices: extract indices from the mesh
-		indices = mesh.Indices;
+		indices.assign(mesh.Indices.begin(), mesh.Indices.end());
 		// 04. Create a MeshComponent to store the processed mesh data 
 		MeshComponent meshData;
 		meshData.m_name = mesh.MeshName;
@@ -208,9 +482,139 @@ ModelLoader::LoadOBJModel(const std::string& filePath) {
 		meshData.m_index = indices;
 		meshData.m_numVertex = vertices.size();
 		meshData.m_numIndex = indices.size();
+		ComputeMeshBounds(meshData);
 		// 05. Add the processed mesh data to the collection 
 		meshes.push_back(meshData);
 	}
+	ProcessTangentSpaces(filePath);
+	ProcessVertexFormats(filePath);
+	ProcessIndexFormats(filePath);
 
 	return true;
 }
+
+void
+ModelLoader::ProcessTangentSpaces(const std::string& filePath) {
+	const unsigned int cores = std::thread::hardware_concurrency();
+	const TangentSpaceStats stats = computeTangentSpaces(meshes, std::max(1u, cores));
+	LOG_INFO(LOG_CATEGORY_RESOURCE, "%s: tangent spaces for %u meshes in %.2f ms on %u threads (%u normals generated, %u vertices split, %u degenerate UV triangles)",
+			 filePath, stats.meshes, stats.timeMs, stats.threads, stats.generatedNormals, stats.splitVertices,
+			 stats.degenerateTriangles);
+}
+
+void
+ModelLoader::ProcessVertexFormats(const std::string& filePath, const std::vector<float>& maxTexcoordErrors) {
+	PROFILE_SCOPE("ModelLoader::ProcessVertexFormats");
+	const VertexFormat standard = VertexFormat::standard();
+	VertexQuantizationError maxError;
+	unsigned long long packedBytes = 0;
+	unsigned long long standardBytes = 0;
+	unsigned long long floatBytes = 0;
+	unsigned int quantizedMeshes = 0;
+
+	VertexQuantizationSettings settings = vertexQuantization;
+	for (size_t i = 0; i < meshes.size(); ++i) {
+		MeshComponent& mesh = meshes[i];
+		const unsigned int vertexCount = static_cast<unsigned int>(mesh.m_vertex.size());
+
+		// 01. El formato buscado, relajado por atributo según el error de esta malla
+		VertexQuantizationError error;
+		settings.maxTexcoordError = i < maxTexcoordErrors.size() ? maxTexcoordErrors[i]
+																 : vertexQuantization.maxTexcoordError;
+		if (vertexQuantization.enabled && vertexCount > 0) {
+			mesh.m_format = vertexQuantization.format.fitError(mesh.m_vertex.data(), vertexCount,
+															   mesh.m_boundsMin, mesh.m_boundsMax,
+															   settings, error);
+			if (mesh.m_format == vertexQuantization.format) {
+				++quantizedMeshes;
+			}
+			else {
+				LOG_INFO(LOG_CATEGORY_RESOURCE, "Mesh '%s' exceeds the quantization budget; %u-byte vertices instead of %u",
+						 mesh.m_name, mesh.m_format.getStride(), vertexQuantization.format.getStride());
+			}
+		}
+		else {
+			mesh.m_format = standard;
+		}
+
+		// 02. Memoria de su vertex buffer frente al formato estándar y a todo en floats
+		maxError.position = std::max(maxError.position, error.position);
+		maxError.normal = std::max(maxError.normal, error.normal);
+		maxError.tangent = std::max(maxError.tangent, error.tangent);
+		maxError.texcoord = std::max(maxError.texcoord, error.texcoord);
+		packedBytes += static_cast<unsigned long long>(mesh.m_format.getStride()) * vertexCount;
+		standardBytes += static_cast<unsigned long long>(standard.getStride()) * vertexCount;
+		floatBytes += static_cast<unsigned long long>(mesh.m_format.unquantized().getStride()) * vertexCount;
+	}
+
+	LOG_INFO(LOG_CATEGORY_RESOURCE, "%s: vertex buffers %.1f KB (standard %.1f KB, all floats %.1f KB); %u/%u meshes fully quantized",
+			 filePath, packedBytes / 1024.0, standardBytes / 1024.0, floatBytes / 1024.0, quantizedMeshes,
+			 static_cast<unsigned int>(meshes.size()));
+	if (vertexQuantization.enabled) {
+		LOG_INFO(LOG_CATEGORY_RESOURCE, "%s: max quantization error %.5f units, normal %.2f deg, tangent %.2f deg, UV %.5f",
+				 filePath, maxError.position, maxError.normal, maxError.tangent, maxError.texcoord);
+	}
+}
+
+void
+ModelLoader::RefitVertexFormats(const std::string& filePath, const TextureAtlas& atlas) {
+	// En una página de 2048 el error del half ya ronda medio texel: se limita a un cuarto de texel de la página
+	std::vector<float> maxTexcoordErrors(meshes.size(), vertexQuantization.maxTexcoordError);
+	for (unsigned int i = 0; i < meshes.size(); ++i) {
+		const float texelSize = atlas.getTexelSize(i);
+		if (texelSize > 0.0f) {
+			maxTexcoordErrors[i] = std::min(maxTexcoordErrors[i], 0.25f * texelSize);
+		}
+	}
+	ProcessVertexFormats(filePath, maxTexcoordErrors);
+}
+
+void
+ModelLoader::ProcessIndexFormats(const std::string& filePath) {
+	IndexFormatStats stats;
+	for (auto& mesh : meshes) {
+		selectIndexFormat(mesh, splitForShortIndices, stats);
+	}
+	LOG_INFO(LOG_CATEGORY_RESOURCE, "%s: index buffers %.1f KB (%.1f KB with 32-bit indices); %u meshes 16-bit, %u 32-bit, %u split into %u chunks (%u vertices repeated)",
+			 filePath, stats.bytes / 1024.0, stats.longBytes / 1024.0, stats.shortMeshes, stats.longMeshes,
+			 stats.splitMeshes, stats.chunks, stats.duplicatedVertices);
+	if (stats.longMeshes > 0 && !splitForShortIndices) {
+		LOG_INFO(LOG_CATEGORY_RESOURCE, "%s: %u meshes exceed %u vertices; enable splitForShortIndices to use 16-bit indices",
+				 filePath, stats.longMeshes, kMaxShortIndexVertices);
+	}
+}
+
+void
+ModelLoader::ComputeMeshBounds(MeshComponent& mesh) {
+	if (mesh.m_vertex.empty()) {
+		return;
+	}
+
+	// 01. AABB a partir de las posiciones
+	XMFLOAT3 minPos = mesh.m_vertex[0].Pos;
+	XMFLOAT3 maxPos = mesh.m_vertex[0].Pos;
+	for (const auto& vertex : mesh.m_vertex) {
+		minPos.x = std::min(minPos.x, vertex.Pos.x);
+		minPos.y = std::min(minPos.y, vertex.Pos.y);
+		minPos.z = std::min(minPos.z, vertex.Pos.z);
+		maxPos.x = std::max(maxPos.x, vertex.Pos.x);
+		maxPos.y = std::max(maxPos.y, vertex.Pos.y);
+		maxPos.z = std::max(maxPos.z, vertex.Pos.z);
+	}
+	mesh.m_boundsMin = minPos;
+	mesh.m_boundsMax = maxPos;
+
+	// 02. Esfera centrada en el AABB con el vértice más lejano como radio
+	XMFLOAT3 center((minPos.x + maxPos.x) * 0.5f,
+					(minPos.y + maxPos.y) * 0.5f,
+					(minPos.z + maxPos.z) * 0.5f);
+	float radiusSq = 0.0f;
+	for (const auto& vertex : mesh.m_vertex) {
+		float dx = vertex.Pos.x - center.x;
+		float dy = vertex.Pos.y - center.y;
+		float dz = vertex.Pos.z - center.z;
+		radiusSq = std::max(radiusSq, dx * dx + dy * dy + dz * dz);
+	}
+	mesh.m_sphereCenter = center;
+	mesh.m_sphereRadius = std::sqrt(radiusSq);
+}
@@ -0,0 +1,472 @@
+#include "OcclusionCuller.h"
+#include "AABBTree.h"
+#include "FrameClock.h"
+#include "CpuFeatures.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+HRESULT
+OcclusionCuller::init(unsigned int width, unsigned int height, unsigned int workerCount) {
+	if (width == 0 || height == 0) {
+		ERROR("OcclusionCuller", "init", "Invalid depth buffer size");
+		return E_INVALIDARG;
+	}
+	destroy();
+
+	m_width = (width + kTileSize - 1) / kTileSize * kTileSize;
+	m_height = (height + kTileSize - 1) / kTileSize * kTileSize;
+	m_tilesX = m_width / kTileSize;
+	m_tilesY = m_height / kTileSize;
+	m_depth.assign(m_width * m_height, 1.0f);
+	m_hiZ.assign(m_tilesX * m_tilesY, 1.0f);
+
+	// Cada franja abarca filas completas de bloques para que la Z jerárquica no se comparta
+	m_bandCount = std::min(workerCount + 1, m_tilesY);
+	m_quit = false;
+	m_generation = 0;
+	for (unsigned int band = 1; band < m_bandCount; ++band) {
+		m_workers.push_back(std::thread(&OcclusionCuller::workerLoop, this, band));
+	}
+	return S_OK;
+}
+
+void
+OcclusionCuller::destroy() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_quit = true;
+	}
+	m_startSignal.notify_all();
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+	m_workers.clear();
+	m_depth.clear();
+	m_hiZ.clear();
+	m_triangles.clear();
+	m_width = m_height = 0;
+}
+
+void
+OcclusionCuller::begin(const XMMATRIX& viewProjection) {
+	m_viewProjection = viewProjection;
+	m_triangles.clear();
+	m_stats = OcclusionStats();
+}
+
+void
+OcclusionCuller::addOccluder(const void* positions,
+							 unsigned int stride,
+							 unsigned int vertexCount,
+							 const unsigned int* indices,
+							 unsigned int indexCount,
+							 const XMMATRIX& world) {
+	if (!positions || !indices || m_width == 0) {
+		return;
+	}
+
+	// 01. Llevar todos los vértices a espacio de clip una sola vez
+	XMMATRIX worldViewProjection = XMMatrixMultiply(world, m_viewProjection);
+	const unsigned char* bytes = static_cast<const unsigned char*>(positions);
+	m_clipVertices.resize(vertexCount);
+	for (unsigned int i = 0; i < vertexCount; ++i) {
+		const XMFLOAT3* position = reinterpret_cast<const XMFLOAT3*>(bytes + i * stride);
+		XMStoreFloat4(&m_clipVertices[i], XMVector3Transform(XMLoadFloat3(position), worldViewProjection));
+	}
+
+	// 02. Armar los triángulos
+	for (unsigned int i = 0; i + 2 < indexCount; i += 3) {
+		if (indices[i] >= vertexCount || indices[i + 1] >= vertexCount || indices[i + 2] >= vertexCount) {
+			continue;
+		}
+		++m_stats.occluderTriangles;
+		setupTriangle(m_clipVertices[indices[i]], m_clipVertices[indices[i + 1]], m_clipVertices[indices[i + 2]]);
+	}
+}
+
+void
+OcclusionCuller::setupTriangle(const XMFLOAT4& v0, const XMFLOAT4& v1, const XMFLOAT4& v2) {
+	// Rechazo trivial si los tres vértices quedan fuera del mismo plano lateral
+	if ((v0.x > v0.w && v1.x > v1.w && v2.x > v2.w) || (v0.x < -v0.w && v1.x < -v1.w && v2.x < -v2.w) ||
+		(v0.y > v0.w && v1.y > v1.w && v2.y > v2.w) || (v0.y < -v0.w && v1.y < -v1.w && v2.y < -v2.w) ||
+		(v0.z < 0.0f && v1.z < 0.0f && v2.z < 0.0f)) {
+		return;
+	}
+
+	// Recortar contra el plano cercano (z >= 0 en Direct3D); el resultado tiene hasta 4 vértices
+	const XMFLOAT4 input[3] = { v0, v1, v2 };
+	XMFLOAT4 clipped[4];
+	unsigned int clippedCount = 0;
+	for (unsigned int i = 0; i < 3; ++i) {
+		const XMFLOAT4& a = input[i];
+		const XMFLOAT4& b = input[(i + 1) % 3];
+		if (a.z >= 0.0f) {
+			clipped[clippedCount++] = a;
+		}
+		if ((a.z >= 0.0f) != (b.z >= 0.0f)) {
+			const float t = a.z / (a.z - b.z);
+			clipped[clippedCount++] = XMFLOAT4(a.x + (b.x - a.x) * t,
+											   a.y + (b.y - a.y) * t,
+											   0.0f,
+											   a.w + (b.w - a.w) * t);
+		}
+	}
+
+	// Proyectar a píxeles y triangular en abanico
+	XMFLOAT3 screen[4];
+	for (unsigned int i = 0; i < clippedCount; ++i) {
+		const float inverseW = 1.0f / clipped[i].w;
+		screen[i] = XMFLOAT3((clipped[i].x * inverseW * 0.5f + 0.5f) * m_width,
+							 (0.5f - clipped[i].y * inverseW * 0.5f) * m_height,
+							 clipped[i].z * inverseW);
+	}
+	for (unsigned int i = 2; i < clippedCount; ++i) {
+		addScreenTriangle(screen[0], screen[i - 1], screen[i]);
+	}
+}
+
+void
+OcclusionCuller::addScreenTriangle(const XMFLOAT3& p0, const XMFLOAT3& p1, const XMFLOAT3& p2) {
+	// Con y hacia abajo, el orden horario de Direct3D (cara frontal) da área positiva
+	const float area = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+	if (area <= 0.0f) {
+		return;
+	}
+
+	ScreenTriangle triangle;
+	triangle.minX = std::max(0, static_cast<int>(std::floor(std::min(p0.x, std::min(p1.x, p2.x)))));
+	triangle.minY = std::max(0, static_cast<int>(std::floor(std::min(p0.y, std::min(p1.y, p2.y)))));
+	triangle.maxX = std::min(static_cast<int>(m_width) - 1, static_cast<int>(std::ceil(std::max(p0.x, std::max(p1.x, p2.x)))));
+	triangle.maxY = std::min(static_cast<int>(m_height) - 1, static_cast<int>(std::ceil(std::max(p0.y, std::max(p1.y, p2.y)))));
+	if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+		return;
+	}
+
+	// Funciones de borde, positivas en el interior
+	const XMFLOAT3* points[3] = { &p0, &p1, &p2 };
+	for (unsigned int i = 0; i < 3; ++i) {
+		const XMFLOAT3& a = *points[i];
+		const XMFLOAT3& b = *points[(i + 1) % 3];
+		triangle.edgeA[i] = a.y - b.y;
+		triangle.edgeB[i] = b.x - a.x;
+		triangle.edgeC[i] = -(triangle.edgeA[i] * a.x + triangle.edgeB[i] * a.y);
+	}
+
+	// Plano de profundidad
+	triangle.depthA = ((p1.z - p0.z) * (p2.y - p0.y) - (p2.z - p0.z) * (p1.y - p0.y)) / area;
+	triangle.depthB = ((p1.x - p0.x) * (p2.z - p0.z) - (p2.x - p0.x) * (p1.z - p0.z)) / area;
+	triangle.depthC = p0.z - triangle.depthA * p0.x - triangle.depthB * p0.y;
+
+	m_triangles.push_back(triangle);
+}
+
+void
+OcclusionCuller::rasterize() {
+	auto start = std::chrono::high_resolution_clock::now();
+	m_stats.rasterizedTriangles = static_cast<unsigned int>(m_triangles.size());
+
+	if (!m_workers.empty()) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_pendingBands = static_cast<unsigned int>(m_workers.size());
+			++m_generation;
+		}
+		m_startSignal.notify_all();
+	}
+
+	// La primera franja la procesa el hilo que llama
+	rasterizeBand(0);
+
+	if (!m_workers.empty()) {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_doneSignal.wait(lock, [this] { return m_pendingBands == 0; });
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+	m_stats.rasterTimeMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void
+OcclusionCuller::rasterizeBand(unsigned int band) {
+	PROFILE_SCOPE("OcclusionCuller::rasterizeBand");
+	const unsigned int tileRowsPerBand = (m_tilesY + m_bandCount - 1) / m_bandCount;
+	const unsigned int firstTileRow = band * tileRowsPerBand;
+	const unsigned int lastTileRow = std::min(m_tilesY, firstTileRow + tileRowsPerBand);
+	if (firstTileRow >= lastTileRow) {
+		return;
+	}
+	const int firstRow = static_cast<int>(firstTileRow * kTileSize);
+	const int lastRow = static_cast<int>(lastTileRow * kTileSize) - 1;
+
+	// 01. Limpiar la franja
+	std::fill(m_depth.begin() + firstRow * m_width, m_depth.begin() + (lastRow + 1) * m_width, 1.0f);
+
+	// 02. Rasterizar las filas de cada triángulo que caen en la franja
+	for (const ScreenTriangle& triangle : m_triangles) {
+		const int rowStart = std::max(triangle.minY, firstRow);
+		const int rowEnd = std::min(triangle.maxY, lastRow);
+		if (rowStart > rowEnd) {
+			continue;
+		}
+		if (getCpuFeatures().avx2) {
+			rasterizeRowsAVX2(triangle, rowStart, rowEnd);
+		}
+		else {
+			rasterizeRowsScalar(triangle, rowStart, rowEnd);
+		}
+	}
+
+	// 03. Z jerárquica: la profundidad más lejana de cada bloque
+	for (unsigned int tileY = firstTileRow; tileY < lastTileRow; ++tileY) {
+		for (unsigned int tileX = 0; tileX < m_tilesX; ++tileX) {
+			float farthest = 0.0f;
+			for (unsigned int y = 0; y < kTileSize; ++y) {
+				const float* row = &m_depth[(tileY * kTileSize + y) * m_width + tileX * kTileSize];
+				for (unsigned int x = 0; x < kTileSize; ++x) {
+					farthest = std::max(farthest, row[x]);
+				}
+			}
+			m_hiZ[tileY * m_tilesX + tileX] = farthest;
+		}
+	}
+}
+
+void
+OcclusionCuller::rasterizeRowsAVX2(const ScreenTriangle& triangle, int firstRow, int lastRow) {
+	// Bloques de 8 píxeles alineados; el ancho es múltiplo de 8 así que nunca se sale de la fila
+	const int startX = triangle.minX & ~7;
+	const __m256 laneOffsets = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+	const __m256 startPx = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(startX)), laneOffsets);
+	const __m256 zero = _mm256_setzero_ps();
+
+	__m256 edgeA[3];
+	__m256 edgeStep[3];
+	for (unsigned int i = 0; i < 3; ++i) {
+		edgeA[i] = _mm256_set1_ps(triangle.edgeA[i]);
+		edgeStep[i] = _mm256_set1_ps(triangle.edgeA[i] * 8.0f);
+	}
+	const __m256 depthA = _mm256_set1_ps(triangle.depthA);
+	const __m256 depthStep = _mm256_set1_ps(triangle.depthA * 8.0f);
+
+	for (int y = firstRow; y <= lastRow; ++y) {
+		const float py = y + 0.5f;
+
+		// Valores al inicio de la fila; después solo se suman los pasos
+		__m256 edge[3];
+		for (unsigned int i = 0; i < 3; ++i) {
+			edge[i] = _mm256_add_ps(_mm256_mul_ps(edgeA[i], startPx),
+									_mm256_set1_ps(triangle.edgeB[i] * py + triangle.edgeC[i]));
+		}
+		__m256 depth = _mm256_add_ps(_mm256_mul_ps(depthA, startPx),
+									 _mm256_set1_ps(triangle.depthB * py + triangle.depthC));
+
+		float* row = &m_depth[y * m_width];
+		for (int x = startX; x <= triangle.maxX; x += 8) {
+			__m256 inside = _mm256_and_ps(_mm256_cmp_ps(edge[0], zero, _CMP_GE_OQ),
+										  _mm256_cmp_ps(edge[1], zero, _CMP_GE_OQ));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(edge[2], zero, _CMP_GE_OQ));
+
+			if (!_mm256_testz_ps(inside, inside)) {
+				const __m256 current = _mm256_loadu_ps(row + x);
+				const __m256 nearest = _mm256_min_ps(current, depth);
+				_mm256_storeu_ps(row + x, _mm256_blendv_ps(current, nearest, inside));
+			}
+
+			for (unsigned int i = 0; i < 3; ++i) {
+				edge[i] = _mm256_add_ps(edge[i], edgeStep[i]);
+			}
+			depth = _mm256_add_ps(depth, depthStep);
+		}
+	}
+}
+
+void
+OcclusionCuller::rasterizeRowsScalar(const ScreenTriangle& triangle, int firstRow, int lastRow) {
+	for (int y = firstRow; y <= lastRow; ++y) {
+		const float py = y + 0.5f;
+		float* row = &m_depth[y * m_width];
+		for (int x = triangle.minX; x <= triangle.maxX; ++x) {
+			const float px = x + 0.5f;
+			if (triangle.edgeA[0] * px + triangle.edgeB[0] * py + triangle.edgeC[0] < 0.0f ||
+				triangle.edgeA[1] * px + triangle.edgeB[1] * py + triangle.edgeC[1] < 0.0f ||
+				triangle.edgeA[2] * px + triangle.edgeB[2] * py + triangle.edgeC[2] < 0.0f) {
+				continue;
+			}
+			const float depth = triangle.depthA * px + triangle.depthB * py + triangle.depthC;
+			row[x] = std::min(row[x], depth);
+		}
+	}
+}
+
+bool
+OcclusionCuller::isVisible(const AABB& box) {
+	++m_stats.tested;
+	if (m_width == 0) {
+		return true;
+	}
+
+	// 01. Proyectar las 8 esquinas; si alguna cruza el plano cercano la caja se considera visible
+	float minX = FLT_MAX, minY = FLT_MAX, maxX = -FLT_MAX, maxY = -FLT_MAX;
+	float nearestDepth = FLT_MAX;
+	for (unsigned int corner = 0; corner < 8; ++corner) {
+		XMVECTOR point = XMVectorSet((corner & 1) ? box.upper.x : box.lower.x,
+									 (corner & 2) ? box.upper.y : box.lower.y,
+									 (corner & 4) ? box.upper.z : box.lower.z,
+									 1.0f);
+		XMFLOAT4 clip;
+		XMStoreFloat4(&clip, XMVector4Transform(point, m_viewProjection));
+		if (clip.z < 0.0f || clip.w <= 0.0f) {
+			return true;
+		}
+		const float inverseW = 1.0f / clip.w;
+		const float sx = (clip.x * inverseW * 0.5f + 0.5f) * m_width;
+		const float sy = (0.5f - clip.y * inverseW * 0.5f) * m_height;
+		minX = std::min(minX, sx);
+		maxX = std::max(maxX, sx);
+		minY = std::min(minY, sy);
+		maxY = std::max(maxY, sy);
+		nearestDepth = std::min(nearestDepth, clip.z * inverseW);
+	}
+
+	// 02. Rectángulo de píxeles cubierto; fuera de pantalla lo decide el frustum culling
+	const int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+	const int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+	const int x1 = std::min(static_cast<int>(m_width) - 1, static_cast<int>(std::ceil(maxX)));
+	const int y1 = std::min(static_cast<int>(m_height) - 1, static_cast<int>(std::ceil(maxY)));
+	if (x0 > x1 || y0 > y1) {
+		return true;
+	}
+
+	// 03. Bloques cuyo punto más lejano está delante de la caja la ocultan por completo;
+	// en el resto se revisan los píxeles
+	for (int tileY = y0 / static_cast<int>(kTileSize); tileY <= y1 / static_cast<int>(kTileSize); ++tileY) {
+		for (int tileX = x0 / static_cast<int>(kTileSize); tileX <= x1 / static_cast<int>(kTileSize); ++tileX) {
+			if (m_hiZ[tileY * m_tilesX + tileX] < nearestDepth) {
+				continue;
+			}
+
+			const int pixelX0 = std::max(x0, tileX * static_cast<int>(kTileSize));
+			const int pixelX1 = std::min(x1, (tileX + 1) * static_cast<int>(kTileSize) - 1);
+			const int pixelY0 = std::max(y0, tileY * static_cast<int>(kTileSize));
+			const int pixelY1 = std::min(y1, (tileY + 1) * static_cast<int>(kTileSize) - 1);
+			for (int y = pixelY0; y <= pixelY1; ++y) {
+				const float* row = &m_depth[y * m_width];
+				for (int x = pixelX0; x <= pixelX1; ++x) {
+					if (row[x] >= nearestDepth) {
+						return true;
+					}
+				}
+			}
+		}
+	}
+
+	++m_stats.occluded;
+	return false;
+}
+
+void
+OcclusionCuller::workerLoop(unsigned int band) {
+	PROFILE_THREAD("Occlusion worker");
+	unsigned int seenGeneration = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_startSignal.wait(lock, [&] { return m_quit || m_generation != seenGeneration; });
+			if (m_quit) {
+				return;
+			}
+			seenGeneration = m_generation;
+		}
+
+		rasterizeBand(band);
+
+		bool last = false;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			last = --m_pendingBands == 0;
+		}
+		if (last) {
+			m_doneSignal.notify_one();
+		}
+	}
+}
+
+OcclusionBenchmarkResult
+runOcclusionBenchmark(OcclusionCuller& culler, unsigned int occluders, unsigned int boxes, unsigned int frames) {
+	OcclusionBenchmarkResult result;
+	result.width = culler.getWidth();
+	result.height = culler.getHeight();
+	frames = frames > 0 ? frames : 1;
+
+	// 01. Cubo unitario con caras en sentido horario vistas desde fuera (caras frontales de Direct3D)
+	const XMFLOAT3 cube[8] = { XMFLOAT3(-1.0f, -1.0f, -1.0f), XMFLOAT3(-1.0f, 1.0f, -1.0f),
+							   XMFLOAT3(1.0f, 1.0f, -1.0f), XMFLOAT3(1.0f, -1.0f, -1.0f),
+							   XMFLOAT3(-1.0f, -1.0f, 1.0f), XMFLOAT3(-1.0f, 1.0f, 1.0f),
+							   XMFLOAT3(1.0f, 1.0f, 1.0f), XMFLOAT3(1.0f, -1.0f, 1.0f) };
+	const unsigned int cubeIndices[36] = { 0, 1, 2, 0, 2, 3,    // -Z
+										   7, 6, 5, 7, 5, 4,    // +Z
+										   4, 5, 1, 4, 1, 0,    // -X
+										   3, 2, 6, 3, 6, 7,    // +X
+										   1, 5, 6, 1, 6, 2,    // +Y
+										   4, 0, 3, 4, 3, 7 };  // -Y
+
+	// 02. Oclusores y cajas dentro del campo de visión (la tangente de 30 grados acota x e y)
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> occluderDepth(10.0f, 30.0f);
+	std::uniform_real_distribution<float> occluderSize(1.0f, 3.0f);
+	std::uniform_real_distribution<float> boxDepth(5.0f, 100.0f);
+	std::uniform_real_distribution<float> boxSize(0.25f, 1.0f);
+	const float aspect = result.height > 0 ? static_cast<float>(result.width) / result.height : 1.0f;
+	const float spread = std::tan(XM_PI / 6.0f);
+	std::vector<XMMATRIX> occluderWorlds(occluders);
+	for (auto& world : occluderWorlds) {
+		const float z = occluderDepth(random);
+		const float size = occluderSize(random);
+		world = XMMatrixScaling(size, size, size) *
+				XMMatrixTranslation(unit(random) * z * spread * aspect, unit(random) * z * spread, z);
+	}
+	std::vector<AABB> testBoxes(boxes);
+	for (auto& box : testBoxes) {
+		const float z = boxDepth(random);
+		const XMFLOAT3 center(unit(random) * z * spread * aspect, unit(random) * z * spread, z);
+		const float half = boxSize(random);
+		box.lower = XMFLOAT3(center.x - half, center.y - half, center.z - half);
+		box.upper = XMFLOAT3(center.x + half, center.y + half, center.z + half);
+	}
+
+	// 03. Rasterizar y probar; rasterize() mide su propio tiempo
+	const XMMATRIX viewProjection = XMMatrixLookAtLH(XMVectorZero(),
+													 XMVectorSet(0.0f, 0.0f, 1.0f, 0.0f),
+													 XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f)) *
+									XMMatrixPerspectiveFovLH(XM_PI / 3.0f, aspect, 0.1f, 200.0f);
+	double rasterMs = 0.0;
+	long long testTime = 0;
+	for (unsigned int frame = 0; frame < frames; ++frame) {
+		culler.begin(viewProjection);
+		for (const auto& world : occluderWorlds) {
+			culler.addOccluder(cube, sizeof(XMFLOAT3), 8, cubeIndices, 36, world);
+		}
+		culler.rasterize();
+		rasterMs += culler.getStats().rasterTimeMs;
+
+		const long long start = FrameClock::now();
+		for (const auto& box : testBoxes) {
+			culler.isVisible(box);
+		}
+		testTime += FrameClock::now() - start;
+	}
+
+	const OcclusionStats& stats = culler.getStats();
+	result.occluderTriangles = stats.occluderTriangles;
+	result.rasterizedTriangles = stats.rasterizedTriangles;
+	result.tested = stats.tested;
+	result.occluded = stats.occluded;
+	result.rasterTimeMs = rasterMs / frames;
+	result.testNsPerBox = boxes > 0 ? static_cast<double>(testTime) / frames / boxes : 0.0;
+	return result;
+}
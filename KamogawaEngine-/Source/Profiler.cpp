@@ -0,0 +1,215 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+	thread_local ProfileThreadBuffer* t_threadBuffer = nullptr;
+
+	/**
+	 * @brief Compara nombres de bloques: primero por puntero y, si difieren, por contenido
+	 *        (el mismo literal puede tener direcciones distintas en cada unidad de compilación).
+	 */
+	bool
+	sameName(const char* a, const char* b) {
+		return a == b || (a && b && strcmp(a, b) == 0);
+	}
+
+	/**
+	 * @brief Escribe una cadena JSON escapando comillas y barras.
+	 */
+	void
+	writeJsonString(std::ofstream& file, const char* text) {
+		file << '"';
+		for (const char* c = text ? text : ""; *c; ++c) {
+			if (*c == '"' || *c == '\\') {
+				file << '\\';
+			}
+			file << *c;
+		}
+		file << '"';
+	}
+}
+
+Profiler&
+Profiler::getInstance() {
+	static Profiler instance;
+	return instance;
+}
+
+Profiler::Profiler() {
+	m_startTicks = now();
+	m_startTime = std::chrono::steady_clock::now();
+	m_frameStart = m_startTicks;
+}
+
+ProfileThreadBuffer&
+Profiler::getThreadBuffer() {
+	if (!t_threadBuffer) {
+		std::lock_guard<std::mutex> lock(m_registryMutex);
+		m_buffers.push_back(std::unique_ptr<ProfileThreadBuffer>(new ProfileThreadBuffer()));
+		t_threadBuffer = m_buffers.back().get();
+		t_threadBuffer->m_thread = static_cast<unsigned int>(m_buffers.size() - 1);
+		t_threadBuffer->m_name = "Thread " + std::to_string(t_threadBuffer->m_thread);
+	}
+	return *t_threadBuffer;
+}
+
+void
+Profiler::setThreadName(const char* name) {
+	ProfileThreadBuffer& buffer = getThreadBuffer();
+	std::lock_guard<std::mutex> lock(m_registryMutex);
+	buffer.m_name = name ? name : "";
+}
+
+void
+Profiler::beginFrame() {
+	m_frameStart = now();
+}
+
+void
+Profiler::calibrate() {
+	std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - m_startTime;
+	unsigned long long ticks = now() - m_startTicks;
+	// Con menos de 1 ms la medición es demasiado ruidosa
+	if (elapsed.count() >= 1.0 && ticks > 0) {
+		m_ticksPerMs = ticks / elapsed.count();
+	}
+}
+
+void
+Profiler::endFrame() {
+	const unsigned long long frameEnd = now();
+	calibrate();
+	m_frameTimeMs = ticksToMs(frameEnd - m_frameStart);
+
+	// 01. Recoger los eventos de cada hilo
+	m_frameEvents.clear();
+	m_summary.clear();
+	std::vector<ProfileThreadBuffer*> buffers;
+	{
+		std::lock_guard<std::mutex> lock(m_registryMutex);
+		for (auto& buffer : m_buffers) {
+			buffers.push_back(buffer.get());
+		}
+	}
+
+	for (ProfileThreadBuffer* buffer : buffers) {
+		const unsigned int read = buffer->m_read.load(std::memory_order_relaxed);
+		const unsigned int write = buffer->m_write.load(std::memory_order_acquire);
+		for (unsigned int i = read; i != write; ++i) {
+			const ProfileEvent& event = buffer->m_events[i & (ProfileThreadBuffer::kCapacity - 1)];
+			m_frameEvents.push_back(event);
+
+			// 02. Tiempo propio: los hijos terminan antes que el padre, así que al llegar el padre
+			//     su nivel inferior ya acumuló la duración de todos sus hijos directos
+			const unsigned long long duration = event.end - event.start;
+			unsigned long long childTicks = 0;
+			if (event.depth < ProfileThreadBuffer::kMaxDepth) {
+				childTicks = buffer->m_childTicks[event.depth + 1];
+				buffer->m_childTicks[event.depth + 1] = 0;
+				buffer->m_childTicks[event.depth] += duration;
+			}
+			addToSummary(event, duration > childTicks ? duration - childTicks : 0);
+		}
+		buffer->m_read.store(write, std::memory_order_release);
+	}
+
+	std::sort(m_summary.begin(), m_summary.end(),
+		[](const ProfileSummaryEntry& a, const ProfileSummaryEntry& b) {
+			if (a.thread != b.thread) {
+				return a.thread < b.thread;
+			}
+			return a.firstStart != b.firstStart ? a.firstStart < b.firstStart : a.depth < b.depth;
+		});
+
+	// 03. Guardar para la traza
+	if (m_capturing) {
+		size_t room = m_maxCaptureEvents > m_captureEvents.size() ? m_maxCaptureEvents - m_captureEvents.size() : 0;
+		size_t count = std::min(room, m_frameEvents.size());
+		m_captureEvents.insert(m_captureEvents.end(), m_frameEvents.begin(), m_frameEvents.begin() + count);
+	}
+}
+
+void
+Profiler::addToSummary(const ProfileEvent& event, unsigned long long selfTicks) {
+	const double totalMs = ticksToMs(event.end - event.start);
+	const double selfMs = ticksToMs(selfTicks);
+
+	for (ProfileSummaryEntry& entry : m_summary) {
+		if (entry.depth == event.depth && entry.thread == event.thread && sameName(entry.name, event.name)) {
+			entry.calls++;
+			entry.totalMs += totalMs;
+			entry.selfMs += selfMs;
+			entry.maxMs = std::max(entry.maxMs, totalMs);
+			entry.firstStart = std::min(entry.firstStart, event.start);
+			return;
+		}
+	}
+
+	ProfileSummaryEntry entry;
+	entry.name = event.name;
+	entry.depth = event.depth;
+	entry.thread = event.thread;
+	entry.calls = 1;
+	entry.totalMs = totalMs;
+	entry.selfMs = selfMs;
+	entry.maxMs = totalMs;
+	entry.firstStart = event.start;
+	m_summary.push_back(entry);
+}
+
+unsigned int
+Profiler::getDroppedEvents() const {
+	unsigned int dropped = 0;
+	for (const auto& buffer : m_buffers) {
+		dropped += buffer->m_dropped.load(std::memory_order_relaxed);
+	}
+	return dropped;
+}
+
+void
+Profiler::beginCapture(size_t maxEvents) {
+	m_captureEvents.clear();
+	m_captureEvents.reserve(std::min<size_t>(maxEvents, 1 << 16));
+	m_maxCaptureEvents = maxEvents;
+	m_capturing = true;
+}
+
+bool
+Profiler::endCapture(const std::string& path) {
+	m_capturing = false;
+	calibrate();
+
+	std::ofstream file(path);
+	if (!file) {
+		m_captureEvents.clear();
+		return false;
+	}
+
+	// Eventos completos ("X") en microsegundos desde el inicio del profiler
+	file << "{\"traceEvents\":[\n";
+	bool first = true;
+	{
+		std::lock_guard<std::mutex> lock(m_registryMutex);
+		for (const auto& buffer : m_buffers) {
+			file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+				 << buffer->m_thread << ",\"args\":{\"name\":";
+			writeJsonString(file, buffer->m_name.c_str());
+			file << "}}";
+			first = false;
+		}
+	}
+	for (const ProfileEvent& event : m_captureEvents) {
+		file << (first ? "" : ",\n") << "{\"name\":";
+		writeJsonString(file, event.name);
+		file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+			 << ",\"ts\":" << ticksToMs(event.start - m_startTicks) * 1000.0
+			 << ",\"dur\":" << ticksToMs(event.end - event.start) * 1000.0 << "}";
+		first = false;
+	}
+	file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+	m_captureEvents.clear();
+	return true;
+}
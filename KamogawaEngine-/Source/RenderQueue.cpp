@@ -0,0 +1,414 @@
+#include "RenderQueue.h"
+#include "Device.h"
+#include "DeviceContext.h"
+#include "ShaderProgram.h"
+#include "SamplerState.h"
+#include "Texture.h"
+#include "CommandListPool.h"
+#include <algorithm>
+#include <chrono>
+
+namespace {
+	const unsigned int kDepthBits = 20;
+	const unsigned int kDepthMax = (1u << kDepthBits) - 1;
+}
+
+void
+RenderQueue::begin(const XMMATRIX& view, float farPlane) {
+	m_packets.clear();
+	m_view = view;
+	m_farPlane = farPlane > 0.0f ? farPlane : 1.0f;
+	m_stats = RenderQueueStats();
+}
+
+unsigned long long
+RenderQueue::makeSortKey(RenderPass pass, const DrawPacket& packet, const XMFLOAT3& worldPosition) {
+	unsigned long long passBits = static_cast<unsigned long long>(pass) & 0xF;
+	unsigned long long shader = resourceId(packet.shader) & 0xFF;
+	unsigned long long texture = resourceId(packet.texture ? packet.texture->m_textureFromImg : nullptr) & 0xFFFF;
+	unsigned long long buffer = resourceId(packet.vertexBuffer ? packet.vertexBuffer->getBuffer() : nullptr) & 0xFFFF;
+	unsigned long long depth = quantizeDepth(worldPosition);
+
+	if (pass == TRANSPARENT_PASS) {
+		// De atrás hacia adelante: la profundidad manda sobre el estado
+		unsigned long long backToFront = kDepthMax - depth;
+		return (passBits << 60) | (backToFront << 40) | (shader << 32) | (texture << 16) | buffer;
+	}
+
+	// De adelante hacia atrás dentro de cada grupo de estado
+	return (passBits << 60) | (shader << 52) | (texture << 36) | (buffer << 20) | depth;
+}
+
+void
+RenderQueue::submit(const DrawPacket& packet) {
+	// Paquetes sin geometría no generan llamadas de dibujo
+	if (packet.indexCount == 0 || !packet.vertexBuffer || !packet.indexBuffer) {
+		return;
+	}
+	m_packets.push_back(packet);
+	++m_stats.packets;
+	m_stats.trianglesSubmitted += packet.indexCount / 3;
+}
+
+void
+RenderQueue::cull(const XMMATRIX& viewProjection) {
+	m_culler.setFrustum(viewProjection);
+	m_culler.clear();
+	for (const DrawPacket& packet : m_packets) {
+		m_culler.add(packet.boundsCenter, packet.boundsExtents);
+	}
+	m_culler.cull();
+
+	// Compactar conservando el orden de envío
+	size_t kept = 0;
+	for (size_t i = 0; i < m_packets.size(); ++i) {
+		if (!m_packets[i].hasBounds || m_culler.isVisible(static_cast<unsigned int>(i))) {
+			if (kept != i) {
+				m_packets[kept] = m_packets[i];
+			}
+			++kept;
+		}
+		else {
+			m_stats.trianglesCulled += m_packets[i].indexCount / 3;
+		}
+	}
+	m_stats.culled += static_cast<unsigned int>(m_packets.size() - kept);
+	m_stats.cullTimeMs = m_culler.getStats().cullTimeMs;
+	m_packets.resize(kept);
+	m_order.clear();
+}
+
+void
+RenderQueue::sort() {
+	auto start = std::chrono::high_resolution_clock::now();
+
+	const size_t count = m_packets.size();
+	m_keys.resize(count);
+	m_order.resize(count);
+	m_scratchKeys.resize(count);
+	m_scratchOrder.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		m_keys[i] = m_packets[i].sortKey;
+		m_order[i] = static_cast<unsigned int>(i);
+	}
+
+	// Radix sort LSD de 8 bits; se saltan los bytes en que todas las llaves coinciden
+	for (unsigned int shift = 0; shift < 64 && count > 1; shift += 8) {
+		unsigned int histogram[256] = {};
+		for (size_t i = 0; i < count; ++i) {
+			++histogram[(m_keys[i] >> shift) & 0xFF];
+		}
+		if (histogram[(m_keys[0] >> shift) & 0xFF] == count) {
+			continue;
+		}
+
+		unsigned int offset = 0;
+		for (unsigned int bucket = 0; bucket < 256; ++bucket) {
+			unsigned int bucketCount = histogram[bucket];
+			histogram[bucket] = offset;
+			offset += bucketCount;
+		}
+		for (size_t i = 0; i < count; ++i) {
+			unsigned int destination = histogram[(m_keys[i] >> shift) & 0xFF]++;
+			m_scratchKeys[destination] = m_keys[i];
+			m_scratchOrder[destination] = m_order[i];
+		}
+		m_keys.swap(m_scratchKeys);
+		m_order.swap(m_scratchOrder);
+	}
+
+	auto end = std::chrono::high_resolution_clock::now();
+	m_stats.sortTimeMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void
+RenderQueue::flush(DeviceContext& deviceContext) {
+	if (m_order.size() != m_packets.size()) {
+		sort();
+	}
+
+	uploadConstants(deviceContext);
+	buildInstances(deviceContext);
+
+	// Un lote se dibuja completo en la posición de su primer paquete en orden de llave
+	m_drawList.clear();
+	for (unsigned int index : m_order) {
+		DrawItem item;
+		item.packet = index;
+		item.batch = m_batcher.batchOf(index);
+		if (item.batch != InstanceBatcher::kNoBatch) {
+			if (m_batchDrawn[item.batch]) {
+				continue;
+			}
+			m_batchDrawn[item.batch] = true;
+		}
+		m_drawList.push_back(item);
+	}
+
+	// Con hilos de grabación, la lista se parte en rangos contiguos que se reproducen en orden
+	unsigned int rangeCount = 1;
+	if (m_commandLists) {
+		unsigned int rangesByDraws = static_cast<unsigned int>(m_drawList.size()) / kMinDrawsPerRange;
+		rangeCount = std::max(1u, std::min(m_commandLists->getMaxRanges(), rangesByDraws));
+	}
+	m_rangeStates.assign(rangeCount, BindState());
+
+	if (rangeCount > 1) {
+		m_commandLists->dispatch(deviceContext, rangeCount,
+			[this, rangeCount](DeviceContext& rangeContext, unsigned int range) {
+				drawRange(rangeContext, range, rangeCount);
+			});
+	}
+	else {
+		drawRange(deviceContext, 0, 1);
+	}
+
+	for (const BindState& state : m_rangeStates) {
+		m_stats.draws += state.draws;
+		m_stats.instancedDraws += state.instancedDraws;
+		m_stats.instances += state.instances;
+		m_stats.vertexBytes += state.vertexBytes;
+		m_stats.bindsIssued += state.bindsIssued;
+		m_stats.bindsSkipped += state.bindsSkipped;
+		m_stats.vertexBufferBinds += state.vertexBufferBinds;
+		m_stats.indexBufferBinds += state.indexBufferBinds;
+	}
+
+	m_packets.clear();
+	m_order.clear();
+}
+
+void
+RenderQueue::drawRange(DeviceContext& deviceContext, unsigned int range, unsigned int rangeCount) {
+	const size_t count = m_drawList.size();
+	const size_t first = count * range / rangeCount;
+	const size_t last = count * (range + 1) / rangeCount;
+	BindState& state = m_rangeStates[range];
+
+	// Los contextos diferidos no heredan el instance buffer enlazado en buildInstances()
+	if (range > 0 && !m_batcher.getTransforms().empty()) {
+		m_instanceBuffer.render(deviceContext, 1, 1);
+	}
+	deviceContext.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+	for (size_t i = first; i < last; ++i) {
+		const DrawItem& item = m_drawList[i];
+		const DrawPacket& packet = m_packets[item.packet];
+
+		if (item.batch != InstanceBatcher::kNoBatch) {
+			const InstanceBatch& batch = m_batcher.getBatches()[item.batch];
+			bindPacket(deviceContext, item.packet, m_instancedShader, state);
+			deviceContext.DrawIndexedInstanced(packet.indexCount,
+											   batch.instanceCount,
+											   packet.startIndex,
+											   packet.baseVertex,
+											   batch.firstInstance);
+			++state.draws;
+			++state.instancedDraws;
+			state.instances += batch.instanceCount;
+			state.vertexBytes += static_cast<unsigned long long>(packet.indexCount) * batch.instanceCount *
+								 packet.vertexBuffer->getStride();
+			continue;
+		}
+
+		bindPacket(deviceContext, item.packet, packet.shader, state);
+		deviceContext.DrawIndexed(packet.indexCount, packet.startIndex, packet.baseVertex);
+		++state.draws;
+		state.vertexBytes += static_cast<unsigned long long>(packet.indexCount) * packet.vertexBuffer->getStride();
+	}
+}
+
+HRESULT
+RenderQueue::initInstancing(Device& device, ShaderProgram& instancedShader, unsigned int maxInstances) {
+	HRESULT hr = m_instanceBuffer.init(device,
+									   sizeof(InstanceTransform),
+									   maxInstances,
+									   D3D11_BIND_VERTEX_BUFFER);
+	if (FAILED(hr)) {
+		ERROR("RenderQueue", "initInstancing", "Failed to create instance buffer");
+		return hr;
+	}
+
+	m_instancedShader = &instancedShader;
+	m_maxInstances = maxInstances;
+	return S_OK;
+}
+
+void
+RenderQueue::destroy() {
+	m_instanceBuffer.destroy();
+	m_instancedShader = nullptr;
+	m_maxInstances = 0;
+}
+
+void
+RenderQueue::buildInstances(DeviceContext& deviceContext) {
+	m_batcher.clear();
+	if (!m_instancedShader) {
+		m_batchDrawn.clear();
+		return;
+	}
+
+	for (unsigned int i = 0; i < m_packets.size(); ++i) {
+		const DrawPacket& packet = m_packets[i];
+		if (!packet.instanceable) {
+			continue;
+		}
+
+		InstanceKey key;
+		key.shader = packet.shader;
+		key.material = packet.texture ? packet.texture->m_textureFromImg : nullptr;
+		key.sampler = packet.sampler ? packet.sampler->getSamplerState() : nullptr;
+		key.vertexBuffer = packet.vertexBuffer->getBuffer();
+		key.indexBuffer = packet.indexBuffer->getBuffer();
+		key.indexCount = packet.indexCount;
+		key.startIndex = packet.startIndex;
+		key.baseVertex = packet.baseVertex;
+		m_batcher.add(key, &packet.world._11, i);
+	}
+
+	// Un solo paquete no gana nada con el instanciado
+	m_batcher.build(2, m_maxInstances);
+	m_batchDrawn.assign(m_batcher.getBatches().size(), false);
+
+	const auto& transforms = m_batcher.getTransforms();
+	if (!transforms.empty()) {
+		m_instanceBuffer.write(deviceContext,
+							   transforms.data(),
+							   static_cast<unsigned int>(transforms.size() * sizeof(InstanceTransform)));
+		m_instanceBuffer.render(deviceContext, 1, 1);
+	}
+}
+
+void
+RenderQueue::uploadConstants(DeviceContext& deviceContext) {
+	// Los paquetes de un mismo objeto llegan seguidos y comparten sus constantes
+	const bool useRing = m_constantRing && m_constantRing->isSupported();
+	m_constantAllocations.assign(useRing ? m_packets.size() : 0, ConstantAllocation());
+
+	// Sin anillo, o desde el paquete en que el anillo falló, cada paquete escribe su propio buffer
+	auto uploadDirect = [this, &deviceContext](unsigned int first) {
+		const void* uploaded = nullptr;
+		for (unsigned int i = first; i < m_packets.size(); ++i) {
+			const DrawPacket& packet = m_packets[i];
+			if (packet.constants && packet.constantBuffer && packet.constants != uploaded) {
+				packet.constantBuffer->update(deviceContext, 0, nullptr, packet.constants, 0, 0);
+				uploaded = packet.constants;
+			}
+		}
+	};
+
+	if (!useRing || FAILED(m_constantRing->map(deviceContext))) {
+		uploadDirect(0);
+		return;
+	}
+
+	const void* uploaded = nullptr;
+	ConstantAllocation allocation;
+	unsigned int i = 0;
+	for (; i < m_packets.size(); ++i) {
+		const DrawPacket& packet = m_packets[i];
+		if (!packet.constants) {
+			continue;
+		}
+		if (packet.constants != uploaded) {
+			if (!m_constantRing->allocate(deviceContext, packet.constantSize, allocation)) {
+				break;
+			}
+			memcpy(allocation.data, packet.constants, packet.constantSize);
+			uploaded = packet.constants;
+		}
+		m_constantAllocations[i] = allocation;
+	}
+
+	m_constantRing->unmap(deviceContext);
+
+	// El anillo se llenó: el resto del frame usa el buffer de cada paquete
+	if (i < m_packets.size()) {
+		uploadDirect(i);
+	}
+}
+
+void
+RenderQueue::bindPacket(DeviceContext& deviceContext,
+						unsigned int index,
+						ShaderProgram* shader,
+						BindState& state) {
+	const DrawPacket& packet = m_packets[index];
+
+	if (shader && state.countBind(shader != state.boundShader)) {
+		shader->render(deviceContext);
+		state.boundShader = shader;
+		state.boundInputLayout = shader->getInputLayout(nullptr).m_inputLayout;
+	}
+
+	// Mallas en otro formato de vértice (p. ej. cuantizadas) usan su propio layout del mismo shader
+	if (state.boundShader) {
+		InputLayout& layout = state.boundShader->getInputLayout(packet.vertexFormat);
+		if (state.countBind(layout.m_inputLayout != state.boundInputLayout)) {
+			layout.render(deviceContext);
+			state.boundInputLayout = layout.m_inputLayout;
+		}
+	}
+
+	if (packet.sampler && state.countBind(packet.sampler->getSamplerState() != state.boundSampler)) {
+		packet.sampler->render(deviceContext, 0, 1);
+		state.boundSampler = packet.sampler->getSamplerState();
+	}
+
+	if (packet.texture && state.countBind(packet.texture->m_textureFromImg != state.boundTexture)) {
+		packet.texture->render(deviceContext, 0, 1);
+		state.boundTexture = packet.texture->m_textureFromImg;
+	}
+
+	if (state.countBind(packet.vertexBuffer->getBuffer() != state.boundVertexBuffer)) {
+		packet.vertexBuffer->render(deviceContext, 0, 1);
+		state.boundVertexBuffer = packet.vertexBuffer->getBuffer();
+		++state.vertexBufferBinds;
+	}
+
+	if (state.countBind(packet.indexBuffer->getBuffer() != state.boundIndexBuffer)) {
+		packet.indexBuffer->render(deviceContext, 0, 1, false, packet.indexFormat);
+		state.boundIndexBuffer = packet.indexBuffer->getBuffer();
+		++state.indexBufferBinds;
+	}
+
+	if (index < m_constantAllocations.size() && m_constantAllocations[index].numConstants > 0) {
+		const ConstantAllocation& allocation = m_constantAllocations[index];
+		if (state.countBind(state.boundConstantBuffer != nullptr || allocation.offset != state.boundConstantOffset)) {
+			m_constantRing->render(deviceContext, allocation, 2, true);
+			state.boundConstantBuffer = nullptr;
+			state.boundConstantOffset = allocation.offset;
+		}
+	}
+	else if (packet.constantBuffer && state.countBind(packet.constantBuffer->getBuffer() != state.boundConstantBuffer)) {
+		packet.constantBuffer->render(deviceContext, 2, 1, true);
+		state.boundConstantBuffer = packet.constantBuffer->getBuffer();
+		state.boundConstantOffset = ~0u;
+	}
+}
+
+unsigned int
+RenderQueue::resourceId(const void* resource) {
+	if (!resource) {
+		return 0;
+	}
+
+	auto it = m_resourceIds.find(resource);
+	if (it != m_resourceIds.end()) {
+		return it->second;
+	}
+
+	unsigned int id = static_cast<unsigned int>(m_resourceIds.size()) + 1;
+	m_resourceIds[resource] = id;
+	return id;
+}
+
+unsigned int
+RenderQueue::quantizeDepth(const XMFLOAT3& worldPosition) const {
+	XMVECTOR viewPosition = XMVector3TransformCoord(XMLoadFloat3(&worldPosition), m_view);
+	float depth = XMVectorGetZ(viewPosition) / m_farPlane;
+	if (depth < 0.0f) depth = 0.0f;
+	if (depth > 1.0f) depth = 1.0f;
+	return static_cast<unsigned int>(depth * kDepthMax);
+}
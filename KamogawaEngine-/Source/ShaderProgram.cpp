@@ -46,6 +46,10 @@ void ShaderProgram::render(DeviceContext& deviceContext) {
 void ShaderProgram::destroy(){
 	SAFE_RELEASE(m_VertexShader);
 	m_inputLayout.destroy();
+	for (auto& formatLayout : m_formatLayouts) {
+		formatLayout.second.destroy();
+	}
+	m_formatLayouts.clear();
 	SAFE_RELEASE(m_PixelShader);
 	SAFE_RELEASE(m_vertexShaderData);
 	SAFE_RELEASE(m_pixelShaderData);
@@ -58,8 +62,8 @@ ShaderProgram::CreateInputLayout(Device& device, std::vector<D3D11_INPUT_ELEMENT
 		return E_POINTER;
 	}
 
+	// El bytecode se conserva: addInputLayout() lo necesita para validar cada formato
 	HRESULT hr = m_inputLayout.init(device, Layout, m_vertexShaderData);
-	SAFE_RELEASE(m_vertexShaderData);
 
 	if (FAILED(hr)) {
 		ERROR("ShaderProgram", "CreateInputLayout", "Failed to create InputLayout");
@@ -68,6 +72,48 @@ ShaderProgram::CreateInputLayout(Device& device, std::vector<D3D11_INPUT_ELEMENT
 	return hr;
 }
 
+HRESULT
+ShaderProgram::addInputLayout(Device& device,
+							  const VertexFormat& format,
+							  const std::vector<D3D11_INPUT_ELEMENT_DESC>& extraElements) {
+	for (const auto& formatLayout : m_formatLayouts) {
+		if (formatLayout.first == format) {
+			return S_OK;
+		}
+	}
+
+	if (!m_vertexShaderData) {
+		ERROR("ShaderProgram", "addInputLayout", "VertexShaderData is nullptr");
+		return E_POINTER;
+	}
+
+	std::vector<D3D11_INPUT_ELEMENT_DESC> layout;
+	format.buildInputLayout(layout);
+	layout.insert(layout.end(), extraElements.begin(), extraElements.end());
+
+	InputLayout inputLayout;
+	HRESULT hr = inputLayout.init(device, layout, m_vertexShaderData);
+	if (FAILED(hr)) {
+		ERROR("ShaderProgram", "addInputLayout", "Failed to create InputLayout");
+		return hr;
+	}
+
+	m_formatLayouts.push_back(std::make_pair(format, inputLayout));
+	return S_OK;
+}
+
+InputLayout&
+ShaderProgram::getInputLayout(const VertexFormat* format) {
+	if (format) {
+		for (auto& formatLayout : m_formatLayouts) {
+			if (formatLayout.first == *format) {
+				return formatLayout.second;
+			}
+		}
+	}
+	return m_inputLayout;
+}
+
 HRESULT
 ShaderProgram::CreateShader(Device& device, ShaderType type){
 	HRESULT hr = S_OK;
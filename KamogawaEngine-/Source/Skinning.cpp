@@ -0,0 +1,575 @@
+#include "Skinning.h"
+#include "MeshComponent.h"
+#include "FrameClock.h"
+#include "CpuFeatures.h"
+#include <immintrin.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+	constexpr float kWeightScale = 1.0f / 255.0f;
+
+	/**
+	 * @brief Cuaternión de la parte de rotación de una matriz afín (se descarta la escala).
+	 */
+	void
+	rotationFromMatrix(const XMFLOAT4X4& m, float* q) {
+		// Normalizar las filas quita la escala de la matriz
+		float r[3][3];
+		for (int row = 0; row < 3; ++row) {
+			const float length = std::sqrt(m.m[row][0] * m.m[row][0] + m.m[row][1] * m.m[row][1] + m.m[row][2] * m.m[row][2]);
+			const float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+			for (int column = 0; column < 3; ++column) {
+				r[row][column] = m.m[row][column] * inverse;
+			}
+		}
+
+		// Convención de vector fila: la matriz de rotación por columnas es la transpuesta
+		const float trace = r[0][0] + r[1][1] + r[2][2];
+		if (trace > 0.0f) {
+			const float s = std::sqrt(trace + 1.0f) * 2.0f;
+			q[3] = 0.25f * s;
+			q[0] = (r[1][2] - r[2][1]) / s;
+			q[1] = (r[2][0] - r[0][2]) / s;
+			q[2] = (r[0][1] - r[1][0]) / s;
+		}
+		else if (r[0][0] > r[1][1] && r[0][0] > r[2][2]) {
+			const float s = std::sqrt(1.0f + r[0][0] - r[1][1] - r[2][2]) * 2.0f;
+			q[3] = (r[1][2] - r[2][1]) / s;
+			q[0] = 0.25f * s;
+			q[1] = (r[1][0] + r[0][1]) / s;
+			q[2] = (r[2][0] + r[0][2]) / s;
+		}
+		else if (r[1][1] > r[2][2]) {
+			const float s = std::sqrt(1.0f + r[1][1] - r[0][0] - r[2][2]) * 2.0f;
+			q[3] = (r[2][0] - r[0][2]) / s;
+			q[0] = (r[1][0] + r[0][1]) / s;
+			q[1] = 0.25f * s;
+			q[2] = (r[2][1] + r[1][2]) / s;
+		}
+		else {
+			const float s = std::sqrt(1.0f + r[2][2] - r[0][0] - r[1][1]) * 2.0f;
+			q[3] = (r[0][1] - r[1][0]) / s;
+			q[0] = (r[2][0] + r[0][2]) / s;
+			q[1] = (r[2][1] + r[1][2]) / s;
+			q[2] = 0.25f * s;
+		}
+	}
+
+	/**
+	 * @brief Aplica un cuaternión dual normalizado a una posición.
+	 */
+	XMFLOAT3
+	transformDualQuaternion(const float* real, const float* dual, const XMFLOAT3& p) {
+		// p' = p + 2 r x (r x p + w p) + 2 (w d - dw r + r x d)
+		const float cx = real[1] * p.z - real[2] * p.y + real[3] * p.x;
+		const float cy = real[2] * p.x - real[0] * p.z + real[3] * p.y;
+		const float cz = real[0] * p.y - real[1] * p.x + real[3] * p.z;
+		const float tx = real[3] * dual[0] - dual[3] * real[0] + real[1] * dual[2] - real[2] * dual[1];
+		const float ty = real[3] * dual[1] - dual[3] * real[1] + real[2] * dual[0] - real[0] * dual[2];
+		const float tz = real[3] * dual[2] - dual[3] * real[2] + real[0] * dual[1] - real[1] * dual[0];
+		return XMFLOAT3(p.x + 2.0f * (real[1] * cz - real[2] * cy + tx),
+						p.y + 2.0f * (real[2] * cx - real[0] * cz + ty),
+						p.z + 2.0f * (real[0] * cy - real[1] * cx + tz));
+	}
+
+	/**
+	 * @brief Rota la normal y la tangente de un vértice con la parte 3x3 de una matriz de
+	 *        skinning mezclada (por columnas) y las renormaliza.
+	 */
+	void
+	skinDirections(const float (&columns)[3][4], SimpleVertex& vertex) {
+		XMFLOAT3* directions[2] = { &vertex.Normal, reinterpret_cast<XMFLOAT3*>(&vertex.Tangent) };
+		for (XMFLOAT3* direction : directions) {
+			const XMFLOAT3 d = *direction;
+			float result[3];
+			for (int row = 0; row < 3; ++row) {
+				result[row] = columns[row][0] * d.x + columns[row][1] * d.y + columns[row][2] * d.z;
+			}
+			const float length = std::sqrt(result[0] * result[0] + result[1] * result[1] + result[2] * result[2]);
+			const float inverse = length > 0.0f ? 1.0f / length : 0.0f;
+			*direction = XMFLOAT3(result[0] * inverse, result[1] * inverse, result[2] * inverse);
+		}
+	}
+
+	/**
+	 * @brief Signo que deja a un cuaternión en el mismo hemisferio que el de referencia.
+	 */
+	float
+	hemisphereSign(const float* reference, const float* real) {
+		const float dot = reference[0] * real[0] + reference[1] * real[1] + reference[2] * real[2] + reference[3] * real[3];
+		return dot < 0.0f ? -1.0f : 1.0f;
+	}
+
+	void
+	skinLinearAVX2(const SimpleVertex* input, const VertexSkin* skin, unsigned int count,
+				   const SkinMatrix* matrices, SimpleVertex* output) {
+		for (unsigned int i = 0; i < count; ++i) {
+			const VertexSkin& influences = skin[i];
+			output[i] = input[i];
+			if (influences.weights[0] == 0) {
+				continue;
+			}
+
+			// 01. Mezclar las matrices (las influencias vienen de mayor a menor peso)
+			__m256 columns01 = _mm256_setzero_ps();
+			__m128 column2 = _mm_setzero_ps();
+			for (int k = 0; k < 4 && influences.weights[k] != 0; ++k) {
+				const SkinMatrix& matrix = matrices[influences.bones[k]];
+				const float weight = influences.weights[k] * kWeightScale;
+				columns01 = _mm256_add_ps(columns01, _mm256_mul_ps(_mm256_set1_ps(weight), _mm256_loadu_ps(matrix.rows[0])));
+				column2 = _mm_add_ps(column2, _mm_mul_ps(_mm_set1_ps(weight), _mm_load_ps(matrix.rows[2])));
+			}
+
+			// 02. Producto punto de cada columna con (x, y, z, 1)
+			const XMFLOAT3& p = input[i].Pos;
+			const __m128 position = _mm_setr_ps(p.x, p.y, p.z, 1.0f);
+			__m256 products = _mm256_mul_ps(columns01, _mm256_set_m128(position, position));
+			products = _mm256_hadd_ps(products, products);
+			products = _mm256_hadd_ps(products, products);
+			__m128 productZ = _mm_mul_ps(column2, position);
+			productZ = _mm_hadd_ps(productZ, productZ);
+			productZ = _mm_hadd_ps(productZ, productZ);
+
+			output[i].Pos = XMFLOAT3(_mm256_cvtss_f32(products),
+									 _mm_cvtss_f32(_mm256_extractf128_ps(products, 1)),
+									 _mm_cvtss_f32(productZ));
+
+			// 03. Normal y tangente con la parte 3x3
+			alignas(32) float columns[3][4];
+			_mm256_store_ps(columns[0], columns01);
+			_mm_store_ps(columns[2], column2);
+			skinDirections(columns, output[i]);
+		}
+	}
+
+	void
+	skinLinearScalar(const SimpleVertex* input, const VertexSkin* skin, unsigned int count,
+					 const SkinMatrix* matrices, SimpleVertex* output) {
+		for (unsigned int i = 0; i < count; ++i) {
+			const VertexSkin& influences = skin[i];
+			output[i] = input[i];
+			if (influences.weights[0] == 0) {
+				continue;
+			}
+
+			float blended[3][4] = {};
+			for (int k = 0; k < 4 && influences.weights[k] != 0; ++k) {
+				const SkinMatrix& matrix = matrices[influences.bones[k]];
+				const float weight = influences.weights[k] * kWeightScale;
+				for (int row = 0; row < 3; ++row) {
+					for (int column = 0; column < 4; ++column) {
+						blended[row][column] += weight * matrix.rows[row][column];
+					}
+				}
+			}
+
+			const XMFLOAT3& p = input[i].Pos;
+			float result[3];
+			for (int row = 0; row < 3; ++row) {
+				result[row] = blended[row][0] * p.x + blended[row][1] * p.y + blended[row][2] * p.z + blended[row][3];
+			}
+			output[i].Pos = XMFLOAT3(result[0], result[1], result[2]);
+			skinDirections(blended, output[i]);
+		}
+	}
+
+	void
+	skinDualQuaternionAVX2(const SimpleVertex* input, const VertexSkin* skin, unsigned int count,
+						   const SkinDualQuaternion* dualQuaternions, SimpleVertex* output) {
+		alignas(32) float blended[8];
+		for (unsigned int i = 0; i < count; ++i) {
+			const VertexSkin& influences = skin[i];
+			output[i] = input[i];
+			if (influences.weights[0] == 0) {
+				continue;
+			}
+
+			// 01. Mezclar los cuaterniones duales en el hemisferio del de mayor peso
+			const float* reference = dualQuaternions[influences.bones[0]].real;
+			__m256 sum = _mm256_setzero_ps();
+			for (int k = 0; k < 4 && influences.weights[k] != 0; ++k) {
+				const SkinDualQuaternion& dq = dualQuaternions[influences.bones[k]];
+				const float weight = influences.weights[k] * kWeightScale * hemisphereSign(reference, dq.real);
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_set1_ps(weight), _mm256_load_ps(dq.real)));
+			}
+
+			// 02. Normalizar por la longitud de la parte real
+			const __m128 real = _mm256_castps256_ps128(sum);
+			const __m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(_mm_dp_ps(real, real, 0xFF)));
+			sum = _mm256_mul_ps(sum, _mm256_set_m128(inverse, inverse));
+			_mm256_store_ps(blended, sum);
+
+			output[i].Pos = transformDualQuaternion(blended, blended + 4, input[i].Pos);
+
+			// Normal y tangente solo rotan: parte dual nula
+			const float noTranslation[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			output[i].Normal = transformDualQuaternion(blended, noTranslation, input[i].Normal);
+			const XMFLOAT3 tangent = transformDualQuaternion(blended, noTranslation,
+															 XMFLOAT3(input[i].Tangent.x, input[i].Tangent.y, input[i].Tangent.z));
+			output[i].Tangent = XMFLOAT4(tangent.x, tangent.y, tangent.z, input[i].Tangent.w);
+		}
+	}
+
+	void
+	skinDualQuaternionScalar(const SimpleVertex* input, const VertexSkin* skin, unsigned int count,
+							 const SkinDualQuaternion* dualQuaternions, SimpleVertex* output) {
+		for (unsigned int i = 0; i < count; ++i) {
+			const VertexSkin& influences = skin[i];
+			output[i] = input[i];
+			if (influences.weights[0] == 0) {
+				continue;
+			}
+
+			const float* reference = dualQuaternions[influences.bones[0]].real;
+			float blended[8] = {};
+			for (int k = 0; k < 4 && influences.weights[k] != 0; ++k) {
+				const SkinDualQuaternion& dq = dualQuaternions[influences.bones[k]];
+				const float weight = influences.weights[k] * kWeightScale * hemisphereSign(reference, dq.real);
+				for (int j = 0; j < 4; ++j) {
+					blended[j] += weight * dq.real[j];
+					blended[j + 4] += weight * dq.dual[j];
+				}
+			}
+
+			const float inverse = 1.0f / std::sqrt(blended[0] * blended[0] + blended[1] * blended[1] +
+												   blended[2] * blended[2] + blended[3] * blended[3]);
+			for (float& value : blended) {
+				value *= inverse;
+			}
+			output[i].Pos = transformDualQuaternion(blended, blended + 4, input[i].Pos);
+
+			// Normal y tangente solo rotan: parte dual nula
+			const float noTranslation[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			output[i].Normal = transformDualQuaternion(blended, noTranslation, input[i].Normal);
+			const XMFLOAT3 tangent = transformDualQuaternion(blended, noTranslation,
+															 XMFLOAT3(input[i].Tangent.x, input[i].Tangent.y, input[i].Tangent.z));
+			output[i].Tangent = XMFLOAT4(tangent.x, tangent.y, tangent.z, input[i].Tangent.w);
+		}
+	}
+}
+
+void
+buildSkinTransforms(const Skeleton& skeleton,
+					const PoseSoA& pose,
+					SkinningMethod method,
+					std::vector<XMFLOAT4X4>& model,
+					std::vector<SkinMatrix>& matrices,
+					std::vector<SkinDualQuaternion>& dualQuaternions) {
+	const unsigned int boneCount = skeleton.getBoneCount();
+	model.resize(boneCount);
+	if (method == SKINNING_LINEAR_BLEND) {
+		matrices.resize(boneCount);
+	}
+	else {
+		dualQuaternions.resize(boneCount);
+	}
+
+	const unsigned int poseBones = pose.getBoneCount();
+	for (unsigned int bone = 0; bone < boneCount; ++bone) {
+		// 01. Local a modelo; los padres ya están calculados
+		const BoneTransform local = bone < poseBones ? pose.get(bone) : skeleton.bones[bone].bindPose;
+		XMMATRIX world = XMMatrixScalingFromVector(XMLoadFloat3(&local.scale)) *
+						 XMMatrixRotationQuaternion(XMLoadFloat4(&local.rotation)) *
+						 XMMatrixTranslationFromVector(XMLoadFloat3(&local.translation));
+		const int parent = skeleton.bones[bone].parent;
+		if (parent >= 0) {
+			world = world * XMLoadFloat4x4(&model[parent]);
+		}
+		XMStoreFloat4x4(&model[bone], world);
+
+		// 02. Transformación de skinning: malla a hueso en la pose de enlace y luego a modelo
+		XMFLOAT4X4 skinning;
+		XMStoreFloat4x4(&skinning, XMLoadFloat4x4(&skeleton.bones[bone].inverseBindPose) * world);
+		if (method == SKINNING_LINEAR_BLEND) {
+			SkinMatrix& matrix = matrices[bone];
+			for (int column = 0; column < 3; ++column) {
+				for (int row = 0; row < 4; ++row) {
+					matrix.rows[column][row] = skinning.m[row][column];
+				}
+			}
+		}
+		else {
+			SkinDualQuaternion& dq = dualQuaternions[bone];
+			rotationFromMatrix(skinning, dq.real);
+			const float* r = dq.real;
+			const float t[3] = { skinning._41, skinning._42, skinning._43 };
+			// dual = 0.5 * (t, 0) * real
+			dq.dual[0] = 0.5f * (r[3] * t[0] + t[1] * r[2] - t[2] * r[1]);
+			dq.dual[1] = 0.5f * (r[3] * t[1] + t[2] * r[0] - t[0] * r[2]);
+			dq.dual[2] = 0.5f * (r[3] * t[2] + t[0] * r[1] - t[1] * r[0]);
+			dq.dual[3] = -0.5f * (t[0] * r[0] + t[1] * r[1] + t[2] * r[2]);
+		}
+	}
+}
+
+void
+skinVerticesLinear(const SimpleVertex* input,
+				   const VertexSkin* skin,
+				   unsigned int count,
+				   const SkinMatrix* matrices,
+				   SimpleVertex* output) {
+	if (getCpuFeatures().avx2) {
+		skinLinearAVX2(input, skin, count, matrices, output);
+	}
+	else {
+		skinLinearScalar(input, skin, count, matrices, output);
+	}
+}
+
+void
+skinVerticesDualQuaternion(const SimpleVertex* input,
+						   const VertexSkin* skin,
+						   unsigned int count,
+						   const SkinDualQuaternion* dualQuaternions,
+						   SimpleVertex* output) {
+	if (getCpuFeatures().avx2) {
+		skinDualQuaternionAVX2(input, skin, count, dualQuaternions, output);
+	}
+	else {
+		skinDualQuaternionScalar(input, skin, count, dualQuaternions, output);
+	}
+}
+
+HRESULT
+SkinningSystem::init(unsigned int workerCount) {
+	destroy();
+	m_scratch.resize(workerCount + 1);
+	m_quit = false;
+	m_generation = 0;
+	for (unsigned int thread = 1; thread <= workerCount; ++thread) {
+		m_workers.push_back(std::thread(&SkinningSystem::workerLoop, this, thread));
+	}
+	return S_OK;
+}
+
+void
+SkinningSystem::destroy() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_quit = true;
+	}
+	m_startSignal.notify_all();
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+	m_workers.clear();
+	m_scratch.clear();
+}
+
+void
+SkinningSystem::update(SkinnedCharacter* const* characters, unsigned int count) {
+	PROFILE_SCOPE("SkinningSystem::update");
+	const long long start = FrameClock::now();
+	if (m_scratch.empty()) {
+		m_scratch.resize(1);
+	}
+	m_batch = characters;
+	m_batchSize = count;
+	m_next.store(0, std::memory_order_relaxed);
+	m_vertexCount.store(0, std::memory_order_relaxed);
+
+	// Con pocos personajes no vale la pena despertar a los hilos
+	const bool parallel = !m_workers.empty() && count > 1;
+	if (parallel) {
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_pendingWorkers = static_cast<unsigned int>(m_workers.size());
+			++m_generation;
+		}
+		m_startSignal.notify_all();
+	}
+
+	processBatch(0);
+
+	if (parallel) {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_doneSignal.wait(lock, [this] { return m_pendingWorkers == 0; });
+	}
+
+	m_stats.characters = count;
+	m_stats.vertices = m_vertexCount.load(std::memory_order_relaxed);
+	m_stats.timeMs = (FrameClock::now() - start) / 1.0e6;
+}
+
+void
+SkinningSystem::processBatch(unsigned int thread) {
+	Scratch& scratch = m_scratch[thread];
+	for (;;) {
+		const unsigned int index = m_next.fetch_add(1, std::memory_order_relaxed);
+		if (index >= m_batchSize) {
+			return;
+		}
+		processCharacter(*m_batch[index], scratch);
+	}
+}
+
+void
+SkinningSystem::processCharacter(SkinnedCharacter& character, Scratch& scratch) {
+	if (!character.skeleton || !character.meshes) {
+		return;
+	}
+
+	// 01. Pose local: clip comprimido, clip o pose de enlace
+	const Skeleton& skeleton = *character.skeleton;
+	if (character.compressedClip) {
+		character.compressedClip->sample(character.time, character.loop, character.cursor, scratch.pose);
+	}
+	else if (character.clip) {
+		character.clip->sample(character.time, character.loop, scratch.pose);
+	}
+	else {
+		scratch.pose.resize(skeleton.getBoneCount());
+		for (unsigned int bone = 0; bone < skeleton.getBoneCount(); ++bone) {
+			scratch.pose.set(bone, skeleton.bones[bone].bindPose);
+		}
+	}
+
+	// 02. Jerarquía y transformaciones de skinning
+	buildSkinTransforms(skeleton, scratch.pose, character.method,
+						scratch.model, scratch.matrices, scratch.dualQuaternions);
+
+	// 03. Deformar cada malla con skin
+	const std::vector<MeshComponent>& meshes = *character.meshes;
+	character.vertices.resize(meshes.size());
+	unsigned long long vertexCount = 0;
+	for (size_t i = 0; i < meshes.size(); ++i) {
+		const MeshComponent& mesh = meshes[i];
+		if (mesh.m_skin.empty() || mesh.m_skin.size() != mesh.m_vertex.size()) {
+			continue;
+		}
+		auto& output = character.vertices[i];
+		output.resize(mesh.m_vertex.size());
+		const unsigned int count = static_cast<unsigned int>(mesh.m_vertex.size());
+		if (character.method == SKINNING_LINEAR_BLEND) {
+			skinVerticesLinear(mesh.m_vertex.data(), mesh.m_skin.data(), count, scratch.matrices.data(), output.data());
+		}
+		else {
+			skinVerticesDualQuaternion(mesh.m_vertex.data(), mesh.m_skin.data(), count, scratch.dualQuaternions.data(), output.data());
+		}
+		vertexCount += count;
+	}
+	m_vertexCount.fetch_add(vertexCount, std::memory_order_relaxed);
+}
+
+void
+SkinningSystem::workerLoop(unsigned int thread) {
+	PROFILE_THREAD("Skinning worker");
+	unsigned int seenGeneration = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_startSignal.wait(lock, [&] { return m_quit || m_generation != seenGeneration; });
+			if (m_quit) {
+				return;
+			}
+			seenGeneration = m_generation;
+		}
+
+		processBatch(thread);
+
+		bool last = false;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			last = --m_pendingWorkers == 0;
+		}
+		if (last) {
+			m_doneSignal.notify_one();
+		}
+	}
+}
+
+SkinningBenchmarkResult
+runSkinningBenchmark(SkinningSystem& system, unsigned int characters, unsigned int frames) {
+	constexpr unsigned int kBones = 64;
+	constexpr unsigned int kVertices = 4096;
+	constexpr float kClipSeconds = 2.0f;
+
+	// 01. Esqueleto en árbol binario con huesos de 0.1 unidades
+	Skeleton skeleton;
+	skeleton.bones.resize(kBones);
+	std::vector<XMMATRIX> bindModel(kBones);
+	for (unsigned int bone = 0; bone < kBones; ++bone) {
+		Bone& data = skeleton.bones[bone];
+		data.name = "Bone" + std::to_string(bone);
+		data.parent = bone > 0 ? static_cast<int>((bone - 1) / 2) : -1;
+		data.bindPose.translation = XMFLOAT3(bone % 2 ? 0.05f : -0.05f, 0.1f, 0.0f);
+		const XMMATRIX local = XMMatrixTranslationFromVector(XMLoadFloat3(&data.bindPose.translation));
+		bindModel[bone] = data.parent >= 0 ? local * bindModel[data.parent] : local;
+		XMStoreFloat4x4(&data.inverseBindPose, XMMatrixInverse(nullptr, bindModel[bone]));
+	}
+
+	// 02. Clip con una oscilación distinta por hueso
+	AnimationClip clip;
+	const unsigned int sampleCount = static_cast<unsigned int>(kClipSeconds * 30.0f) + 1;
+	clip.init("Benchmark", kClipSeconds, 30.0f, sampleCount, kBones);
+	for (unsigned int sample = 0; sample < sampleCount; ++sample) {
+		for (unsigned int bone = 0; bone < kBones; ++bone) {
+			BoneTransform transform = skeleton.bones[bone].bindPose;
+			const float angle = 0.5f * std::sin(sample / 30.0f * XM_2PI / kClipSeconds + bone * 0.3f);
+			XMStoreFloat4(&transform.rotation, XMQuaternionRotationRollPitchYaw(angle, angle * 0.5f, 0.0f));
+			clip.setTransform(sample, bone, transform);
+		}
+	}
+
+	// 03. Malla con 4 influencias aleatorias por vértice (semilla fija)
+	std::vector<MeshComponent> meshes(1);
+	MeshComponent& mesh = meshes[0];
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> weight(0.05f, 1.0f);
+	std::uniform_int_distribution<unsigned int> boneIndex(0, kBones - 1);
+	mesh.m_vertex.resize(kVertices);
+	mesh.m_skin.resize(kVertices);
+	for (unsigned int i = 0; i < kVertices; ++i) {
+		mesh.m_vertex[i].Pos = XMFLOAT3(position(random), position(random), position(random));
+		mesh.m_vertex[i].Tex = XMFLOAT2(0.0f, 0.0f);
+		mesh.m_vertex[i].Normal = XMFLOAT3(0.0f, 1.0f, 0.0f);
+		unsigned int bones[4];
+		float weights[4];
+		for (int k = 0; k < 4; ++k) {
+			bones[k] = boneIndex(random);
+			weights[k] = weight(random);
+		}
+		mesh.m_skin[i] = quantizeSkinWeights(bones, weights, 4);
+	}
+	mesh.m_numVertex = kVertices;
+
+	// 04. Medir cada método con los personajes desfasados en el clip
+	std::vector<SkinnedCharacter> crowd(characters);
+	std::vector<SkinnedCharacter*> batch(characters);
+	for (unsigned int i = 0; i < characters; ++i) {
+		crowd[i].skeleton = &skeleton;
+		crowd[i].clip = &clip;
+		crowd[i].meshes = &meshes;
+		batch[i] = &crowd[i];
+	}
+
+	SkinningBenchmarkResult result;
+	result.characters = characters;
+	result.bones = kBones;
+	result.vertices = kVertices;
+	result.threads = system.getThreadCount();
+	result.avx2 = getCpuFeatures().avx2;
+	const SkinningMethod methods[] = { SKINNING_LINEAR_BLEND, SKINNING_DUAL_QUATERNION };
+	for (SkinningMethod method : methods) {
+		for (auto& character : crowd) {
+			character.method = method;
+		}
+		// Un frame de calentamiento reserva las salidas antes de medir
+		system.update(batch.data(), characters);
+
+		double totalMs = 0.0;
+		for (unsigned int frame = 0; frame < frames; ++frame) {
+			for (unsigned int i = 0; i < characters; ++i) {
+				crowd[i].time = frame / 60.0f + i * 0.01f;
+			}
+			system.update(batch.data(), characters);
+			totalMs += system.getStats().timeMs;
+		}
+		const double perMs = totalMs > 0.0 ? static_cast<double>(characters) * frames / totalMs : 0.0;
+		(method == SKINNING_LINEAR_BLEND ? result.linearCharactersPerMs : result.dualCharactersPerMs) = perMs;
+	}
+	return result;
+}
@@ -0,0 +1,117 @@
+#include "StateCache.h"
+
+void
+StateCache::invalidate() {
+	m_inputLayout = unknown();
+	m_vertexShader = unknown();
+	m_pixelShader = unknown();
+	m_topology = ~0u;
+
+	m_indexBuffer = unknown();
+	m_indexFormat = ~0u;
+	m_indexOffset = ~0u;
+
+	for (unsigned int slot = 0; slot < kMaxSlots; ++slot) {
+		m_vertexBuffers[slot] = unknown();
+		m_vertexStrides[slot] = ~0u;
+		m_vertexOffsets[slot] = ~0u;
+		m_psShaderResources[slot] = unknown();
+		m_psSamplers[slot] = unknown();
+		m_vsConstantBuffers[slot] = unknown();
+		m_psConstantBuffers[slot] = unknown();
+		m_vsConstantRanges[slot] = 0;
+		m_psConstantRanges[slot] = 0;
+	}
+}
+
+bool
+StateCache::setIndexBuffer(const void* buffer, unsigned int format, unsigned int offset) {
+	bool changed = m_indexBuffer != buffer || m_indexFormat != format || m_indexOffset != offset;
+	m_indexBuffer = buffer;
+	m_indexFormat = format;
+	m_indexOffset = offset;
+	return record(changed);
+}
+
+bool
+StateCache::setVertexBuffers(unsigned int startSlot,
+							 unsigned int count,
+							 const void* const* buffers,
+							 const unsigned int* strides,
+							 const unsigned int* offsets) {
+	// Un rango que sale de los slots rastreados se envía siempre
+	if (startSlot + count > kMaxSlots) {
+		for (unsigned int slot = startSlot; slot < kMaxSlots; ++slot) {
+			m_vertexBuffers[slot] = unknown();
+		}
+		return record(true);
+	}
+
+	bool changed = false;
+	for (unsigned int i = 0; i < count; ++i) {
+		unsigned int slot = startSlot + i;
+		if (m_vertexBuffers[slot] != buffers[i] ||
+			m_vertexStrides[slot] != strides[i] ||
+			m_vertexOffsets[slot] != offsets[i]) {
+			m_vertexBuffers[slot] = buffers[i];
+			m_vertexStrides[slot] = strides[i];
+			m_vertexOffsets[slot] = offsets[i];
+			changed = true;
+		}
+	}
+	return record(changed);
+}
+
+bool
+StateCache::trackSlots(const void** current,
+					   unsigned int startSlot,
+					   unsigned int count,
+					   const void* const* values) {
+	if (startSlot + count > kMaxSlots) {
+		for (unsigned int slot = startSlot; slot < kMaxSlots; ++slot) {
+			current[slot] = unknown();
+		}
+		return record(true);
+	}
+
+	bool changed = false;
+	for (unsigned int i = 0; i < count; ++i) {
+		if (current[startSlot + i] != values[i]) {
+			current[startSlot + i] = values[i];
+			changed = true;
+		}
+	}
+	return record(changed);
+}
+
+bool
+StateCache::trackConstantBuffers(const void** current,
+								 unsigned long long* currentRanges,
+								 unsigned int startSlot,
+								 unsigned int count,
+								 const void* const* buffers,
+								 const unsigned int* firstConstants,
+								 const unsigned int* numConstants) {
+	if (startSlot + count > kMaxSlots) {
+		for (unsigned int slot = startSlot; slot < kMaxSlots; ++slot) {
+			current[slot] = unknown();
+		}
+		return record(true);
+	}
+
+	// El mismo buffer enlazado con otro rango cuenta como un cambio
+	bool changed = false;
+	for (unsigned int i = 0; i < count; ++i) {
+		unsigned long long range = 0;
+		if (firstConstants && numConstants) {
+			range = (static_cast<unsigned long long>(firstConstants[i]) << 32) | numConstants[i];
+		}
+		const unsigned int slot = startSlot + i;
+		if (current[slot] != buffers[i] || currentRanges[slot] != range) {
+			current[slot] = buffers[i];
+			currentRanges[slot] = range;
+			changed = true;
+		}
+	}
+	return record(changed);
+}
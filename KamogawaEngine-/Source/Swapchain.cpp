@@ -3,6 +3,7 @@
 #include "DeviceContext.h"
 #include "Window.h"
 #include "Texture.h"
+#include "CommandRecorder.h"
 
 HRESULT SwapChain::init(Device& device,
                         DeviceContext& deviceContext,
@@ -28,6 +29,16 @@ HRESULT SwapChain::init(Device& device,
     };
     unsigned int numDriverTypes = ARRAYSIZE(driverTypes);
 
+    // El backend nulo solo prueba el driver nulo, que no necesita GPU ni pantalla
+    D3D_DRIVER_TYPE nullDriverTypes[] = {
+        D3D_DRIVER_TYPE_NULL
+    };
+    D3D_DRIVER_TYPE* candidateTypes = driverTypes;
+    if (m_backend == NULL_BACKEND) {
+        candidateTypes = nullDriverTypes;
+        numDriverTypes = ARRAYSIZE(nullDriverTypes);
+    }
+
     D3D_FEATURE_LEVEL featureLevels[] = {
         D3D_FEATURE_LEVEL_11_0,
         D3D_FEATURE_LEVEL_10_1,
@@ -36,7 +47,7 @@ HRESULT SwapChain::init(Device& device,
     unsigned int numFeatureLevels = ARRAYSIZE(featureLevels);
 
     for (unsigned int driverTypeIndex = 0; driverTypeIndex < numDriverTypes; driverTypeIndex++) {
-        m_driverType = driverTypes[driverTypeIndex];
+        m_driverType = candidateTypes[driverTypeIndex];
         hr = D3D11CreateDevice(
             nullptr,
             m_driverType,
@@ -64,12 +75,40 @@ HRESULT SwapChain::init(Device& device,
     hr = device.m_device->CheckMultisampleQualityLevels(DXGI_FORMAT_R8G8B8A8_UNORM, 
                                                         m_sampleCount, 
                                                         &m_qualityLevels);
+    if (m_backend == NULL_BACKEND && (FAILED(hr) || m_qualityLevels == 0)) {
+        // El driver nulo puede no reportar MSAA; sin muestras múltiples el costo de CPU es el mismo
+        m_sampleCount = 1;
+        m_qualityLevels = 1;
+        hr = S_OK;
+    }
     if (FAILED(hr) || m_qualityLevels == 0) {
         ERROR("SwapChain", "init", "MSAA not supported or invalid quality level");
         return hr;
     }
 
-    // Configurar la descripcin del SwapChain
+    // Sin cadena de intercambio: el back buffer es una textura fuera de pantalla
+    if (m_backend == NULL_BACKEND) {
+        D3D11_TEXTURE2D_DESC backBufferDesc;
+        memset(&backBufferDesc, 0, sizeof(backBufferDesc));
+        backBufferDesc.Width = window.m_width;
+        backBufferDesc.Height = window.m_height;
+        backBufferDesc.MipLevels = 1;
+        backBufferDesc.ArraySize = 1;
+        backBufferDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+        backBufferDesc.SampleDesc.Count = m_sampleCount;
+        backBufferDesc.SampleDesc.Quality = m_qualityLevels - 1;
+        backBufferDesc.Usage = D3D11_USAGE_DEFAULT;
+        backBufferDesc.BindFlags = D3D11_BIND_RENDER_TARGET;
+
+        hr = device.CreateTexture2D(&backBufferDesc, nullptr, &backBuffer.m_texture);
+        if (FAILED(hr)) {
+            ERROR("SwapChain", "init", "Failed to create offscreen back buffer");
+            return hr;
+        }
+        return S_OK;
+    }
+
+    // Configurar la descripción del SwapChain
     DXGI_SWAP_CHAIN_DESC sd;
     memset(&sd, 0, sizeof(sd));
     sd.BufferCount = 1;
@@ -83,9 +122,9 @@ HRESULT SwapChain::init(Device& device,
     sd.Windowed = TRUE;
     sd.SwapEffect = DXGI_SWAP_EFFECT_DISCARD;
     sd.SampleDesc.Count = m_sampleCount;
-    sd.SampleDesc.Quality = m_qualityLevels - 1;  // Mxima calidad
+    sd.SampleDesc.Quality = m_qualityLevels - 1;  // Máxima calidad
 
-    // Obtener la fbrica DXGI
+    // Obtener la fábrica DXGI
     hr = device.m_device->QueryInterface(__uuidof(IDXGIDevice), reinterpret_cast<void**>(&m_dxgiDevice));
     if (FAILED(hr)) {
         ERROR("SwapChain", "init", "Failed to query IDXGIDevice");
@@ -123,12 +162,12 @@ HRESULT SwapChain::init(Device& device,
 
 void 
 SwapChain::update() {
-    // Se puede agregar cdigo para manejar eventos de SwapChain si es necesario
+    // Se puede agregar código para manejar eventos de SwapChain si es necesario
 }
 
 void 
 SwapChain::render() {
-    // Este mtodo puede expandirse para gestionar mltiples buffers de renderizado
+    // Este método puede expandirse para gestionar múltiples buffers de renderizado
 }
 
 void 
@@ -140,6 +179,12 @@ SwapChain::destroy() {
 }
 
 void SwapChain::present() {
+    if (m_recorder) {
+        m_recorder->record(CMD_PRESENT, 0, 1, m_swapchain);
+    }
+    if (m_backend == NULL_BACKEND) {
+        return;
+    }
     if (m_swapchain) {
         HRESULT hr = m_swapchain->Present(0, 0);
         if (FAILED(hr)) {
@@ -0,0 +1,246 @@
+#include "TangentSpace.h"
+#include "MeshComponent.h"
+#include "FrameClock.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <mutex>
+
+namespace {
+	constexpr float kEpsilon = 1.0e-12f;
+
+	XMVECTOR
+	loadPosition(const SimpleVertex& vertex) {
+		return XMLoadFloat3(&vertex.Pos);
+	}
+
+	/**
+	 * @brief Ángulo de una esquina entre sus dos aristas proyectadas sobre el plano de la normal.
+	 */
+	float
+	cornerAngle(FXMVECTOR corner, FXMVECTOR next, FXMVECTOR previous, FXMVECTOR normal) {
+		XMVECTOR edge0 = XMVectorSubtract(next, corner);
+		XMVECTOR edge1 = XMVectorSubtract(previous, corner);
+		edge0 = XMVectorSubtract(edge0, XMVectorMultiply(normal, XMVector3Dot(normal, edge0)));
+		edge1 = XMVectorSubtract(edge1, XMVectorMultiply(normal, XMVector3Dot(normal, edge1)));
+		if (XMVectorGetX(XMVector3LengthSq(edge0)) < kEpsilon || XMVectorGetX(XMVector3LengthSq(edge1)) < kEpsilon) {
+			return 0.0f;
+		}
+		const float cosine = XMVectorGetX(XMVector3Dot(XMVector3Normalize(edge0), XMVector3Normalize(edge1)));
+		return std::acos(std::max(-1.0f, std::min(1.0f, cosine)));
+	}
+
+	/**
+	 * @brief Cualquier dirección unitaria perpendicular a la normal.
+	 */
+	XMVECTOR
+	anyPerpendicular(FXMVECTOR normal) {
+		const XMVECTOR axis = std::fabs(XMVectorGetX(normal)) < 0.9f ? XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f)
+																	 : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+		return XMVector3Normalize(XMVectorSubtract(axis, XMVectorMultiply(normal, XMVector3Dot(normal, axis))));
+	}
+
+	/**
+	 * @brief Completa las normales que no se importaron con la suma de sus caras ponderada por
+	 *        ángulo y normaliza todas.
+	 */
+	unsigned int
+	completeNormals(MeshComponent& mesh) {
+		const size_t vertexCount = mesh.m_vertex.size();
+		std::vector<unsigned char> missing(vertexCount, 0);
+		unsigned int missingCount = 0;
+		for (size_t v = 0; v < vertexCount; ++v) {
+			const XMFLOAT3& n = mesh.m_vertex[v].Normal;
+			if (n.x * n.x + n.y * n.y + n.z * n.z < kEpsilon) {
+				missing[v] = 1;
+				++missingCount;
+			}
+		}
+
+		if (missingCount > 0) {
+			std::vector<XMFLOAT3> sums(vertexCount, XMFLOAT3(0.0f, 0.0f, 0.0f));
+			for (size_t i = 0; i + 2 < mesh.m_index.size(); i += 3) {
+				const unsigned int corners[3] = { mesh.m_index[i], mesh.m_index[i + 1], mesh.m_index[i + 2] };
+				const XMVECTOR p[3] = { loadPosition(mesh.m_vertex[corners[0]]),
+										loadPosition(mesh.m_vertex[corners[1]]),
+										loadPosition(mesh.m_vertex[corners[2]]) };
+				const XMVECTOR face = XMVector3Cross(XMVectorSubtract(p[1], p[0]), XMVectorSubtract(p[2], p[0]));
+				if (XMVectorGetX(XMVector3LengthSq(face)) < kEpsilon) {
+					continue;
+				}
+				const XMVECTOR normal = XMVector3Normalize(face);
+				for (int c = 0; c < 3; ++c) {
+					if (!missing[corners[c]]) {
+						continue;
+					}
+					const float angle = cornerAngle(p[c], p[(c + 1) % 3], p[(c + 2) % 3], normal);
+					XMFLOAT3& sum = sums[corners[c]];
+					XMStoreFloat3(&sum, XMVectorAdd(XMLoadFloat3(&sum), XMVectorScale(normal, angle)));
+				}
+			}
+			for (size_t v = 0; v < vertexCount; ++v) {
+				if (missing[v]) {
+					mesh.m_vertex[v].Normal = sums[v];
+				}
+			}
+		}
+
+		for (auto& vertex : mesh.m_vertex) {
+			const XMVECTOR normal = XMLoadFloat3(&vertex.Normal);
+			if (XMVectorGetX(XMVector3LengthSq(normal)) < kEpsilon) {
+				vertex.Normal = XMFLOAT3(0.0f, 1.0f, 0.0f);
+			}
+			else {
+				XMStoreFloat3(&vertex.Normal, XMVector3Normalize(normal));
+			}
+		}
+		return missingCount;
+	}
+}
+
+void
+computeTangentSpace(MeshComponent& mesh, TangentSpaceStats& stats) {
+	if (mesh.m_vertex.empty() || mesh.m_index.size() < 3) {
+		return;
+	}
+
+	// 01. Normales: las importadas se normalizan, las que faltan se calculan
+	stats.generatedNormals += completeNormals(mesh);
+
+	// 02. Dirección de la U y orientación en UV de cada triángulo
+	const size_t triangleCount = mesh.m_index.size() / 3;
+	std::vector<XMFLOAT3> triangleTangents(triangleCount);
+	std::vector<signed char> orientation(triangleCount, 0);   // 1, -1 o 0 si es degenerado
+	for (size_t t = 0; t < triangleCount; ++t) {
+		const SimpleVertex& v0 = mesh.m_vertex[mesh.m_index[t * 3]];
+		const SimpleVertex& v1 = mesh.m_vertex[mesh.m_index[t * 3 + 1]];
+		const SimpleVertex& v2 = mesh.m_vertex[mesh.m_index[t * 3 + 2]];
+		const XMVECTOR d1 = XMVectorSubtract(loadPosition(v1), loadPosition(v0));
+		const XMVECTOR d2 = XMVectorSubtract(loadPosition(v2), loadPosition(v0));
+		const float s1 = v1.Tex.x - v0.Tex.x;
+		const float t1 = v1.Tex.y - v0.Tex.y;
+		const float s2 = v2.Tex.x - v0.Tex.x;
+		const float t2 = v2.Tex.y - v0.Tex.y;
+		const float signedArea = s1 * t2 - t1 * s2;
+		const XMVECTOR tangent = XMVectorSubtract(XMVectorScale(d1, t2), XMVectorScale(d2, t1));
+		if (std::fabs(signedArea) < kEpsilon || XMVectorGetX(XMVector3LengthSq(tangent)) < kEpsilon) {
+			++stats.degenerateTriangles;
+			continue;
+		}
+		// Dividir por el área con signo: solo importa el signo, la magnitud se normaliza
+		orientation[t] = signedArea > 0.0f ? 1 : -1;
+		XMStoreFloat3(&triangleTangents[t], XMVectorScale(XMVector3Normalize(tangent), orientation[t]));
+	}
+
+	// 03. Un vértice usado con ambas orientaciones se duplica para los triángulos espejados
+	const size_t originalCount = mesh.m_vertex.size();
+	std::vector<unsigned char> used(originalCount, 0);  // bit 0: orientación +, bit 1: orientación -
+	for (size_t t = 0; t < triangleCount; ++t) {
+		if (orientation[t] == 0) {
+			continue;
+		}
+		for (int c = 0; c < 3; ++c) {
+			used[mesh.m_index[t * 3 + c]] |= orientation[t] > 0 ? 1 : 2;
+		}
+	}
+	std::vector<unsigned int> mirrored(originalCount);
+	const bool hasSkin = mesh.m_skin.size() == originalCount;
+	for (size_t v = 0; v < originalCount; ++v) {
+		mirrored[v] = static_cast<unsigned int>(v);
+		if (used[v] == 3) {
+			mirrored[v] = static_cast<unsigned int>(mesh.m_vertex.size());
+			mesh.m_vertex.push_back(mesh.m_vertex[v]);
+			if (hasSkin) {
+				mesh.m_skin.push_back(mesh.m_skin[v]);
+			}
+			++stats.splitVertices;
+		}
+	}
+	for (size_t t = 0; t < triangleCount; ++t) {
+		if (orientation[t] < 0) {
+			for (int c = 0; c < 3; ++c) {
+				unsigned int& index = mesh.m_index[t * 3 + c];
+				index = mirrored[index];
+			}
+		}
+	}
+
+	// 04. Acumular la tangente proyectada en el plano de la normal, ponderada por el ángulo
+	const size_t vertexCount = mesh.m_vertex.size();
+	std::vector<XMFLOAT3> sums(vertexCount, XMFLOAT3(0.0f, 0.0f, 0.0f));
+	std::vector<signed char> signs(vertexCount, 1);
+	for (size_t t = 0; t < triangleCount; ++t) {
+		if (orientation[t] == 0) {
+			continue;
+		}
+		const unsigned int corners[3] = { mesh.m_index[t * 3], mesh.m_index[t * 3 + 1], mesh.m_index[t * 3 + 2] };
+		const XMVECTOR p[3] = { loadPosition(mesh.m_vertex[corners[0]]),
+								loadPosition(mesh.m_vertex[corners[1]]),
+								loadPosition(mesh.m_vertex[corners[2]]) };
+		const XMVECTOR tangent = XMLoadFloat3(&triangleTangents[t]);
+		for (int c = 0; c < 3; ++c) {
+			const XMVECTOR normal = XMLoadFloat3(&mesh.m_vertex[corners[c]].Normal);
+			XMVECTOR projected = XMVectorSubtract(tangent, XMVectorMultiply(normal, XMVector3Dot(normal, tangent)));
+			if (XMVectorGetX(XMVector3LengthSq(projected)) < kEpsilon) {
+				continue;
+			}
+			projected = XMVector3Normalize(projected);
+			const float angle = cornerAngle(p[c], p[(c + 1) % 3], p[(c + 2) % 3], normal);
+			XMFLOAT3& sum = sums[corners[c]];
+			XMStoreFloat3(&sum, XMVectorAdd(XMLoadFloat3(&sum), XMVectorScale(projected, angle)));
+			signs[corners[c]] = orientation[t];
+		}
+	}
+
+	// 05. Ortonormalizar contra la normal y guardar el signo
+	for (size_t v = 0; v < vertexCount; ++v) {
+		SimpleVertex& vertex = mesh.m_vertex[v];
+		const XMVECTOR normal = XMLoadFloat3(&vertex.Normal);
+		XMVECTOR tangent = XMLoadFloat3(&sums[v]);
+		tangent = XMVectorSubtract(tangent, XMVectorMultiply(normal, XMVector3Dot(normal, tangent)));
+		tangent = XMVectorGetX(XMVector3LengthSq(tangent)) < kEpsilon ? anyPerpendicular(normal) : XMVector3Normalize(tangent);
+		XMFLOAT3 result;
+		XMStoreFloat3(&result, tangent);
+		vertex.Tangent = XMFLOAT4(result.x, result.y, result.z, static_cast<float>(signs[v]));
+	}
+
+	mesh.m_numVertex = static_cast<int>(mesh.m_vertex.size());
+	++stats.meshes;
+}
+
+TangentSpaceStats
+computeTangentSpaces(std::vector<MeshComponent>& meshes, unsigned int threadCount) {
+	PROFILE_SCOPE("computeTangentSpaces");
+	const long long start = FrameClock::now();
+
+	TangentSpaceStats total;
+	const unsigned int meshCount = static_cast<unsigned int>(meshes.size());
+	const unsigned int threads = std::max(1u, std::min(threadCount, meshCount));
+	std::atomic<unsigned int> next{ 0 };
+	std::mutex mutex;
+
+	auto work = [&]() {
+		TangentSpaceStats local;
+		for (unsigned int i = next.fetch_add(1); i < meshCount; i = next.fetch_add(1)) {
+			computeTangentSpace(meshes[i], local);
+		}
+		std::lock_guard<std::mutex> lock(mutex);
+		total.meshes += local.meshes;
+		total.generatedNormals += local.generatedNormals;
+		total.splitVertices += local.splitVertices;
+		total.degenerateTriangles += local.degenerateTriangles;
+	};
+
+	std::vector<std::thread> workers;
+	for (unsigned int i = 1; i < threads; ++i) {
+		workers.emplace_back(work);
+	}
+	work();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+
+	total.threads = threads;
+	total.timeMs = (FrameClock::now() - start) / 1.0e6;
+	return total;
+}
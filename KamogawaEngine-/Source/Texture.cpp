@@ -1,3 +1,8 @@
+#include "MemoryTracker.h"
+// Los píxeles decodificados (y los temporales de stb_image) se contabilizan como texturas
+#define STBI_MALLOC(size)          trackedMalloc(MEMORY_TAG_TEXTURE, (size), "stb_image", 0)
+#define STBI_REALLOC(memory, size) trackedRealloc(MEMORY_TAG_TEXTURE, (memory), (size), "stb_image", 0)
+#define STBI_FREE(memory)          trackedFree(MEMORY_TAG_TEXTURE, (memory))
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #include "Texture.h"
@@ -7,6 +12,7 @@
 HRESULT Texture::init(Device device, 
                       const std::string& textureName, 
                       ExtensionType extensionType) {
+    PROFILE_SCOPE("Texture::init");
     if (!device.m_device) {
         ERROR("Texture", "init", "Device is nullptr in texture loading method");
         return E_POINTER;
@@ -36,6 +42,7 @@ HRESULT Texture::init(Device device,
 
     case PNG: {
         int width, height, channels;
+        PROFILE_SCOPE("Texture decode");
         unsigned char* data = stbi_load(textureName.c_str(), &width, &height, &channels, 4); // 4 bytes por pixel (RGBA)
         if (!data) {
             ERROR("Texture", "init",
@@ -43,7 +50,7 @@ HRESULT Texture::init(Device device,
             return E_FAIL;
         }
 
-        // Crear descripcin de textura
+        // Crear descripción de textura
         D3D11_TEXTURE2D_DESC textureDesc = {};
         textureDesc.Width = width;
         textureDesc.Height = height;
@@ -113,7 +120,7 @@ Texture::init(Device device,
 
     HRESULT hr = S_OK;
 
-    // Configuracin de la textura
+    // Configuración de la textura
     D3D11_TEXTURE2D_DESC desc = {};
     desc.Width = width;
     desc.Height = height;
@@ -134,6 +141,62 @@ Texture::init(Device device,
     return hr;
 }
 
+HRESULT
+Texture::init(Device device,
+              unsigned int width,
+              unsigned int height,
+              const unsigned char* const* mipData,
+              unsigned int mipLevels) {
+    if (!device.m_device) {
+        ERROR("Texture", "init", "Device is nullptr in memory texture initialization method");
+        return E_POINTER;
+    }
+    if (width == 0 || height == 0 || !mipData || mipLevels == 0) {
+        ERROR("Texture", "init", "Invalid memory texture parameters");
+        return E_INVALIDARG;
+    }
+
+    D3D11_TEXTURE2D_DESC textureDesc = {};
+    textureDesc.Width = width;
+    textureDesc.Height = height;
+    textureDesc.MipLevels = mipLevels;
+    textureDesc.ArraySize = 1;
+    textureDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    textureDesc.SampleDesc.Count = 1;
+    textureDesc.Usage = D3D11_USAGE_IMMUTABLE;
+    textureDesc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    // Un subrecurso por nivel de mip
+    std::vector<D3D11_SUBRESOURCE_DATA> initData(mipLevels);
+    for (unsigned int level = 0; level < mipLevels; ++level) {
+        unsigned int levelWidth = (width >> level) > 0 ? (width >> level) : 1;
+        initData[level].pSysMem = mipData[level];
+        initData[level].SysMemPitch = levelWidth * 4;
+        initData[level].SysMemSlicePitch = 0;
+    }
+
+    HRESULT hr = device.CreateTexture2D(&textureDesc, initData.data(), &m_texture);
+    if (FAILED(hr)) {
+        ERROR("Texture", "init", "Failed to create texture from memory data");
+        return hr;
+    }
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = textureDesc.Format;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Texture2D.MipLevels = mipLevels;
+
+    hr = device.m_device->CreateShaderResourceView(m_texture, &srvDesc, &m_textureFromImg);
+    SAFE_RELEASE(m_texture);
+
+    if (FAILED(hr)) {
+        ERROR("Texture", "init", "Failed to create shader resource view for memory texture");
+        return hr;
+    }
+
+    return S_OK;
+}
+
 void 
 Texture::update() {
 }
@@ -143,8 +206,6 @@ Texture::render(DeviceContext& deviceContext,
                 unsigned int StartSlot, 
                 unsigned int NumViews) {
     if (m_textureFromImg) {
-        ID3D11ShaderResourceView* nullSRV[] = { nullptr };
-        deviceContext.PSSetShaderResources(StartSlot, NumViews, nullSRV);
         deviceContext.PSSetShaderResources(StartSlot, NumViews, &m_textureFromImg);
     }
     else {
@@ -0,0 +1,309 @@
+#include "TextureAtlas.h"
+#include "Device.h"
+#include "MeshComponent.h"
+#include "stb_image.h"
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "imstb_rectpack.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+	/**
+	 * @brief Redondea hacia arriba al siguiente múltiplo de alignment.
+	 */
+	unsigned int
+	alignUp(unsigned int value, unsigned int alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	/**
+	 * @brief Intenta empaquetar los rectángulos en una página cuadrada de pageBlocks bloques.
+	 * @return Número de rectángulos que quedaron dentro de la página.
+	 */
+	int
+	packPage(std::vector<stbrp_rect>& rects, int pageBlocks) {
+		stbrp_context context;
+		std::vector<stbrp_node> nodes(pageBlocks);
+		stbrp_init_target(&context, pageBlocks, pageBlocks, nodes.data(), pageBlocks);
+		stbrp_setup_heuristic(&context, STBRP_HEURISTIC_Skyline_BF_sortHeight);
+		stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size()));
+
+		int packed = 0;
+		for (const auto& rect : rects) {
+			if (rect.was_packed) {
+				++packed;
+			}
+		}
+		return packed;
+	}
+}
+
+HRESULT
+TextureAtlas::init(Device& device,
+				   const std::vector<std::string>& textureNames,
+				   std::vector<MeshComponent>& meshes,
+				   std::vector<Texture>& meshTextures) {
+	if (!device.m_device) {
+		ERROR("TextureAtlas", "init", "Device is nullptr");
+		return E_POINTER;
+	}
+	if (textureNames.empty()) {
+		ERROR("TextureAtlas", "init", "Texture list is empty");
+		return E_INVALIDARG;
+	}
+
+	// Solo se cargan las texturas que alguna malla usa (malla i -> textura i)
+	const unsigned int count = static_cast<unsigned int>(std::min(textureNames.size(), meshes.size()));
+	m_images.assign(count, SourceImage());
+	m_regions.assign(count, AtlasRegion());
+	m_pageSizes.clear();
+	m_packedCount = 0;
+	m_standaloneCount = 0;
+	m_pageCount = 0;
+
+	// 01. Cargar las imágenes de origen y elegir las candidatas al atlas
+	std::vector<unsigned int> candidates;
+	std::vector<float> cellU(count, 0.0f);
+	std::vector<float> cellV(count, 0.0f);
+	for (unsigned int i = 0; i < count; ++i) {
+		int channels = 0;
+		SourceImage& image = m_images[i];
+		image.pixels = stbi_load(textureNames[i].c_str(), &image.width, &image.height, &channels, 4);
+		if (!image.pixels) {
+			ERROR("TextureAtlas", "init",
+				("Failed to load texture: " + textureNames[i] + " " + std::string(stbi_failure_reason())).c_str());
+			destroy();
+			return E_FAIL;
+		}
+		m_regions[i].width = image.width;
+		m_regions[i].height = image.height;
+
+		bool small = static_cast<unsigned int>(image.width) <= m_maxTextureSize &&
+					 static_cast<unsigned int>(image.height) <= m_maxTextureSize;
+		if (small && fitsSingleCell(meshes[i], cellU[i], cellV[i])) {
+			candidates.push_back(i);
+		}
+	}
+
+	// 02. Empaquetar las candidatas y crear las páginas
+	m_pageCount = packCandidates(candidates);
+
+	std::vector<Texture> pages(m_pageCount);
+	for (unsigned int page = 0; page < m_pageCount; ++page) {
+		HRESULT hr = buildPage(device, page, pages[page]);
+		if (FAILED(hr)) {
+			destroy();
+			return hr;
+		}
+	}
+
+	// 03. Reescribir UVs de las mallas empaquetadas y asignar la textura de cada malla
+	meshTextures.clear();
+	for (unsigned int i = 0; i < count; ++i) {
+		const AtlasRegion& region = m_regions[i];
+		if (region.packed) {
+			const float pageSize = static_cast<float>(m_pageSizes[region.page]);
+			for (auto& vertex : meshes[i].m_vertex) {
+				vertex.Tex.x = (region.x + (vertex.Tex.x - cellU[i]) * region.width) / pageSize;
+				vertex.Tex.y = (region.y + (vertex.Tex.y - cellV[i]) * region.height) / pageSize;
+			}
+			meshTextures.push_back(pages[region.page]);
+			++m_packedCount;
+		}
+		else {
+			// Texturas grandes o con UVs repetidas conservan su propia textura
+			Texture standalone;
+			const unsigned char* levels[] = { m_images[i].pixels };
+			HRESULT hr = standalone.init(device, m_images[i].width, m_images[i].height, levels, 1);
+			if (FAILED(hr)) {
+				destroy();
+				return hr;
+			}
+			meshTextures.push_back(standalone);
+			++m_standaloneCount;
+		}
+	}
+
+	std::string msg = std::to_string(m_packedCount) + " textures packed in " + std::to_string(m_pageCount) +
+					  " page(s), " + std::to_string(m_standaloneCount) + " standalone";
+	MESSAGE("TextureAtlas", "init", msg.c_str());
+
+	destroy();
+	return S_OK;
+}
+
+void
+TextureAtlas::destroy() {
+	for (auto& image : m_images) {
+		if (image.pixels) {
+			stbi_image_free(image.pixels);
+			image.pixels = nullptr;
+		}
+	}
+	m_images.clear();
+}
+
+float
+TextureAtlas::getTexelSize(unsigned int mesh) const {
+	if (mesh >= m_regions.size() || !m_regions[mesh].packed) {
+		return 0.0f;
+	}
+	return 1.0f / static_cast<float>(m_pageSizes[m_regions[mesh].page]);
+}
+
+bool
+TextureAtlas::fitsSingleCell(const MeshComponent& mesh, float& cellU, float& cellV) const {
+	if (mesh.m_vertex.empty()) {
+		return false;
+	}
+
+	float minU = mesh.m_vertex[0].Tex.x, maxU = minU;
+	float minV = mesh.m_vertex[0].Tex.y, maxV = minV;
+	for (const auto& vertex : mesh.m_vertex) {
+		minU = std::min(minU, vertex.Tex.x);
+		maxU = std::max(maxU, vertex.Tex.x);
+		minV = std::min(minV, vertex.Tex.y);
+		maxV = std::max(maxV, vertex.Tex.y);
+	}
+
+	// El cargador FBX invierte V, por lo que las UVs pueden vivir en [-1, 0]
+	const float epsilon = 1e-4f;
+	cellU = std::floor(minU + epsilon);
+	cellV = std::floor(minV + epsilon);
+	return maxU <= cellU + 1.0f + epsilon && maxV <= cellV + 1.0f + epsilon;
+}
+
+unsigned int
+TextureAtlas::packCandidates(const std::vector<unsigned int>& candidates) {
+	if (candidates.empty()) {
+		return 0;
+	}
+
+	// Cada región (contenido + gutter) se alinea al bloque que cubre un texel del último mip
+	const unsigned int blockSize = 1u << (m_mipLevels > 0 ? m_mipLevels - 1 : 0);
+
+	std::vector<stbrp_rect> rects;
+	unsigned int totalArea = 0;
+	for (unsigned int index : candidates) {
+		stbrp_rect rect = {};
+		rect.id = static_cast<int>(index);
+		rect.w = alignUp(m_regions[index].width + 2 * m_padding, blockSize) / blockSize;
+		rect.h = alignUp(m_regions[index].height + 2 * m_padding, blockSize) / blockSize;
+		totalArea += rect.w * rect.h * blockSize * blockSize;
+		rects.push_back(rect);
+	}
+
+	// Buscar la página más pequeña que contenga todo en una sola pieza
+	unsigned int pageSize = blockSize;
+	while (pageSize * pageSize < totalArea && pageSize < m_maxPageSize) {
+		pageSize *= 2;
+	}
+	for (; pageSize <= m_maxPageSize; pageSize *= 2) {
+		std::vector<stbrp_rect> attempt = rects;
+		if (packPage(attempt, pageSize / blockSize) == static_cast<int>(attempt.size())) {
+			assignPage(attempt, 0, pageSize, blockSize);
+			return 1;
+		}
+	}
+
+	// No cabe en una página: repartir en varias páginas del tamaño máximo
+	unsigned int pageCount = 0;
+	std::vector<stbrp_rect> pending = rects;
+	while (!pending.empty()) {
+		if (packPage(pending, m_maxPageSize / blockSize) == 0) {
+			break; // Lo que no cabe en una página vacía conserva su textura propia
+		}
+		assignPage(pending, pageCount++, m_maxPageSize, blockSize);
+
+		std::vector<stbrp_rect> next;
+		for (const auto& rect : pending) {
+			if (!rect.was_packed) {
+				next.push_back(rect);
+			}
+		}
+		pending = next;
+	}
+
+	return pageCount;
+}
+
+void
+TextureAtlas::assignPage(const std::vector<stbrp_rect>& rects,
+						 unsigned int page,
+						 unsigned int pageSize,
+						 unsigned int blockSize) {
+	for (const auto& rect : rects) {
+		if (!rect.was_packed) {
+			continue;
+		}
+		AtlasRegion& region = m_regions[rect.id];
+		region.packed = true;
+		region.page = page;
+		region.x = rect.x * blockSize + m_padding;
+		region.y = rect.y * blockSize + m_padding;
+	}
+	m_pageSizes.push_back(pageSize);
+}
+
+HRESULT
+TextureAtlas::buildPage(Device& device, unsigned int page, Texture& texture) {
+	const unsigned int size = m_pageSizes[page];
+	TrackedVector<unsigned char, MEMORY_TAG_TEXTURE> level0(size * size * 4, 0);
+
+	// 01. Copiar cada textura extruyendo sus bordes hacia el gutter
+	for (unsigned int i = 0; i < m_regions.size(); ++i) {
+		const AtlasRegion& region = m_regions[i];
+		if (!region.packed || region.page != page) {
+			continue;
+		}
+
+		const SourceImage& image = m_images[i];
+		const int pad = static_cast<int>(m_padding);
+		for (int y = -pad; y < image.height + pad; ++y) {
+			int srcY = std::min(std::max(y, 0), image.height - 1);
+			for (int x = -pad; x < image.width + pad; ++x) {
+				int srcX = std::min(std::max(x, 0), image.width - 1);
+				const unsigned char* src = image.pixels + (srcY * image.width + srcX) * 4;
+				unsigned char* dst = level0.data() + ((region.y + y) * size + (region.x + x)) * 4;
+				memcpy(dst, src, 4);
+			}
+		}
+	}
+
+	// 02. Generar la cadena de mips con un filtro de caja 2x2
+	unsigned int levels = 1;
+	while (levels < m_mipLevels && (size >> levels) > 0) {
+		++levels;
+	}
+
+	std::vector<TrackedVector<unsigned char, MEMORY_TAG_TEXTURE>> chain(levels);
+	chain[0] = std::move(level0);
+	for (unsigned int level = 1; level < levels; ++level) {
+		const unsigned int srcSize = size >> (level - 1);
+		const unsigned int dstSize = size >> level;
+		const TrackedVector<unsigned char, MEMORY_TAG_TEXTURE>& src = chain[level - 1];
+		TrackedVector<unsigned char, MEMORY_TAG_TEXTURE>& dst = chain[level];
+		dst.resize(dstSize * dstSize * 4);
+		for (unsigned int y = 0; y < dstSize; ++y) {
+			for (unsigned int x = 0; x < dstSize; ++x) {
+				for (unsigned int c = 0; c < 4; ++c) {
+					unsigned int sum = src[((2 * y) * srcSize + 2 * x) * 4 + c] +
+									   src[((2 * y) * srcSize + 2 * x + 1) * 4 + c] +
+									   src[((2 * y + 1) * srcSize + 2 * x) * 4 + c] +
+									   src[((2 * y + 1) * srcSize + 2 * x + 1) * 4 + c];
+					dst[(y * dstSize + x) * 4 + c] = static_cast<unsigned char>((sum + 2) / 4);
+				}
+			}
+		}
+	}
+
+	std::vector<const unsigned char*> mipData(levels);
+	for (unsigned int level = 0; level < levels; ++level) {
+		mipData[level] = chain[level].data();
+	}
+
+	return texture.init(device, size, size, mipData.data(), levels);
+}
@@ -4,17 +4,30 @@
 #include "DeviceContext.h"
 #include "BaseApp.h"
 
+namespace {
+    void*
+    imguiAlloc(size_t size, void*) {
+        return trackedMalloc(MEMORY_TAG_UI, size, "ImGui", 0);
+    }
+
+    void
+    imguiFree(void* memory, void*) {
+        trackedFree(MEMORY_TAG_UI, memory);
+    }
+}
+
 void 
 UserInterface::init(void* window, 
 			        ID3D11Device* device, 
 			        ID3D11DeviceContext* deviceContext) {
-    // Inicializacin bsica de ImGui
+    // Inicialización básica de ImGui
     IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(imguiAlloc, imguiFree, nullptr);  // Memoria de ImGui en la etiqueta UI
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
-    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard; // Habilitar navegacin con teclado
+    io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard; // Habilitar navegación con teclado
 
-    // Inicializacin de backends
+    // Inicialización de backends
     ImGui_ImplWin32_Init(window);
     ImGui_ImplDX11_Init(device, deviceContext);
 
@@ -40,30 +53,156 @@ void UserInterface::render(std::vector<EngineUtilities::TSharedPointer<Actor>>&
 	ImGui::Combo("Actor", &this->selectedActorIndex, actorNames, IM_ARRAYSIZE(actorNames)); //Combo para seleccionar el actor 
     ImGui::Separator();
     
-	if (this->selectedActorIndex >= 0 && this->selectedActorIndex < actors.size() && !actors[this->selectedActorIndex].isNull()) { // Verifica si el actor es vlido
+	if (this->selectedActorIndex >= 0 && this->selectedActorIndex < actors.size() && !actors[this->selectedActorIndex].isNull()) { // Verifica si el actor es válido
 		Transform* transform = actors[this->selectedActorIndex]->getComponent<Transform>().get(); // Obtiene el componente Transform del actor seleccionado
         if (transform) {
             EngineUtilities::Vector3 position = transform->getPosition();
             EngineUtilities::Vector3 rotation = transform->getRotation();
             EngineUtilities::Vector3 scale = transform->getScale();
+            // setTransform coloca el actor de golpe: las ediciones no se interpolan
 
-            if (ImGui::DragFloat3("Position", &position.x, 0.1f)) transform->setPosition(position);
+            if (ImGui::DragFloat3("Position", &position.x, 0.1f)) transform->setTransform(position, rotation, scale);
             ImGui::Separator();
 
-            if (ImGui::DragFloat3("Rotation", &rotation.x, 0.1f)) transform->setRotation(rotation);
+            if (ImGui::DragFloat3("Rotation", &rotation.x, 0.1f)) transform->setTransform(position, rotation, scale);
             ImGui::Separator();
 
-            if (ImGui::DragFloat3("Scale", &scale.x, 0.1f)) transform->setScale(scale);
+            if (ImGui::DragFloat3("Scale", &scale.x, 0.1f)) transform->setTransform(position, rotation, scale);
             ImGui::Separator();
         }
     }
 
     ImGui::End();
 
+    if (m_frameStats) {
+        statsWindow();
+    }
+
     ImGui::Render();
     ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
 }
 
+void
+UserInterface::statsWindow() {
+    PROFILE_SCOPE("UserInterface::statsWindow");
+    const FrameStats& stats = *m_frameStats;
+    const FrameSample& frame = stats.getLatest();
+
+    ImGui::SetNextWindowSize(ImVec2(420.0f, 520.0f), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Stats")) {
+        ImGui::End();
+        return;
+    }
+
+    // Tiempo de frame
+    FrameTimePercentiles percentiles = stats.computePercentiles();
+    ImGui::Text("Frame %.2f ms (%.0f FPS)  CPU %.2f ms", frame.frameMs,
+                frame.frameMs > 0.0f ? 1000.0f / frame.frameMs : 0.0f, frame.cpuMs);
+    ImGui::Text("avg %.2f  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f",
+                percentiles.average, percentiles.p50, percentiles.p95, percentiles.p99, percentiles.max);
+    ImGui::PlotLines("##frame", stats.getFrameTimes(), static_cast<int>(stats.getCount()),
+                     static_cast<int>(stats.getOffset()), "frame ms", 0.0f,
+                     std::max(33.4f, percentiles.max), ImVec2(-1.0f, 70.0f));
+    ImGui::PlotLines("##cpu", stats.getCpuTimes(), static_cast<int>(stats.getCount()),
+                     static_cast<int>(stats.getOffset()), "CPU ms", 0.0f,
+                     std::max(33.4f, percentiles.max), ImVec2(-1.0f, 40.0f));
+    ImGui::Text("Jitter %.2f ms  Sim steps %u  alpha %.2f", frame.jitterMs, frame.simulationSteps,
+                frame.interpolationAlpha);
+    ImGui::Text("Latency %.2f ms  Packets dropped %llu", frame.latencyMs, frame.packetsDropped);
+
+    // Contadores de render
+    if (ImGui::CollapsingHeader("Render", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("Draw calls:        %u", frame.draws);
+        ImGui::Text("State changes:     %u (%u skipped)", frame.stateChanges, frame.bindsSkipped);
+        ImGui::Text("Triangles:         %u submitted, %u culled, %llu drawn",
+                    frame.trianglesSubmitted, frame.trianglesCulled, frame.trianglesDrawn);
+        ImGui::Text("Vertex fetch:      %.1f KB", frame.vertexBytes / 1024.0);
+        ImGui::Text("Buffer binds:      %u VB, %u IB", frame.vertexBufferBinds, frame.indexBufferBinds);
+        ImGui::Text("Actors occluded:   %u", frame.actorsOccluded);
+        ImGui::Text("Uploads:           %u (%.1f KB)", frame.uploads, frame.uploadBytes / 1024.0);
+    }
+
+    // Memoria
+    if (ImGui::CollapsingHeader("Memory", ImGuiTreeNodeFlags_DefaultOpen)) {
+        ImGui::Text("Textures:          %.2f MB", frame.textureBytes / (1024.0 * 1024.0));
+        ImGui::Text("Buffers:           %.2f MB", frame.bufferBytes / (1024.0 * 1024.0));
+        ImGui::Text("Allocations:       %u resources, %u ring", frame.allocations, frame.ringAllocations);
+        ImGui::Text("Frame arena:       %u allocs, %.1f KB, %u heap blocks",
+                    frame.arenaAllocations, frame.arenaBytes / 1024.0, frame.arenaHeapBlocks);
+        for (int tag = 0; tag < MEMORY_TAG_COUNT; ++tag) {
+            const MemoryTagStats memory = MemoryTracker::getInstance().getTagStats(static_cast<MemoryTag>(tag));
+            const bool overBudget = memory.budget > 0 && memory.bytes > static_cast<long long>(memory.budget);
+            ImGui::TextColored(overBudget ? ImVec4(1.0f, 0.4f, 0.4f, 1.0f) : ImGui::GetStyleColorVec4(ImGuiCol_Text),
+                               "%-8s           %.2f MB (peak %.2f MB, %lld allocs)",
+                               MemoryTracker::getTagName(static_cast<MemoryTag>(tag)),
+                               memory.bytes / (1024.0 * 1024.0), memory.peakBytes / (1024.0 * 1024.0),
+                               memory.allocations);
+        }
+    }
+
+    // Pools de objetos
+    if (ImGui::CollapsingHeader("Pools")) {
+        if (ImGui::BeginTable("pools", 6, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+            ImGui::TableSetupColumn("Type");
+            ImGui::TableSetupColumn("Live");
+            ImGui::TableSetupColumn("Peak");
+            ImGui::TableSetupColumn("Slabs");
+            ImGui::TableSetupColumn("Cached");
+            ImGui::TableSetupColumn("Frag.");
+            ImGui::TableHeadersRow();
+            auto poolRow = [](const char* name, const EngineUtilities::PoolStats& pool) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("%s (%zu B)", name, pool.slotSize);
+                ImGui::TableNextColumn(); ImGui::Text("%u / %u", pool.live, pool.capacity);
+                ImGui::TableNextColumn(); ImGui::Text("%u", pool.peakLive);
+                ImGui::TableNextColumn(); ImGui::Text("%u (%u empty)", pool.slabs, pool.emptySlabs);
+                ImGui::TableNextColumn(); ImGui::Text("%u", pool.cached);
+                ImGui::TableNextColumn(); ImGui::Text("%.0f%%", pool.fragmentation * 100.0f);
+            };
+            poolRow("Actor", EngineUtilities::TObjectPool<Actor>::getInstance().getStats());
+            poolRow("Transform", EngineUtilities::TObjectPool<Transform>::getInstance().getStats());
+            poolRow("MeshComponent", EngineUtilities::TObjectPool<MeshComponent>::getInstance().getStats());
+            ImGui::EndTable();
+        }
+    }
+
+    // Tiempos por bloque del último frame
+    if (ImGui::CollapsingHeader("CPU scopes", ImGuiTreeNodeFlags_DefaultOpen)) {
+#ifdef PROFILE
+        const std::vector<ProfileSummaryEntry>& summary = Profiler::getInstance().getSummary();
+        if (ImGui::BeginTable("scopes", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp)) {
+            ImGui::TableSetupColumn("Scope");
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupColumn("Total");
+            ImGui::TableSetupColumn("Self");
+            ImGui::TableSetupColumn("Max");
+            ImGui::TableHeadersRow();
+            for (const ProfileSummaryEntry& entry : summary) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::Text("%*s%s", static_cast<int>(entry.depth * 2), "", entry.name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", entry.calls);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", entry.totalMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", entry.selfMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", entry.maxMs);
+            }
+            ImGui::EndTable();
+        }
+        ImGui::Text("Dropped events: %u", Profiler::getInstance().getDroppedEvents());
+        ImGui::Text("F9: %s", Profiler::getInstance().isCapturing() ? "stop capture" : "start capture");
+#else
+        ImGui::TextDisabled("Profiler disabled (build with PROFILE)");
+#endif
+    }
+
+    ImGui::TextDisabled("Stats update: %.4f ms", stats.getUpdateTimeMs());
+    ImGui::End();
+}
+
 void 
 UserInterface::destroy() {
     ImGui_ImplDX11_Shutdown();
@@ -0,0 +1,575 @@
+#include "VertexFormat.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+	const char* const g_semanticNames[VERTEX_ATTRIBUTE_COUNT] = { "POSITION", "NORMAL", "TANGENT", "TEXCOORD", "TEXCOORD", "COLOR" };
+	const unsigned int g_semanticIndices[VERTEX_ATTRIBUTE_COUNT] = { 0, 0, 0, 0, 1, 0 };
+	const unsigned int g_componentCounts[VERTEX_ATTRIBUTE_COUNT] = { 3, 3, 4, 2, 2, 4 };
+
+	unsigned int
+	encodingSize(VertexAttribute attribute, VertexEncoding encoding) {
+		switch (encoding) {
+		case VERTEX_ENCODING_FLOAT:
+			return g_componentCounts[attribute] * sizeof(float);
+		case VERTEX_ENCODING_OCTAHEDRAL:
+		case VERTEX_ENCODING_SNORM8:
+		case VERTEX_ENCODING_UNORM8:
+		case VERTEX_ENCODING_HALF:
+		case VERTEX_ENCODING_UNORM1010102:
+			return 4;
+		case VERTEX_ENCODING_UNORM16:
+			return 8;
+		default:
+			return 0;
+		}
+	}
+
+	float
+	signNotZero(float value) {
+		return value >= 0.0f ? 1.0f : -1.0f;
+	}
+
+	signed char
+	toSnorm8(float value) {
+		return static_cast<signed char>(std::round(std::max(-1.0f, std::min(1.0f, value)) * 127.0f));
+	}
+
+	/**
+	 * @brief Cuantiza un valor en [0, 1] a un entero de bits bits.
+	 */
+	unsigned int
+	toUnorm(float value, unsigned int bits) {
+		const float maxValue = static_cast<float>((1u << bits) - 1);
+		return static_cast<unsigned int>(std::round(std::max(0.0f, std::min(1.0f, value)) * maxValue));
+	}
+
+	/**
+	 * @brief Ángulo en grados entre dos direcciones (0 si la original no tiene largo).
+	 */
+	float
+	angleBetween(const float* original, const float* decoded) {
+		const float dot = original[0] * decoded[0] + original[1] * decoded[1] + original[2] * decoded[2];
+		const float lengths = std::sqrt((original[0] * original[0] + original[1] * original[1] + original[2] * original[2]) *
+										(decoded[0] * decoded[0] + decoded[1] * decoded[1] + decoded[2] * decoded[2]));
+		if (lengths <= 0.0f) {
+			return 0.0f;
+		}
+		return std::acos(std::max(-1.0f, std::min(1.0f, dot / lengths))) * (180.0f / XM_PI);
+	}
+
+	/**
+	 * @brief Componentes float de un atributo de SimpleVertex.
+	 */
+	void
+	readAttribute(const SimpleVertex& vertex, VertexAttribute attribute, float* value) {
+		switch (attribute) {
+		case VERTEX_ATTRIBUTE_POSITION:
+			value[0] = vertex.Pos.x; value[1] = vertex.Pos.y; value[2] = vertex.Pos.z;
+			break;
+		case VERTEX_ATTRIBUTE_NORMAL:
+			value[0] = vertex.Normal.x; value[1] = vertex.Normal.y; value[2] = vertex.Normal.z;
+			break;
+		case VERTEX_ATTRIBUTE_TANGENT:
+			value[0] = vertex.Tangent.x; value[1] = vertex.Tangent.y;
+			value[2] = vertex.Tangent.z; value[3] = vertex.Tangent.w;
+			break;
+		case VERTEX_ATTRIBUTE_TEXCOORD0:
+			value[0] = vertex.Tex.x; value[1] = vertex.Tex.y;
+			break;
+		case VERTEX_ATTRIBUTE_TEXCOORD1:
+			value[0] = vertex.Tex1.x; value[1] = vertex.Tex1.y;
+			break;
+		case VERTEX_ATTRIBUTE_COLOR:
+			for (int i = 0; i < 4; ++i) {
+				value[i] = ((vertex.Color >> (8 * i)) & 0xFF) / 255.0f;
+			}
+			break;
+		default:
+			break;
+		}
+	}
+
+	/**
+	 * @brief Escribe las componentes float de un atributo en SimpleVertex (inversa de readAttribute).
+	 */
+	void
+	writeAttribute(SimpleVertex& vertex, VertexAttribute attribute, const float* value) {
+		switch (attribute) {
+		case VERTEX_ATTRIBUTE_POSITION:
+			vertex.Pos = XMFLOAT3(value[0], value[1], value[2]);
+			break;
+		case VERTEX_ATTRIBUTE_NORMAL:
+			vertex.Normal = XMFLOAT3(value[0], value[1], value[2]);
+			break;
+		case VERTEX_ATTRIBUTE_TANGENT:
+			vertex.Tangent = XMFLOAT4(value[0], value[1], value[2], value[3]);
+			break;
+		case VERTEX_ATTRIBUTE_TEXCOORD0:
+			vertex.Tex = XMFLOAT2(value[0], value[1]);
+			break;
+		case VERTEX_ATTRIBUTE_TEXCOORD1:
+			vertex.Tex1 = XMFLOAT2(value[0], value[1]);
+			break;
+		case VERTEX_ATTRIBUTE_COLOR:
+			vertex.Color = 0;
+			for (int i = 0; i < 4; ++i) {
+				vertex.Color |= toUnorm(value[i], 8) << (8 * i);
+			}
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+VertexFormat
+VertexFormat::simple() {
+	VertexFormat format;
+	format.set(VERTEX_ATTRIBUTE_POSITION, VERTEX_ENCODING_FLOAT)
+		  .set(VERTEX_ATTRIBUTE_TEXCOORD0, VERTEX_ENCODING_FLOAT);
+	return format;
+}
+
+VertexFormat
+VertexFormat::standard() {
+	VertexFormat format;
+	format.set(VERTEX_ATTRIBUTE_POSITION, VERTEX_ENCODING_FLOAT)
+		  .set(VERTEX_ATTRIBUTE_NORMAL, VERTEX_ENCODING_OCTAHEDRAL)
+		  .set(VERTEX_ATTRIBUTE_TANGENT, VERTEX_ENCODING_SNORM8)
+		  .set(VERTEX_ATTRIBUTE_TEXCOORD0, VERTEX_ENCODING_FLOAT);
+	return format;
+}
+
+VertexFormat
+VertexFormat::compact() {
+	VertexFormat format;
+	format.set(VERTEX_ATTRIBUTE_POSITION, VERTEX_ENCODING_UNORM16)
+		  .set(VERTEX_ATTRIBUTE_NORMAL, VERTEX_ENCODING_OCTAHEDRAL)
+		  .set(VERTEX_ATTRIBUTE_TANGENT, VERTEX_ENCODING_UNORM1010102)
+		  .set(VERTEX_ATTRIBUTE_TEXCOORD0, VERTEX_ENCODING_HALF);
+	return format;
+}
+
+VertexFormat
+VertexFormat::unquantized() const {
+	VertexFormat format;
+	for (int i = 0; i < VERTEX_ATTRIBUTE_COUNT; ++i) {
+		if (m_encodings[i] != VERTEX_ENCODING_NONE) {
+			format.set(static_cast<VertexAttribute>(i), VERTEX_ENCODING_FLOAT);
+		}
+	}
+	return format;
+}
+
+bool
+VertexFormat::isSupported(VertexAttribute attribute, VertexEncoding encoding) {
+	switch (encoding) {
+	case VERTEX_ENCODING_NONE:
+	case VERTEX_ENCODING_FLOAT:
+		return true;
+	case VERTEX_ENCODING_OCTAHEDRAL:
+		return attribute == VERTEX_ATTRIBUTE_NORMAL;
+	case VERTEX_ENCODING_SNORM8:
+		return attribute == VERTEX_ATTRIBUTE_NORMAL || attribute == VERTEX_ATTRIBUTE_TANGENT;
+	case VERTEX_ENCODING_UNORM8:
+		return attribute == VERTEX_ATTRIBUTE_COLOR;
+	case VERTEX_ENCODING_UNORM16:
+		return attribute == VERTEX_ATTRIBUTE_POSITION;
+	case VERTEX_ENCODING_HALF:
+		return attribute == VERTEX_ATTRIBUTE_TEXCOORD0 || attribute == VERTEX_ATTRIBUTE_TEXCOORD1;
+	case VERTEX_ENCODING_UNORM1010102:
+		return attribute == VERTEX_ATTRIBUTE_NORMAL || attribute == VERTEX_ATTRIBUTE_TANGENT;
+	default:
+		return false;
+	}
+}
+
+VertexFormat&
+VertexFormat::set(VertexAttribute attribute, VertexEncoding encoding) {
+	if (attribute >= VERTEX_ATTRIBUTE_COUNT || !isSupported(attribute, encoding)) {
+		ERROR("VertexFormat", "set", "Unsupported encoding " << encoding << " for attribute " << attribute);
+		return *this;
+	}
+
+	// Los atributos van en orden y sin huecos
+	m_encodings[attribute] = encoding;
+	m_stride = 0;
+	for (int i = 0; i < VERTEX_ATTRIBUTE_COUNT; ++i) {
+		const VertexAttribute current = static_cast<VertexAttribute>(i);
+		m_offsets[i] = m_stride;
+		m_stride += encodingSize(current, m_encodings[i]);
+	}
+	return *this;
+}
+
+DXGI_FORMAT
+VertexFormat::getDxgiFormat(VertexAttribute attribute) const {
+	switch (m_encodings[attribute]) {
+	case VERTEX_ENCODING_FLOAT:
+		switch (g_componentCounts[attribute]) {
+		case 2: return DXGI_FORMAT_R32G32_FLOAT;
+		case 3: return DXGI_FORMAT_R32G32B32_FLOAT;
+		default: return DXGI_FORMAT_R32G32B32A32_FLOAT;
+		}
+	case VERTEX_ENCODING_OCTAHEDRAL:
+		return DXGI_FORMAT_R16G16_SNORM;
+	case VERTEX_ENCODING_SNORM8:
+		return DXGI_FORMAT_R8G8B8A8_SNORM;
+	case VERTEX_ENCODING_UNORM8:
+		return DXGI_FORMAT_R8G8B8A8_UNORM;
+	case VERTEX_ENCODING_UNORM16:
+		return DXGI_FORMAT_R16G16B16A16_UNORM;
+	case VERTEX_ENCODING_HALF:
+		return DXGI_FORMAT_R16G16_FLOAT;
+	case VERTEX_ENCODING_UNORM1010102:
+		return DXGI_FORMAT_R10G10B10A2_UNORM;
+	default:
+		return DXGI_FORMAT_UNKNOWN;
+	}
+}
+
+void
+VertexFormat::buildInputLayout(std::vector<D3D11_INPUT_ELEMENT_DESC>& layout, unsigned int slot) const {
+	for (int i = 0; i < VERTEX_ATTRIBUTE_COUNT; ++i) {
+		const VertexAttribute attribute = static_cast<VertexAttribute>(i);
+		if (!has(attribute)) {
+			continue;
+		}
+		D3D11_INPUT_ELEMENT_DESC element;
+		element.SemanticName = g_semanticNames[i];
+		element.SemanticIndex = g_semanticIndices[i];
+		element.Format = getDxgiFormat(attribute);
+		element.InputSlot = slot;
+		element.AlignedByteOffset = m_offsets[i];
+		element.InputSlotClass = D3D11_INPUT_PER_VERTEX_DATA;
+		element.InstanceDataStepRate = 0;
+		layout.push_back(element);
+	}
+}
+
+void
+VertexFormat::pack(const SimpleVertex* vertices,
+				   unsigned int count,
+				   void* output,
+				   const XMFLOAT3& boundsMin,
+				   const XMFLOAT3& boundsMax) const {
+	unsigned char* out = static_cast<unsigned char*>(output);
+	const float origin[3] = { boundsMin.x, boundsMin.y, boundsMin.z };
+	const float extent[3] = { boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y, boundsMax.z - boundsMin.z };
+	float value[4];
+	for (unsigned int v = 0; v < count; ++v, out += m_stride) {
+		for (int i = 0; i < VERTEX_ATTRIBUTE_COUNT; ++i) {
+			const VertexAttribute attribute = static_cast<VertexAttribute>(i);
+			unsigned char* target = out + m_offsets[i];
+			switch (m_encodings[i]) {
+			case VERTEX_ENCODING_FLOAT:
+				readAttribute(vertices[v], attribute, value);
+				memcpy(target, value, g_componentCounts[i] * sizeof(float));
+				break;
+			case VERTEX_ENCODING_OCTAHEDRAL: {
+				short encoded[2];
+				encodeOctahedral(vertices[v].Normal, encoded[0], encoded[1]);
+				memcpy(target, encoded, sizeof(encoded));
+				break;
+			}
+			case VERTEX_ENCODING_SNORM8: {
+				readAttribute(vertices[v], attribute, value);
+				if (attribute == VERTEX_ATTRIBUTE_NORMAL) {
+					value[3] = 0.0f;
+				}
+				const signed char encoded[4] = { toSnorm8(value[0]), toSnorm8(value[1]), toSnorm8(value[2]), toSnorm8(value[3]) };
+				memcpy(target, encoded, sizeof(encoded));
+				break;
+			}
+			case VERTEX_ENCODING_UNORM8:
+				memcpy(target, &vertices[v].Color, sizeof(unsigned int));
+				break;
+			case VERTEX_ENCODING_UNORM16: {
+				// Posición relativa a la caja; w = 1 para que el shader la lea como punto
+				readAttribute(vertices[v], attribute, value);
+				unsigned short encoded[4] = { 0, 0, 0, 0xFFFF };
+				for (int c = 0; c < 3; ++c) {
+					encoded[c] = static_cast<unsigned short>(extent[c] > 0.0f ? toUnorm((value[c] - origin[c]) / extent[c], 16) : 0);
+				}
+				memcpy(target, encoded, sizeof(encoded));
+				break;
+			}
+			case VERTEX_ENCODING_HALF: {
+				readAttribute(vertices[v], attribute, value);
+				const unsigned short encoded[2] = { floatToHalf(value[0]), floatToHalf(value[1]) };
+				memcpy(target, encoded, sizeof(encoded));
+				break;
+			}
+			case VERTEX_ENCODING_UNORM1010102: {
+				readAttribute(vertices[v], attribute, value);
+				const unsigned int sign = attribute == VERTEX_ATTRIBUTE_NORMAL || value[3] >= 0.0f ? 3u : 0u;
+				const unsigned int encoded = toUnorm(value[0] * 0.5f + 0.5f, 10) |
+											 (toUnorm(value[1] * 0.5f + 0.5f, 10) << 10) |
+											 (toUnorm(value[2] * 0.5f + 0.5f, 10) << 20) |
+											 (sign << 30);
+				memcpy(target, &encoded, sizeof(encoded));
+				break;
+			}
+			default:
+				break;
+			}
+		}
+	}
+}
+
+void
+VertexFormat::unpack(const void* input,
+					 unsigned int count,
+					 SimpleVertex* vertices,
+					 const XMFLOAT3& boundsMin,
+					 const XMFLOAT3& boundsMax) const {
+	const unsigned char* in = static_cast<const unsigned char*>(input);
+	const float origin[3] = { boundsMin.x, boundsMin.y, boundsMin.z };
+	const float extent[3] = { boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y, boundsMax.z - boundsMin.z };
+	float value[4];
+	for (unsigned int v = 0; v < count; ++v, in += m_stride) {
+		for (int i = 0; i < VERTEX_ATTRIBUTE_COUNT; ++i) {
+			const VertexAttribute attribute = static_cast<VertexAttribute>(i);
+			const unsigned char* source = in + m_offsets[i];
+			switch (m_encodings[i]) {
+			case VERTEX_ENCODING_FLOAT:
+				memcpy(value, source, g_componentCounts[i] * sizeof(float));
+				writeAttribute(vertices[v], attribute, value);
+				break;
+			case VERTEX_ENCODING_OCTAHEDRAL: {
+				short encoded[2];
+				memcpy(encoded, source, sizeof(encoded));
+				vertices[v].Normal = decodeOctahedral(encoded[0], encoded[1]);
+				break;
+			}
+			case VERTEX_ENCODING_SNORM8: {
+				signed char encoded[4];
+				memcpy(encoded, source, sizeof(encoded));
+				for (int c = 0; c < 4; ++c) {
+					value[c] = std::max(-1.0f, encoded[c] / 127.0f);
+				}
+				writeAttribute(vertices[v], attribute, value);
+				break;
+			}
+			case VERTEX_ENCODING_UNORM8:
+				memcpy(&vertices[v].Color, source, sizeof(unsigned int));
+				break;
+			case VERTEX_ENCODING_UNORM16: {
+				unsigned short encoded[4];
+				memcpy(encoded, source, sizeof(encoded));
+				for (int c = 0; c < 3; ++c) {
+					value[c] = origin[c] + encoded[c] / 65535.0f * extent[c];
+				}
+				writeAttribute(vertices[v], attribute, value);
+				break;
+			}
+			case VERTEX_ENCODING_HALF: {
+				unsigned short encoded[2];
+				memcpy(encoded, source, sizeof(encoded));
+				value[0] = halfToFloat(encoded[0]);
+				value[1] = halfToFloat(encoded[1]);
+				writeAttribute(vertices[v], attribute, value);
+				break;
+			}
+			case VERTEX_ENCODING_UNORM1010102: {
+				unsigned int encoded;
+				memcpy(&encoded, source, sizeof(encoded));
+				for (int c = 0; c < 3; ++c) {
+					value[c] = ((encoded >> (10 * c)) & 0x3FF) / 1023.0f * 2.0f - 1.0f;
+				}
+				value[3] = (encoded >> 30) / 3.0f * 2.0f - 1.0f;
+				writeAttribute(vertices[v], attribute, value);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+	}
+}
+
+VertexQuantizationError
+VertexFormat::measureError(const SimpleVertex* vertices,
+						   unsigned int count,
+						   const XMFLOAT3& boundsMin,
+						   const XMFLOAT3& boundsMax) const {
+	// 01. Ida y vuelta por el formato
+	std::vector<unsigned char> packed(static_cast<size_t>(m_stride) * count);
+	std::vector<SimpleVertex> decoded(vertices, vertices + count);
+	pack(vertices, count, packed.data(), boundsMin, boundsMax);
+	unpack(packed.data(), count, decoded.data(), boundsMin, boundsMax);
+
+	// 02. Máximo por atributo
+	VertexQuantizationError error;
+	float original[4];
+	float result[4];
+	for (unsigned int v = 0; v < count; ++v) {
+		if (has(VERTEX_ATTRIBUTE_POSITION)) {
+			readAttribute(vertices[v], VERTEX_ATTRIBUTE_POSITION, original);
+			readAttribute(decoded[v], VERTEX_ATTRIBUTE_POSITION, result);
+			const float dx = result[0] - original[0];
+			const float dy = result[1] - original[1];
+			const float dz = result[2] - original[2];
+			error.position = std::max(error.position, std::sqrt(dx * dx + dy * dy + dz * dz));
+		}
+		if (has(VERTEX_ATTRIBUTE_NORMAL)) {
+			readAttribute(vertices[v], VERTEX_ATTRIBUTE_NORMAL, original);
+			readAttribute(decoded[v], VERTEX_ATTRIBUTE_NORMAL, result);
+			error.normal = std::max(error.normal, angleBetween(original, result));
+		}
+		if (has(VERTEX_ATTRIBUTE_TANGENT)) {
+			readAttribute(vertices[v], VERTEX_ATTRIBUTE_TANGENT, original);
+			readAttribute(decoded[v], VERTEX_ATTRIBUTE_TANGENT, result);
+			const bool flipped = (original[3] < 0.0f) != (result[3] < 0.0f);
+			error.tangent = std::max(error.tangent, flipped ? 180.0f : angleBetween(original, result));
+		}
+		for (int i = VERTEX_ATTRIBUTE_TEXCOORD0; i <= VERTEX_ATTRIBUTE_TEXCOORD1; ++i) {
+			const VertexAttribute attribute = static_cast<VertexAttribute>(i);
+			if (!has(attribute)) {
+				continue;
+			}
+			readAttribute(vertices[v], attribute, original);
+			readAttribute(decoded[v], attribute, result);
+			error.texcoord = std::max(error.texcoord, std::max(std::fabs(result[0] - original[0]),
+															   std::fabs(result[1] - original[1])));
+		}
+	}
+	return error;
+}
+
+VertexFormat
+VertexFormat::fitError(const SimpleVertex* vertices,
+					   unsigned int count,
+					   const XMFLOAT3& boundsMin,
+					   const XMFLOAT3& boundsMax,
+					   const VertexQuantizationSettings& settings,
+					   VertexQuantizationError& error) const {
+	VertexFormat format = *this;
+	error = format.measureError(vertices, count, boundsMin, boundsMax);
+
+	// Cada atributo cuantizado que se pasa del error admitido vuelve a floats
+	auto relax = [&format](VertexAttribute attribute, bool exceeded) {
+		if (exceeded && format.has(attribute) && format.getEncoding(attribute) != VERTEX_ENCODING_FLOAT) {
+			format.set(attribute, VERTEX_ENCODING_FLOAT);
+			return true;
+		}
+		return false;
+	};
+	bool relaxed = relax(VERTEX_ATTRIBUTE_POSITION, error.position > settings.maxPositionError);
+	relaxed |= relax(VERTEX_ATTRIBUTE_NORMAL, error.normal > settings.maxDirectionError);
+	relaxed |= relax(VERTEX_ATTRIBUTE_TANGENT, error.tangent > settings.maxDirectionError);
+	relaxed |= relax(VERTEX_ATTRIBUTE_TEXCOORD0, error.texcoord > settings.maxTexcoordError);
+	relaxed |= relax(VERTEX_ATTRIBUTE_TEXCOORD1, error.texcoord > settings.maxTexcoordError);
+
+	if (relaxed) {
+		error = format.measureError(vertices, count, boundsMin, boundsMax);
+	}
+	return format;
+}
+
+XMMATRIX
+VertexFormat::getPositionDecode(const XMFLOAT3& boundsMin, const XMFLOAT3& boundsMax) const {
+	if (m_encodings[VERTEX_ATTRIBUTE_POSITION] != VERTEX_ENCODING_UNORM16) {
+		return XMMatrixIdentity();
+	}
+	return XMMatrixScaling(boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y, boundsMax.z - boundsMin.z) *
+		   XMMatrixTranslation(boundsMin.x, boundsMin.y, boundsMin.z);
+}
+
+bool
+VertexFormat::operator==(const VertexFormat& other) const {
+	return std::equal(m_encodings, m_encodings + VERTEX_ATTRIBUTE_COUNT, other.m_encodings);
+}
+
+void
+encodeOctahedral(const XMFLOAT3& direction, short& x, short& y) {
+	// Proyección sobre el octaedro |x| + |y| + |z| = 1; el hemisferio inferior se dobla hacia afuera
+	const float length = std::fabs(direction.x) + std::fabs(direction.y) + std::fabs(direction.z);
+	float u = length > 0.0f ? direction.x / length : 0.0f;
+	float v = length > 0.0f ? direction.y / length : 0.0f;
+	if (direction.z < 0.0f) {
+		const float foldedU = (1.0f - std::fabs(v)) * signNotZero(u);
+		const float foldedV = (1.0f - std::fabs(u)) * signNotZero(v);
+		u = foldedU;
+		v = foldedV;
+	}
+	x = static_cast<short>(std::round(std::max(-1.0f, std::min(1.0f, u)) * 32767.0f));
+	y = static_cast<short>(std::round(std::max(-1.0f, std::min(1.0f, v)) * 32767.0f));
+}
+
+XMFLOAT3
+decodeOctahedral(short x, short y) {
+	const float u = std::max(-1.0f, x / 32767.0f);
+	const float v = std::max(-1.0f, y / 32767.0f);
+	XMFLOAT3 direction(u, v, 1.0f - std::fabs(u) - std::fabs(v));
+	if (direction.z < 0.0f) {
+		direction.x = (1.0f - std::fabs(v)) * signNotZero(u);
+		direction.y = (1.0f - std::fabs(u)) * signNotZero(v);
+	}
+	const float length = std::sqrt(direction.x * direction.x + direction.y * direction.y + direction.z * direction.z);
+	return XMFLOAT3(direction.x / length, direction.y / length, direction.z / length);
+}
+
+unsigned short
+floatToHalf(float value) {
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+	const unsigned int sign = (bits >> 16) & 0x8000;
+	const unsigned int exponent = (bits >> 23) & 0xFF;
+	unsigned int mantissa = bits & 0x7FFFFF;
+
+	// NaN se conserva; infinito y valores fuera de rango saturan al máximo finito
+	if (exponent == 0xFF && mantissa != 0) {
+		return static_cast<unsigned short>(sign | 0x7E00);
+	}
+	const int halfExponent = static_cast<int>(exponent) - 127 + 15;
+	if (halfExponent >= 31) {
+		return static_cast<unsigned short>(sign | 0x7BFF);
+	}
+
+	unsigned int shift = 13;
+	unsigned int half = 0;
+	if (halfExponent <= 0) {
+		// Subnormal: la mantisa con su bit implícito se corre hasta el exponente mínimo
+		if (halfExponent < -10) {
+			return static_cast<unsigned short>(sign);
+		}
+		mantissa |= 0x800000;
+		shift = static_cast<unsigned int>(14 - halfExponent);
+	}
+	else {
+		half = static_cast<unsigned int>(halfExponent) << 10;
+	}
+	half |= mantissa >> shift;
+
+	// Redondeo al par; el acarreo puede subir el exponente, que es lo correcto
+	const unsigned int remainder = mantissa & ((1u << shift) - 1);
+	const unsigned int halfway = 1u << (shift - 1);
+	if (remainder > halfway || (remainder == halfway && (half & 1))) {
+		++half;
+	}
+	return static_cast<unsigned short>(sign | std::min(half, 0x7BFFu));
+}
+
+float
+halfToFloat(unsigned short value) {
+	const unsigned int sign = static_cast<unsigned int>(value & 0x8000) << 16;
+	const unsigned int exponent = (value >> 10) & 0x1F;
+	const unsigned int mantissa = value & 0x3FF;
+	unsigned int bits;
+	if (exponent == 0) {
+		const float magnitude = mantissa * (1.0f / 16777216.0f);
+		return sign ? -magnitude : magnitude;
+	}
+	if (exponent == 31) {
+		bits = sign | 0x7F800000 | (mantissa << 13);
+	}
+	else {
+		bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+	}
+	float result;
+	memcpy(&result, &bits, sizeof(result));
+	return result;
+}
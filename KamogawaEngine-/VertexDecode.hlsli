@@ -0,0 +1,42 @@
+//--------------------------------------------------------------------------------------
+// File: VertexDecode.hlsli
+//
+// Decodificación de los atributos cuantizados de VertexFormat. El input layout ya entrega
+// floats normalizados; estas funciones los llevan a su rango original.
+//--------------------------------------------------------------------------------------
+
+// Posición UNORM16 relativa a la caja de la malla. Los shaders del motor no la necesitan
+// porque la escala y el origen de la caja van antepuestos a la matriz de mundo.
+float3 DecodePosition( float3 encoded, float3 boundsMin, float3 boundsMax )
+{
+    return boundsMin + encoded * ( boundsMax - boundsMin );
+}
+
+// Normal octaédrica (R16G16_SNORM)
+float3 DecodeOctahedral( float2 encoded )
+{
+    float3 n = float3( encoded, 1.0f - abs( encoded.x ) - abs( encoded.y ) );
+    if ( n.z < 0.0f )
+    {
+        n.xy = ( 1.0f - abs( n.yx ) ) * float2( n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f );
+    }
+    return normalize( n );
+}
+
+// Dirección 10:10:10:2 (R10G10B10A2_UNORM); w trae el signo de la bitangente (-1 o 1)
+float4 DecodeUnorm1010102( float4 encoded )
+{
+    return float4( normalize( encoded.xyz * 2.0f - 1.0f ), encoded.w * 2.0f - 1.0f );
+}
+
+// Tangente SNORM8 (R8G8B8A8_SNORM) con el signo de la bitangente en w
+float4 DecodeSnorm8Tangent( float4 encoded )
+{
+    return float4( normalize( encoded.xyz ), encoded.w >= 0.0f ? 1.0f : -1.0f );
+}
+
+// Bitangente a partir de la normal y la tangente decodificadas (convención de MikkTSpace)
+float3 DecodeBitangent( float3 normal, float4 tangent )
+{
+    return tangent.w * cross( normal, tangent.xyz );
+}